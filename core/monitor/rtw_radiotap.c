@@ -285,20 +285,444 @@ static inline void _rtw_radiotap_fill_flags(struct rx_pkt_attrib *a, u8 *flags)
 
 }
 
+/* u16 frequency, u16 flags */
+static void _rtw_radiotap_fill_chan(_adapter *padapter,
+	struct rtw_recv_pkt *rx_req, u8 *p)
+{
+	u16 tmp_16bit = 0;
+
+	tmp_16bit = CHAN2FREQ(rtw_get_oper_ch(padapter));
+	_rtw_memcpy(&p[0], &tmp_16bit, 2);
+
+	/* channel flags */
+	tmp_16bit = 0;
+	if (WIFI_ROLE_IS_ON_24G(padapter))
+		tmp_16bit |= cpu_to_le16(IEEE80211_CHAN_2GHZ);
+	else
+		tmp_16bit |= cpu_to_le16(IEEE80211_CHAN_5GHZ);
+
+	if (rx_req->mdata.rx_rate <= RTW_DATA_RATE_CCK11) {
+		/* CCK */
+		tmp_16bit |= cpu_to_le16(IEEE80211_CHAN_CCK);
+	} else {
+		/* OFDM */
+		tmp_16bit |= cpu_to_le16(IEEE80211_CHAN_OFDM);
+	}
+
+	if (rtw_get_oper_bw(padapter) == CHANNEL_WIDTH_10) {
+		/* 10Mhz Channel Width */
+		tmp_16bit |= cpu_to_le16(IEEE80211_CHAN_HALF);
+	}
+
+	if (rtw_get_oper_bw(padapter) == CHANNEL_WIDTH_5) {
+		/* 5Mhz Channel Width */
+		tmp_16bit |= cpu_to_le16(IEEE80211_CHAN_QUARTER);
+	}
+	_rtw_memcpy(&p[2], &tmp_16bit, 2);
+}
+
+/* Structure u8 known, u8 flags, u8 mcs, p must be zeroed */
+static void _rtw_radiotap_fill_mcs(struct rx_pkt_attrib *a,
+	struct rtw_recv_pkt *rx_req, u8 *p)
+{
+	struct moinfo *moif = (struct moinfo *)&a->moif;
+
+	/* known.bandwidth */
+	p[0] |= IEEE80211_RADIOTAP_MCS_HAVE_BW;
+	if (moif->u.snif_info.ofdm_bw)
+		p[1] |= IEEE80211_RADIOTAP_MCS_BW_40;
+	if (rx_req->mdata.bw == CHANNEL_WIDTH_40)
+		p[1] |= IEEE80211_RADIOTAP_MCS_BW_40;
+	else
+		p[1] |= IEEE80211_RADIOTAP_MCS_BW_20;
+
+
+	/* known.guard interval */
+	p[0] |= IEEE80211_RADIOTAP_MCS_HAVE_GI;
+	if (moif->u.snif_info.sgi) {
+		p[1] |= IEEE80211_RADIOTAP_MCS_SGI;
+	} else {
+		p[1] |= ((a->sgi & 0x01) << 2);
+	}
+
+	/* FEC Type */
+	p[0] |= IEEE80211_RADIOTAP_MCS_HAVE_FEC;
+	if (moif->u.snif_info.ldpc) {
+		p[1] |= ((moif->u.snif_info.ldpc & 0x01) << 4);
+	} else {
+		p[1] |= ((a->ldpc & 0x01) << 4);
+	}
+
+	/* STBC */
+	p[0] |= IEEE80211_RADIOTAP_MCS_HAVE_STBC;
+	if (moif->u.snif_info.stbc) {
+		p[1] |= ((moif->u.snif_info.stbc & 0x03) << 5);
+	} else {
+		p[1] |= ((a->stbc & 0x03) << 5);
+	}
+
+	/* known.MCS index */
+	p[0] |= IEEE80211_RADIOTAP_MCS_HAVE_MCS;
+
+	/* u8 mcs */
+	p[2] = rx_req->mdata.rx_rate - RTW_DATA_RATE_MCS0;
+}
+
+/* Structure u32 reference number, u16 flags, u8 delimiter CRC value, u8 reserved */
+static void _rtw_radiotap_fill_ampdu(struct rtw_recv_pkt *rx_req, u8 *p)
+{
+	static u32 ref_num = 0x10000000;
+	static u8 ppdu_cnt = 0;
+	u16 tmp_16bit = 0;
+	u32 tmp_32bit = 0;
+
+	/* u32 reference number */
+	if (rx_req->mdata.ppdu_cnt != ppdu_cnt) {
+		ppdu_cnt = rx_req->mdata.ppdu_cnt;
+		ref_num += 1;
+	}
+	tmp_32bit = cpu_to_le32(ref_num);
+	_rtw_memcpy(&p[0], &tmp_32bit, 4);
+
+	/* u16 flags */
+	if (0) {
+		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_AMPDU_REPORT_ZEROLEN);
+		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_AMPDU_IS_ZEROLEN);
+	}
+
+	if (0) {
+		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_AMPDU_IS_LAST);
+		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_AMPDU_LAST_KNOWN);
+	}
+
+	if (0) {
+		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_AMPDU_DELIM_CRC_ERR);
+		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_AMPDU_DELIM_CRC_KNOWN);
+	}
+
+	if (rx_req->mdata.ampdu_end_pkt) {
+		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_AMPDU_EOF_KNOWN);
+		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_AMPDU_EOF);
+	}
+
+	_rtw_memcpy(&p[4], &tmp_16bit, 2);
+
+	/* u8 delimiter CRC value, u8 reserved */
+	p[6] = 0;
+	p[7] = 0;
+}
+
+/*
+ * Structure
+ * u16 known, u8 flags, u8 bandwidth, u8 mcs_nss[4],
+ * u8 coding, u8 group_id, u16 partial_aid
+ * p must be zeroed
+ */
+static void _rtw_radiotap_fill_vht(struct rx_pkt_attrib *a,
+	struct rtw_recv_pkt *rx_req, u8 *p)
+{
+	struct moinfo *moif = (struct moinfo *)&a->moif;
+	u8 tmp_8bit = 0;
+	u16 tmp_16bit = 0;
+
+	/* STBC */
+	tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_STBC);
+	if (moif->u.snif_info.stbc) {
+		p[2] |= IEEE80211_RADIOTAP_VHT_FLAG_STBC;
+	} else {
+		p[2] |= (a->stbc & 0x01);
+	}
+
+	/* TXOP_PS_NOT_ALLOWED */
+	tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_TXOP_PS_NA);
+	if (moif->u.snif_info.vht_txop_not_allow) {
+		p[2] |= IEEE80211_RADIOTAP_VHT_FLAG_TXOP_PS_NA;
+	}
+
+
+	/* Guard interval */
+	tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_GI);
+	if (moif->u.snif_info.sgi) {
+		p[2] |= IEEE80211_RADIOTAP_VHT_FLAG_SGI;
+	} else {
+		p[2] |= ((a->sgi & 0x01) << 2);
+	}
+
+	/* Short GI NSYM */
+	tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_SGI_NSYM_DIS);
+	if (moif->u.snif_info.vht_nsym_dis) {
+		p[2] |= IEEE80211_RADIOTAP_VHT_FLAG_SGI_NSYM_M10_9;
+	}
+
+	/* LDPC extra OFDM symbol */
+	tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_LDPC_EXTRA_OFDM_SYM);
+	if (moif->u.snif_info.vht_ldpc_extra) {
+		p[2] |= IEEE80211_RADIOTAP_VHT_FLAG_LDPC_EXTRA_OFDM_SYM;
+	} else {
+		p[2] |= ((a->ldpc & 0x01) << 4);
+	}
+
+	/* Short GI NSYM */
+	tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_BEAMFORMED);
+	if (moif->u.snif_info.vht_beamformed) {
+		p[2] |= IEEE80211_RADIOTAP_VHT_FLAG_BEAMFORMED;
+	}
+
+	/* know.Bandwidth */
+	tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_BANDWIDTH);
+
+	/* Group ID */
+	tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_GROUP_ID);
+
+	/* Partial AID */
+	tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_PARTIAL_AID);
+
+	_rtw_memcpy(&p[0], &tmp_16bit, 2);
+
+	/* u8 bandwidth */
+	if (moif->u.snif_info.ofdm_bw)
+		tmp_8bit = moif->u.snif_info.ofdm_bw;
+	else
+		tmp_8bit = rx_req->mdata.bw;
+
+	switch (tmp_8bit) {
+	case CHANNEL_WIDTH_20:
+		p[3] |= 0;
+		break;
+	case CHANNEL_WIDTH_40:
+		p[3] |= 1;
+		break;
+	case CHANNEL_WIDTH_80:
+		p[3] |= 4;
+		break;
+	case CHANNEL_WIDTH_160:
+		p[3] |= 11;
+		break;
+	default:
+		p[3] |= 0;
+	}
+
+	/* u8 mcs_nss[4] */
+	if ((RTW_DATA_RATE_VHT_NSS1_MCS0 <= rx_req->mdata.rx_rate) &&
+		(rx_req->mdata.rx_rate <= RTW_DATA_RATE_VHT_NSS4_MCS9)) {
+		/* User 0 */
+		/* MCS */
+		p[4] = cpu_to_le16 (((rx_req->mdata.rx_rate - RTW_DATA_RATE_VHT_NSS1_MCS0) % 10) << 4);
+		/* NSS */
+		p[4] |= cpu_to_le16((((rx_req->mdata.rx_rate - RTW_DATA_RATE_VHT_NSS1_MCS0) / 10) + 1));
+	}
+
+	/* u8 coding, phystat? */
+	p[8] = 0;
+
+	/* u8 group_id */
+	p[9] = moif->u.snif_info.vht_group_id;
+
+	/* u16 partial_aid */
+	tmp_16bit = cpu_to_le16(moif->u.snif_info.vht_nsts_aid);
+	_rtw_memcpy(&p[10], &tmp_16bit, 2);
+}
+
+/* Structure u16 data1, data2, data3, data4, data5, data6 */
+static void _rtw_radiotap_fill_he(struct rtw_recv_pkt *rx_req, u8 *p)
+{
+	struct ieee80211_radiotap_he he_hdr;
+	u8 ltf, he_gi, ss;
+
+	_rtw_memset(&he_hdr, 0, sizeof(struct ieee80211_radiotap_he));
+
+	/* HE PPDU Format: 0=HE_SU, 1=HE_EXT_SU, 2=HE_MU, 3=HE_TRIG */
+	he_hdr.data1 |= 0x0000;
+	he_hdr.data1 |= cpu_to_le16(IEEE80211_RADIOTAP_HE_DATA1_DATA_MCS_KNOWN);
+	he_hdr.data1 |= cpu_to_le16(IEEE80211_RADIOTAP_HE_DATA1_BW_RU_ALLOC_KNOWN);
+
+	he_hdr.data2 |= cpu_to_le16(IEEE80211_RADIOTAP_HE_DATA2_GI_KNOWN);
+	he_hdr.data2 |= cpu_to_le16(IEEE80211_RADIOTAP_HE_DATA2_NUM_LTF_SYMS_KNOWN);
+
+	he_hdr.data3 |= __le16_encode_bits((rx_req->mdata.rx_rate & 0xf), IEEE80211_RADIOTAP_HE_DATA3_DATA_MCS);
+
+	he_hdr.data5 |= cpu_to_le16((rx_req->mdata.bw));
+
+	switch (rx_req->mdata.rx_gi_ltf) {
+	case 0x0:
+		he_gi = IEEE80211_RADIOTAP_HE_DATA5_GI_3_2;
+		ltf = IEEE80211_RADIOTAP_HE_DATA5_LTF_SIZE_4X;
+		break;
+	case 0x1:
+		he_gi = IEEE80211_RADIOTAP_HE_DATA5_GI_0_8;
+		ltf = IEEE80211_RADIOTAP_HE_DATA5_LTF_SIZE_4X;
+		break;
+	case 0x2:
+		he_gi = IEEE80211_RADIOTAP_HE_DATA5_GI_1_6;
+		ltf = IEEE80211_RADIOTAP_HE_DATA5_LTF_SIZE_2X;
+		break;
+	case 0x3:
+		he_gi = IEEE80211_RADIOTAP_HE_DATA5_GI_0_8;
+		ltf = IEEE80211_RADIOTAP_HE_DATA5_LTF_SIZE_2X;
+		break;
+	case 0x4:
+		he_gi = IEEE80211_RADIOTAP_HE_DATA5_GI_1_6;
+		ltf = IEEE80211_RADIOTAP_HE_DATA5_LTF_SIZE_1X;
+		break;
+	case 0x5:
+		he_gi = IEEE80211_RADIOTAP_HE_DATA5_GI_0_8;
+		ltf = IEEE80211_RADIOTAP_HE_DATA5_LTF_SIZE_1X;
+		break;
+	default:
+		he_gi = IEEE80211_RADIOTAP_HE_DATA5_GI_0_8;
+		ltf = IEEE80211_RADIOTAP_HE_DATA5_LTF_SIZE_1X;
+		break;
+	}
+
+	he_hdr.data5 |= __le16_encode_bits(he_gi, IEEE80211_RADIOTAP_HE_DATA5_GI);
+	he_hdr.data5 |= __le16_encode_bits(ltf, IEEE80211_RADIOTAP_HE_DATA5_LTF_SIZE);
+
+	ss = cpu_to_le16(((0x70 & rx_req->mdata.rx_rate) >> 4) + 1);
+	he_hdr.data6 |= __le16_encode_bits(ss, IEEE80211_RADIOTAP_HE_DATA6_NSTS);
+
+	_rtw_memcpy(p, &he_hdr, sizeof(struct ieee80211_radiotap_he));
+}
+
+#ifdef CONFIG_RTW_MON_RTAP_FAST
+enum rtw_rtap_ppdu {
+	RTW_RTAP_PPDU_OTHER,
+	RTW_RTAP_PPDU_LEGACY,
+	RTW_RTAP_PPDU_HT,
+	RTW_RTAP_PPDU_VHT,
+	RTW_RTAP_PPDU_HE,
+	RTW_RTAP_PPDU_NUM
+};
+
+/* flags, channel and dBm antenna signal are in every layout */
+#define RTW_RTAP_OFS_FLAGS	8
+#define RTW_RTAP_OFS_RATE	9
+#define RTW_RTAP_OFS_CHAN	10
+#define RTW_RTAP_OFS_ANTSIG	14
+
+#define RTW_RTAP_PRESENT_BASE	(BIT(IEEE80211_RADIOTAP_FLAGS) | \
+				 BIT(IEEE80211_RADIOTAP_CHANNEL) | \
+				 BIT(IEEE80211_RADIOTAP_DBM_ANTSIGNAL))
+#define RTW_RTAP_PRESENT_AMPDU	BIT(IEEE80211_RADIOTAP_AMPDU_STATUS)
+
+/*
+ * Radiotap layout of a ppdu type, aligned as the radiotap spec requires.
+ * Offset 0 means the field is absent.
+ */
+struct rtw_rtap_tmpl {
+	u32 present;
+	u8 len;
+	u8 mcs;
+	u8 ampdu;
+	u8 vht;
+	u8 he;
+};
+
+/* [ppdu type][ampdu] */
+static const struct rtw_rtap_tmpl rtw_rtap_tmpl[RTW_RTAP_PPDU_NUM][2] = {
+	[RTW_RTAP_PPDU_OTHER] = {
+		{RTW_RTAP_PRESENT_BASE, 15, 0, 0, 0, 0},
+		{RTW_RTAP_PRESENT_BASE | RTW_RTAP_PRESENT_AMPDU, 24, 0, 16, 0, 0},
+	},
+	[RTW_RTAP_PPDU_LEGACY] = {
+		{RTW_RTAP_PRESENT_BASE | BIT(IEEE80211_RADIOTAP_RATE),
+			15, 0, 0, 0, 0},
+		{RTW_RTAP_PRESENT_BASE | BIT(IEEE80211_RADIOTAP_RATE) |
+			RTW_RTAP_PRESENT_AMPDU, 24, 0, 16, 0, 0},
+	},
+	[RTW_RTAP_PPDU_HT] = {
+		{RTW_RTAP_PRESENT_BASE | BIT(IEEE80211_RADIOTAP_MCS),
+			18, 15, 0, 0, 0},
+		{RTW_RTAP_PRESENT_BASE | BIT(IEEE80211_RADIOTAP_MCS) |
+			RTW_RTAP_PRESENT_AMPDU, 28, 15, 20, 0, 0},
+	},
+	[RTW_RTAP_PPDU_VHT] = {
+		{RTW_RTAP_PRESENT_BASE | BIT(IEEE80211_RADIOTAP_VHT),
+			28, 0, 0, 16, 0},
+		{RTW_RTAP_PRESENT_BASE | BIT(IEEE80211_RADIOTAP_VHT) |
+			RTW_RTAP_PRESENT_AMPDU, 36, 0, 16, 24, 0},
+	},
+	[RTW_RTAP_PPDU_HE] = {
+		{RTW_RTAP_PRESENT_BASE | BIT(IEEE80211_RADIOTAP_HE),
+			28, 0, 0, 0, 16},
+		{RTW_RTAP_PRESENT_BASE | BIT(IEEE80211_RADIOTAP_HE) |
+			RTW_RTAP_PRESENT_AMPDU, 36, 0, 16, 0, 24},
+	},
+};
+
+static u8 _rtw_radiotap_ppdu(u16 rate)
+{
+	if (rate <= RTW_DATA_RATE_OFDM54)
+		return RTW_RTAP_PPDU_LEGACY;
+	if (rate >= RTW_DATA_RATE_MCS0 && rate <= RTW_DATA_RATE_MCS31)
+		return RTW_RTAP_PPDU_HT;
+	if (rate >= RTW_DATA_RATE_VHT_NSS1_MCS0 && rate <= RTW_DATA_RATE_VHT_NSS4_MCS9)
+		return RTW_RTAP_PPDU_VHT;
+	if (rate >= RTW_DATA_RATE_HE_NSS1_MCS0 && rate <= RTW_DATA_RATE_HE_NSS4_MCS11)
+		return RTW_RTAP_PPDU_HE;
+	return RTW_RTAP_PPDU_OTHER;
+}
+
+/*
+ * Push the header of the ppdu type in place and fill only the per packet
+ * fields. The rx copy reserves RTW_RTAP_HDR_MAX of headroom in monitor
+ * mode, so the skb is reallocated only when it came without.
+ */
+sint rtw_fill_radiotap_hdr(_adapter *padapter,
+	struct rx_pkt_attrib *a, struct rtw_recv_pkt *rx_req, u8 *buf)
+{
+	struct sk_buff *pskb = (struct sk_buff *)buf;
+	const struct rtw_rtap_tmpl *t = NULL;
+	struct ieee80211_radiotap_header *rtap_hdr = NULL;
+	u8 ppdu = _rtw_radiotap_ppdu(rx_req->mdata.rx_rate);
+	u8 *ptr = NULL;
+
+	t = &rtw_rtap_tmpl[ppdu][rx_req->mdata.ampdu ? 1 : 0];
+
+	if (skb_headroom(pskb) < t->len) {
+		padapter->recvinfo.rx_rtap_realloc++;
+		if (pskb_expand_head(pskb, RTW_RTAP_HDR_MAX, 0, GFP_ATOMIC)) {
+			RTW_INFO("%s:%d %s headroom is too small.\n", __FILE__, __LINE__, __func__);
+			return _FAIL;
+		}
+	}
+
+	ptr = skb_push(pskb, t->len);
+	_rtw_memset(ptr, 0, t->len);
+
+	rtap_hdr = (struct ieee80211_radiotap_header *)ptr;
+	rtap_hdr->it_version = PKTHDR_RADIOTAP_VERSION;
+	rtap_hdr->it_len = cpu_to_le16(t->len);
+	rtap_hdr->it_present = cpu_to_le32(t->present);
+
+	_rtw_radiotap_fill_flags(a, &ptr[RTW_RTAP_OFS_FLAGS]);
+	if (ppdu == RTW_RTAP_PPDU_LEGACY)
+		ptr[RTW_RTAP_OFS_RATE] = hwrate_to_mrate(rx_req->mdata.rx_rate);
+	_rtw_radiotap_fill_chan(padapter, rx_req, &ptr[RTW_RTAP_OFS_CHAN]);
+	ptr[RTW_RTAP_OFS_ANTSIG] = a->phy_info.recv_signal_power;
+
+	if (t->mcs)
+		_rtw_radiotap_fill_mcs(a, rx_req, &ptr[t->mcs]);
+	if (t->ampdu)
+		_rtw_radiotap_fill_ampdu(rx_req, &ptr[t->ampdu]);
+	if (t->vht)
+		_rtw_radiotap_fill_vht(a, rx_req, &ptr[t->vht]);
+	if (t->he)
+		_rtw_radiotap_fill_he(rx_req, &ptr[t->he]);
+
+	return _SUCCESS;
+}
+#else /* !CONFIG_RTW_MON_RTAP_FAST */
 sint rtw_fill_radiotap_hdr(_adapter *padapter,
 	struct rx_pkt_attrib *a, struct rtw_recv_pkt *rx_req, u8 *buf)
 {
 #define RTAP_HDR_MAX 64
 
 	sint ret = _SUCCESS;
-	struct moinfo *moif = (struct moinfo *)&a->moif;
 
 	u8 rx_cnt = 0;
 
 	int i = 0;
-	u8 tmp_8bit = 0;
 	u16 tmp_16bit = 0;
-	u32 tmp_32bit = 0;
 	u64 tmp_64bit = 0;
 
 	struct sk_buff *pskb = NULL;
@@ -373,36 +797,8 @@ sint rtw_fill_radiotap_hdr(_adapter *padapter,
 		rtap_hdr->it_present |= BIT(IEEE80211_RADIOTAP_CHANNEL);
 		rt_len += (rt_len % 2); /* Alignment */
 
-		tmp_16bit = CHAN2FREQ(rtw_get_oper_ch(padapter));
-		_rtw_memcpy(&hdr_buf[rt_len], &tmp_16bit, 2);
-		rt_len += 2;
-
-		/* channel flags */
-		tmp_16bit = 0;
-		if (WIFI_ROLE_IS_ON_24G(padapter))
-			tmp_16bit |= cpu_to_le16(IEEE80211_CHAN_2GHZ);
-		else
-			tmp_16bit |= cpu_to_le16(IEEE80211_CHAN_5GHZ);
-
-		if (rx_req->mdata.rx_rate <= RTW_DATA_RATE_CCK11) {
-			/* CCK */
-			tmp_16bit |= cpu_to_le16(IEEE80211_CHAN_CCK);
-		} else {
-			/* OFDM */
-			tmp_16bit |= cpu_to_le16(IEEE80211_CHAN_OFDM);
-		}
-
-		if (rtw_get_oper_bw(padapter) == CHANNEL_WIDTH_10) {
-			/* 10Mhz Channel Width */
-			tmp_16bit |= cpu_to_le16(IEEE80211_CHAN_HALF);
-		}
-
-		if (rtw_get_oper_bw(padapter) == CHANNEL_WIDTH_5) {
-			/* 5Mhz Channel Width */
-			tmp_16bit |= cpu_to_le16(IEEE80211_CHAN_QUARTER);
-		}
-		_rtw_memcpy(&hdr_buf[rt_len], &tmp_16bit, 2);
-		rt_len += 2;
+		_rtw_radiotap_fill_chan(padapter, rx_req, &hdr_buf[rt_len]);
+		rt_len += 4;
 	}
 
 	/* dBm Antenna Signal */
@@ -443,97 +839,19 @@ sint rtw_fill_radiotap_hdr(_adapter *padapter,
 	/* MCS information, Required Alignment: 1 bytes */
 	if (rx_req->mdata.rx_rate >= RTW_DATA_RATE_MCS0 && rx_req->mdata.rx_rate <= RTW_DATA_RATE_MCS31) {
 		rtap_hdr->it_present |= BIT(IEEE80211_RADIOTAP_MCS);
-		/* Structure u8 known, u8 flags, u8 mcs */
-
-		/* known.bandwidth */
-		hdr_buf[rt_len] |= IEEE80211_RADIOTAP_MCS_HAVE_BW;
-		if (moif->u.snif_info.ofdm_bw)
-			hdr_buf[rt_len + 1] |= IEEE80211_RADIOTAP_MCS_BW_40;
-		if (rx_req->mdata.bw == CHANNEL_WIDTH_40)
-			hdr_buf[rt_len + 1] |= IEEE80211_RADIOTAP_MCS_BW_40;
-		else
-			hdr_buf[rt_len + 1] |= IEEE80211_RADIOTAP_MCS_BW_20;
-
-
-		/* known.guard interval */
-		hdr_buf[rt_len] |= IEEE80211_RADIOTAP_MCS_HAVE_GI;
-		if (moif->u.snif_info.sgi) {
-			hdr_buf[rt_len + 1] |= IEEE80211_RADIOTAP_MCS_SGI;
-		} else {
-			hdr_buf[rt_len + 1] |= ((a->sgi & 0x01) << 2);
-		}
-
-		/* FEC Type */
-		hdr_buf[rt_len] |= IEEE80211_RADIOTAP_MCS_HAVE_FEC;
-		if (moif->u.snif_info.ldpc) {
-			hdr_buf[rt_len + 1] |= ((moif->u.snif_info.ldpc & 0x01) << 4);
-		} else {
-			hdr_buf[rt_len + 1] |= ((a->ldpc & 0x01) << 4);
-		}
-
-		/* STBC */
-		hdr_buf[rt_len] |= IEEE80211_RADIOTAP_MCS_HAVE_STBC;
-		if (moif->u.snif_info.stbc) {
-			hdr_buf[rt_len + 1] |= ((moif->u.snif_info.stbc & 0x03) << 5);
-		} else {
-			hdr_buf[rt_len + 1] |= ((a->stbc & 0x03) << 5);
-		}
-
-		/* known.MCS index */
-		hdr_buf[rt_len] |= IEEE80211_RADIOTAP_MCS_HAVE_MCS;
-
-		/* u8 mcs */
-		hdr_buf[rt_len + 2] = rx_req->mdata.rx_rate - RTW_DATA_RATE_MCS0;
-
+		_rtw_radiotap_fill_mcs(a, rx_req, &hdr_buf[rt_len]);
 		rt_len += 3;
 	}
 
 	/* AMPDU, Required Alignment: 4 bytes */
 	if (rx_req->mdata.ampdu) {
-		static u32 ref_num = 0x10000000;
-		static u8 ppdu_cnt = 0;
-
 		/* Structure u32 reference number, u16 flags, u8 delimiter CRC value, u8 reserved */
 		rtap_hdr->it_present |= BIT(IEEE80211_RADIOTAP_AMPDU_STATUS);
 		if (!IS_ALIGNED(rt_len, 4))
 			rt_len = ((rt_len + 3) & 0xFFFC); /* Alignment */
 
-		/* u32 reference number */
-		if (rx_req->mdata.ppdu_cnt != ppdu_cnt) {
-			ppdu_cnt = rx_req->mdata.ppdu_cnt;
-			ref_num += 1;
-		}
-		tmp_32bit = cpu_to_le32(ref_num);
-		_rtw_memcpy(&hdr_buf[rt_len], &tmp_32bit, 4);
-		rt_len += 4;
-
-		/* u16 flags */
-		tmp_16bit = 0;
-		if (0) {
-			tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_AMPDU_REPORT_ZEROLEN);
-			tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_AMPDU_IS_ZEROLEN);
-		}
-
-		if (0) {
-			tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_AMPDU_IS_LAST);
-			tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_AMPDU_LAST_KNOWN);
-		}
-
-		if (0) {
-			tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_AMPDU_DELIM_CRC_ERR);
-			tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_AMPDU_DELIM_CRC_KNOWN);
-		}
-
-		if (rx_req->mdata.ampdu_end_pkt) {
-			tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_AMPDU_EOF_KNOWN);
-			tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_AMPDU_EOF);
-		}
-
-		_rtw_memcpy(&hdr_buf[rt_len], &tmp_16bit, 2);
-		rt_len += 2;
-
-		/* u8 delimiter CRC value, u8 reserved */
-		rt_len += 2;
+		_rtw_radiotap_fill_ampdu(rx_req, &hdr_buf[rt_len]);
+		rt_len += 8;
 	}
 
 	/* VHT, Required Alignment: 2 bytes */
@@ -543,180 +861,16 @@ sint rtw_fill_radiotap_hdr(_adapter *padapter,
 
 		rt_len += (rt_len % 2); /* Alignment */
 
-		/* Structure
-		   u16 known, u8 flags, u8 bandwidth, u8 mcs_nss[4],
-		   u8 coding, u8 group_id, u16 partial_aid */
-
-		tmp_16bit = 0;
-
-		/* STBC */
-		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_STBC);
-		if (moif->u.snif_info.stbc) {
-			hdr_buf[rt_len + 2] |= IEEE80211_RADIOTAP_VHT_FLAG_STBC;
-		} else {
-			hdr_buf[rt_len + 2] |= (a->stbc & 0x01);
-		}
-
-		/* TXOP_PS_NOT_ALLOWED */
-		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_TXOP_PS_NA);
-		if (moif->u.snif_info.vht_txop_not_allow) {
-			hdr_buf[rt_len + 2] |= IEEE80211_RADIOTAP_VHT_FLAG_TXOP_PS_NA;
-		}
-
-
-		/* Guard interval */
-		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_GI);
-		if (moif->u.snif_info.sgi) {
-			hdr_buf[rt_len + 2] |= IEEE80211_RADIOTAP_VHT_FLAG_SGI;
-		} else {
-			hdr_buf[rt_len + 2] |= ((a->sgi & 0x01) << 2);
-		}
-
-		/* Short GI NSYM */
-		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_SGI_NSYM_DIS);
-		if (moif->u.snif_info.vht_nsym_dis) {
-			hdr_buf[rt_len + 2] |= IEEE80211_RADIOTAP_VHT_FLAG_SGI_NSYM_M10_9;
-		}
-
-		/* LDPC extra OFDM symbol */
-		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_LDPC_EXTRA_OFDM_SYM);
-		if (moif->u.snif_info.vht_ldpc_extra) {
-			hdr_buf[rt_len + 2] |= IEEE80211_RADIOTAP_VHT_FLAG_LDPC_EXTRA_OFDM_SYM;
-		} else {
-			hdr_buf[rt_len + 2] |= ((a->ldpc & 0x01) << 4);
-		}
-
-		/* Short GI NSYM */
-		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_BEAMFORMED);
-		if (moif->u.snif_info.vht_beamformed) {
-			hdr_buf[rt_len + 2] |= IEEE80211_RADIOTAP_VHT_FLAG_BEAMFORMED;
-		}
-
-		/* know.Bandwidth */
-		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_BANDWIDTH);
-
-		/* Group ID */
-		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_GROUP_ID);
-
-		/* Partial AID */
-		tmp_16bit |= cpu_to_le16(IEEE80211_RADIOTAP_VHT_KNOWN_PARTIAL_AID);
-
-		_rtw_memcpy(&hdr_buf[rt_len], &tmp_16bit, 2);
-		rt_len += 3;
-
-		/* u8 bandwidth */
-		if (moif->u.snif_info.ofdm_bw)
-			tmp_8bit = moif->u.snif_info.ofdm_bw;
-		else
-			tmp_8bit = rx_req->mdata.bw;
-
-		switch (tmp_8bit) {
-		case CHANNEL_WIDTH_20:
-			hdr_buf[rt_len] |= 0;
-			break;
-		case CHANNEL_WIDTH_40:
-			hdr_buf[rt_len] |= 1;
-			break;
-		case CHANNEL_WIDTH_80:
-			hdr_buf[rt_len] |= 4;
-			break;
-		case CHANNEL_WIDTH_160:
-			hdr_buf[rt_len] |= 11;
-			break;
-		default:
-			hdr_buf[rt_len] |= 0;
-		}
-		rt_len += 1;
-
-		/* u8 mcs_nss[4] */
-		if ((RTW_DATA_RATE_VHT_NSS1_MCS0 <= rx_req->mdata.rx_rate) &&
-			(rx_req->mdata.rx_rate <= RTW_DATA_RATE_VHT_NSS4_MCS9)) {
-			/* User 0 */
-			/* MCS */
-			hdr_buf[rt_len] = cpu_to_le16 (((rx_req->mdata.rx_rate - RTW_DATA_RATE_VHT_NSS1_MCS0) % 10) << 4);
-			/* NSS */
-			hdr_buf[rt_len] |= cpu_to_le16((((rx_req->mdata.rx_rate - RTW_DATA_RATE_VHT_NSS1_MCS0) / 10) + 1));
-		}
-		rt_len += 4;
-
-		/* u8 coding, phystat? */
-		hdr_buf[rt_len] = 0;
-		rt_len += 1;
-
-		/* u8 group_id */
-		hdr_buf[rt_len] = moif->u.snif_info.vht_group_id;
-		rt_len += 1;
-
-		/* u16 partial_aid */
-		tmp_16bit = cpu_to_le16(moif->u.snif_info.vht_nsts_aid);
-		_rtw_memcpy(&hdr_buf[rt_len], &tmp_16bit, 2);
-		rt_len += 2;
+		_rtw_radiotap_fill_vht(a, rx_req, &hdr_buf[rt_len]);
+		rt_len += 12;
 	}
 
 	/* HE, Required Alignment: 2 bytes */
 	if (rx_req->mdata.rx_rate >= RTW_DATA_RATE_HE_NSS1_MCS0 && rx_req->mdata.rx_rate <= RTW_DATA_RATE_HE_NSS4_MCS11) {
 
-		struct ieee80211_radiotap_he he_hdr;
-		u8 ltf, he_gi, ss;
-
-		_rtw_memset(&he_hdr, 0, sizeof(struct ieee80211_radiotap_he));
 		rtap_hdr->it_present |= BIT(IEEE80211_RADIOTAP_HE);
-
 		rt_len += (rt_len % 2); /* Alignment */
-		/* Structure
-		   u16 data1, data2, data3, data4, data5, data6 */
-
-		/* HE PPDU Format: 0=HE_SU, 1=HE_EXT_SU, 2=HE_MU, 3=HE_TRIG */
-		he_hdr.data1 |= 0x0000;
-		he_hdr.data1 |= cpu_to_le16(IEEE80211_RADIOTAP_HE_DATA1_DATA_MCS_KNOWN);
-		he_hdr.data1 |= cpu_to_le16(IEEE80211_RADIOTAP_HE_DATA1_BW_RU_ALLOC_KNOWN);
-
-		he_hdr.data2 |= cpu_to_le16(IEEE80211_RADIOTAP_HE_DATA2_GI_KNOWN);
-		he_hdr.data2 |= cpu_to_le16(IEEE80211_RADIOTAP_HE_DATA2_NUM_LTF_SYMS_KNOWN);
-
-		he_hdr.data3 |= __le16_encode_bits((rx_req->mdata.rx_rate & 0xf), IEEE80211_RADIOTAP_HE_DATA3_DATA_MCS);
-
-		he_hdr.data5 |= cpu_to_le16((rx_req->mdata.bw));
-
-		switch (rx_req->mdata.rx_gi_ltf) {
-		case 0x0:
-			he_gi = IEEE80211_RADIOTAP_HE_DATA5_GI_3_2;
-			ltf = IEEE80211_RADIOTAP_HE_DATA5_LTF_SIZE_4X;
-			break;
-		case 0x1:
-			he_gi = IEEE80211_RADIOTAP_HE_DATA5_GI_0_8;
-			ltf = IEEE80211_RADIOTAP_HE_DATA5_LTF_SIZE_4X;
-			break;
-		case 0x2:
-			he_gi = IEEE80211_RADIOTAP_HE_DATA5_GI_1_6;
-			ltf = IEEE80211_RADIOTAP_HE_DATA5_LTF_SIZE_2X;
-			break;
-		case 0x3:
-			he_gi = IEEE80211_RADIOTAP_HE_DATA5_GI_0_8;
-			ltf = IEEE80211_RADIOTAP_HE_DATA5_LTF_SIZE_2X;
-			break;
-		case 0x4:
-			he_gi = IEEE80211_RADIOTAP_HE_DATA5_GI_1_6;
-			ltf = IEEE80211_RADIOTAP_HE_DATA5_LTF_SIZE_1X;
-			break;
-		case 0x5:
-			he_gi = IEEE80211_RADIOTAP_HE_DATA5_GI_0_8;
-			ltf = IEEE80211_RADIOTAP_HE_DATA5_LTF_SIZE_1X;
-			break;
-		default:
-			he_gi = IEEE80211_RADIOTAP_HE_DATA5_GI_0_8;
-			ltf = IEEE80211_RADIOTAP_HE_DATA5_LTF_SIZE_1X;
-			break;
-		}
-
-		he_hdr.data5 |= __le16_encode_bits(he_gi, IEEE80211_RADIOTAP_HE_DATA5_GI);
-		he_hdr.data5 |= __le16_encode_bits(ltf, IEEE80211_RADIOTAP_HE_DATA5_LTF_SIZE);
-
-		ss = cpu_to_le16(((0x70 & rx_req->mdata.rx_rate) >> 4) + 1);
-		he_hdr.data6 |= __le16_encode_bits(ss, IEEE80211_RADIOTAP_HE_DATA6_NSTS);
-
-		_rtw_memcpy(&hdr_buf[rt_len], &he_hdr, sizeof(struct ieee80211_radiotap_he));
-
+		_rtw_radiotap_fill_he(rx_req, &hdr_buf[rt_len]);
 		rt_len += sizeof(struct ieee80211_radiotap_he);
 	}
 
@@ -786,6 +940,7 @@ sint rtw_fill_radiotap_hdr(_adapter *padapter,
 	return ret;
 
 }
+#endif /* CONFIG_RTW_MON_RTAP_FAST */
 
 void rx_query_moinfo(struct rx_pkt_attrib *a, u8 *desc)
 {
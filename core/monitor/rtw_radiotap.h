@@ -15,6 +15,11 @@
 #ifndef __RTW_RADIOTAP_H_
 #define __RTW_RADIOTAP_H_
 
+#ifdef CONFIG_RTW_MON_RTAP_FAST
+/* headroom the rx copy reserves for the radiotap header */
+#define RTW_RTAP_HDR_MAX 64
+#endif
+
 struct mon_reg_backup {
 	/* flags */
 	u8	known_rcr:1;
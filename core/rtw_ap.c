@@ -15,6 +15,10 @@
 #define _RTW_AP_C_
 
 #include <drv_types.h>
+#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+#include <linux/in.h>
+#include <linux/in6.h>
+#endif
 
 #ifdef CONFIG_AP_MODE
 
@@ -24,11 +28,28 @@ extern unsigned char	WPS_OUI[];
 extern unsigned char	P2P_OUI[];
 extern unsigned char	WFD_OUI[];
 
+#ifdef CONFIG_RTW_BCN_COAL
+static void ap_bcn_coal_timer_hdl(void *ctx)
+{
+	_adapter *padapter = (_adapter *)ctx;
+	struct mlme_priv *pmlmepriv = &padapter->mlmepriv;
+
+	if (set_tx_beacon_cmd(padapter, 0) != _SUCCESS) {
+		_rtw_spinlock_bh(&pmlmepriv->bcn_update_lock);
+		pmlmepriv->bcn_tx_pending = _FALSE;
+		_rtw_spinunlock_bh(&pmlmepriv->bcn_update_lock);
+	}
+}
+#endif
+
 void init_mlme_ap_info(_adapter *padapter)
 {
 	struct mlme_priv *pmlmepriv = &(padapter->mlmepriv);
 
 	_rtw_spinlock_init(&pmlmepriv->bcn_update_lock);
+#ifdef CONFIG_RTW_BCN_COAL
+	rtw_init_timer(&pmlmepriv->bcn_coal_timer, ap_bcn_coal_timer_hdl, padapter);
+#endif
 	/* pmlmeext->bstart_bss = _FALSE; */
 }
 
@@ -84,7 +105,10 @@ u8 rtw_set_tim_ie(u8 dtim_cnt, u8 dtim_period
 	return 2 + 2 + 1 + bmp_len;
 }
 
-static void update_BCNTIM(_adapter *padapter)
+/*
+* return _FALSE if TIM IE is unchanged
+*/
+static bool update_BCNTIM(_adapter *padapter)
 {
 	struct sta_priv *pstapriv = &padapter->stapriv;
 	struct mlme_ext_priv *pmlmeext = &(padapter->mlmeextpriv);
@@ -92,6 +116,26 @@ static void update_BCNTIM(_adapter *padapter)
 	WLAN_BSSID_EX *pnetwork_mlmeext = &(pmlmeinfo->network);
 	unsigned char *pie = pnetwork_mlmeext->IEs;
 
+#ifdef CONFIG_RTW_BCN_COAL
+	{
+		/* same length, rewrite in place instead of moving the remainder IEs */
+		u8 tim_ie[2 + 255];
+		u8 *p, len;
+		uint tim_ielen;
+
+		p = rtw_get_ie(pie + _FIXED_IE_LENGTH_, _TIM_IE_, &tim_ielen, pnetwork_mlmeext->IELength - _FIXED_IE_LENGTH_);
+		if (p != NULL && tim_ielen > 0) {
+			len = rtw_set_tim_ie(0, 1, pstapriv->tim_bitmap, pstapriv->aid_bmp_len, tim_ie);
+			if (len == tim_ielen + 2) {
+				if (_rtw_memcmp(p, tim_ie, len) == _TRUE)
+					return _FALSE;
+				_rtw_memcpy(p, tim_ie, len);
+				return _TRUE;
+			}
+		}
+	}
+#endif
+
 #if 0
 
 
@@ -162,6 +206,8 @@ static void update_BCNTIM(_adapter *padapter)
 		pnetwork_mlmeext->IELength = offset + remainder_ielen;
 
 	}
+
+	return _TRUE;
 }
 
 void rtw_add_bcn_ie(_adapter *padapter, WLAN_BSSID_EX *pnetwork, u8 index, u8 *data, u8 len)
@@ -3357,6 +3403,125 @@ static void update_bcn_vendor_spec_ie(_adapter *padapter, u8 *oui)
 
 }
 
+#ifdef CONFIG_RTW_BCN_COAL
+/* IEs that keep their length and can be patched into the downloaded beacon */
+static void ap_bcn_mark_dirty(struct mlme_priv *pmlmepriv, u8 ie_id)
+{
+	u8 i;
+
+	switch (ie_id) {
+	case _TIM_IE_:
+	case _ERPINFO_IE_:
+	case _HT_CAPABILITY_IE_:
+	case _RSN_IE_2_:
+	case _HT_ADD_INFO_IE_:
+		break;
+	default:
+		pmlmepriv->bcn_dirty_full = _TRUE;
+		return;
+	}
+
+	for (i = 0; i < pmlmepriv->bcn_dirty_num; i++)
+		if (pmlmepriv->bcn_dirty_ie[i] == ie_id)
+			return;
+
+	if (pmlmepriv->bcn_dirty_num < RTW_BCN_DIRTY_IE_NUM)
+		pmlmepriv->bcn_dirty_ie[pmlmepriv->bcn_dirty_num++] = ie_id;
+	else
+		pmlmepriv->bcn_dirty_full = _TRUE;
+}
+
+/* at most one beacon download per beacon interval, later updates ride along */
+static void ap_bcn_tx_coal(_adapter *padapter)
+{
+	struct mlme_priv *pmlmepriv = &padapter->mlmepriv;
+	u32 intvl = padapter->mlmeextpriv.mlmext_info.bcn_interval;
+	u32 passing;
+
+	_rtw_spinlock_bh(&pmlmepriv->bcn_update_lock);
+	if (pmlmepriv->bcn_tx_pending) {
+		pmlmepriv->bcn_coal_cnt++;
+		_rtw_spinunlock_bh(&pmlmepriv->bcn_update_lock);
+		return;
+	}
+	pmlmepriv->bcn_tx_pending = _TRUE;
+	passing = rtw_get_passing_time_ms(pmlmepriv->bcn_tx_time);
+	_rtw_spinunlock_bh(&pmlmepriv->bcn_update_lock);
+
+	if (passing < intvl) {
+		_set_timer(&pmlmepriv->bcn_coal_timer, intvl - passing);
+		return;
+	}
+
+	if (set_tx_beacon_cmd(padapter, 0) != _SUCCESS) {
+		_rtw_spinlock_bh(&pmlmepriv->bcn_update_lock);
+		pmlmepriv->bcn_tx_pending = _FALSE;
+		_rtw_spinunlock_bh(&pmlmepriv->bcn_update_lock);
+	}
+}
+
+/*
+* Copy the changed IEs into the last downloaded beacon and download it again,
+* run from tx_beacon_hdl.
+* return _FALSE if the whole beacon has to be rebuilt: not downloaded yet,
+* an IE was added, removed or resized, or a change not bound to one IE.
+*/
+u8 rtw_ap_bcn_patch(_adapter *padapter)
+{
+	struct mlme_priv *pmlmepriv = &padapter->mlmepriv;
+	WLAN_BSSID_EX *pnetwork = &padapter->mlmeextpriv.mlmext_info.network;
+	struct rtw_wifi_role_t *wrole = padapter->phl_role;
+	struct rtw_bcn_info_cmn *bcn_cmn = NULL;
+	u8 *bcn_ie, *src[RTW_BCN_DIRTY_IE_NUM], *dst[RTW_BCN_DIRTY_IE_NUM];
+	uint bcn_ielen, src_len[RTW_BCN_DIRTY_IE_NUM], dst_len;
+	u32 hdr_len = sizeof(struct rtw_ieee80211_hdr_3addr) + _FIXED_IE_LENGTH_;
+	u8 i, ret = _FALSE;
+
+	_rtw_spinlock_bh(&pmlmepriv->bcn_update_lock);
+	pmlmepriv->bcn_tx_pending = _FALSE;
+	pmlmepriv->bcn_tx_time = rtw_get_current_time();
+	pmlmepriv->bcn_tx_cnt++;
+
+	if (wrole == NULL || pmlmepriv->bcn_dirty_full
+		|| pmlmepriv->bcn_dirty_num == 0)
+		goto exit;
+
+	bcn_cmn = &wrole->bcn_cmn;
+	if (!bcn_cmn->bcn_added || bcn_cmn->bcn_length <= hdr_len)
+		goto exit;
+
+	bcn_ie = bcn_cmn->bcn_buf + hdr_len;
+	bcn_ielen = bcn_cmn->bcn_length - hdr_len;
+
+	/* all or nothing, check every IE before touching the template */
+	for (i = 0; i < pmlmepriv->bcn_dirty_num; i++) {
+		src[i] = rtw_get_ie(pnetwork->IEs + _FIXED_IE_LENGTH_, pmlmepriv->bcn_dirty_ie[i]
+			, &src_len[i], pnetwork->IELength - _FIXED_IE_LENGTH_);
+		dst[i] = rtw_get_ie(bcn_ie, pmlmepriv->bcn_dirty_ie[i], &dst_len, bcn_ielen);
+		if (!src[i] || !dst[i] || src_len[i] != dst_len)
+			goto exit;
+	}
+
+	for (i = 0; i < pmlmepriv->bcn_dirty_num; i++)
+		_rtw_memcpy(dst[i] + 2, src[i] + 2, src_len[i]);
+
+	pmlmepriv->bcn_dirty_num = 0;
+	pmlmepriv->update_bcn = _FALSE;
+	pmlmepriv->bcn_patch_cnt++;
+	ret = _TRUE;
+
+exit:
+	_rtw_spinunlock_bh(&pmlmepriv->bcn_update_lock);
+
+	if (ret == _TRUE
+		&& rtw_phl_cmd_issue_beacon(padapter->dvobj->phl, wrole
+			, bcn_cmn, PHL_CMD_DIRECTLY, 0) != RTW_PHL_STATUS_SUCCESS)
+		ret = _FALSE;
+
+	return ret;
+}
+#endif /* CONFIG_RTW_BCN_COAL */
+
 void _update_beacon(_adapter *padapter, u8 ie_id, u8 *oui, u8 tx, u8 flags, const char *tag)
 {
 	struct mlme_priv *pmlmepriv;
@@ -3376,7 +3541,7 @@ void _update_beacon(_adapter *padapter, u8 ie_id, u8 *oui, u8 tx, u8 flags, cons
 
 	switch (ie_id) {
 	case _TIM_IE_:
-		update_BCNTIM(padapter);
+		updated = update_BCNTIM(padapter);
 		break;
 
 	case _ERPINFO_IE_:
@@ -3415,8 +3580,12 @@ void _update_beacon(_adapter *padapter, u8 ie_id, u8 *oui, u8 tx, u8 flags, cons
 		break;
 	}
 
-	if (updated)
+	if (updated) {
 		pmlmepriv->update_bcn = _TRUE;
+#ifdef CONFIG_RTW_BCN_COAL
+		ap_bcn_mark_dirty(pmlmepriv, ie_id);
+#endif
+	}
 
 	_rtw_spinunlock_bh(&pmlmepriv->bcn_update_lock);
 
@@ -3429,7 +3598,11 @@ void _update_beacon(_adapter *padapter, u8 ie_id, u8 *oui, u8 tx, u8 flags, cons
 		if(flags == RTW_CMDF_WAIT_ACK)
 			set_tx_beacon_cmd(padapter, RTW_CMDF_WAIT_ACK);
 		else
+#ifdef CONFIG_RTW_BCN_COAL
+			ap_bcn_tx_coal(padapter);
+#else
 			set_tx_beacon_cmd(padapter, 0);
+#endif
 	}
 #else
 	{
@@ -4332,6 +4505,12 @@ void stop_ap_mode(_adapter *padapter)
 		rtw_warn_on(1);
 
 	pmlmepriv->update_bcn = _FALSE;
+#ifdef CONFIG_RTW_BCN_COAL
+	_cancel_timer_ex(&pmlmepriv->bcn_coal_timer);
+	pmlmepriv->bcn_tx_pending = _FALSE;
+	pmlmepriv->bcn_dirty_num = 0;
+	pmlmepriv->bcn_dirty_full = _FALSE;
+#endif
 	/*pmlmeext->bstart_bss = _FALSE;*/
 	padapter->netif_up = _FALSE;
 	/* _rtw_spinlock_free(&pmlmepriv->bcn_update_lock); */
@@ -5546,6 +5725,337 @@ void rtw_ap_parse_sta_multi_ap_ie(_adapter *adapter, struct sta_info *sta, u8 *i
 }
 
 #if CONFIG_RTW_AP_DATA_BMC_TO_UC
+#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+#define IGMP_V1_REPORT	0x12
+#define IGMP_V2_REPORT	0x16
+#define IGMP_V2_LEAVE	0x17
+#define IGMP_V3_REPORT	0x22
+#define MLD_V1_REPORT	131
+#define MLD_V1_DONE	132
+#define MLD_V2_REPORT	143
+
+/* IGMPv3/MLDv2 group record types */
+#define MC_REC_IS_IN	1
+#define MC_REC_IS_EX	2
+#define MC_REC_TO_IN	3
+#define MC_REC_TO_EX	4
+#define MC_REC_ALLOW	5
+
+/* caller must hold mc_grp_lock */
+static struct rtw_mc_grp *ap_mc_grp_get(struct sta_priv *stapriv, const u8 *addr, bool add)
+{
+	struct rtw_mc_grp *grp, *unused = NULL;
+	int i;
+
+	for (i = 0; i < RTW_MC_GRP_NUM; i++) {
+		grp = &stapriv->mc_grp[i];
+		/* no report for a membership interval, the members are gone */
+		if (grp->sta_num && rtw_get_passing_time_ms(grp->update) > RTW_MC_GRP_TO_MS)
+			_rtw_memset(grp, 0, sizeof(*grp));
+
+		if (!grp->sta_num) {
+			if (!unused)
+				unused = grp;
+			continue;
+		}
+		if (_rtw_memcmp(grp->addr, addr, ETH_ALEN) == _TRUE)
+			return grp;
+	}
+
+	if (add && unused) {
+		_rtw_memset(unused, 0, sizeof(*unused));
+		_rtw_memcpy(unused->addr, addr, ETH_ALEN);
+		return unused;
+	}
+
+	return NULL;
+}
+
+static void ap_mc_grp_update(_adapter *adapter, struct sta_info *sta, const u8 *addr, bool join)
+{
+	struct sta_priv *stapriv = &adapter->stapriv;
+	struct rtw_mc_grp *grp;
+	int offset = rtw_stainfo_offset(stapriv, sta);
+
+	if (!stainfo_offset_valid(offset))
+		return;
+
+	_rtw_spinlock_bh(&stapriv->mc_grp_lock);
+	grp = ap_mc_grp_get(stapriv, addr, join);
+	if (!grp)
+		goto exit;
+
+	if (join) {
+		if (!rtw_bmp_is_set(grp->sta_bmp, RTW_MC_GRP_STA_BMP_LEN, offset)) {
+			rtw_bmp_set(grp->sta_bmp, RTW_MC_GRP_STA_BMP_LEN, offset);
+			grp->sta_num++;
+		}
+		grp->update = rtw_get_current_time();
+	} else if (rtw_bmp_is_set(grp->sta_bmp, RTW_MC_GRP_STA_BMP_LEN, offset)) {
+		rtw_bmp_clear(grp->sta_bmp, RTW_MC_GRP_STA_BMP_LEN, offset);
+		if (--grp->sta_num == 0)
+			_rtw_memset(grp, 0, sizeof(*grp));
+	}
+
+exit:
+	_rtw_spinunlock_bh(&stapriv->mc_grp_lock);
+}
+
+static void ap_mc_ipv4_grp(_adapter *adapter, struct sta_info *sta, const u8 *ip, bool join)
+{
+	u8 addr[ETH_ALEN] = {0x01, 0x00, 0x5e};
+
+	/* 224.0.0.0/24 is link local, always flooded */
+	if (ip[0] < 224 || ip[0] > 239 || (ip[0] == 224 && ip[1] == 0 && ip[2] == 0))
+		return;
+
+	addr[3] = ip[1] & 0x7f;
+	addr[4] = ip[2];
+	addr[5] = ip[3];
+	ap_mc_grp_update(adapter, sta, addr, join);
+}
+
+static void ap_mc_ipv6_grp(_adapter *adapter, struct sta_info *sta, const u8 *ip6, bool join)
+{
+	u8 addr[ETH_ALEN] = {0x33, 0x33};
+
+	/* interface and link local scope, always flooded */
+	if (ip6[0] != 0xff || (ip6[1] & 0x0f) <= 2)
+		return;
+
+	_rtw_memcpy(addr + 2, ip6 + 12, 4);
+	ap_mc_grp_update(adapter, sta, addr, join);
+}
+
+/* 1: join, 0: leave, -1: membership unchanged */
+static int ap_mc_rec_act(u8 type, u16 src_num)
+{
+	switch (type) {
+	case MC_REC_IS_EX:
+	case MC_REC_TO_EX:
+		return 1;
+	case MC_REC_IS_IN:
+	case MC_REC_TO_IN:
+		return src_num ? 1 : 0;
+	case MC_REC_ALLOW:
+		return src_num ? 1 : -1;
+	default:
+		/* block old sources */
+		return -1;
+	}
+}
+
+static void ap_mc_snoop_igmp(_adapter *adapter, struct sta_info *sta, const u8 *igmp, u32 len)
+{
+	u16 rec_num, src_num, i;
+	u32 rec_len;
+	int act;
+
+	if (len < 8)
+		return;
+
+	switch (igmp[0]) {
+	case IGMP_V1_REPORT:
+	case IGMP_V2_REPORT:
+		ap_mc_ipv4_grp(adapter, sta, igmp + 4, _TRUE);
+		break;
+	case IGMP_V2_LEAVE:
+		ap_mc_ipv4_grp(adapter, sta, igmp + 4, _FALSE);
+		break;
+	case IGMP_V3_REPORT:
+		rec_num = RTW_GET_BE16(igmp + 6);
+		igmp += 8;
+		len -= 8;
+		/* type, aux len, source num, group, sources, aux data */
+		for (i = 0; i < rec_num && len >= 8; i++) {
+			src_num = RTW_GET_BE16(igmp + 2);
+			act = ap_mc_rec_act(igmp[0], src_num);
+			if (act >= 0)
+				ap_mc_ipv4_grp(adapter, sta, igmp + 4, act);
+
+			rec_len = 8 + src_num * 4 + igmp[1] * 4;
+			if (rec_len > len)
+				break;
+			igmp += rec_len;
+			len -= rec_len;
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+static void ap_mc_snoop_mld(_adapter *adapter, struct sta_info *sta, const u8 *icmp6, u32 len)
+{
+	u16 rec_num, src_num, i;
+	u32 rec_len;
+	int act;
+
+	if (len < 8)
+		return;
+
+	switch (icmp6[0]) {
+	case MLD_V1_REPORT:
+	case MLD_V1_DONE:
+		if (len >= 8 + 16)
+			ap_mc_ipv6_grp(adapter, sta, icmp6 + 8, icmp6[0] == MLD_V1_REPORT);
+		break;
+	case MLD_V2_REPORT:
+		rec_num = RTW_GET_BE16(icmp6 + 6);
+		icmp6 += 8;
+		len -= 8;
+		for (i = 0; i < rec_num && len >= 4 + 16; i++) {
+			src_num = RTW_GET_BE16(icmp6 + 2);
+			act = ap_mc_rec_act(icmp6[0], src_num);
+			if (act >= 0)
+				ap_mc_ipv6_grp(adapter, sta, icmp6 + 4, act);
+
+			rec_len = 4 + 16 + src_num * 16 + icmp6[1] * 4;
+			if (rec_len > len)
+				break;
+			icmp6 += rec_len;
+			len -= rec_len;
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+/* learn group membership from IGMP/MLD reports of associated stations */
+void rtw_ap_mc_snoop_rx(_adapter *adapter, struct sta_info *sta
+	, const u8 *msdu, u16 msdu_len, enum rtw_rx_llc_hdl llc_hdl)
+{
+	const u8 *ip;
+	u32 ip_len, hdr_len;
+	u16 eth_type;
+	u8 next_hdr;
+
+	if (!adapter->mc_snoop_sta_max || !sta || llc_hdl != RTW_RX_LLC_REMOVE
+		|| msdu_len < SNAP_SIZE + 2)
+		return;
+
+	eth_type = RTW_GET_BE16(msdu + SNAP_SIZE);
+	ip = msdu + SNAP_SIZE + 2;
+	ip_len = msdu_len - SNAP_SIZE - 2;
+
+	if (eth_type == ETH_P_IP) {
+		if (ip_len < 20 || GET_IPV4_PROTOCOL(ip) != IPPROTO_IGMP)
+			return;
+		hdr_len = GET_IPV4_IHL(ip) * 4;
+		if (hdr_len < 20 || hdr_len > ip_len)
+			return;
+		ap_mc_snoop_igmp(adapter, sta, ip + hdr_len, ip_len - hdr_len);
+
+	} else if (eth_type == ETH_P_IPV6) {
+		if (ip_len < 40)
+			return;
+		hdr_len = 40;
+		next_hdr = ip[6];
+		/* MLD comes behind a hop-by-hop router alert option */
+		if (next_hdr == IPPROTO_HOPOPTS) {
+			if (ip_len < hdr_len + 8)
+				return;
+			next_hdr = ip[hdr_len];
+			hdr_len += (ip[hdr_len + 1] + 1) * 8;
+		}
+		if (next_hdr != IPPROTO_ICMPV6 || hdr_len > ip_len)
+			return;
+		ap_mc_snoop_mld(adapter, sta, ip + hdr_len, ip_len - hdr_len);
+	}
+}
+
+void rtw_ap_mc_snoop_sta_del(_adapter *adapter, struct sta_info *sta)
+{
+	struct sta_priv *stapriv = &adapter->stapriv;
+	struct rtw_mc_grp *grp;
+	int offset = rtw_stainfo_offset(stapriv, sta);
+	int i;
+
+	if (!stainfo_offset_valid(offset))
+		return;
+
+	_rtw_spinlock_bh(&stapriv->mc_grp_lock);
+	for (i = 0; i < RTW_MC_GRP_NUM; i++) {
+		grp = &stapriv->mc_grp[i];
+		if (!grp->sta_num || !rtw_bmp_is_set(grp->sta_bmp, RTW_MC_GRP_STA_BMP_LEN, offset))
+			continue;
+		rtw_bmp_clear(grp->sta_bmp, RTW_MC_GRP_STA_BMP_LEN, offset);
+		if (--grp->sta_num == 0)
+			_rtw_memset(grp, 0, sizeof(*grp));
+	}
+	_rtw_spinunlock_bh(&stapriv->mc_grp_lock);
+}
+
+/*
+* Members of the snooped group of @da into @sta_id, return -1 if @da is not
+* a snooped group. The member count is still returned without filling
+* @sta_id when it's over mc_snoop_sta_max, the frame then stays bmc.
+*/
+static int ap_mc_snoop_sta(_adapter *adapter, const u8 *da, char *sta_id)
+{
+	struct sta_priv *stapriv = &adapter->stapriv;
+	struct rtw_mc_grp *grp;
+	int num = -1;
+	int i;
+
+	if (!adapter->mc_snoop_sta_max || !(IP_MCAST_MAC(da) || ICMPV6_MCAST_MAC(da)))
+		return -1;
+
+	_rtw_spinlock_bh(&stapriv->mc_grp_lock);
+	grp = ap_mc_grp_get(stapriv, da, _FALSE);
+	if (!grp)
+		goto exit;
+
+	num = grp->sta_num;
+	if (num > adapter->mc_snoop_sta_max) {
+		grp->tx_bmc++;
+		goto exit;
+	}
+
+	grp->tx_uc++;
+	num = 0;
+	for (i = 0; i < NUM_STA; i++)
+		if (rtw_bmp_is_set(grp->sta_bmp, RTW_MC_GRP_STA_BMP_LEN, i))
+			sta_id[num++] = i;
+
+exit:
+	_rtw_spinunlock_bh(&stapriv->mc_grp_lock);
+	return num;
+}
+
+void dump_ap_mc_snoop(void *sel, _adapter *adapter)
+{
+	struct sta_priv *stapriv = &adapter->stapriv;
+	struct rtw_mc_grp *grp;
+	struct sta_info *sta;
+	int i, j;
+
+	RTW_PRINT_SEL(sel, "sta_max:%u\n", adapter->mc_snoop_sta_max);
+	RTW_PRINT_SEL(sel, "%-17s %3s %10s %10s %6s\n", "group", "num", "tx_uc", "tx_bmc", "update");
+
+	_rtw_spinlock_bh(&stapriv->mc_grp_lock);
+	for (i = 0; i < RTW_MC_GRP_NUM; i++) {
+		grp = &stapriv->mc_grp[i];
+		if (!grp->sta_num)
+			continue;
+
+		RTW_PRINT_SEL(sel, MAC_FMT" %3u %10u %10u %6u\n"
+			, MAC_ARG(grp->addr), grp->sta_num, grp->tx_uc, grp->tx_bmc
+			, rtw_get_passing_time_ms(grp->update) / 1000);
+
+		for (j = 0; j < NUM_STA; j++) {
+			if (!rtw_bmp_is_set(grp->sta_bmp, RTW_MC_GRP_STA_BMP_LEN, j))
+				continue;
+			sta = rtw_get_stainfo_by_offset(stapriv, j);
+			if (sta && sta->phl_sta)
+				RTW_PRINT_SEL(sel, "  "MAC_FMT"\n", MAC_ARG(sta->phl_sta->mac_addr));
+		}
+	}
+	_rtw_spinunlock_bh(&stapriv->mc_grp_lock);
+}
+#endif /* CONFIG_RTW_AP_MCAST_SNOOP */
+
 static bool rtw_ap_data_bmc_to_uc(_adapter *adapter
 	, const u8 *da, const u8 *sa, const u8 *ori_ta
 	, u16 os_qid, _list *b2u_list)
@@ -5559,6 +6069,19 @@ static bool rtw_ap_data_bmc_to_uc(_adapter *adapter
 	bool bmc_need = _FALSE;
 	int i;
 
+#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+	/* snooped group, only to its members, or as bmc when there are too many */
+	i = ap_mc_snoop_sta(adapter, da, b2u_sta_id);
+	if (i > adapter->mc_snoop_sta_max) {
+		bmc_need = _TRUE;
+		goto exit;
+	}
+	if (i >= 0) {
+		b2u_sta_num = i;
+		goto b2u;
+	}
+#endif
+
 	 _rtw_spinlock_bh(&stapriv->asoc_list_lock);
 	head = &stapriv->asoc_list;
 	list = get_next(head);
@@ -5575,6 +6098,9 @@ static bool rtw_ap_data_bmc_to_uc(_adapter *adapter
 	}
 	_rtw_spinunlock_bh(&stapriv->asoc_list_lock);
 
+#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+b2u:
+#endif
 	if (!b2u_sta_num)
 		goto exit;
 
@@ -5842,7 +6368,7 @@ exit:
 
 int rtw_ap_rx_msdu_act_check(union recv_frame *rframe
 	, const u8 *da, const u8 *sa
-	, u8 *msdu, enum rtw_rx_llc_hdl llc_hdl
+	, u8 *msdu, u16 msdu_len, enum rtw_rx_llc_hdl llc_hdl
 	, struct xmit_frame **fwd_frame, _list *f_list)
 {
 	_adapter *adapter = rframe->u.hdr.adapter;
@@ -5883,6 +6409,9 @@ int rtw_ap_rx_msdu_act_check(union recv_frame *rframe
 	if (is_da_bmc) {
 		/* DA is bmc addr */
 		act |= RTW_RX_MSDU_ACT_INDICATE;
+		#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+		rtw_ap_mc_snoop_rx(adapter, rframe->u.hdr.psta, msdu, msdu_len, llc_hdl);
+		#endif
 		#if 0 /* TODO: ap_isolate */
 		if (adapter->mlmepriv.ap_isolate)
 			goto exit;
@@ -1775,6 +1775,12 @@ int proc_get_ap_info(struct seq_file *m, void *v)
 	} else
 		RTW_PRINT_SEL(m, "can't get sta's macaddr, cur_network's macaddr:" MAC_FMT "\n", MAC_ARG(cur_network->network.MacAddress));
 
+#ifdef CONFIG_RTW_BCN_COAL
+	if (MLME_IS_AP(padapter) || MLME_IS_MESH(padapter))
+		RTW_PRINT_SEL(m, "bcn_tx=%u, bcn_patch=%u, bcn_coal=%u\n"
+			, pmlmepriv->bcn_tx_cnt, pmlmepriv->bcn_patch_cnt, pmlmepriv->bcn_coal_cnt);
+#endif
+
 	return 0;
 }
 
@@ -1861,6 +1867,46 @@ int proc_get_trx_info(struct seq_file *m, void *v)
 
 	rtw_hal_get_hwreg(padapter, HW_VAR_DUMP_MAC_TXFIFO, (u8 *)m);
 
+#ifdef CONFIG_WD_TMPL_CACHE
+	{
+		struct rtw_wd_tmpl_stats wd_tmpl = {0};
+		u32 wd_cnt = 0;
+
+		rtw_phl_get_wd_tmpl_stats(GET_PHL_INFO(dvobj), &wd_tmpl);
+		wd_cnt = wd_tmpl.hit_cnt + wd_tmpl.miss_cnt;
+		RTW_PRINT_SEL(m, "wd_tmpl hit=%u, miss=%u, bypass=%u, invalidate=%u, hit_ratio=%u%%\n"
+			, wd_tmpl.hit_cnt, wd_tmpl.miss_cnt, wd_tmpl.bypass_cnt
+			, wd_tmpl.invalidate_cnt
+			, wd_cnt ? (u32)rtw_division64((u64)wd_tmpl.hit_cnt * 100, wd_cnt) : 0);
+	}
+#endif
+
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+	RTW_PRINT_SEL(m, "hdr_conv tx hw=%u, sw=%u, rx hw=%llu, sw=%llu\n"
+		, pxmitpriv->tx_hdr_conv_hw, pxmitpriv->tx_hdr_conv_sw
+		, (unsigned long long)padapter->recvinfo.rx_hdr_conv_hw
+		, (unsigned long long)padapter->recvinfo.rx_hdr_conv_sw);
+#endif
+
+#ifdef CONFIG_TCP_CSUM_OFFLOAD_RX
+	RTW_PRINT_SEL(m, "rx_csum ok=%llu, err=%llu, none=%llu\n"
+		, (unsigned long long)padapter->recvinfo.rx_csum_ok
+		, (unsigned long long)padapter->recvinfo.rx_csum_err
+		, (unsigned long long)padapter->recvinfo.rx_csum_none);
+#endif
+
+#ifdef CONFIG_RTW_MON_RTAP_FAST
+	RTW_PRINT_SEL(m, "rx_mon rtap_realloc=%llu, napi=%llu\n"
+		, (unsigned long long)padapter->recvinfo.rx_rtap_realloc
+		, (unsigned long long)padapter->recvinfo.rx_mon_napi);
+#endif
+
+#ifdef CONFIG_RTW_TX_GSO
+	RTW_PRINT_SEL(m, "tx_gso pkt=%u, seg=%u, sw=%u\n"
+		, pxmitpriv->tx_gso_pkt, pxmitpriv->tx_gso_seg
+		, pxmitpriv->tx_gso_sw);
+#endif
+
 #ifdef CONFIG_USB_HCI
 	RTW_PRINT_SEL(m, "tx_urb_cnt=%d\n", xmit_urb_q->free_urb_buf_cnt);
 	RTW_PRINT_SEL(m, "rx_urb_cnt=%d\n", recv_urb_q->free_urb_buf_cnt);
@@ -3303,6 +3349,9 @@ int proc_get_tx_amsdu(struct seq_file *m, void *v)
 	if (padapter)
 	{
 		RTW_PRINT_SEL(m, "tx amsdu = %d\n", padapter->tx_amsdu);
+#ifdef CONFIG_TX_AMSDU_HW_MODE
+		RTW_PRINT_SEL(m, "amsdu hw mode, max num = %d\n", RTW_HW_AMSDU_MAX_NUM);
+#endif
 		RTW_PRINT_SEL(m, "amsdu set timer conut = %u\n", pxmitpriv->amsdu_debug_set_timer);
 		RTW_PRINT_SEL(m, "amsdu time out count = %u\n", pxmitpriv->amsdu_debug_timeout);
 		for (i = 0; i < (AMSDU_DEBUG_MAX_COUNT - 1); i++) {
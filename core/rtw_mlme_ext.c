@@ -6177,6 +6177,10 @@ _issue_bcn:
 
 #if defined(CONFIG_AP_MODE) && defined (CONFIG_NATIVEAP_MLME)
 	pmlmepriv->update_bcn = _FALSE;
+#ifdef CONFIG_RTW_BCN_COAL
+	pmlmepriv->bcn_dirty_num = 0;
+	pmlmepriv->bcn_dirty_full = _FALSE;
+#endif
 
 	_rtw_spinunlock_bh(&pmlmepriv->bcn_update_lock);
 #endif /* #if defined (CONFIG_AP_MODE) && defined (CONFIG_NATIVEAP_MLME) */
@@ -12712,8 +12716,11 @@ u8 set_stakey_hdl(struct _ADAPTER *a, struct set_stakey_parm *key,
 		err = rtw_hw_add_key(a, sta, key->keyid, key->algorithm,
 				     key->gk, key->key, spp, PHL_CMD_DIRECTLY, 0);
 	}
-	if (!(key->gk))
+	if (!(key->gk)) {
 		ATOMIC_INC(&sta->keytrack);	/*CVE-2020-24587*/
+		/* template protected bit follows the pairwise key */
+		core_tx_hdr_conv_update(a, sta, err ? _NO_PRIVACY_ : key->algorithm);
+	}
 	if (err)
 		RTW_ERR("%s: FAIL to set %s key for %pM, kid:%d algo:%s !\n",
 			__func__, key->gk?"group":"pairwise",
@@ -12764,8 +12771,11 @@ u8 set_stakey_hdl(struct _ADAPTER *a, u8 *pbuf)
 		err = rtw_hw_add_key(a, sta, key->keyid, key->algorithm,
 				     key->gk, key->key, spp, PHL_CMD_DIRECTLY, 0);
 	}
-	if (!(key->gk))
+	if (!(key->gk)) {
 		ATOMIC_INC(&sta->keytrack);	/*CVE-2020-24587*/
+		/* template protected bit follows the pairwise key */
+		core_tx_hdr_conv_update(a, sta, err ? _NO_PRIVACY_ : key->algorithm);
+	}
 
 	if (err)
 		RTW_ERR("%s: FAIL to set %s key for %pM, kid:%d algo:%s !\n",
@@ -13090,6 +13100,12 @@ u8 chk_bmc_sleepq_hdl(_adapter *padapter, unsigned char *pbuf)
 u8 tx_beacon_hdl(_adapter *padapter, unsigned char *pbuf)
 {
 	/*RTW_INFO(FUNC_ADPT_FMT, FUNC_ADPT_ARG(padapter));*/
+#ifdef CONFIG_RTW_BCN_COAL
+	if (rtw_ap_bcn_patch(padapter) == _TRUE) {
+		chk_bmc_sleepq_hdl(padapter, NULL);
+		return H2C_SUCCESS;
+	}
+#endif
 	if (send_beacon(padapter) == _FAIL) {
 		RTW_INFO("issue_beacon, fail!\n");
 		return H2C_PARAMETERS_ERROR;
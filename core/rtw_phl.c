@@ -1865,6 +1865,21 @@ int rtw_hw_set_edca(struct _ADAPTER *a, u8 ac, u32 param)
 	return 0;
 }
 
+/*
+ * The connect/disconnect steps below issue their CAM, role and RA h2c in a
+ * burst; hold them in a coalescing window so they go out in few aggregated
+ * h2c, shared with any other station's sequence running at the same time.
+ */
+#ifdef CONFIG_H2C_COAL
+#define rtw_hw_h2c_coal_begin(phl, seq, sta) \
+	rtw_phl_h2c_coal_begin(phl, H2C_COAL_TOKEN(seq, (sta)->phl_sta->macid))
+#define rtw_hw_h2c_coal_end(phl, seq, sta) \
+	rtw_phl_h2c_coal_end(phl, H2C_COAL_TOKEN(seq, (sta)->phl_sta->macid))
+#else
+#define rtw_hw_h2c_coal_begin(phl, seq, sta)
+#define rtw_hw_h2c_coal_end(phl, seq, sta)
+#endif
+
 int rtw_hw_connected(struct _ADAPTER *a, struct sta_info *sta)
 {
 
@@ -1893,11 +1908,16 @@ int rtw_hw_connected(struct _ADAPTER *a, struct sta_info *sta)
 	}
 #endif
 
+	rtw_hw_h2c_coal_begin(phl, H2C_COAL_SEQ_CONNECT, sta);
 	status = rtw_phl_cmd_update_media_status(phl, sta->phl_sta,
 					sta->phl_sta->mac_addr, true,
 					PHL_CMD_DIRECTLY, 0);
-	if (status != RTW_PHL_STATUS_SUCCESS)
+	if (status != RTW_PHL_STATUS_SUCCESS) {
+		rtw_hw_h2c_coal_end(phl, H2C_COAL_SEQ_CONNECT, sta);
 		return -1;
+	}
+	/* no pairwise key yet, set_stakey_hdl reprograms it */
+	core_tx_hdr_conv_update(a, sta, _NO_PRIVACY_);
 	rtw_dump_phl_sta_info(RTW_DBGDUMP, sta);
 
 	/* Todo: update IOT-releated issue */
@@ -1960,6 +1980,8 @@ int rtw_hw_connected(struct _ADAPTER *a, struct sta_info *sta)
 	beamforming_wk_cmd(a, BEAMFORMING_CTRL_ENTER, (u8 *)psta, sizeof(struct sta_info), 0);
 #endif
 
+	/* the channel check below may switch and poll the hw */
+	rtw_hw_h2c_coal_end(phl, H2C_COAL_SEQ_CONNECT, sta);
 	rtw_join_done_chk_ch(a, 1);
 	rtw_phl_connected(phl, a->phl_role, sta->phl_sta);
 #ifdef CONFIG_80211AX_HE
@@ -1986,6 +2008,7 @@ int rtw_hw_disconnect(struct _ADAPTER *a, struct sta_info *sta)
 		_rtw_memcmp(a->phl_role->mac_addr, sta->phl_sta->mac_addr, ETH_ALEN))
 		is_ap_self = _TRUE;
 
+	rtw_hw_h2c_coal_begin(phl, H2C_COAL_SEQ_DISCONNECT, sta);
 	/* Check and reset setting related to rx ampdu resources of PHL. */
 	for (tid = 0; tid < TID_NUM; tid++) {
 		if(sta->recvreorder_ctrl[tid].enable == _TRUE) {
@@ -2002,12 +2025,17 @@ int rtw_hw_disconnect(struct _ADAPTER *a, struct sta_info *sta)
 	if (is_ap_self == _FALSE) {
 		status = rtw_phl_cmd_update_media_status(phl, sta->phl_sta, NULL, false,
 						PHL_CMD_DIRECTLY, 0);
-		if (status != RTW_PHL_STATUS_SUCCESS)
+		if (status != RTW_PHL_STATUS_SUCCESS) {
+			rtw_hw_h2c_coal_end(phl, H2C_COAL_SEQ_DISCONNECT, sta);
 			return -1;
+		}
 
 		rtw_dump_phl_sta_info(RTW_DBGDUMP, sta);
 	}
 
+	/* the channel switch below polls the hw, let the h2c out first */
+	rtw_hw_h2c_coal_end(phl, H2C_COAL_SEQ_DISCONNECT, sta);
+
 	if (MLME_IS_STA(a)) {
 		/*
 		 * the following flow only for STA
@@ -2036,11 +2064,17 @@ int rtw_hw_connected_apmode(struct _ADAPTER *a, struct sta_info *sta)
 	update_sta_ra_info(a, sta);
 	rtw_update_phl_sta_cap(a, sta, &sta->phl_sta->asoc_cap);
 
+	rtw_hw_h2c_coal_begin(phl, H2C_COAL_SEQ_AP_ASSOC, sta);
 	if (RTW_PHL_STATUS_SUCCESS != rtw_phl_cmd_update_media_status(
 		phl, sta->phl_sta, sta->phl_sta->mac_addr, true,
-		PHL_CMD_DIRECTLY, 0))
+		PHL_CMD_DIRECTLY, 0)) {
+		rtw_hw_h2c_coal_end(phl, H2C_COAL_SEQ_AP_ASSOC, sta);
 		return -1;
+	}
 
+	/* no pairwise key yet, set_stakey_hdl reprograms it */
+	core_tx_hdr_conv_update(a, sta, _NO_PRIVACY_);
+	rtw_hw_h2c_coal_end(phl, H2C_COAL_SEQ_AP_ASSOC, sta);
 	rtw_dump_phl_sta_info(RTW_DBGDUMP, sta);
 
 	return 0;
@@ -1569,6 +1569,9 @@ sint rtw_proccess_pspoll(_adapter *adapter, union recv_frame *precv_frame, struc
 	}
 
 	if ((psta->state & WIFI_SLEEP_STATE) && (rtw_tim_map_is_set(adapter, pstapriv->sta_dz_bitmap, psta->phl_sta->aid))) {
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+		xmit_pspoll_frame(adapter, psta);
+#else
 		_list	*xmitframe_plist, *xmitframe_phead;
 		struct xmit_frame *pxmitframe = NULL;
 		struct xmit_priv *pxmitpriv = &adapter->xmitpriv;
@@ -1634,6 +1637,7 @@ sint rtw_proccess_pspoll(_adapter *adapter, union recv_frame *precv_frame, struc
 				rtw_update_beacon(adapter, _TIM_IE_, NULL, _TRUE, 0);
 			}
 		}
+#endif /* CONFIG_RTW_AP_PS_STA_Q */
 	}
 	return _SUCCESS;
 }
@@ -3160,7 +3164,7 @@ int amsdu_to_msdu(_adapter *padapter, union recv_frame *prframe)
 			#ifdef CONFIG_AP_MODE
 			if (MLME_IS_AP(padapter)) {
 				act = rtw_ap_rx_msdu_act_check(prframe, da, sa
-					, pdata + ETH_HLEN, llc_hdl, &fwd_frame, &f_list);
+					, pdata + ETH_HLEN, nSubframe_Length, llc_hdl, &fwd_frame, &f_list);
 			} else
 			#endif
 			if (MLME_IS_STA(padapter))
@@ -4851,7 +4855,7 @@ void core_update_recvframe_pkt( union recv_frame *prframe, struct rtw_recv_pkt *
 }
 
 static int core_alloc_recvframe_pkt(union recv_frame *prframe,
-				    struct rtw_recv_pkt *phlrx)
+				    struct rtw_recv_pkt *phlrx, u16 headroom)
 {
 	struct rtw_pkt_buf_list *pktbuf;
 	u8 shift_sz;
@@ -4890,6 +4894,7 @@ static int core_alloc_recvframe_pkt(union recv_frame *prframe,
 		 */
 		alloc_sz += 14;
 	}
+	alloc_sz += headroom;
 
 	pkt = rtw_skb_alloc(alloc_sz);
 	if (!pkt) {
@@ -4899,6 +4904,8 @@ static int core_alloc_recvframe_pkt(union recv_frame *prframe,
 		return -1;
 	}
 
+	/* room for a header pushed in front later, e.g. radiotap */
+	skb_reserve(pkt, headroom);
 	/* force pkt->data at 8-byte alignment address */
 	skb_reserve(pkt, 8 - ((SIZE_PTR)pkt->data & 7));
 	/* force ip_hdr at 8-byte alignment address according to shift_sz. */
@@ -4928,8 +4935,13 @@ void core_update_recvframe_mdata(union recv_frame *prframe, struct rtw_recv_pkt
 	prxattrib->data_rate = mdata->rx_rate; /* enum rtw_data_rate */
 	prxattrib->gi_ltf = mdata->rx_gi_ltf;
 #ifdef CONFIG_TCP_CSUM_OFFLOAD_RX
-	prxattrib->csum_valid = mdata->chksum_ofld_en;
+	/* a whole a-msdu has one status, only a cut msdu is checked alone */
+	prxattrib->csum_valid = (mdata->chksum_ofld_en
+				 && (!mdata->amsdu || mdata->amsdu_cut)) ? 1 : 0;
 	prxattrib->csum_err = mdata->chksum_status;
+#endif
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+	prxattrib->hdr_cnv = mdata->hdr_cnv;
 #endif
 	/* when 0 indicate no encrypt. when non-zero, indicate the encrypt algorith */
 	prxattrib->encrypt = rtw_sec_algo_phl2drv((enum rtw_enc_algo)mdata->sec_type);
@@ -5191,7 +5203,7 @@ s32 core_rx_process_msdu(_adapter *adapter, union recv_frame *prframe)
 
 	if (MLME_IS_AP(adapter))
 		act = rtw_ap_rx_msdu_act_check(prframe, pattrib->dst, pattrib->src
-				, msdu, llc_hdl, &fwd_frame, &f_list);
+				, msdu, msdu_len, llc_hdl, &fwd_frame, &f_list);
 	if (!act)
 		return CORE_RX_DROP;
 #endif
@@ -5236,6 +5248,202 @@ s32 core_rx_process_msdu(_adapter *adapter, union recv_frame *prframe)
 	return CORE_RX_DONE;
 }
 
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+/* validate_recv_data_frame for a frame the MAC has converted to 802.3, the
+ * fields of the wlan header it checks come from the rx desc instead.
+ */
+static sint validate_recv_hdr_cnv_frame(_adapter *adapter, union recv_frame *prframe)
+{
+	struct rx_pkt_attrib *pattrib = &prframe->u.hdr.attrib;
+	struct security_priv *psecuritypriv = &adapter->securitypriv;
+	struct sta_info *psta = prframe->u.hdr.psta;
+	u8 *ehdr = get_recvframe_data(prframe);
+	u16 eth_type = RTW_GET_BE16(ehdr + ETH_ALEN * 2);
+	u8 bmc = IS_MCAST(pattrib->ra);
+
+	if (!(psta->state & WIFI_ASOC_STATE))
+		return _FAIL;
+
+	if (MLME_IS_STA(adapter)) {
+		if (!_rtw_memcmp(pattrib->ta, get_bssid(&adapter->mlmepriv), ETH_ALEN))
+			return _FAIL;
+#ifdef CONFIG_AP_MODE
+	} else if (MLME_IS_AP(adapter)) {
+		/* to_ds, the RA is never group addressed */
+		if (bmc)
+			return _FAIL;
+
+		if (pattrib->pw_save) {
+			if (!(psta->state & WIFI_SLEEP_STATE))
+				stop_sta_xmit(adapter, psta);
+		} else if (psta->state & WIFI_SLEEP_STATE) {
+			wakeup_sta_to_xmit(adapter, psta);
+		}
+		if (pattrib->qos)
+			process_wmmps_data(adapter, prframe, psta);
+#endif
+	} else {
+		/* mesh/ad-hoc/wds addressing needs the wlan header */
+		return _FAIL;
+	}
+
+	/* fragments are reassembled on the wlan header */
+	if (pattrib->mfrag || pattrib->frag_num)
+		return _FAIL;
+
+	if ((psta->flags & WLAN_STA_AMSDU_DISABLE) && pattrib->amsdu)
+		return _FAIL;
+
+	if (recv_decache(prframe) == _FAIL)
+		return _FAIL;
+
+	/*
+	 * The IV went with the wlan header, so recv_bcast_pn_decache has no PN
+	 * to check a group frame against: drop it rather than skip the replay
+	 * check. recv_ucast_pn_decache only tracks the PN and never drops.
+	 */
+	if (bmc && MLME_IS_STA(adapter)
+	    && (pattrib->encrypt == _TKIP_ || pattrib->encrypt == _AES_ ||
+		pattrib->encrypt == _GCMP_ || pattrib->encrypt == _CCMP_256_ ||
+		pattrib->encrypt == _GCMP_256_)) {
+		#ifdef DBG_RX_DROP_FRAME
+		RTW_INFO("DBG_RX_DROP_FRAME "FUNC_ADPT_FMT" converted bmc frame w/o PN for sta="MAC_FMT"\n"
+			, FUNC_ADPT_ARG(adapter), MAC_ARG(psta->phl_sta->mac_addr));
+		#endif
+		return _FAIL;
+	}
+
+	/* drop unprotected frame in protected network */
+	if (psecuritypriv->dot11PrivacyAlgrthm != _NO_PRIVACY_ && !pattrib->encrypt) {
+		if (bmc)
+			return _FAIL;
+		/* CVE-2020-26140/26143/26147/26144, only plain EAPOL in 802.1X */
+		if (psecuritypriv->dot11AuthAlgrthm != dot11AuthAlgrthm_8021X
+		    || eth_type != 0x888e || pattrib->amsdu)
+			return _FAIL;
+		/* CVE-2020-26139, no EAPOL forwarding before the 4-way is done */
+		if (MLME_IS_AP(adapter) && psta->dot118021XPrivacy == _NO_PRIVACY_
+		    && !_rtw_memcmp(adapter_mac_addr(adapter), pattrib->dst, ETH_ALEN))
+			return _FAIL;
+	}
+
+	return _SUCCESS;
+}
+
+/* The MAC has already replaced the wlan header with an 802.3 header and
+ * decrypted the frame, validate_recv_hdr_cnv_frame does the checks of the
+ * wlan header path before port control, stats and AP forwarding.
+ */
+static s32 core_rx_process_hdr_cnv(_adapter *adapter, union recv_frame *prframe)
+{
+	struct rx_pkt_attrib *pattrib = &prframe->u.hdr.attrib;
+	struct sta_info *psta = prframe->u.hdr.psta;
+	u8 *ehdr = get_recvframe_data(prframe);
+	u16 eth_type = RTW_GET_BE16(ehdr + ETH_ALEN * 2);
+	int act = RTW_RX_MSDU_ACT_INDICATE;
+#if defined(CONFIG_AP_MODE)
+	struct xmit_frame *fwd_frame = NULL;
+	_list f_list;
+#endif
+
+	if (validate_recv_hdr_cnv_frame(adapter, prframe) != _SUCCESS)
+		return CORE_RX_DROP;
+
+	/* only EAPOL until the 802.1X port is authorized */
+	if (adapter->securitypriv.dot11AuthAlgrthm == dot11AuthAlgrthm_8021X
+	    && psta->ieee8021x_blocked && eth_type != 0x888e)
+		return CORE_RX_DROP;
+
+	count_rx_stats(adapter, prframe, psta);
+
+#if defined(CONFIG_AP_MODE)
+	/* ehdr + 6 is where an llc-removed msdu would start, to get the ethertype */
+	if (MLME_IS_AP(adapter))
+		act = rtw_ap_rx_msdu_act_check(prframe, pattrib->dst, pattrib->src
+				, ehdr + ETH_ALEN * 2 - SNAP_SIZE
+				, prframe->u.hdr.len - ETH_ALEN * 2 + SNAP_SIZE, RTW_RX_LLC_REMOVE
+				, &fwd_frame, &f_list);
+	if (!act)
+		return CORE_RX_DROP;
+#endif
+
+	rtw_rframe_set_os_pkt(prframe);
+	adapter->recvinfo.rx_hdr_conv_hw++;
+
+	#if defined(CONFIG_AP_MODE)
+	if (act & RTW_RX_MSDU_ACT_FORWARD) {
+		recv_fwd_pkt_hdl(adapter, prframe->u.hdr.pkt, act, fwd_frame, &f_list);
+		if (!(act & RTW_RX_MSDU_ACT_INDICATE)) {
+			prframe->u.hdr.pkt = NULL;
+			rtw_free_recvframe(prframe);
+			return CORE_RX_DONE;
+		}
+	}
+	#endif
+
+	if (rtw_recv_indicatepkt_check(prframe, ehdr, get_recvframe_len(prframe)) != _SUCCESS)
+		return CORE_RX_DROP;
+
+	if (rtw_recv_indicatepkt(adapter, prframe) != _SUCCESS)
+		return CORE_RX_DROP;
+
+	return CORE_RX_DONE;
+}
+
+/* No wlan header to take the iface from, the peer is the one in the
+ * address cam, its address is reported in the rx desc.
+ */
+static s32 core_update_recvframe_hdr_cnv(struct dvobj_priv *dvobj,
+	union recv_frame *prframe, struct rtw_recv_pkt *rx_req)
+{
+	struct rtw_r_meta_data *mdata = &rx_req->mdata;
+	struct rx_pkt_attrib *pattrib = &prframe->u.hdr.attrib;
+	struct sta_info *psta = NULL;
+	_adapter *iface = NULL;
+	u8 *ehdr = NULL;
+	u8 i;
+
+	if (mdata->hdr_offset && !recvframe_pull(prframe, mdata->hdr_offset))
+		return _FAIL;
+
+	if (get_recvframe_len(prframe) < ETH_HLEN)
+		return _FAIL;
+
+	for (i = 0; i < dvobj->iface_nums; i++) {
+		iface = dvobj->padapters[i];
+		if (!iface)
+			continue;
+		psta = rtw_get_stainfo(&iface->stapriv, mdata->mac_addr);
+		if (psta)
+			break;
+	}
+	if (!psta)
+		return _FAIL;
+
+	prframe->u.hdr.adapter = iface;
+	prframe->u.hdr.pkt->dev = iface->pnetdev;
+	prframe->u.hdr.psta = psta;
+
+	ehdr = get_recvframe_data(prframe);
+	_rtw_memcpy(pattrib->dst, ehdr, ETH_ALEN);
+	_rtw_memcpy(pattrib->src, ehdr + ETH_ALEN, ETH_ALEN);
+	_rtw_memcpy(pattrib->ta, mdata->mac_addr, ETH_ALEN);
+	if (mdata->bc || mdata->mc)
+		_rtw_memcpy(pattrib->ra, pattrib->dst, ETH_ALEN);
+	else
+		_rtw_memcpy(pattrib->ra, adapter_mac_addr(iface), ETH_ALEN);
+	pattrib->qos = mdata->qos;
+	pattrib->priority = mdata->tid;
+	pattrib->seq_num = mdata->seq;
+	pattrib->frag_num = mdata->frag_num;
+	pattrib->mfrag = mdata->more_frag;
+	pattrib->mdata = mdata->more_data;
+	pattrib->pw_save = mdata->pwr_bit;
+	pattrib->amsdu = mdata->amsdu;
+
+	return _SUCCESS;
+}
+#endif /* CONFIG_RTW_HW_HDR_CONV_OFFLOAD */
 
 s32 rtw_core_rx_data_post_process(_adapter *adapter, union recv_frame *prframe)
 {
@@ -5337,7 +5545,13 @@ s32 rtw_core_update_recvframe(struct dvobj_priv *dvobj,
 		prframe->u.hdr.pkt = rx_req->os_priv; /*skb*/
 		core_update_recvframe_pkt(prframe, rx_req);
 	} else {
-		err = core_alloc_recvframe_pkt(prframe, rx_req);
+		u16 headroom = 0;
+
+#ifdef CONFIG_RTW_MON_RTAP_FAST
+		if (rtw_mi_check_fwstate(primary_padapter, WIFI_MONITOR_STATE))
+			headroom = RTW_RTAP_HDR_MAX;
+#endif
+		err = core_alloc_recvframe_pkt(prframe, rx_req, headroom);
 		if (err) {
 			rx_state = CORE_RX_FAIL;
 			goto exit;
@@ -5352,6 +5566,14 @@ s32 rtw_core_update_recvframe(struct dvobj_priv *dvobj,
 	prframe->u.hdr.adapter = primary_padapter;
 	prframe->u.hdr.pkt->dev = primary_padapter->pnetdev;
 
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+	if (rx_req->mdata.hdr_cnv) {
+		if (core_update_recvframe_hdr_cnv(dvobj, prframe, rx_req) != _SUCCESS)
+			rx_state = CORE_RX_FAIL;
+		goto exit;
+	}
+#endif
+
 	if (!is_bmc) {
 		pbuf = prframe->u.hdr.rx_data;
 		pda = get_ra(pbuf);
@@ -5474,10 +5696,24 @@ enum rtw_phl_status rtw_core_rx_process(void *drv_priv)
 		if (!rtw_is_adapter_up(adapter))
 			goto rx_next;
 
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+		if (prxattrib->hdr_cnv) {
+			if (core_rx_process_hdr_cnv(adapter, prframe) == CORE_RX_DONE) {
+				adapter->recvinfo.rx_pkts++;
+				continue;
+			}
+			goto rx_next;
+		}
+#endif
+
 #ifdef CONFIG_RTW_CORE_RXSC
 		if (core_rxsc_apply_check(adapter, prframe) == CORE_RX_GO_SHORTCUT &&
-			core_rxsc_apply_shortcut(adapter, prframe) == CORE_RX_DONE)
+			core_rxsc_apply_shortcut(adapter, prframe) == CORE_RX_DONE) {
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+			adapter->recvinfo.rx_hdr_conv_sw++;
+#endif
 			continue;
+		}
 #endif
 
 		//recv_func_prehandle
@@ -5494,6 +5730,9 @@ enum rtw_phl_status rtw_core_rx_process(void *drv_priv)
 
 		if(rtw_core_rx_data_post_process(adapter, prframe) == CORE_RX_DONE) {
 			adapter->recvinfo.rx_pkts++;
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+			adapter->recvinfo.rx_hdr_conv_sw++;
+#endif
 			continue;
 		}
 
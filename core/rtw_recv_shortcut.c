@@ -152,6 +152,10 @@ s32 core_rxsc_apply_check(_adapter *adapter, union recv_frame *prframe)
 {
 	struct rx_pkt_attrib *pattrib = &prframe->u.hdr.attrib;
 	struct core_rxsc_entry *rxsc_entry = NULL;
+#ifdef CONFIG_TCP_CSUM_OFFLOAD_RX
+	u8 csum_valid = pattrib->csum_valid;
+	u8 csum_err = pattrib->csum_err;
+#endif
 
 	if (!adapter->enable_rxsc)
 		return CORE_RX_CONTINUE;
@@ -167,6 +171,12 @@ s32 core_rxsc_apply_check(_adapter *adapter, union recv_frame *prframe)
 	wmb();
 	rxsc_entry->status = RXSC_ENTRY_VALID;
 
+#ifdef CONFIG_TCP_CSUM_OFFLOAD_RX
+	/* checksum result is per packet, not part of the cached attrib */
+	pattrib->csum_valid = csum_valid;
+	pattrib->csum_err = csum_err;
+#endif
+
 	return CORE_RX_GO_SHORTCUT;
 }
 
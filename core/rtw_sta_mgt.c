@@ -191,6 +191,10 @@ void dump_st_ctl(void *sel, struct st_ctl_t *st_ctl)
 void _rtw_init_stainfo(struct sta_info *psta);
 void _rtw_init_stainfo(struct sta_info *psta)
 {
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+	u8 i;
+#endif
+
 	_rtw_memset((u8 *)psta, 0, sizeof(struct sta_info));
 
 	_rtw_spinlock_init(&psta->lock);
@@ -201,6 +205,11 @@ void _rtw_init_stainfo(struct sta_info *psta)
 	/* _rtw_init_listhead(&psta->wakeup_list);	 */
 
 	_rtw_init_queue(&psta->sleep_q);
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+	_rtw_spinlock_init(&psta->ps_lock);
+	for (i = 0; i < 4; i++)
+		_rtw_init_listhead(&psta->ps_acq[i]);
+#endif
 
 	_rtw_init_sta_xmit_priv(&psta->sta_xmitpriv);
 	_rtw_init_sta_recv_priv(&psta->sta_recvpriv);
@@ -285,6 +294,12 @@ u32	_rtw_init_sta_priv(struct	sta_priv *pstapriv)
 	_rtw_init_listhead(&pstapriv->auth_list);
 	_rtw_spinlock_init(&pstapriv->asoc_list_lock);
 	_rtw_spinlock_init(&pstapriv->auth_list_lock);
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+	_rtw_spinlock_init(&pstapriv->tim_lock);
+#endif
+#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+	_rtw_spinlock_init(&pstapriv->mc_grp_lock);
+#endif
 	pstapriv->asoc_list_cnt = 0;
 	pstapriv->auth_list_cnt = 0;
 #ifdef CONFIG_RTW_TOKEN_BASED_XMIT
@@ -388,6 +403,9 @@ void rtw_mfree_stainfo(struct sta_info *psta)
 
 	if (&psta->lock != NULL)
 		_rtw_spinlock_free(&psta->lock);
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+	_rtw_spinlock_free(&psta->ps_lock);
+#endif
 
 	_rtw_free_sta_xmit_priv_lock(&psta->sta_xmitpriv);
 	_rtw_free_sta_recv_priv_lock(&psta->sta_recvpriv);
@@ -434,6 +452,12 @@ void rtw_mfree_sta_priv_lock(struct	sta_priv *pstapriv)
 #ifdef CONFIG_AP_MODE
 	_rtw_spinlock_free(&pstapriv->asoc_list_lock);
 	_rtw_spinlock_free(&pstapriv->auth_list_lock);
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+	_rtw_spinlock_free(&pstapriv->tim_lock);
+#endif
+#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+	_rtw_spinlock_free(&pstapriv->mc_grp_lock);
+#endif
 #endif
 
 }
@@ -720,6 +744,8 @@ u32 static _rtw_free_core_stainfo(_adapter *padapter , struct sta_info *psta)
 	if (psta == NULL)
 		goto exit;
 
+	core_tx_hdr_conv_clear(psta);
+
 #if defined(CONFIG_CORE_TXSC) && defined(USE_ONE_WLHDR)
 	/* free shortcut entry wlhdr buffer */
 	for (i = 0; i < CORE_TXSC_ENTRY_NUM; i++) {
@@ -760,6 +786,10 @@ u32 static _rtw_free_core_stainfo(_adapter *padapter , struct sta_info *psta)
 	psta->state &= ~WIFI_ASOC_STATE;
 	_rtw_spinunlock_bh(&psta->lock);
 
+#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+	rtw_ap_mc_snoop_sta_del(padapter, psta);
+#endif
+
 	pfree_sta_queue = &pstapriv->free_sta_queue;
 
 
@@ -775,6 +805,9 @@ u32 static _rtw_free_core_stainfo(_adapter *padapter , struct sta_info *psta)
 	_rtw_spinlock_bh(&pxmitpriv->lock);
 
 	rtw_free_xmitframe_queue(pxmitpriv, &psta->sleep_q);
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+	rtw_free_ps_sta_q(pxmitpriv, psta);
+#endif
 	psta->sleepq_len = 0;
 
 	/* vo */
@@ -943,6 +976,9 @@ u32 static _rtw_free_core_stainfo(_adapter *padapter , struct sta_info *psta)
 
 	if (is_pre_link_sta == _FALSE) {
 		_rtw_spinlock_free(&psta->lock);
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+		_rtw_spinlock_free(&psta->ps_lock);
+#endif
 
 		/* _rtw_spinlock_bh(&(pfree_sta_queue->lock)); */
 		_rtw_spinlock_bh(&(pstapriv->sta_hash_lock));
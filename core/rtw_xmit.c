@@ -15,6 +15,10 @@
 #define _RTW_XMIT_C_
 
 #include <drv_types.h>
+#ifdef CONFIG_RTW_TX_GSO
+#include <linux/tcp.h>
+#include <linux/ipv6.h>
+#endif
 
 static u8 P802_1H_OUI[P80211_OUI_LEN] = { 0x00, 0x00, 0xf8 };
 static u8 RFC1042_OUI[P80211_OUI_LEN] = { 0x00, 0x00, 0x00 };
@@ -5345,6 +5349,31 @@ void rtw_free_xmitframe_queue(struct xmit_priv *pxmitpriv, _queue *pframequeue)
 
 }
 
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+void rtw_free_ps_sta_q(struct xmit_priv *pxmitpriv, struct sta_info *psta)
+{
+	_list *plist, *phead;
+	struct xmit_frame *pxmitframe;
+	u8 ac;
+
+	_rtw_spinlock_bh(&psta->ps_lock);
+
+	for (ac = VO_QUEUE_INX; ac <= BK_QUEUE_INX; ac++) {
+		phead = &psta->ps_acq[ac];
+		plist = get_next(phead);
+
+		while (rtw_end_of_queue_search(phead, plist) == _FALSE) {
+			pxmitframe = LIST_CONTAINOR(plist, struct xmit_frame, list);
+			plist = get_next(plist);
+			rtw_free_xmitframe(pxmitpriv, pxmitframe);
+		}
+	}
+	psta->sleepq_ac_len = 0;
+
+	_rtw_spinunlock_bh(&psta->ps_lock);
+}
+#endif
+
 s32 rtw_xmitframe_enqueue(_adapter *padapter, struct xmit_frame *pxmitframe)
 {
 	DBG_COUNTER(padapter->tx_logs.core_tx_enqueue);
@@ -7318,6 +7347,234 @@ static enum rtw_data_rate _rate_drv2phl(struct sta_info *sta, u8 rate)
 	return phl;
 }
 
+#ifdef CONFIG_TX_AMSDU_HW_MODE
+/* A-MSDU is built by the MAC from msdu submitted back to back with the
+ * hw_amsdu hint, no queueing, timer or copy in core.
+ */
+static u8 core_tx_amsdu_hw_check(_adapter *padapter, struct xmit_frame *pxframe)
+{
+	struct registry_priv *pregpriv = &padapter->registrypriv;
+
+	if (pxframe->xftype != RTW_TX_OS)
+		return _FALSE;
+
+	/* the MAC only aggregates frames whose wlan header it builds itself */
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+	if (!pxframe->attrib.hw_hdr_conv)
+		return _FALSE;
+#else
+	/* platform hw mode without the 802.3 path, CONFIG_TX_AMSDU_HW needs it */
+	return _FALSE;
+#endif
+
+	/* fragments are never aggregated */
+	if (pxframe->txreq_cnt > 1)
+		return _FALSE;
+
+	/*No amsdu when wifi_spec on*/
+	if (pregpriv->wifi_spec == 1)
+		return _FALSE;
+
+	if (check_amsdu_tx_support(padapter) == _FALSE)
+		return _FALSE;
+
+	return check_amsdu(pxframe) ? _TRUE : _FALSE;
+}
+
+/* The MAC does not report the size of the A-MSDU it built, count the runs
+ * of hinted msdu to the same macid/tid instead, capped by the hw max num.
+ * This shares amsdu_debug_coalesce[] with the sw mode for comparison.
+ */
+static void core_tx_amsdu_hw_count(_adapter *padapter, struct rtw_t_meta_data *mdata)
+{
+	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+	u8 run = pxmitpriv->amsdu_hw_run;
+
+	if (mdata->hw_amsdu)
+		pxmitpriv->amsdu_debug_enqueue++;
+
+	if (run && mdata->hw_amsdu
+	    && pxmitpriv->amsdu_hw_macid == mdata->macid
+	    && pxmitpriv->amsdu_hw_tid == mdata->tid
+	    && run < RTW_HW_AMSDU_MAX_NUM) {
+		pxmitpriv->amsdu_hw_run++;
+		return;
+	}
+
+	if (run) {
+		if (run < AMSDU_DEBUG_MAX_COUNT)
+			pxmitpriv->amsdu_debug_coalesce[run - 1]++;
+		else
+			pxmitpriv->amsdu_debug_coalesce[AMSDU_DEBUG_MAX_COUNT - 1]++;
+		pxmitpriv->amsdu_debug_dequeue++;
+	}
+
+	pxmitpriv->amsdu_hw_run = mdata->hw_amsdu ? 1 : 0;
+	pxmitpriv->amsdu_hw_macid = mdata->macid;
+	pxmitpriv->amsdu_hw_tid = mdata->tid;
+}
+#endif /* CONFIG_TX_AMSDU_HW_MODE */
+
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+/* The MAC builds the wlan header from the template of the macid and the
+ * DA/SA of the 802.3 header, and the AES IV with hw_sec_iv. Frames which
+ * need the wlan header or the payload in sw stay on the sw path.
+ */
+static u8 core_tx_hdr_conv_allow(_adapter *padapter, struct xmit_frame *pxframe)
+{
+	struct pkt_attrib *attrib = &pxframe->attrib;
+
+	if (!GET_PHL_COM(adapter_to_dvobj(padapter))->dev_cap.hw_hdr_conv)
+		return _FALSE;
+
+	if (pxframe->xftype != RTW_TX_OS || !attrib->psta)
+		return _FALSE;
+
+	if (MLME_IS_MESH(padapter) || IS_MCAST(attrib->ra))
+		return _FALSE;
+#ifdef CONFIG_RTW_WDS
+	/* 4-address, DA/SA are not the addresses of the template */
+	if (attrib->wds)
+		return _FALSE;
+#endif
+
+	/* sw A-MSDU subframes are built on the 802.11 header */
+	if (attrib->nr_frags > 1 || attrib->amsdu)
+		return _FALSE;
+
+	/* EAPOL is sent before and across key install */
+	if (attrib->ether_type == 0x888e)
+		return _FALSE;
+
+	switch (attrib->encrypt) {
+	case _NO_PRIVACY_:
+		break;
+	case _AES_:
+	case _CCMP_256_:
+	case _GCMP_:
+	case _GCMP_256_:
+		if (attrib->bswenc)
+			return _FALSE;
+		break;
+	default:
+		/* TKIP needs the sw MIC, no hw IV for WEP/WAPI */
+		return _FALSE;
+	}
+
+	return _TRUE;
+}
+
+static u8 core_tx_hdr_conv_check(_adapter *padapter, struct xmit_frame *pxframe)
+{
+	struct sta_info *psta = pxframe->attrib.psta;
+
+	if (!core_tx_hdr_conv_allow(padapter, pxframe))
+		return _FALSE;
+
+	/* no template, or one built for another key or header (qos/htc) */
+	if (!psta->hw_hdr_conv_rdy
+	    || psta->hw_hdr_conv_enc != pxframe->attrib.encrypt
+	    || psta->hw_hdr_conv_hlen != pxframe->attrib.hdrlen)
+		return _FALSE;
+
+	return _TRUE;
+}
+
+/* Download the wlan header template of a station, called from the connect
+ * and pairwise key paths. DA/SA are taken from the 802.3 header by the MAC,
+ * seq and qos ctrl are filled per frame.
+ */
+void core_tx_hdr_conv_update(_adapter *padapter, struct sta_info *psta, u8 encrypt)
+{
+	struct mlme_priv *pmlmepriv = &padapter->mlmepriv;
+	u8 hdr[WLAN_HDR_A3_QOS_LEN] = {0};
+	struct rtw_ieee80211_hdr *pwlanhdr = (struct rtw_ieee80211_hdr *)hdr;
+	u16 *fctrl = &pwlanhdr->frame_ctl;
+	u8 qos_option, hdrlen;
+
+	psta->hw_hdr_conv_rdy = 0;
+
+	if (!GET_PHL_COM(adapter_to_dvobj(padapter))->dev_cap.hw_hdr_conv)
+		return;
+
+	if (MLME_IS_STA(padapter)) {
+		/* to_ds, tdls peers stay on the sw path */
+		if (!_rtw_memcmp(psta->phl_sta->mac_addr, get_bssid(pmlmepriv), ETH_ALEN))
+			return;
+		SetToDs(fctrl);
+		_rtw_memcpy(pwlanhdr->addr1, get_bssid(pmlmepriv), ETH_ALEN);
+		_rtw_memcpy(pwlanhdr->addr2, adapter_mac_addr(padapter), ETH_ALEN);
+		_rtw_memcpy(pwlanhdr->addr3, psta->phl_sta->mac_addr, ETH_ALEN);
+		qos_option = pmlmepriv->qospriv.qos_option;
+	} else if (MLME_IS_AP(padapter)) {
+		SetFrDs(fctrl);
+		_rtw_memcpy(pwlanhdr->addr1, psta->phl_sta->mac_addr, ETH_ALEN);
+		_rtw_memcpy(pwlanhdr->addr2, get_bssid(pmlmepriv), ETH_ALEN);
+		_rtw_memcpy(pwlanhdr->addr3, adapter_mac_addr(padapter), ETH_ALEN);
+		qos_option = psta->qos_option;
+	} else {
+		return;
+	}
+
+	set_frame_sub_type(fctrl, qos_option ? WIFI_QOS_DATA_TYPE : WIFI_DATA_TYPE);
+	if (encrypt)
+		SetPrivacy(fctrl);
+	hdrlen = qos_option ? WLAN_HDR_A3_QOS_LEN : WLAN_HDR_A3_LEN;
+
+	if (rtw_phl_upd_shcut_mhdr(GET_PHL_INFO(adapter_to_dvobj(padapter)),
+				   psta->phl_sta->macid, hdr,
+				   hdrlen) != RTW_PHL_STATUS_SUCCESS)
+		return;
+
+	psta->hw_hdr_conv_enc = encrypt;
+	psta->hw_hdr_conv_hlen = hdrlen;
+	psta->hw_hdr_conv_rdy = 1;
+}
+
+/* the shortcut cam entry of the macid is stale once the station is gone */
+void core_tx_hdr_conv_clear(struct sta_info *psta)
+{
+	psta->hw_hdr_conv_rdy = 0;
+}
+
+static u8 fill_txreq_pkt_hdr_conv(_adapter *padapter, struct xmit_frame *pxframe)
+{
+	struct rtw_xmit_req *xf_txreq = NULL;
+	struct rtw_pkt_buf_list *pkt_list = NULL;
+	struct sk_buff *skb = pxframe->pkt;
+	struct xmit_txreq_buf *txreq_buf = NULL;
+	u8 *txreq, *head, *tail, *list;
+
+	txreq_buf = (struct xmit_txreq_buf *)get_txreq_buffer(padapter, &txreq, &list, &head, &tail);
+	if (txreq_buf == NULL)
+		return _FAIL;
+#ifdef USE_PREV_WLHDR_BUF /* CONFIG_CORE_TXSC */
+	txreq_buf->macid = 0xff;
+	txreq_buf->txsc_id = 0xff;
+#endif
+	pxframe->ptxreq_buf = txreq_buf;
+	pxframe->txreq_cnt = 1;
+
+	pxframe->phl_txreq = xf_txreq = (struct rtw_xmit_req *)txreq;
+	pkt_list = (struct rtw_pkt_buf_list *)list;
+#ifdef CONFIG_CORE_TXSC
+	xf_txreq->shortcut_id = 0;
+	xf_txreq->treq_type = RTW_PHL_TREQ_TYPE_NORMAL;
+#endif
+	xf_txreq->pkt_cnt = 0;
+	xf_txreq->total_len = 0;
+	xf_txreq->pkt_list = (u8 *)pkt_list;
+
+	/* whole 802.3 frame, no wlan head/tail */
+	fill_txreq_list_skb(padapter, xf_txreq, &pkt_list, skb, skb->len, 0);
+
+	_rtw_memset(pxframe->wlhdr, 0, sizeof(pxframe->wlhdr));
+	_rtw_memset(pxframe->wltail, 0, sizeof(pxframe->wltail));
+
+	return _SUCCESS;
+}
+#endif /* CONFIG_RTW_HW_HDR_CONV_OFFLOAD */
+
 void fill_txreq_mdata(_adapter *padapter, struct xmit_frame *pxframe)
 {
 	struct rtw_xmit_req *txreq = pxframe->phl_txreq;
@@ -7469,6 +7726,22 @@ void fill_txreq_mdata(_adapter *padapter, struct xmit_frame *pxframe)
 	mdata->spe_rpt = 0;
 	mdata->sw_define = 0;
 
+#ifdef CONFIG_TX_AMSDU_HW_MODE
+	mdata->hw_amsdu = core_tx_amsdu_hw_check(padapter, pxframe);
+#endif
+
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+	if (pxframe->attrib.hw_hdr_conv) {
+		mdata->smh_en = 1;
+		mdata->hdr_len = ETH_HLEN;
+		mdata->shcut_camid = (u8)mdata->macid;
+		mdata->hw_sec_iv = mdata->sec_hw_enc;
+	} else {
+		mdata->smh_en = 0;
+		mdata->shcut_camid = 0;
+	}
+#endif
+
 #ifdef CONFIG_XMIT_ACK
 	if (pxframe->ack_report) {
 		mdata->spe_rpt = 1;
@@ -7555,6 +7828,11 @@ u8 core_wlan_fill_txreq_pre(_adapter *padapter, struct xmit_frame *pxframe)
 
 	if (pxframe->xftype == RTW_TX_OS) {
 		get_wl_frag_paras(padapter, pxframe, &frag_perfr, &wl_frags);
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+		pxframe->attrib.hw_hdr_conv = core_tx_hdr_conv_check(padapter, pxframe);
+		if (pxframe->attrib.hw_hdr_conv)
+			return fill_txreq_pkt_hdr_conv(padapter, pxframe);
+#endif
 		if (fill_txreq_pkt_perfrag_txos(padapter, pxframe, frag_perfr, wl_frags) == _FAIL)
 			return _FAIL;
 	} else if (pxframe->xftype == RTW_TX_DRV_MGMT) {
@@ -8006,7 +8284,11 @@ s32 core_tx_prepare_phl(_adapter *padapter, struct xmit_frame *pxframe)
 	if (core_wlan_fill_txreq_pre(padapter, pxframe) == _FAIL)
 		return FAIL;
 
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+	if (pxframe->xftype == RTW_TX_OS && !pxframe->attrib.hw_hdr_conv) {
+#else
 	if (pxframe->xftype == RTW_TX_OS) {
+#endif
 		core_wlan_fill_head(padapter, pxframe);
 		if (core_wlan_fill_tkip_mic(padapter, pxframe) == _FAIL) {
 			RTW_ERR("core_wlan_fill_tkip_mic FAIL\n");
@@ -8025,7 +8307,8 @@ s32 core_tx_prepare_phl(_adapter *padapter, struct xmit_frame *pxframe)
 }
 
 
-s32 core_tx_call_phl(_adapter *padapter, struct xmit_frame *pxframe, void *txsc_pkt)
+static s32 _core_tx_call_phl(_adapter *padapter, struct xmit_frame *pxframe,
+			     void *txsc_pkt, u8 notify)
 {
 	struct rtw_xmit_req *txreq = NULL;
 	void *phl = padapter->dvobj->phl;
@@ -8033,6 +8316,8 @@ s32 core_tx_call_phl(_adapter *padapter, struct xmit_frame *pxframe, void *txsc_
 	u8 txreq_cnt = 0;
 #ifdef CONFIG_CORE_TXSC
 	struct rtw_xmit_req *ptxsc_txreq = NULL;
+#endif
+#if defined(CONFIG_CORE_TXSC) || defined(CONFIG_RTW_HW_HDR_CONV_OFFLOAD)
 	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
 #endif
 
@@ -8057,12 +8342,23 @@ s32 core_tx_call_phl(_adapter *padapter, struct xmit_frame *pxframe, void *txsc_
 		if (rtw_phl_add_tx_req(phl, txreq) != RTW_PHL_STATUS_SUCCESS)
 			return FAIL;
 
-		rtw_phl_tx_req_notify(phl);
+#ifdef CONFIG_TX_AMSDU_HW_MODE
+		core_tx_amsdu_hw_count(padapter, &txreq->mdata);
+#endif
+		if (notify)
+			rtw_phl_tx_req_notify(phl);
 
 
 		txreq++;
 	}
 
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+	if (pxframe && pxframe->xftype == RTW_TX_OS && pxframe->attrib.hw_hdr_conv)
+		pxmitpriv->tx_hdr_conv_hw++;
+	else
+		pxmitpriv->tx_hdr_conv_sw++;
+#endif
+
 	/* should count tx status after add tx req is success */
 #ifdef CONFIG_CORE_TXSC
 	if (ptxsc_txreq != NULL)
@@ -8074,13 +8370,63 @@ s32 core_tx_call_phl(_adapter *padapter, struct xmit_frame *pxframe, void *txsc_
 	return SUCCESS;
 }
 
-s32 core_tx_per_packet(_adapter *padapter, struct xmit_frame *pxframe,
-			   struct sk_buff **pskb, struct sta_info *psta)
+s32 core_tx_call_phl(_adapter *padapter, struct xmit_frame *pxframe, void *txsc_pkt)
+{
+	return _core_tx_call_phl(padapter, pxframe, txsc_pkt, _TRUE);
+}
+
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+/* hand frames released from a ps queue to phl, one tx notify for the burst */
+static void core_tx_ps_burst(_adapter *padapter, _list *burst)
+{
+	_list *plist = get_next(burst);
+	struct xmit_frame *pxframe;
+	u32 cnt = 0;
+
+	while (rtw_end_of_queue_search(burst, plist) == _FALSE) {
+		pxframe = LIST_CONTAINOR(plist, struct xmit_frame, list);
+		plist = get_next(plist);
+		rtw_list_delete(&pxframe->list);
+
+		if (_core_tx_call_phl(padapter, pxframe, NULL, _FALSE) == FAIL) {
+			core_tx_free_xmitframe(padapter, pxframe);
+			continue;
+		}
+		cnt++;
+	}
+
+	if (cnt)
+		rtw_phl_tx_req_notify(padapter->dvobj->phl);
+}
+#endif
+
+#ifdef CONFIG_AP_MODE
+/*
+ * Buffer a frame for a dozing receiver, return _TRUE if it was queued.
+ * Unicast frames only take the station ps_lock, bc/mc keep the global
+ * xmit lock.
+ */
+u8 core_tx_ps_enqueue(_adapter *padapter, struct xmit_frame *pxframe)
 {
-#if defined(CONFIG_AP_MODE) || defined(CONFIG_CORE_TXSC)
 	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+	u8 ret;
+
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+	if (!IS_MCAST(pxframe->attrib.ra))
+		return xmitframe_enqueue_for_sleeping_sta(padapter, pxframe);
 #endif
 
+	_rtw_spinlock_bh(&pxmitpriv->lock);
+	ret = xmitframe_enqueue_for_sleeping_sta(padapter, pxframe);
+	_rtw_spinunlock_bh(&pxmitpriv->lock);
+
+	return ret;
+}
+#endif
+
+s32 core_tx_per_packet(_adapter *padapter, struct xmit_frame *pxframe,
+			   struct sk_buff **pskb, struct sta_info *psta)
+{
 	if (core_tx_update_xmitframe(padapter, pxframe, pskb, psta, RTW_TX_OS) == FAIL)
 		goto abort_tx_per_packet;
 
@@ -8100,13 +8446,10 @@ s32 core_tx_per_packet(_adapter *padapter, struct xmit_frame *pxframe,
 		goto abort_tx_per_packet;
 
 #ifdef CONFIG_AP_MODE
-	_rtw_spinlock_bh(&pxmitpriv->lock);
-	if (xmitframe_enqueue_for_sleeping_sta(padapter, pxframe) == _TRUE) {
-		_rtw_spinunlock_bh(&pxmitpriv->lock);
+	if (core_tx_ps_enqueue(padapter, pxframe) == _TRUE) {
 		DBG_COUNTER(padapter->tx_logs.core_tx_ap_enqueue);
 		return SUCCESS;
 	}
-	_rtw_spinunlock_bh(&pxmitpriv->lock);
 #endif
 
 #if !defined(CONFIG_CORE_TXSC) || defined(CONFIG_RTW_DATA_BMC_TO_UC)
@@ -8240,56 +8583,442 @@ abort_core_tx:
 	return FAIL;
 }
 
-enum rtw_phl_status
-rtw_core_tx_recycle(void *drv_priv, struct rtw_xmit_req *txreq)
+#ifdef CONFIG_RTW_TX_GSO
+/*
+ * TSO skb is sent without skb_gso_segment(). Each MSS sized segment becomes
+ * one MPDU (txreq): its head buffer holds wlan hdr + iv + LLC followed by a
+ * patched copy of the IP/TCP header, its payload points into the skb frags.
+ * Up to RTW_MAX_FRAG_NUM segments share one xmit_frame and one update_attrib
+ * result, every xmit_frame holds its own reference of the skb.
+ */
+static u8 core_tx_gso_seg_nr(struct sk_buff *skb, u32 off, u32 len)
 {
-	_adapter *padapter = NULL;
-	struct xmit_frame *pxframe = NULL;
-#ifdef CONFIG_CORE_TXSC
-	struct xmit_txreq_buf *ptxreq_buf = NULL;
+#if (LINUX_VERSION_CODE < KERNEL_VERSION(3, 2, 0))
+	#define skb_frag_size(f) ((f)->size)
 #endif
+	u32 end = off + len;
+	u32 pos = skb_headlen(skb);
+	u8 nr = (off < pos) ? 1 : 0;
+	int i;
 
-	if (txreq->os_priv == NULL) {
-		RTW_ERR("NULL txreq!\n");
-		return RTW_PHL_STATUS_FAILURE;
-	}
+	for (i = 0; i < skb_shinfo(skb)->nr_frags && pos < end; i++) {
+		u32 frag_sz = skb_frag_size(&skb_shinfo(skb)->frags[i]);
 
-#ifdef CONFIG_CORE_TXSC
-	if (txreq->treq_type == RTW_PHL_TREQ_TYPE_CORE_TXSC) {
-		ptxreq_buf = (struct xmit_txreq_buf *)txreq->os_priv;
-		padapter = ptxreq_buf->adapter;
-		#ifdef RTW_PHL_DBG_CMD
-		core_add_record(padapter, REC_TX_PHL_RCC, txreq);
-		#endif
-		txsc_free_txreq(padapter, txreq);
-		return RTW_PHL_STATUS_SUCCESS;
+		if (pos + frag_sz > off)
+			nr++;
+		pos += frag_sz;
 	}
-#endif /* CONFIG_CORE_TXSC */
 
-	pxframe = (struct xmit_frame *)txreq->os_priv;
-	if (pxframe == NULL) {
-		RTW_ERR("%s: NULL xmitframe !!\n", __func__);
-		rtw_warn_on(1);
-		return RTW_PHL_STATUS_FAILURE;
-	}
+	return nr;
+#if (LINUX_VERSION_CODE < KERNEL_VERSION(3, 2, 0))
+	#undef skb_frag_size
+#endif
+}
 
-	padapter = pxframe->padapter;
+u8 rtw_core_tx_gso_check(_adapter *padapter, struct sk_buff *skb)
+{
+	struct skb_shared_info *shinfo = skb_shinfo(skb);
+	struct ethhdr *ehdr = (struct ethhdr *)skb->data;
+	u32 hdr_len, mss, off;
 
-	#ifdef RTW_PHL_DBG_CMD
-	core_add_record(padapter, REC_TX_PHL_RCC, txreq);
-	#endif
+	if (!(shinfo->gso_type & (SKB_GSO_TCPV4 | SKB_GSO_TCPV6))
+	    || (shinfo->gso_type & SKB_GSO_DODGY)
+	    || skb->ip_summed != CHECKSUM_PARTIAL
+	    || skb_has_frag_list(skb))
+		return _FALSE;
 
-	#ifdef CONFIG_PCI_HCI
-	core_recycle_txreq_phyaddr(padapter, txreq);
-	#endif
-	core_tx_free_xmitframe(padapter, pxframe);
+	/* plain ethernet + ip + tcp, vlan and ipv6 ext hdr go the slow way */
+	if (skb_network_offset(skb) != ETH_HLEN)
+		return _FALSE;
+	if (skb->protocol == htons(ETH_P_IP)) {
+		if (ip_hdr(skb)->protocol != IPPROTO_TCP)
+			return _FALSE;
+	} else if (skb->protocol == htons(ETH_P_IPV6)) {
+		if (ipv6_hdr(skb)->nexthdr != IPPROTO_TCP
+		    || skb_network_header_len(skb) != sizeof(struct ipv6hdr))
+			return _FALSE;
+	} else {
+		return _FALSE;
+	}
 
-	return RTW_PHL_STATUS_SUCCESS;
-}
+	hdr_len = skb_transport_offset(skb) + tcp_hdrlen(skb);
+	if (skb_headlen(skb) < hdr_len || skb->len <= hdr_len)
+		return _FALSE;
+
+	if (IS_MCAST(ehdr->h_dest) || MLME_IS_MESH(padapter)
+	    || adapter_use_wds(padapter))
+		return _FALSE;
+#ifdef CONFIG_LAYER2_ROAMING
+	if (padapter->mlmepriv.roam_network)
+		return _FALSE;
 #endif
 
+	/* head + payload pieces of each segment must fit in one txreq */
+	mss = shinfo->gso_size;
+	for (off = hdr_len; off < skb->len; off += mss) {
+		if (core_tx_gso_seg_nr(skb, off, rtw_min(mss, skb->len - off))
+		    > NUM_PKT_LIST_PER_TXREQ - 1)
+			return _FALSE;
+	}
 
-#ifdef CONFIG_TDLS
+	return _TRUE;
+}
+
+static u8 core_tx_gso_attrib_check(_adapter *padapter,
+	struct xmit_frame *pxframe, struct sk_buff *skb)
+{
+	struct pkt_attrib *pattrib = &pxframe->attrib;
+	u32 wl_head, wl_tail;
+
+	/* sw encryption and tkip mic are done over the whole msdu */
+	if (pattrib->bswenc || pattrib->encrypt == _TKIP_)
+		return _FALSE;
+
+	if (pattrib->amsdu || XATTRIB_GET_WDS(pattrib) || !pattrib->psta)
+		return _FALSE;
+
+	wl_head = pattrib->hdrlen + RTW_SZ_LLC
+		  + skb_transport_offset(skb) + tcp_hdrlen(skb) - ETH_HLEN;
+	wl_tail = RTW_SZ_FCS;
+	if (pattrib->encrypt) {
+		wl_head += pattrib->iv_len;
+		wl_tail += pattrib->icv_len;
+	}
+
+	if (wl_head > SZ_HEAD_BUF)
+		return _FALSE;
+
+	/* a segment is never fragmented */
+	if (wl_head + skb_shinfo(skb)->gso_size + wl_tail
+	    > padapter->xmitpriv.frag_len)
+		return _FALSE;
+
+	return _TRUE;
+}
+
+/* ip/tcp header of segment idx, checksum left to the MAC */
+static void core_tx_gso_patch_hdr(struct sk_buff *skb, u8 *l3,
+	u16 idx, u16 seg_num, u32 payload_len)
+{
+	u32 l3_len = skb_transport_offset(skb) - skb_network_offset(skb);
+	u32 l4_len = tcp_hdrlen(skb);
+	struct tcphdr *th = (struct tcphdr *)(l3 + l3_len);
+
+	if (skb->protocol == htons(ETH_P_IP)) {
+		struct iphdr *iph = (struct iphdr *)l3;
+
+		iph->tot_len = htons(l3_len + l4_len + payload_len);
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(4, 7, 0))
+		if (!(skb_shinfo(skb)->gso_type & SKB_GSO_TCP_FIXEDID))
+#endif
+			iph->id = htons(ntohs(iph->id) + idx);
+		iph->check = 0;
+	} else {
+		struct ipv6hdr *ip6h = (struct ipv6hdr *)l3;
+
+		ip6h->payload_len = htons(l4_len + payload_len);
+	}
+
+	th->seq = htonl(ntohl(th->seq) + idx * skb_shinfo(skb)->gso_size);
+	if (idx)
+		th->cwr = 0;
+	if (idx != seg_num - 1) {
+		th->fin = 0;
+		th->psh = 0;
+	}
+	th->check = 0;
+}
+
+/* fill txreq for segments from seg_idx on, return the number taken */
+static u16 core_tx_gso_fill_txreq(_adapter *padapter,
+	struct xmit_frame *pxframe, struct sk_buff *skb,
+	u16 seg_idx, u16 seg_num)
+{
+	struct pkt_attrib *pattrib = &pxframe->attrib;
+	struct xmit_txreq_buf *txreq_buf = NULL;
+	struct rtw_xmit_req *xf_txreq = NULL;
+	struct rtw_pkt_buf_list *pkt_list = NULL;
+	u8 *txreq, *head, *list;
+	u32 mss = skb_shinfo(skb)->gso_size;
+	u32 hdr_len = skb_transport_offset(skb) + tcp_hdrlen(skb);
+	u32 l34_len = hdr_len - ETH_HLEN;
+	u32 wl_len = pattrib->hdrlen + RTW_SZ_LLC;
+	u32 list_rem = NUM_PKT_LIST_PER_TXREQ * RTW_MAX_FRAG_NUM;
+	u32 payload_sz, payload_len, pktlen = 0;
+	s32 payload_offset;
+	u8 nr;
+	u16 cnt = 0;
+
+	if (pattrib->encrypt)
+		wl_len += pattrib->iv_len;
+
+	txreq_buf = (struct xmit_txreq_buf *)get_txreq_buffer(padapter, &txreq, &list, &head, NULL);
+	if (txreq_buf == NULL)
+		return 0;
+#ifdef USE_PREV_WLHDR_BUF /* CONFIG_CORE_TXSC */
+	txreq_buf->macid = 0xff;
+	txreq_buf->txsc_id = 0xff;
+#endif
+	pxframe->ptxreq_buf = txreq_buf;
+	pxframe->phl_txreq = xf_txreq = (struct rtw_xmit_req *)txreq;
+	pkt_list = (struct rtw_pkt_buf_list *)list;
+
+	while ((seg_idx + cnt) < seg_num && cnt < RTW_MAX_FRAG_NUM) {
+		payload_offset = hdr_len + (seg_idx + cnt) * mss;
+		payload_len = rtw_min(mss, skb->len - payload_offset);
+
+		nr = core_tx_gso_seg_nr(skb, payload_offset, payload_len) + 1;
+		if (nr > list_rem)
+			break;
+		list_rem -= nr;
+
+		xf_txreq->pkt_cnt = 0;
+		xf_txreq->total_len = 0;
+		xf_txreq->pkt_list = (u8 *)pkt_list;
+#ifdef CONFIG_CORE_TXSC
+		xf_txreq->shortcut_id = 0;
+		xf_txreq->treq_type = RTW_PHL_TREQ_TYPE_NORMAL;
+#endif
+
+		/* wlan hdr/iv/LLC is made later, ip/tcp header copied now */
+		pxframe->wlhdr[cnt] = head;
+		_rtw_memcpy(head + wl_len, skb->data + ETH_HLEN, l34_len);
+		core_tx_gso_patch_hdr(skb, head + wl_len, seg_idx + cnt,
+				      seg_num, payload_len);
+
+		pkt_list->vir_addr = head;
+		pkt_list->length = wl_len + l34_len;
+		head += pkt_list->length;
+		xf_txreq->pkt_cnt++;
+		xf_txreq->total_len += pkt_list->length;
+		pkt_list++;
+
+		payload_sz = payload_len;
+		_fill_txreq_list_skb(padapter, xf_txreq, &pkt_list, skb,
+				     &payload_sz, &payload_offset);
+
+		pktlen += l34_len + payload_len;
+		xf_txreq++;
+		cnt++;
+	}
+
+	pxframe->txreq_cnt = cnt;
+	pattrib->nr_frags = 1;
+	pattrib->pktlen = pktlen;
+
+	return cnt;
+}
+
+static void core_tx_gso_fill_head(_adapter *padapter, struct xmit_frame *pxframe)
+{
+	struct pkt_attrib *pattrib = &pxframe->attrib;
+	u8 *pwlanhdr;
+	u32 idx;
+
+	for (idx = 0; idx < pxframe->txreq_cnt; idx++) {
+		pwlanhdr = pxframe->wlhdr[idx];
+
+		/* every segment takes the next seq num and pn */
+		rtw_make_wlanhdr(padapter, pwlanhdr, pattrib);
+		ClearMFrag(pwlanhdr);
+
+		if (pattrib->iv_len) {
+			update_attrib_sec_iv_info(padapter, pattrib);
+			_rtw_memcpy(pwlanhdr + pattrib->hdrlen, pattrib->iv,
+				    pattrib->iv_len);
+		}
+
+		rtw_put_snap(pwlanhdr + pattrib->hdrlen + pattrib->iv_len,
+			     pattrib->ether_type);
+	}
+}
+
+static s32 core_tx_gso_prepare_phl(_adapter *padapter, struct xmit_frame *pxframe)
+{
+	struct rtw_xmit_req *txreq = NULL;
+	u32 idx;
+
+	core_tx_gso_fill_head(padapter, pxframe);
+
+	if (core_migrate_to_coherent_buf(padapter, pxframe) == _FAIL)
+		return FAIL;
+
+	fill_txreq_mdata(padapter, pxframe);
+	/* mdata is copied from the first txreq, seq differs per segment */
+	txreq = pxframe->phl_txreq;
+	for (idx = 0; idx < pxframe->txreq_cnt; idx++) {
+		txreq->mdata.sw_seq = GetSequence(pxframe->wlhdr[idx]);
+		txreq++;
+	}
+	fill_txreq_others(padapter, pxframe);
+#ifdef CONFIG_PCI_HCI
+	fill_txreq_phyaddr(padapter, pxframe);
+#endif
+
+	return SUCCESS;
+}
+
+/* none of the txreq reached phl, release the frame at once */
+static void core_tx_gso_abort_frame(_adapter *padapter, struct xmit_frame *pxframe)
+{
+	if (pxframe->txreq_cnt)
+		pxframe->txfree_cnt = pxframe->txreq_cnt - 1;
+	core_tx_free_xmitframe(padapter, pxframe);
+}
+
+s32 rtw_core_tx_gso(_adapter *padapter, struct sk_buff **pskb, u16 os_qid)
+{
+	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+	struct xmit_frame *pxframe = NULL;
+	struct pkt_attrib tmpl_attrib;
+	struct sk_buff *skb = NULL;
+	u32 hdr_len;
+	u16 seg_idx = 0, seg_num, cnt;
+
+	if (core_tx_alloc_xmitframe(padapter, &pxframe, os_qid) == FAIL) {
+		rtw_os_pkt_complete(padapter, *pskb);
+		return FAIL;
+	}
+
+	/* frame is freed inside on failure */
+	if (core_tx_update_pkt(padapter, pxframe, pskb) == FAIL) {
+		rtw_os_pkt_complete(padapter, *pskb);
+		return FAIL;
+	}
+	skb = *pskb;
+
+#ifdef CONFIG_AP_MODE
+	if (MLME_IS_AP(padapter)) {
+		_list f_list;
+
+		/* unicast, no wds: resolves the next hop only */
+		if (rtw_ap_addr_resolve(padapter, os_qid, pxframe, skb, &f_list) != _SUCCESS)
+			goto abort;
+	}
+#endif
+
+	if (core_tx_update_xmitframe(padapter, pxframe, pskb, NULL, RTW_TX_OS) == FAIL)
+		goto abort;
+
+	if (core_tx_gso_attrib_check(padapter, pxframe, skb) == _FALSE) {
+		pxframe->pkt = NULL;
+		core_tx_free_xmitframe(padapter, pxframe);
+		return rtw_os_tx_gso_sw(padapter, skb, os_qid);
+	}
+
+#ifdef CONFIG_80211N_HT
+	rtw_issue_addbareq_cmd(padapter, pxframe, _TRUE);
+#endif
+
+	_rtw_memcpy(&tmpl_attrib, &pxframe->attrib, sizeof(tmpl_attrib));
+	hdr_len = skb_transport_offset(skb) + tcp_hdrlen(skb);
+	seg_num = RTW_DIV_ROUND_UP(skb->len - hdr_len, skb_shinfo(skb)->gso_size);
+
+	while (seg_idx < seg_num) {
+		if (pxframe == NULL) {
+			if (core_tx_alloc_xmitframe(padapter, &pxframe, os_qid) == FAIL)
+				break;
+			pxframe->xftype = RTW_TX_OS;
+			_rtw_memcpy(&pxframe->attrib, &tmpl_attrib, sizeof(tmpl_attrib));
+		}
+
+		/* released in rtw_os_xmit_complete when the frame is recycled */
+		pxframe->pkt = skb_get(skb);
+		rtw_mstat_update(MSTAT_TYPE_SKB, MSTAT_ALLOC_SUCCESS, skb->truesize);
+
+		cnt = core_tx_gso_fill_txreq(padapter, pxframe, skb, seg_idx, seg_num);
+		if (cnt == 0 || core_tx_gso_prepare_phl(padapter, pxframe) == FAIL) {
+			core_tx_gso_abort_frame(padapter, pxframe);
+			pxframe = NULL;
+			break;
+		}
+		seg_idx += cnt;
+
+#ifdef CONFIG_AP_MODE
+		if (core_tx_ps_enqueue(padapter, pxframe) == _TRUE) {
+			DBG_COUNTER(padapter->tx_logs.core_tx_ap_enqueue);
+			pxmitpriv->tx_gso_seg += cnt;
+			pxframe = NULL;
+			continue;
+		}
+#endif
+
+		if (core_tx_call_phl(padapter, pxframe, NULL) == FAIL) {
+			core_tx_free_xmitframe(padapter, pxframe);
+			pxframe = NULL;
+			break;
+		}
+		pxmitpriv->tx_gso_seg += cnt;
+		pxframe = NULL;
+	}
+
+	/* drop the caller's reference, frames hold their own */
+	rtw_os_pkt_complete(padapter, skb);
+
+	if (seg_idx < seg_num)
+		return FAIL;
+
+	pxmitpriv->tx_gso_pkt++;
+	return SUCCESS;
+
+abort:
+	pxframe->pkt = NULL;
+	core_tx_free_xmitframe(padapter, pxframe);
+	rtw_os_pkt_complete(padapter, skb);
+	return FAIL;
+}
+#endif /* CONFIG_RTW_TX_GSO */
+
+enum rtw_phl_status
+rtw_core_tx_recycle(void *drv_priv, struct rtw_xmit_req *txreq)
+{
+	_adapter *padapter = NULL;
+	struct xmit_frame *pxframe = NULL;
+#ifdef CONFIG_CORE_TXSC
+	struct xmit_txreq_buf *ptxreq_buf = NULL;
+#endif
+
+	if (txreq->os_priv == NULL) {
+		RTW_ERR("NULL txreq!\n");
+		return RTW_PHL_STATUS_FAILURE;
+	}
+
+#ifdef CONFIG_CORE_TXSC
+	if (txreq->treq_type == RTW_PHL_TREQ_TYPE_CORE_TXSC) {
+		ptxreq_buf = (struct xmit_txreq_buf *)txreq->os_priv;
+		padapter = ptxreq_buf->adapter;
+		#ifdef RTW_PHL_DBG_CMD
+		core_add_record(padapter, REC_TX_PHL_RCC, txreq);
+		#endif
+		txsc_free_txreq(padapter, txreq);
+		return RTW_PHL_STATUS_SUCCESS;
+	}
+#endif /* CONFIG_CORE_TXSC */
+
+	pxframe = (struct xmit_frame *)txreq->os_priv;
+	if (pxframe == NULL) {
+		RTW_ERR("%s: NULL xmitframe !!\n", __func__);
+		rtw_warn_on(1);
+		return RTW_PHL_STATUS_FAILURE;
+	}
+
+	padapter = pxframe->padapter;
+
+	#ifdef RTW_PHL_DBG_CMD
+	core_add_record(padapter, REC_TX_PHL_RCC, txreq);
+	#endif
+
+	#ifdef CONFIG_PCI_HCI
+	core_recycle_txreq_phyaddr(padapter, txreq);
+	#endif
+	core_tx_free_xmitframe(padapter, pxframe);
+
+	return RTW_PHL_STATUS_SUCCESS;
+}
+#endif
+
+
+#ifdef CONFIG_TDLS
 sint xmitframe_enqueue_for_tdls_sleeping_sta(_adapter *padapter, struct xmit_frame *pxmitframe)
 {
 	sint ret = _FALSE;
@@ -8398,6 +9127,236 @@ inline bool xmitframe_hiq_filter(struct xmit_frame *xmitframe)
 
 #if defined(CONFIG_AP_MODE) || defined(CONFIG_TDLS)
 
+/*
+ * Lock order: pxmitpriv->lock, psta->ps_lock, pstapriv->tim_lock. Without
+ * CONFIG_RTW_AP_PS_STA_Q everything runs under pxmitpriv->lock as before.
+ */
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+#define ps_sta_q_lock(psta) _rtw_spinlock_bh(&(psta)->ps_lock)
+#define ps_sta_q_unlock(psta) _rtw_spinunlock_bh(&(psta)->ps_lock)
+#define ps_tim_lock(pstapriv) _rtw_spinlock_bh(&(pstapriv)->tim_lock)
+#define ps_tim_unlock(pstapriv) _rtw_spinunlock_bh(&(pstapriv)->tim_lock)
+#else
+#define ps_sta_q_lock(psta) do {} while (0)
+#define ps_sta_q_unlock(psta) do {} while (0)
+#define ps_tim_lock(pstapriv) do {} while (0)
+#define ps_tim_unlock(pstapriv) do {} while (0)
+#endif
+
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+static u8 ps_up_to_ac(u8 up)
+{
+	switch (up) {
+	case 1:
+	case 2:
+		return BK_QUEUE_INX;
+	case 4:
+	case 5:
+		return VI_QUEUE_INX;
+	case 6:
+	case 7:
+		return VO_QUEUE_INX;
+	case 0:
+	case 3:
+	default:
+		return BE_QUEUE_INX;
+	}
+}
+
+/* BIT(0): delivery enabled, BIT(1): trigger enabled */
+static u8 ps_ac_uapsd(struct sta_info *psta, u8 ac)
+{
+	switch (ac) {
+	case BK_QUEUE_INX:
+		return psta->uapsd_bk;
+	case VI_QUEUE_INX:
+		return psta->uapsd_vi;
+	case VO_QUEUE_INX:
+		return psta->uapsd_vo;
+	case BE_QUEUE_INX:
+	default:
+		return psta->uapsd_be;
+	}
+}
+
+/* return _TRUE if the bit was clear */
+static bool ps_tim_map_set(_adapter *padapter, u8 *map, u16 aid)
+{
+	struct sta_priv *pstapriv = &padapter->stapriv;
+	bool changed;
+
+	ps_tim_lock(pstapriv);
+	changed = !rtw_tim_map_is_set(padapter, map, aid);
+	rtw_tim_map_set(padapter, map, aid);
+	ps_tim_unlock(pstapriv);
+
+	return changed;
+}
+
+/* return _TRUE if the bit was set */
+static bool ps_tim_map_clear(_adapter *padapter, u8 *map, u16 aid)
+{
+	struct sta_priv *pstapriv = &padapter->stapriv;
+	bool changed;
+
+	ps_tim_lock(pstapriv);
+	changed = rtw_tim_map_is_set(padapter, map, aid) ? _TRUE : _FALSE;
+	rtw_tim_map_clear(padapter, map, aid);
+	ps_tim_unlock(pstapriv);
+
+	return changed;
+}
+
+static sint ps_sta_q_enqueue(_adapter *padapter, struct sta_info *psta,
+			     struct xmit_frame *pxmitframe)
+{
+	struct sta_priv *pstapriv = &padapter->stapriv;
+	u8 ac = ps_up_to_ac(pxmitframe->attrib.priority);
+	u8 wmmps_ac = ps_ac_uapsd(psta, ac) & BIT(0);
+	bool update_tim = _FALSE;
+	sint ret = _FALSE;
+
+	/* unlocked peek, the common case is an awake receiver */
+	if (!(psta->state & WIFI_SLEEP_STATE) && !psta->ps_release)
+		return _FALSE;
+
+	ps_sta_q_lock(psta);
+
+	if (!(psta->state & WIFI_SLEEP_STATE)) {
+		/* awake, but must not overtake the frames being released */
+		if (!psta->ps_release)
+			goto exit;
+	} else if (!rtw_tim_map_is_set(padapter, pstapriv->sta_dz_bitmap, psta->phl_sta->aid))
+		goto exit;
+
+	rtw_list_delete(&pxmitframe->list);
+	rtw_list_insert_tail(&pxmitframe->list, &psta->ps_acq[ac]);
+
+	psta->sleepq_len++;
+	if (wmmps_ac)
+		psta->sleepq_ac_len++;
+
+	if ((psta->state & WIFI_SLEEP_STATE)
+	    && ((psta->has_legacy_ac && !wmmps_ac) || (!psta->has_legacy_ac && wmmps_ac)))
+		update_tim = ps_tim_map_set(padapter, pstapriv->tim_bitmap, psta->phl_sta->aid);
+
+	ret = _TRUE;
+	DBG_COUNTER(padapter->tx_logs.core_tx_ap_enqueue_ucast);
+
+exit:
+	ps_sta_q_unlock(psta);
+
+	if (update_tim == _TRUE)
+		_update_beacon(padapter, _TIM_IE_, NULL, _TRUE, 0, "buffer UC");
+
+	return ret;
+}
+
+/*
+ * Move a buffered frame to the release burst, caller holds ps_lock.
+ * @de: the frame's ac is delivery enabled
+ * @sp: released within a u-apsd service period
+ */
+static void ps_sta_q_take(struct sta_info *psta, struct xmit_frame *pxmitframe,
+			  u8 de, u8 sp, _list *burst)
+{
+	struct pkt_attrib *pattrib = &pxmitframe->attrib;
+
+	rtw_list_delete(&pxmitframe->list);
+	rtw_list_insert_tail(&pxmitframe->list, burst);
+
+	psta->sleepq_len--;
+	if (de)
+		psta->sleepq_ac_len--;
+
+	if (sp) {
+		pattrib->mdata = (psta->sleepq_ac_len > 0) ? 1 : 0;
+		pattrib->eosp = pattrib->mdata ? 0 : 1;
+	} else {
+		pattrib->mdata = (psta->sleepq_len > 0) ? 1 : 0;
+	}
+	pattrib->triggered = 1;
+}
+
+/* move every buffered frame to the burst, caller holds ps_lock */
+static bool ps_sta_q_take_all(struct sta_info *psta, _list *burst)
+{
+	_list *plist, *phead;
+	struct xmit_frame *pxmitframe;
+	bool taken = _FALSE;
+	u8 ac, de;
+
+	for (ac = VO_QUEUE_INX; ac <= BK_QUEUE_INX; ac++) {
+		de = ps_ac_uapsd(psta, ac) & BIT(0);
+		phead = &psta->ps_acq[ac];
+		plist = get_next(phead);
+
+		while (rtw_end_of_queue_search(phead, plist) == _FALSE) {
+			pxmitframe = LIST_CONTAINOR(plist, struct xmit_frame, list);
+			plist = get_next(plist);
+			ps_sta_q_take(psta, pxmitframe, de, _FALSE, burst);
+			taken = _TRUE;
+		}
+	}
+
+	return taken;
+}
+
+/*
+ * Release every buffered frame, return _TRUE if the tim bit was cleared.
+ * ps_release stays set until ps_sta_q_release_end, so frames sent while the
+ * burst is on its way to phl are queued behind it instead of overtaking.
+ */
+static bool ps_sta_q_wakeup(_adapter *padapter, struct sta_info *psta, _list *burst)
+{
+	struct sta_priv *pstapriv = &padapter->stapriv;
+	bool update_tim;
+
+	ps_sta_q_lock(psta);
+
+	ps_sta_q_take_all(psta, burst);
+	psta->ps_release = 1;
+
+	update_tim = ps_tim_map_clear(padapter, pstapriv->tim_bitmap, psta->phl_sta->aid);
+
+	if (psta->state & WIFI_SLEEP_STATE)
+		psta->state ^= WIFI_SLEEP_STATE;
+
+	if (psta->state & WIFI_STA_ALIVE_CHK_STATE) {
+		RTW_INFO("%s alive check\n", __func__);
+		psta->expire_to = pstapriv->expire_to;
+		psta->state ^= WIFI_STA_ALIVE_CHK_STATE;
+	}
+
+	ps_tim_map_clear(padapter, pstapriv->sta_dz_bitmap, psta->phl_sta->aid);
+
+	ps_sta_q_unlock(psta);
+
+	return update_tim;
+}
+
+/* hand over what was queued behind the release, then let frames go direct */
+static void ps_sta_q_release_end(_adapter *padapter, struct sta_info *psta)
+{
+	_list burst;
+	bool more;
+
+	do {
+		_rtw_init_listhead(&burst);
+
+		ps_sta_q_lock(psta);
+		/* dozing again, the rest stays buffered for the next wakeup */
+		more = (psta->state & WIFI_SLEEP_STATE) ?
+			_FALSE : ps_sta_q_take_all(psta, &burst);
+		if (more == _FALSE)
+			psta->ps_release = 0;
+		ps_sta_q_unlock(psta);
+
+		core_tx_ps_burst(padapter, &burst);
+	} while (more == _TRUE);
+}
+#endif /* CONFIG_RTW_AP_PS_STA_Q */
+
 sint xmitframe_enqueue_for_sleeping_sta(_adapter *padapter, struct xmit_frame *pxmitframe)
 {
 	sint ret = _FALSE;
@@ -8427,12 +9386,17 @@ sint xmitframe_enqueue_for_sleeping_sta(_adapter *padapter, struct xmit_frame *p
 			psta=rtw_get_stainfo(pstapriv, pattrib->ra);
 		}
 	*/
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+	/* update_attrib already looked the receiver up */
+	psta = pattrib->psta;
+#else
 	psta = rtw_get_stainfo(&padapter->stapriv, pattrib->ra);
 	if (pattrib->psta != psta) {
 		DBG_COUNTER(padapter->tx_logs.core_tx_ap_enqueue_warn_sta);
 		RTW_INFO("%s, pattrib->psta(%p) != psta(%p)\n", __func__, pattrib->psta, psta);
 		return _FALSE;
 	}
+#endif
 
 	if (psta == NULL) {
 		DBG_COUNTER(padapter->tx_logs.core_tx_ap_enqueue_warn_nosta);
@@ -8473,11 +9437,13 @@ sint xmitframe_enqueue_for_sleeping_sta(_adapter *padapter, struct xmit_frame *p
 
 			psta->sleepq_len++;
 
+			ps_tim_lock(pstapriv);
 			if (!(rtw_tim_map_is_set(padapter, pstapriv->tim_bitmap, 0)))
 				update_tim = _TRUE;
 
 			rtw_tim_map_set(padapter, pstapriv->tim_bitmap, 0);
 			rtw_tim_map_set(padapter, pstapriv->sta_dz_bitmap, 0);
+			ps_tim_unlock(pstapriv);
 
 			/* RTW_INFO("enqueue, sq_len=%d\n", psta->sleepq_len); */
 			/* RTW_INFO_DUMP("enqueue, tim=", pstapriv->tim_bitmap, pstapriv->aid_bmp_len); */
@@ -8502,7 +9468,9 @@ sint xmitframe_enqueue_for_sleeping_sta(_adapter *padapter, struct xmit_frame *p
 
 	}
 
-
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+	return ps_sta_q_enqueue(padapter, psta, pxmitframe);
+#else
 	_rtw_spinlock_bh(&psta->sleep_q.lock);
 
 	if (psta->state & WIFI_SLEEP_STATE) {
@@ -8573,7 +9541,7 @@ sint xmitframe_enqueue_for_sleeping_sta(_adapter *padapter, struct xmit_frame *p
 	_rtw_spinunlock_bh(&psta->sleep_q.lock);
 
 	return ret;
-
+#endif /* CONFIG_RTW_AP_PS_STA_Q */
 }
 
 static void dequeue_xmitframes_to_sleeping_queue(_adapter *padapter, struct sta_info *psta, _queue *pframequeue)
@@ -8629,12 +9597,18 @@ void stop_sta_xmit(_adapter *padapter, struct sta_info *psta)
 
 	_rtw_spinlock_bh(&pxmitpriv->lock);
 
+	ps_sta_q_lock(psta);
 	psta->state |= WIFI_SLEEP_STATE;
 
 #ifdef CONFIG_TDLS
 	if (!(psta->tdls_sta_state & TDLS_LINKED_STATE))
 #endif /* CONFIG_TDLS */
+	{
+		ps_tim_lock(pstapriv);
 		rtw_tim_map_set(padapter, pstapriv->sta_dz_bitmap, psta->phl_sta->aid);
+		ps_tim_unlock(pstapriv);
+	}
+	ps_sta_q_unlock(psta);
 
 	dequeue_xmitframes_to_sleeping_queue(padapter, psta, &pstaxmitpriv->vo_q.sta_pending);
 	rtw_list_delete(&(pstaxmitpriv->vo_q.tx_pending));
@@ -8670,16 +9644,29 @@ void stop_sta_xmit(_adapter *padapter, struct sta_info *psta)
 
 void wakeup_sta_to_xmit(_adapter *padapter, struct sta_info *psta)
 {
-	u8 update_mask = 0, wmmps_ac = 0;
+	u8 update_mask = 0;
 	struct sta_info *psta_bmc;
 	_list	*xmitframe_plist, *xmitframe_phead;
 	struct xmit_frame *pxmitframe = NULL;
 	struct sta_priv *pstapriv = &padapter->stapriv;
 	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+	_list burst;
+#else
+	u8 wmmps_ac = 0;
+#endif
 
 	psta_bmc = rtw_get_bcmc_stainfo(padapter);
 
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+	_rtw_init_listhead(&burst);
+	if (ps_sta_q_wakeup(padapter, psta, &burst) == _TRUE)
+		update_mask = BIT(0);
+	core_tx_ps_burst(padapter, &burst);
+	ps_sta_q_release_end(padapter, psta);
 
+	_rtw_spinlock_bh(&pxmitpriv->lock);
+#else
 	/* _rtw_spinlock_bh(&psta->sleep_q.lock); */
 	_rtw_spinlock_bh(&pxmitpriv->lock);
 
@@ -8778,6 +9765,7 @@ void wakeup_sta_to_xmit(_adapter *padapter, struct sta_info *psta)
 
 		rtw_tim_map_clear(padapter, pstapriv->sta_dz_bitmap, psta->phl_sta->aid);
 	}
+#endif /* CONFIG_RTW_AP_PS_STA_Q */
 
 	/* for BC/MC Frames */
 	if (!psta_bmc)
@@ -8824,8 +9812,10 @@ void wakeup_sta_to_xmit(_adapter *padapter, struct sta_info *psta)
 				/* update_BCNTIM(padapter); */
 				update_mask |= BIT(1);
 			}
+			ps_tim_lock(pstapriv);
 			rtw_tim_map_clear(padapter, pstapriv->tim_bitmap, 0);
 			rtw_tim_map_clear(padapter, pstapriv->sta_dz_bitmap, 0);
+			ps_tim_unlock(pstapriv);
 		}
 
 	}
@@ -8847,6 +9837,90 @@ _exit:
 
 }
 
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+void xmit_delivery_enabled_frames(_adapter *padapter, struct sta_info *psta)
+{
+	struct sta_priv *pstapriv = &padapter->stapriv;
+	_list *plist, *phead;
+	struct xmit_frame *pxmitframe;
+	_list burst;
+	bool update_tim = _FALSE;
+	u8 ac;
+
+	_rtw_init_listhead(&burst);
+
+	ps_sta_q_lock(psta);
+
+	/* the whole service period goes out as one burst */
+	for (ac = VO_QUEUE_INX; ac <= BK_QUEUE_INX; ac++) {
+		if (!(ps_ac_uapsd(psta, ac) & BIT(0)))
+			continue;
+
+		phead = &psta->ps_acq[ac];
+		plist = get_next(phead);
+
+		while (rtw_end_of_queue_search(phead, plist) == _FALSE) {
+			pxmitframe = LIST_CONTAINOR(plist, struct xmit_frame, list);
+			plist = get_next(plist);
+			ps_sta_q_take(psta, pxmitframe, _TRUE, _TRUE, &burst);
+		}
+	}
+
+	if (psta->sleepq_ac_len == 0 && !psta->has_legacy_ac)
+		update_tim = ps_tim_map_clear(padapter, pstapriv->tim_bitmap, psta->phl_sta->aid);
+
+	ps_sta_q_unlock(psta);
+
+	core_tx_ps_burst(padapter, &burst);
+
+	if (update_tim == _TRUE)
+		rtw_update_beacon(padapter, _TIM_IE_, NULL, _TRUE, 0);
+}
+
+/* answer a ps-poll with one buffered frame, legacy acs first */
+void xmit_pspoll_frame(_adapter *padapter, struct sta_info *psta)
+{
+	struct sta_priv *pstapriv = &padapter->stapriv;
+	struct xmit_frame *pxmitframe = NULL;
+	_list burst;
+	bool update_tim = _FALSE, sent = _FALSE;
+	u8 ac, de, pass;
+
+	_rtw_init_listhead(&burst);
+
+	ps_sta_q_lock(psta);
+
+	for (pass = 0; pass < 2 && !sent; pass++) {
+		for (ac = VO_QUEUE_INX; ac <= BK_QUEUE_INX; ac++) {
+			de = ps_ac_uapsd(psta, ac) & BIT(0);
+			if ((pass == 0 && de) || rtw_is_list_empty(&psta->ps_acq[ac]))
+				continue;
+
+			pxmitframe = LIST_CONTAINOR(get_next(&psta->ps_acq[ac]),
+						    struct xmit_frame, list);
+			ps_sta_q_take(psta, pxmitframe, de, _FALSE, &burst);
+			sent = _TRUE;
+			break;
+		}
+	}
+
+	if (psta->sleepq_len == 0)
+		update_tim = ps_tim_map_clear(padapter, pstapriv->tim_bitmap, psta->phl_sta->aid);
+
+	ps_sta_q_unlock(psta);
+
+	if (sent == _TRUE) {
+		core_tx_ps_burst(padapter, &burst);
+	} else if (update_tim == _TRUE) {
+		/* issue nulldata with More data bit = 0 to indicate we have no buffered packets */
+		RTW_INFO("no buffered packets to xmit\n");
+		issue_nulldata(padapter, psta->phl_sta->mac_addr, 0, 0, 0);
+	}
+
+	if (update_tim == _TRUE)
+		rtw_update_beacon(padapter, _TIM_IE_, NULL, _TRUE, 0);
+}
+#else
 void xmit_delivery_enabled_frames(_adapter *padapter, struct sta_info *psta)
 {
 	u8 wmmps_ac = 0;
@@ -8933,6 +10007,7 @@ exit:
 
 	return;
 }
+#endif /* CONFIG_RTW_AP_PS_STA_Q */
 
 #endif /* defined(CONFIG_AP_MODE) || defined(CONFIG_TDLS) */
 
@@ -309,6 +309,12 @@ static void txsc_add_sc_check(_adapter *padapter, struct xmit_frame *pxframe, st
 	if (pxframe->attrib.nr_frags > 1 || pxframe->attrib.bswenc == 1)
 		goto exit;
 
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+	/* the MAC builds the wlan header of this sta, nothing to cache */
+	if (pattrib->hw_hdr_conv || psta->hw_hdr_conv_rdy)
+		goto exit;
+#endif
+
 	if (txsc_pkt->step != TXSC_NONE)
 		goto exit;
 
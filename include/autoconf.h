@@ -98,7 +98,7 @@
 #endif
 #define CONFIG_TX_AMSDU
 #ifdef CONFIG_TX_AMSDU
-	#ifdef CONFIG_PLATFORM_RTL8198D
+	#if defined(CONFIG_PLATFORM_RTL8198D) || defined(CONFIG_RTW_TX_AMSDU_HW)
 	#define CONFIG_TX_AMSDU_HW_MODE	1
 	#else
 	#define CONFIG_TX_AMSDU_SW_MODE	1
@@ -50,6 +50,13 @@
 
 #endif
 
+/* the MAC only aggregates the 802.3 frames it builds the header of */
+#if defined(CONFIG_RTW_TX_AMSDU_HW) && !defined(CONFIG_RTW_HW_HDR_CONV_OFFLOAD)
+
+	#error "Enable CONFIG_HW_HDR_CONV_OFFLOAD before enable CONFIG_TX_AMSDU_HW\n"
+
+#endif
+
 #ifdef CONFIG_RTW_ANDROID
 
 	#include <linux/version.h>
@@ -635,10 +642,44 @@ power down etc.) in last time, we can unmark this flag to avoid some unpredictab
 #ifdef CONFIG_TX_AMSDU_HW_MODE
 #define CONFIG_HW_HDR_CONVERSION
 #elif defined(CONFIG_TX_AMSDU_SW_MODE)
+/* the 802.3 path needs the MAC converter, sw A-MSDU frames keep the sw header */
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+#define CONFIG_HW_HDR_CONVERSION
+#endif
 #else
 #define CONFIG_HW_HDR_CONVERSION	/* TODO: should be 'unchange' */
 #endif
 
+/* gso segments are sent with zero ip/tcp checksum for the MAC to fill */
+#if defined(CONFIG_RTW_TX_GSO) && (!defined(CONFIG_TCP_CSUM_OFFLOAD_TX) || !defined(CONFIG_RTW_NETIF_SG))
+#undef CONFIG_RTW_TX_GSO
+#endif
+
+/* tdls peers still buffer on sleep_q */
+#if defined(CONFIG_RTW_AP_PS_STA_Q) && (!defined(CONFIG_AP_MODE) || defined(CONFIG_TDLS))
+#undef CONFIG_RTW_AP_PS_STA_Q
+#endif
+
+/* interrupt based tx beacon rebuilds the beacon on its own */
+#if defined(CONFIG_RTW_BCN_COAL) && (!defined(CONFIG_AP_MODE) || !defined(CONFIG_NATIVEAP_MLME) || defined(CONFIG_INTERRUPT_BASED_TXBCN))
+#undef CONFIG_RTW_BCN_COAL
+#endif
+
+/* snooping picks the receivers of the ap bmc to uc conversion */
+#if defined(CONFIG_RTW_AP_MCAST_SNOOP) && !(defined(CONFIG_AP_MODE) && CONFIG_RTW_AP_DATA_BMC_TO_UC)
+#undef CONFIG_RTW_AP_MCAST_SNOOP
+#endif
+#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+	#ifndef CONFIG_RTW_AP_MC_SNOOP_STA_MAX
+	#define CONFIG_RTW_AP_MC_SNOOP_STA_MAX 8
+	#endif
+#endif
+
+/* radiotap is only pushed for monitor interfaces */
+#if defined(CONFIG_RTW_MON_RTAP_FAST) && !defined(CONFIG_WIFI_MONITOR)
+#undef CONFIG_RTW_MON_RTAP_FAST
+#endif
+
 /* for phl illegal mac io access check*/
 #define CONFIG_MAC_REG_RW_CHK
 
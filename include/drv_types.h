@@ -258,6 +258,9 @@ struct registry_priv {
 	u8 ap_src_b2u_flags;
 	u8 ap_fwd_b2u_flags;
 	#endif
+	#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+	u8 ap_mc_snoop_sta_max;
+	#endif
 #endif
 
 #ifdef CONFIG_RTW_MESH
@@ -611,7 +614,12 @@ struct registry_priv {
 
 
 #define SZ_TXREQ 	(sizeof(struct rtw_xmit_req))
+#ifdef CONFIG_RTW_TX_GSO
+/* in place tso segment: qos+htc wlan hdr, llc, ipv6, 60 bytes tcp hdr, iv */
+#define SZ_HEAD_BUF	152
+#else
 #define SZ_HEAD_BUF	100
+#endif
 #define SZ_TAIL_BUF	30
 
 #define NUM_PKT_LIST_PER_TXREQ	8
@@ -1594,6 +1602,9 @@ struct _ADAPTER {
 	u8 b2u_flags_ap_src;
 	u8 b2u_flags_ap_fwd;
 	#endif
+	#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+	u8 mc_snoop_sta_max;
+	#endif
 	#endif/*CONFIG_AP_MODE*/
 
 	u32	setband;
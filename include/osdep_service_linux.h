@@ -507,6 +507,11 @@ static inline _thread_hdl_ rtw_thread_start(int (*threadfn)(void *data),
 	}
 	return _rtw_thread;
 }
+static inline void rtw_thread_set_cpu(_thread_hdl_ th, int cpu)
+{
+	if (cpu < nr_cpu_ids && cpu_online(cpu))
+		set_cpus_allowed_ptr(th, cpumask_of(cpu));
+}
 static inline bool rtw_thread_stop(_thread_hdl_ th)
 {
 
@@ -36,6 +36,9 @@ void _update_beacon(_adapter *padapter, u8 ie_id, u8 *oui, u8 tx, u8 flags, cons
 #define rtw_update_beacon(adapter, ie_id, oui, tx, flags) _update_beacon((adapter), (ie_id), (oui), (tx), (flags), __func__)
 /*rtw_update_beacon - (flags) can set to normal enqueue (0) and RTW_CMDF_WAIT_ACK enqueue. 
  (flags) = RTW_CMDF_DIRECTLY  is not currently implemented, it will do normal enqueue.*/
+#ifdef CONFIG_RTW_BCN_COAL
+u8 rtw_ap_bcn_patch(_adapter *padapter);
+#endif
 
 void expire_timeout_chk(_adapter *padapter);
 void update_sta_info_apmode(_adapter *padapter, struct sta_info *psta);
@@ -114,11 +117,18 @@ void rtw_core_ap_swch_start(_adapter *padapter, struct createbss_parm *parm);
 
 void dump_ap_b2u_flags(void *sel, _adapter *adapter);
 
+#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+void rtw_ap_mc_snoop_rx(_adapter *adapter, struct sta_info *sta
+	, const u8 *msdu, u16 msdu_len, enum rtw_rx_llc_hdl llc_hdl);
+void rtw_ap_mc_snoop_sta_del(_adapter *adapter, struct sta_info *sta);
+void dump_ap_mc_snoop(void *sel, _adapter *adapter);
+#endif
+
 int rtw_ap_addr_resolve(_adapter *adapter, u16 os_qid, struct xmit_frame *xframe, struct sk_buff *pkt, _list *f_list);
 int rtw_ap_rx_data_validate_hdr(_adapter *adapter, union recv_frame *rframe, struct sta_info **sta);
 int rtw_ap_rx_msdu_act_check(union recv_frame *rframe
 	, const u8 *da, const u8 *sa
-	, u8 *msdu, enum rtw_rx_llc_hdl llc_hdl
+	, u8 *msdu, u16 msdu_len, enum rtw_rx_llc_hdl llc_hdl
 	, struct xmit_frame **fwd_frame, _list *f_list);
 
 #ifdef CONFIG_BMC_TX_RATE_SELECT
@@ -28,6 +28,9 @@
 #define MAX_UNASSOC_STA_CNT 128
 #define UNASSOC_STA_LIFETIME_MS 60000
 
+/* distinct IEs patched into the downloaded beacon before falling back to rebuild */
+#define RTW_BCN_DIRTY_IE_NUM 5
+
 /*pmlmepriv->fw_state*/
 #define WIFI_NULL_STATE			0x00000000
 #define WIFI_ASOC_STATE			0x00000001 /* Linked */
@@ -662,6 +665,18 @@ struct mlme_priv {
 
 	_lock	bcn_update_lock;
 	u8 update_bcn;
+#ifdef CONFIG_RTW_BCN_COAL
+	/* IEs changed since the last download, patched in place unless full */
+	u8 bcn_dirty_ie[RTW_BCN_DIRTY_IE_NUM];
+	u8 bcn_dirty_num;
+	u8 bcn_dirty_full;
+	u8 bcn_tx_pending;
+	systime bcn_tx_time;
+	_timer bcn_coal_timer;
+	u32 bcn_tx_cnt;
+	u32 bcn_patch_cnt;
+	u32 bcn_coal_cnt;
+#endif
 
 	struct rtw_chan_def ori_chandef;
 	#ifdef CONFIG_80211AC_VHT
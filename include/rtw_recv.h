@@ -190,6 +190,9 @@ struct rx_pkt_attrib {
 #ifdef CONFIG_RTW_CORE_RXSC
 	u8	bsnaphdr;
 #endif
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+	u8	hdr_cnv;	/* 802.3 frame, converted by the MAC */
+#endif
 
 };
 
@@ -269,6 +272,22 @@ struct recv_info {
 	u64 rx_bytes;
 	u64 rx_pkts;
 	u64 rx_drop;
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+	/* data frames received as 802.3 vs converted by wlanhdr_to_ethhdr */
+	u64 rx_hdr_conv_hw;
+	u64 rx_hdr_conv_sw;
+#endif
+#ifdef CONFIG_TCP_CSUM_OFFLOAD_RX
+	/* frames indicated with the MAC checksum result vs left to the stack */
+	u64 rx_csum_ok;
+	u64 rx_csum_err;
+	u64 rx_csum_none;
+#endif
+#ifdef CONFIG_RTW_MON_RTAP_FAST
+	/* monitor frames without radiotap headroom vs queued for napi */
+	u64 rx_rtap_realloc;
+	u64 rx_mon_napi;
+#endif
 
 	u64 dbg_rx_drop_count;
 	u64 dbg_rx_ampdu_drop_count;
@@ -432,6 +432,9 @@ struct pkt_attrib {
 	struct sta_info *ptdls_sta;
 #endif /* CONFIG_TDLS */
 	u8 key_type;
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+	u8 hw_hdr_conv;/* 802.3 frame, wlan header built by the MAC */
+#endif
 
 
 
@@ -974,10 +977,29 @@ struct	xmit_priv	{
 #ifndef AMSDU_DEBUG_MAX_COUNT
 #define AMSDU_DEBUG_MAX_COUNT 5
 #endif
+/* msdu per hw A-MSDU, HAL_HW_AMSDU_MAX_NUM is its mac encoding (num - 1) */
+#define RTW_HW_AMSDU_MAX_NUM 4
 	u32 amsdu_debug_coalesce[AMSDU_DEBUG_MAX_COUNT];
 	u32 amsdu_debug_tasklet;
 	u32 amsdu_debug_enqueue;
 	u32 amsdu_debug_dequeue;
+#ifdef CONFIG_TX_AMSDU_HW_MODE
+	/* run of msdu with hw_amsdu hint to the same macid/tid */
+	u16 amsdu_hw_macid;
+	u8 amsdu_hw_tid;
+	u8 amsdu_hw_run;
+#endif
+#endif
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+	/* data frames submitted as 802.3 vs built with a sw wlan header */
+	u32 tx_hdr_conv_hw;
+	u32 tx_hdr_conv_sw;
+#endif
+#ifdef CONFIG_RTW_TX_GSO
+	/* tso skbs segmented in place vs handed to skb_gso_segment */
+	u32 tx_gso_pkt;
+	u32 tx_gso_seg;
+	u32 tx_gso_sw;
 #endif
 #ifdef DBG_TXBD_DESC_DUMP
 	BOOLEAN	 dump_txbd_desc;
@@ -1026,6 +1048,9 @@ struct xmit_frame *rtw_alloc_xmitframe_ext(struct xmit_priv *pxmitpriv);
 struct xmit_frame *rtw_alloc_xmitframe_once(struct xmit_priv *pxmitpriv);
 extern s32 rtw_free_xmitframe(struct xmit_priv *pxmitpriv, struct xmit_frame *pxmitframe);
 extern void rtw_free_xmitframe_queue(struct xmit_priv *pxmitpriv, _queue *pframequeue);
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+void rtw_free_ps_sta_q(struct xmit_priv *pxmitpriv, struct sta_info *psta);
+#endif
 s32 core_tx_free_xmitframe(_adapter *padapter, struct xmit_frame *pxframe);
 struct tx_servq *rtw_get_sta_pending(_adapter *padapter, struct sta_info *psta, sint up, u8 *ac);
 extern s32 rtw_xmitframe_enqueue(_adapter *padapter, struct xmit_frame *pxmitframe);
@@ -1076,16 +1101,33 @@ sint xmitframe_enqueue_for_sleeping_sta(_adapter *padapter, struct xmit_frame *p
 void stop_sta_xmit(_adapter *padapter, struct sta_info *psta);
 void wakeup_sta_to_xmit(_adapter *padapter, struct sta_info *psta);
 void xmit_delivery_enabled_frames(_adapter *padapter, struct sta_info *psta);
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+void xmit_pspoll_frame(_adapter *padapter, struct sta_info *psta);
+#endif
 #endif
 
 #ifdef RTW_PHL_TX
 s32 core_tx_prepare_phl(_adapter *padapter, struct xmit_frame *pxframe);
 s32 core_tx_call_phl(_adapter *padapter, struct xmit_frame *pxframe, void *txsc_pkt);
+#ifdef CONFIG_AP_MODE
+u8 core_tx_ps_enqueue(_adapter *padapter, struct xmit_frame *pxframe);
+#endif
 s32 core_tx_per_packet(_adapter *padapter, struct xmit_frame *pxframe,
 		       struct sk_buff **pskb, struct sta_info *psta);
 s32 rtw_core_tx(_adapter *padapter, struct sk_buff **ppkt, struct sta_info *psta, u16 os_qid);
 enum rtw_phl_status rtw_core_tx_recycle(void *drv_priv, struct rtw_xmit_req *txreq);
 s32 core_tx_alloc_xmitframe(_adapter *padapter, struct xmit_frame **pxmitframe, u16 os_qid);
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+void core_tx_hdr_conv_update(_adapter *padapter, struct sta_info *psta, u8 encrypt);
+void core_tx_hdr_conv_clear(struct sta_info *psta);
+#else
+#define core_tx_hdr_conv_update(_adapter, _psta, _encrypt) do {} while (0)
+#define core_tx_hdr_conv_clear(_psta) do {} while (0)
+#endif
+#ifdef CONFIG_RTW_TX_GSO
+u8 rtw_core_tx_gso_check(_adapter *padapter, struct sk_buff *skb);
+s32 rtw_core_tx_gso(_adapter *padapter, struct sk_buff **pskb, u16 os_qid);
+#endif
 #ifdef CONFIG_CORE_TXSC
 void core_recycle_txreq_phyaddr(_adapter *padapter, struct rtw_xmit_req *txreq);
 s32 core_tx_free_xmitframe(_adapter *padapter, struct xmit_frame *pxframe);
@@ -292,6 +292,18 @@ struct sta_info {
 #endif
 	_queue sleep_q;
 	unsigned int sleepq_len;
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+	/*
+	 * unicast frames buffered while dozing, one list per ac (VO_QUEUE_INX
+	 * to BK_QUEUE_INX), sleep_q is left to bc/mc. ps_lock also guards
+	 * sleepq_len, sleepq_ac_len and the WIFI_SLEEP_STATE transitions.
+	 * ps_release is set from wakeup until the released frames are with
+	 * phl; frames sent meanwhile still queue here behind them.
+	 */
+	_lock ps_lock;
+	_list ps_acq[4];
+	u8 ps_release;
+#endif
 
 	uint state;
 	uint qos_option;
@@ -569,6 +581,13 @@ struct sta_info {
 	struct txsc_entry txsc_entry_cache[CORE_TXSC_ENTRY_NUM];
 	u8 debug_buf[CORE_TXSC_DEBUG_BUF_SIZE];
 #endif /* CONFIG_CORE_TXSC */
+
+#ifdef CONFIG_RTW_HW_HDR_CONV_OFFLOAD
+	/* wlan header template downloaded to the shortcut cam of the macid */
+	u8 hw_hdr_conv_rdy;
+	u8 hw_hdr_conv_enc; /* encrypt type the template was built with */
+	u8 hw_hdr_conv_hlen; /* wlan header length of the template */
+#endif
 };
 
 #ifdef CONFIG_RTW_MESH
@@ -700,6 +719,23 @@ struct sta_info {
 
 #define AID_BMP_LEN(max_aid) ((max_aid + 1) / 8 + (((max_aid + 1) % 8) ? 1 : 0))
 
+#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+#define RTW_MC_GRP_NUM 32
+#define RTW_MC_GRP_STA_BMP_LEN ((NUM_STA + 7) / 8)
+/* group membership interval of IGMPv2/v3 and MLDv1/v2 with default timers */
+#define RTW_MC_GRP_TO_MS 260000
+
+/* ip multicast group learned from IGMP/MLD reports, keyed by group mac address */
+struct rtw_mc_grp {
+	u8 addr[ETH_ALEN];
+	u8 sta_num; /* 0: entry unused */
+	u8 sta_bmp[RTW_MC_GRP_STA_BMP_LEN]; /* by stainfo offset */
+	systime update;
+	u32 tx_uc;
+	u32 tx_bmc;
+};
+#endif
+
 struct	sta_priv {
 
 	u8 *pallocated_stainfo_buf;
@@ -741,6 +777,14 @@ struct	sta_priv {
 	u8 aid_bmp_len; /* in byte */
 	u8 *sta_dz_bitmap;
 	u8 *tim_bitmap;
+#ifdef CONFIG_RTW_AP_PS_STA_Q
+	/* bits of different aids share a byte, flip them under this lock */
+	_lock tim_lock;
+#endif
+#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+	_lock mc_grp_lock;
+	struct rtw_mc_grp mc_grp[RTW_MC_GRP_NUM];
+#endif
 
 	u16 max_num_sta;
 
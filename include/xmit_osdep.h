@@ -63,6 +63,9 @@ extern int rtw_xmit_entry(struct sk_buff *pkt, _nic_hdl pnetdev);
 
 #ifdef RTW_PHL_TX
 extern int rtw_os_tx(struct sk_buff *pkt, _nic_hdl pnetdev);
+#ifdef CONFIG_RTW_TX_GSO
+extern s32 rtw_os_tx_gso_sw(_adapter *padapter, struct sk_buff *pkt, u16 os_qid);
+#endif
 #endif
 #endif /* PLATFORM_LINUX */
 
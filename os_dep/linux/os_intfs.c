@@ -403,6 +403,13 @@ struct net_device *rtw_init_netdev(_adapter *old_padapter)
 #endif
 #endif
 
+#ifdef CONFIG_TCP_CSUM_OFFLOAD_RX
+        pnetdev->features |= NETIF_F_RXCSUM;
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 39)
+        pnetdev->hw_features |= NETIF_F_RXCSUM;
+#endif
+#endif
+
 #ifdef CONFIG_RTW_NETIF_SG
         pnetdev->features |= NETIF_F_SG;
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 39)
@@ -414,6 +421,13 @@ struct net_device *rtw_init_netdev(_adapter *old_padapter)
 		pnetdev->features |= (NETIF_F_TSO | NETIF_F_GSO);
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 39)
 		pnetdev->hw_features |= (NETIF_F_TSO | NETIF_F_GSO);
+#endif
+#ifdef CONFIG_RTW_TX_GSO
+		/* rtw_core_tx_gso() rebuilds ipv6 segments as well */
+		pnetdev->features |= NETIF_F_TSO6;
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 39)
+		pnetdev->hw_features |= NETIF_F_TSO6;
+#endif
 #endif
 	}
 	/* pnetdev->tx_timeout = NULL; */
@@ -976,6 +990,9 @@ u8 rtw_init_default_value(_adapter *padapter)
 	padapter->b2u_flags_ap_src = pregistrypriv->ap_src_b2u_flags;
 	padapter->b2u_flags_ap_fwd = pregistrypriv->ap_fwd_b2u_flags;
 	#endif
+	#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+	padapter->mc_snoop_sta_max = pregistrypriv->ap_mc_snoop_sta_max;
+	#endif
 #endif
 	padapter->driver_tx_bw_mode = pregistrypriv->tx_bw_mode;
 
@@ -1480,6 +1497,10 @@ void rtw_cancel_all_timer(_adapter *padapter)
 
 	_cancel_timer_ex(&padapter->mlmepriv.scan_to_timer);
 
+#ifdef CONFIG_RTW_BCN_COAL
+	_cancel_timer_ex(&padapter->mlmepriv.bcn_coal_timer);
+#endif
+
 #ifdef CONFIG_DFS_MASTER
 	_cancel_timer_ex(&adapter_to_rfctl(padapter)->radar_detect_timer);
 #endif
@@ -456,9 +456,17 @@ void rtw_os_recv_indicate_pkt(_adapter *padapter, struct sk_buff *pkt,
 		pkt->dev = padapter->pnetdev;
 		pkt->ip_summed = CHECKSUM_NONE; /* CONFIG_TCP_CSUM_OFFLOAD_RX */
 #ifdef CONFIG_TCP_CSUM_OFFLOAD_RX
-		if ((rframe->u.hdr.attrib.csum_valid == 1)
-		    && (rframe->u.hdr.attrib.csum_err == 0))
+		/* set before the skb is queued for napi_gro_receive */
+		if (!(padapter->pnetdev->features & NETIF_F_RXCSUM)
+		    || rframe->u.hdr.attrib.csum_valid != 1) {
+			padapter->recvinfo.rx_csum_none++;
+		} else if (rframe->u.hdr.attrib.csum_err == 0) {
 			pkt->ip_summed = CHECKSUM_UNNECESSARY;
+			padapter->recvinfo.rx_csum_ok++;
+		} else {
+			/* stack verifies and drops it */
+			padapter->recvinfo.rx_csum_err++;
+		}
 #endif /* CONFIG_TCP_CSUM_OFFLOAD_RX */
 
 #ifdef CONFIG_RTW_NAPI
@@ -602,9 +610,29 @@ int rtw_recv_monitor(_adapter *padapter, union recv_frame *precv_frame)
 	skb->pkt_type = PACKET_OTHERHOST;
 	skb->protocol = htons(0x0019); /* ETH_P_80211_RAW */
 
+#if defined(CONFIG_RTW_MON_RTAP_FAST) && defined(CONFIG_RTW_NAPI)
+	/* deliver with the data frames in napi batches */
+	if (padapter->registrypriv.en_napi
+		#ifdef CONFIG_RTW_NAPI_DYNAMIC
+		&& adapter_to_dvobj(padapter)->en_napi_dynamic
+		#endif
+	) {
+		skb->dev = padapter->pnetdev;
+		skb_queue_tail(&adapter_to_dvobj(padapter)->recvpriv.rx_napi_skb_queue, skb);
+		#ifndef CONFIG_RTW_NAPI_V2
+		napi_schedule(&padapter->napi);
+		#endif
+		padapter->recvinfo.rx_mon_napi++;
+		goto _recv_done;
+	}
+#endif
+
 	/* send to kernel */
 	rtw_netif_rx(padapter->pnetdev, skb);
 
+#if defined(CONFIG_RTW_MON_RTAP_FAST) && defined(CONFIG_RTW_NAPI)
+_recv_done:
+#endif
 	/* pointers to NULL before rtw_free_recvframe() */
 	precv_frame->u.hdr.pkt = NULL;
 
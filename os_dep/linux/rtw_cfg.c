@@ -548,6 +548,12 @@ module_param(rtw_ap_src_b2u_flags, int, 0644);
 int rtw_ap_fwd_b2u_flags = CONFIG_RTW_AP_FWD_B2U_FLAGS;
 module_param(rtw_ap_fwd_b2u_flags, int, 0644);
 #endif /* CONFIG_RTW_AP_DATA_BMC_TO_UC */
+
+#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+/* snooped ip multicast groups with at most this many members go unicast, 0: snooping off */
+int rtw_ap_mc_snoop_sta_max = CONFIG_RTW_AP_MC_SNOOP_STA_MAX;
+module_param(rtw_ap_mc_snoop_sta_max, int, 0644);
+#endif
 #endif /* CONFIG_AP_MODE */
 
 #ifdef CONFIG_RTW_MESH
@@ -712,6 +718,13 @@ module_param(rtw_dbcc_en, int, 0644);
 MODULE_PARM_DESC(rtw_dbcc_en, "0:Disable, 1:Enable DBCC");
 #endif
 
+#ifdef CONFIG_CMD_DISP_SOLO_MODE
+static int rtw_dispr_cpu[2] = {-1, -1};
+static uint rtw_dispr_cpu_num = 0;
+module_param_array(rtw_dispr_cpu, int, &rtw_dispr_cpu_num, 0644);
+MODULE_PARM_DESC(rtw_dispr_cpu, "cpu of the cmd dispatcher thread of each band, -1: not bound");
+#endif
+
 uint rtw_powertracking_type = 64;
 module_param(rtw_powertracking_type, uint, 0644);
 MODULE_PARM_DESC(rtw_powertracking_type, "default init value:64");
@@ -1220,6 +1233,10 @@ void rtw_core_update_default_setting (struct dvobj_priv *dvobj)
 #ifdef CONFIG_DBCC_SUPPORT
 	phl_com->dev_sw_cap.dbcc_sup = rtw_dbcc_en;
 #endif
+#ifdef CONFIG_CMD_DISP_SOLO_MODE
+	phl_com->dev_sw_cap.dispr_cpu[0] = (s8)rtw_dispr_cpu[0];
+	phl_com->dev_sw_cap.dispr_cpu[1] = (s8)rtw_dispr_cpu[1];
+#endif
 
 	phl_com->dev_sw_cap.hw_hdr_conv = rtw_hw_hdr_conv;
 
@@ -1776,6 +1793,9 @@ int rtw_stbc_cap = 0x13;
 	registry_par->ap_src_b2u_flags = rtw_ap_src_b2u_flags;
 	registry_par->ap_fwd_b2u_flags = rtw_ap_fwd_b2u_flags;
 	#endif
+	#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+	registry_par->ap_mc_snoop_sta_max = rtw_ap_mc_snoop_sta_max;
+	#endif
 #endif /* CONFIG_AP_MODE */
 
 #ifdef CONFIG_RTW_MESH
@@ -864,8 +864,244 @@ static ssize_t proc_set_ap_b2u_flags(struct file *file, const char __user *buffe
 	return count;
 }
 #endif /* CONFIG_RTW_AP_DATA_BMC_TO_UC */
+
+#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+static int proc_get_ap_mc_snoop(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = rtw_netdev_priv(dev);
+
+	if (MLME_IS_AP(adapter))
+		dump_ap_mc_snoop(m, adapter);
+
+	return 0;
+}
+
+static ssize_t proc_set_ap_mc_snoop(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = rtw_netdev_priv(dev);
+	char tmp[32];
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+		u8 sta_max;
+		int num = sscanf(tmp, "%hhu", &sta_max);
+
+		if (num >= 1)
+			adapter->mc_snoop_sta_max = sta_max;
+	}
+
+	return count;
+}
+#endif /* CONFIG_RTW_AP_MCAST_SNOOP */
 #endif /* CONFIG_AP_MODE */
 
+#ifdef CONFIG_TX_ATF
+static int proc_get_tx_atf(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = rtw_netdev_priv(dev);
+	void *phl = GET_PHL_INFO(adapter_to_dvobj(adapter));
+	struct phl_tx_atf cfg;
+	struct rtw_atf_sta_stats *stats;
+	u16 num, i;
+
+	rtw_phl_tx_atf_get_cfg(phl, &cfg);
+	RTW_PRINT_SEL(m, "en=%u, quantum=%u us, round=%u\n"
+		, cfg.en, cfg.quantum, cfg.round_cnt);
+
+	stats = rtw_zmalloc(sizeof(*stats) * PHL_MAX_STA_NUM);
+	if (!stats)
+		return 0;
+
+	num = rtw_phl_tx_atf_get_sta_stats(phl, stats, PHL_MAX_STA_NUM);
+	for (i = 0; i < num; i++) {
+		RTW_PRINT_SEL(m, "macid %u: rate %u00k, ampdu %u, deficit %d, airtime %llu us, share %u%%, held %u\n"
+			, stats[i].macid, stats[i].rate, stats[i].ampdu
+			, stats[i].deficit, (unsigned long long)stats[i].airtime
+			, stats[i].share, stats[i].held_cnt);
+	}
+
+	rtw_mfree(stats, sizeof(*stats) * PHL_MAX_STA_NUM);
+	return 0;
+}
+
+/* echo <en> [quantum_us] */
+static ssize_t proc_set_tx_atf(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = rtw_netdev_priv(dev);
+	char tmp[32];
+
+	if (count < 1)
+		return -EFAULT;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+		u8 en;
+		u32 quantum = 0;
+		int num = sscanf(tmp, "%hhu %u", &en, &quantum);
+
+		if (num >= 1)
+			rtw_phl_tx_atf_cfg(GET_PHL_INFO(adapter_to_dvobj(adapter))
+				, en ? _TRUE : _FALSE, quantum);
+	}
+
+	return count;
+}
+#endif /* CONFIG_TX_ATF */
+
+#ifdef CONFIG_RX_CLS
+static int proc_get_rx_cls(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = rtw_netdev_priv(dev);
+	void *phl = GET_PHL_INFO(adapter_to_dvobj(adapter));
+	static const char *const policy_str[RX_CLS_POLICY_MAX] = {
+		"off", "normal", "strict"
+	};
+	static const char *const target_str[] = {"drop", "host", "wlcpu"};
+	struct rtw_rx_cls_rule rule;
+	u8 idx;
+
+	RTW_PRINT_SEL(m, "policy=%s\n"
+		, policy_str[rtw_phl_rx_cls_get_policy(phl)]);
+
+	for (idx = 0; idx < RTW_RX_CLS_RULE_NUM; idx++) {
+		if (!rtw_phl_rx_cls_get_rule(phl, idx, &rule))
+			continue;
+		if (rule.target == RX_CLS_TARGET_DROP)
+			RTW_PRINT_SEL(m, "rule[%u] band=%u, type=%u, subtype=0x%x -> %s\n"
+				, idx, rule.band, rule.type, rule.subtype
+				, target_str[rule.target]);
+		else
+			RTW_PRINT_SEL(m, "rule[%u] band=%u, type=%u, subtype=0x%x -> %s, hit=%u\n"
+				, idx, rule.band, rule.type, rule.subtype
+				, target_str[rule.target], rule.hit);
+	}
+
+	return 0;
+}
+
+/*
+ * echo policy <0:off|1:normal|2:strict>
+ * echo add <band> <type> <subtype> <0:drop|1:host|2:wlcpu>
+ * echo del <idx>
+ */
+static ssize_t proc_set_rx_cls(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = rtw_netdev_priv(dev);
+	void *phl = GET_PHL_INFO(adapter_to_dvobj(adapter));
+	struct rtw_rx_cls_rule rule = {0};
+	char tmp[32] = {0};
+	char cmd[8];
+	u8 val[4] = {0};
+	u8 idx = 0;
+	enum rtw_phl_status status = RTW_PHL_STATUS_FAILURE;
+
+	if (count > sizeof(tmp)) {
+		rtw_warn_on(1);
+		return -EFAULT;
+	}
+
+	if (buffer && !copy_from_user(tmp, buffer, count)) {
+		int num = sscanf(tmp, "%7s %hhu %hhu %hhx %hhu", cmd,
+				 &val[0], &val[1], &val[2], &val[3]);
+
+		if (num < 2)
+			return count;
+
+		if (strcmp("policy", cmd) == 0) {
+			status = rtw_phl_rx_cls_set_policy(phl,
+					(enum rtw_rx_cls_policy)val[0]);
+		} else if (strcmp("add", cmd) == 0 && num == 5) {
+			rule.band = val[0];
+			rule.type = val[1];
+			rule.subtype = val[2];
+			rule.target = val[3];
+			status = rtw_phl_rx_cls_add_rule(phl, &rule, &idx);
+			if (status == RTW_PHL_STATUS_SUCCESS)
+				RTW_INFO(FUNC_ADPT_FMT" rx_cls rule %u added\n",
+					 FUNC_ADPT_ARG(adapter), idx);
+		} else if (strcmp("del", cmd) == 0) {
+			status = rtw_phl_rx_cls_del_rule(phl, val[0]);
+		}
+
+		if (status != RTW_PHL_STATUS_SUCCESS)
+			RTW_ERR(FUNC_ADPT_FMT" rx_cls %s fail\n",
+				FUNC_ADPT_ARG(adapter), cmd);
+	}
+
+	return count;
+}
+#endif /* CONFIG_RX_CLS */
+
+#ifdef CONFIG_H2C_COAL
+static int proc_get_h2c_coal(struct seq_file *m, void *v)
+{
+	struct net_device *dev = m->private;
+	_adapter *adapter = rtw_netdev_priv(dev);
+	void *phl = GET_PHL_INFO(adapter_to_dvobj(adapter));
+	static const char *const cls_str[H2C_COAL_CLS_MAX] = {
+		"ra", "cam", "role", "stats"
+	};
+	static const char *const trig_str[H2C_COAL_TRIG_MAX] = {
+		"size", "deadline", "order", "end"
+	};
+	struct rtw_h2c_coal_cfg cfg;
+	struct rtw_h2c_coal_stat stat;
+	u8 i;
+
+	rtw_phl_h2c_coal_get_cfg(phl, &cfg);
+	RTW_PRINT_SEL(m, "en=%u, cls_map=0x%x, max_pkt=%u, deadline=%u us\n"
+		, cfg.en, cfg.cls_map, cfg.max_pkt, cfg.deadline_us);
+
+	if (rtw_phl_h2c_coal_get_stat(phl, &stat, 0) != RTW_PHL_STATUS_SUCCESS)
+		return 0;
+
+	RTW_PRINT_SEL(m, "tx=%u\n", stat.tx_cnt);
+	for (i = 0; i < H2C_COAL_TRIG_MAX; i++)
+		RTW_PRINT_SEL(m, "flush %-8s %u\n", trig_str[i], stat.flush_cnt[i]);
+	RTW_PRINT_SEL(m, "batch 1:%u 2:%u 3-4:%u 5-8:%u 9+:%u\n"
+		, stat.batch_bin[0], stat.batch_bin[1], stat.batch_bin[2]
+		, stat.batch_bin[3], stat.batch_bin[4]);
+	for (i = 0; i < H2C_COAL_CLS_MAX; i++) {
+		RTW_PRINT_SEL(m, "%-5s pkt=%u, lat avg=%u us, max=%u us\n"
+			, cls_str[i], stat.pkt_cnt[i]
+			, stat.pkt_cnt[i] ? stat.lat_sum_us[i] / stat.pkt_cnt[i] : 0
+			, stat.lat_max_us[i]);
+	}
+
+	return 0;
+}
+
+/* any write clears the counters */
+static ssize_t proc_set_h2c_coal(struct file *file, const char __user *buffer, size_t count, loff_t *pos, void *data)
+{
+	struct net_device *dev = data;
+	_adapter *adapter = rtw_netdev_priv(dev);
+	struct rtw_h2c_coal_stat stat;
+
+	rtw_phl_h2c_coal_get_stat(GET_PHL_INFO(adapter_to_dvobj(adapter))
+		, &stat, 1);
+
+	return count;
+}
+#endif /* CONFIG_H2C_COAL */
+
 static int proc_get_dump_tx_rate_bmp(struct seq_file *m, void *v)
 {
 	struct net_device *dev = m->private;
@@ -5024,8 +5260,23 @@ const struct rtw_proc_hdl adapter_proc_hdls[] = {
 	#if CONFIG_RTW_AP_DATA_BMC_TO_UC
 	RTW_PROC_HDL_SSEQ("ap_b2u_flags", proc_get_ap_b2u_flags, proc_set_ap_b2u_flags),
 	#endif
+	#ifdef CONFIG_RTW_AP_MCAST_SNOOP
+	RTW_PROC_HDL_SSEQ("ap_mc_snoop", proc_get_ap_mc_snoop, proc_set_ap_mc_snoop),
+	#endif
 #endif /* CONFIG_AP_MODE */
 
+#ifdef CONFIG_TX_ATF
+	RTW_PROC_HDL_SSEQ("tx_atf", proc_get_tx_atf, proc_set_tx_atf),
+#endif
+
+#ifdef CONFIG_RX_CLS
+	RTW_PROC_HDL_SSEQ("rx_cls", proc_get_rx_cls, proc_set_rx_cls),
+#endif
+
+#ifdef CONFIG_H2C_COAL
+	RTW_PROC_HDL_SSEQ("h2c_coal", proc_get_h2c_coal, proc_set_h2c_coal),
+#endif
+
 #ifdef DBG_MEMORY_LEAK
 	RTW_PROC_HDL_SSEQ("_malloc_cnt", proc_get_malloc_cnt, NULL),
 #endif /* DBG_MEMORY_LEAK */
@@ -583,6 +583,39 @@ int rtw_os_is_adapter_ready(_adapter *padapter, struct sk_buff *pkt)
 	return _TRUE;
 }
 
+#ifdef CONFIG_RTW_TX_GSO
+/* tso skb the in place path can't take, split it and send each segment */
+s32 rtw_os_tx_gso_sw(_adapter *padapter, struct sk_buff *pkt, u16 os_qid)
+{
+	struct xmit_priv *pxmitpriv = &padapter->xmitpriv;
+	netdev_features_t features = padapter->pnetdev->features;
+	struct sk_buff *segs, *nskb;
+
+	features &= ~(NETIF_F_TSO | NETIF_F_TSO6);
+	segs = skb_gso_segment(pkt, features);
+	if (IS_ERR(segs) || !segs) {
+		rtw_os_pkt_complete(padapter, pkt);
+		return FAIL;
+	}
+
+	pxmitpriv->tx_gso_sw++;
+
+	do {
+		nskb = segs;
+		segs = segs->next;
+		nskb->next = NULL;
+		rtw_mstat_update(MSTAT_TYPE_SKB, MSTAT_ALLOC_SUCCESS, nskb->truesize);
+		/* rtw_core_tx frees the segment on failure */
+		if (rtw_core_tx(padapter, &nskb, NULL, os_qid) == FAIL)
+			pxmitpriv->tx_drop++;
+	} while (segs);
+
+	rtw_os_pkt_complete(padapter, pkt);
+
+	return SUCCESS;
+}
+#endif
+
 int rtw_os_tx(struct sk_buff *pkt, _nic_hdl pnetdev)
 {
 	_adapter *padapter = (_adapter *)rtw_netdev_priv(pnetdev);
@@ -613,6 +646,17 @@ int rtw_os_tx(struct sk_buff *pkt, _nic_hdl pnetdev)
 #endif
 
 	PHLTX_LOG;
+#ifdef CONFIG_RTW_TX_GSO
+	if (skb_is_gso(pkt)) {
+		if (rtw_core_tx_gso_check(padapter, pkt) == _TRUE)
+			res = rtw_core_tx_gso(padapter, &pkt, os_qid);
+		else
+			res = rtw_os_tx_gso_sw(padapter, pkt, os_qid);
+		if (res == FAIL)
+			goto inc_drop_cnt;
+		goto exit;
+	}
+#endif
 	if (rtw_core_tx(padapter, &pkt, NULL, os_qid) == FAIL)
 		goto inc_drop_cnt;
 
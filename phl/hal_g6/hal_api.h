@@ -347,6 +347,10 @@ void rtw_hal_get_cur_chdef(void *hal, u8 band_idx,
 				struct rtw_chan_def *cur_chandef);
 
 void rtw_hal_sync_cur_ch(void *hal, u8 band_idx, struct rtw_chan_def chandef);
+#ifdef CONFIG_PHL_FAST_CHSW
+void rtw_hal_chsw_cfg(void *hal, u8 en);
+u8 rtw_hal_chsw_get_stat(void *hal, struct rtw_chsw_stat *stat, u8 rst);
+#endif
 
 u8 rtw_hal_get_fwcmd_queue_idx(void* hal);
 void rtw_hal_cfg_txhci(void *hal, u8 en);
@@ -717,6 +721,50 @@ enum rtw_hal_status rtw_hal_acpt_crc_err_pkt(void *hal, u8 band, u8 enable);
 enum rtw_hal_status rtw_hal_set_rxfltr_mpdu_size(void *hal, u8 band, u16 size);
 enum rtw_hal_status rtw_hal_set_rxfltr_by_type(void *hal, u8 band, u8 type,u8 target);
 
+#ifdef CONFIG_PHL_RX_CLS
+enum rtw_hal_status
+rtw_hal_rx_cls_set_policy(void *hal, enum rtw_rx_cls_policy policy);
+enum rtw_rx_cls_policy rtw_hal_rx_cls_get_policy(void *hal);
+enum rtw_hal_status
+rtw_hal_rx_cls_add_rule(void *hal, struct rtw_rx_cls_rule *rule, u8 *idx);
+enum rtw_hal_status rtw_hal_rx_cls_del_rule(void *hal, u8 idx);
+bool rtw_hal_rx_cls_get_rule(void *hal, u8 idx, struct rtw_rx_cls_rule *rule);
+u8 rtw_hal_rx_cls_get_slot(void *hal, u8 band, u8 type, u8 subtype,
+			   u32 *ind_cnt);
+void rtw_hal_rx_cls_reset_cnt(void *hal);
+void rtw_hal_rx_cls_restore(void *hal, u8 band);
+void rtw_hal_rx_cls_hit(void *hal, struct rtw_r_meta_data *mdata, u8 *hdr);
+#endif
+
+#ifdef CONFIG_PHL_DLE_REBAL
+void rtw_hal_dle_rebal_set_en(void *hal, bool en);
+enum rtw_hal_status
+rtw_hal_dle_rebal_set_prof(void *hal, enum rtw_dle_rebal_prof prof);
+void rtw_hal_dle_rebal_get_info(void *hal, struct rtw_dle_rebal_info *info);
+#endif
+
+#ifdef CONFIG_PHL_H2C_COAL
+enum rtw_hal_status
+rtw_hal_h2c_coal_set_cfg(void *hal, struct rtw_h2c_coal_cfg *cfg);
+void rtw_hal_h2c_coal_get_cfg(void *hal, struct rtw_h2c_coal_cfg *cfg);
+enum rtw_hal_status
+rtw_hal_h2c_coal_get_stat(void *hal, struct rtw_h2c_coal_stat *stat, u8 rst);
+void rtw_hal_h2c_coal_begin(void *hal, u32 token);
+void rtw_hal_h2c_coal_end(void *hal, u32 token);
+#endif
+
+#ifdef CONFIG_PHL_IO_SHADOW
+void rtw_hal_io_shadow_ctrl(void *hal, u8 en);
+u8 rtw_hal_io_shadow_get_stat(void *hal, struct rtw_io_shadow_stat *stat,
+			      u8 rst);
+#endif
+
+#ifdef CONFIG_PHL_RFK_CACHE
+void rtw_hal_rf_rfk_cache_cfg(void *hal, u8 en, u8 ther_th);
+u8 rtw_hal_rf_rfk_cache_get_stat(void *hal, struct rtw_rfk_cache_stat *stat,
+				 u8 *ther_th, u8 rst);
+#endif
+
 
 enum rtw_hal_status
 rtw_hal_fw_log_cfg(void *hal, u8 op, u8 type, u32 value);
@@ -855,6 +903,10 @@ rtw_hal_tsf_sync(void *hal, u8 wrole_sync_from, u8 wrole_sync_to,
 enum rtw_hal_status rtw_hal_fill_txdesc(void *hal, struct rtw_xmit_req *treq,
 					u8 *wd_buf, u32 *wd_len);
 
+void rtw_hal_get_wd_tmpl_stats(void *hal, struct rtw_wd_tmpl_stats *stats);
+enum rtw_hal_status rtw_hal_upd_shcut_mhdr(void *hal, u16 macid,
+					   u8 *hdr, u8 hdr_len);
+
 enum rtw_hal_status rtw_hal_poll_hw_tx_done(void *hal);
 enum rtw_hal_status rtw_hal_hw_tx_resume(void *hal);
 enum rtw_hal_status rtw_hal_poll_hw_rx_done(void *hal);
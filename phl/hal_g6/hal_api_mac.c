@@ -836,6 +836,11 @@ hal_mac_ld_fw_symbol(void *phl_com, void *hal_com, const char *name,
 		(struct rtw_hal_com_t *)hal_com, name, buf, buf_size);
 }
 
+static u32 hal_mac_get_time_us(void *h)
+{
+	return _os_get_cur_time_us();
+}
+
 #define RTW_HALMAC_FAIL		0
 #define RTW_HALMAC_SUCCESS		1
 #define MSG_PREFIX			"[MAC]"
@@ -912,6 +917,7 @@ void rtw_plt_cb_init(void)
 	rtw_plt_cb.event_notify = hal_mac_event_notify;
 	rtw_plt_cb.ser_l2_notify = hal_ser_l2_notify;
 	rtw_plt_cb.ld_fw_symbol = hal_mac_ld_fw_symbol;
+	rtw_plt_cb.rtl_get_time_us = hal_mac_get_time_us;
 	/*.tx = ;	*/
 #if MAC_AX_PHL_H2C
 	rtw_plt_cb.tx = hal_pltfm_tx;
@@ -1513,6 +1519,24 @@ static void hal_mac_parse_rxd_checksume(struct rtw_hal_com_t *hal,
 	else
 		meta->chksum_status = 1;
 }
+
+/*
+ * status byte follows the 8 byte aligned packet in the rx buffer,
+ * frames the engine does not check (not tcp/udp) are left to the stack
+ */
+void rtw_hal_mac_parse_rx_chksum(struct hal_info_t *hal_info, u8 status,
+				 struct rtw_r_meta_data *meta)
+{
+	struct mac_ax_adapter *mac = hal_to_mac(hal_info);
+	u32 result = mac->ops->chk_rx_tcpip_chksum_ofd(mac, status);
+
+	if (result == MAC_AX_CHKSUM_OFD_HW_NO_SUPPORT ||
+	    result == MAC_AX_CHKSUM_OFD_INVALID) {
+		meta->chksum_ofld_en = 0;
+		return;
+	}
+	hal_mac_parse_rxd_checksume(hal_info->hal_com, meta, (u8)result);
+}
 #endif
 
 static void hal_mac_parse_rxd(struct rtw_hal_com_t *hal,
@@ -1756,6 +1780,8 @@ rtw_hal_mac_power_switch(struct rtw_phl_com_t *phl_com,
 	/*pwr_state = hal_mac_get_pwr_state(mac);
 	if(pwr_state != on_off)*/
 
+	hal_io_shadow_inval(hal_info->hal_com);
+	hal_chsw_inval(hal_info);
 	if (mac->ops->pwr_switch(mac, on_off) != MACSUCCESS)
 		return RTW_HAL_STATUS_FAILURE;
 
@@ -2823,7 +2849,7 @@ rtw_hal_mac_hal_init(struct rtw_phl_com_t *phl_com,
 	struct mac_ax_fwdl_info fwdl_info;
 	u32 mac_status = 0;
 	enum rtw_fw_type fw_type = RTW_FW_MAX;
-#ifdef CONFIG_PHL_CSUM_OFFLOAD_RX
+#if defined(CONFIG_PHL_CSUM_OFFLOAD_RX) || defined(CONFIG_PHL_CSUM_OFFLOAD_TX)
 	u8 tx_chksum_offload = 0;
 	u8 rx_chksum_offload = 0;
 #endif
@@ -2867,12 +2893,25 @@ rtw_hal_mac_hal_init(struct rtw_phl_com_t *phl_com,
 		PHL_ERR("%s : mac_status %d!\n", __func__, mac_status);
 	}
 	_hal_mac_get_ofld_cap(phl_com, hal_info);
+#if defined(CONFIG_PHL_CSUM_OFFLOAD_RX) || defined(CONFIG_PHL_CSUM_OFFLOAD_TX)
 #ifdef CONFIG_PHL_CSUM_OFFLOAD_RX
 	rx_chksum_offload = 1;
+#endif
+#ifdef CONFIG_PHL_CSUM_OFFLOAD_TX
+	/* core leaves ip/tcp/udp checksum zero for the MAC to fill */
+	tx_chksum_offload = 1;
+#endif
 	mac_status = mac->ops->tcpip_chksum_ofd(mac, tx_chksum_offload, rx_chksum_offload);
 	if (mac_status != MACSUCCESS)
 		PHL_ERR("%s : tcpip_chksum_ofd mac_status %d!!!!!!!\n", __func__, mac_status);
 #endif
+#ifdef CONFIG_PHL_HW_AMSDU
+	/* msdu with hw_amsdu set in wd are aggregated by the MAC */
+	mac_status = mac->ops->enable_hwmasdu(mac, true, HAL_HW_AMSDU_MAX_NUM,
+					      false, false);
+	if (mac_status != MACSUCCESS)
+		PHL_ERR("%s : enable_hwmasdu mac_status %d!\n", __func__, mac_status);
+#endif
 
 	FUNCOUT_WSTS(hstatus);
 
@@ -4704,6 +4743,42 @@ enum rtw_hal_status rtw_hal_hdr_conv_cfg(struct hal_info_t *hal_info,
 	return sts;
 }
 
+/**
+ * the function to download the wlan header template of a macid, the MAC
+ * builds the 802.11 header of frames submitted with smh_en from it
+ * @hal_info: see struct hal_info_t
+ * @macid: shortcut cam index, one template per macid
+ * @hdr: wlan header w/o iv
+ * @hdr_len: length of @hdr
+ *
+ * return RTW_HAL_STATUS_MAC_API_FAILURE if update fail
+ */
+enum rtw_hal_status
+rtw_hal_mac_upd_shcut_mhdr(struct hal_info_t *hal_info, u16 macid,
+			   u8 *hdr, u8 hdr_len)
+{
+	struct mac_ax_adapter *mac = hal_to_mac(hal_info);
+	struct mac_ax_shcut_mhdr info;
+	u32 ret = 0;
+
+	/* the header follows the length byte */
+	if (hdr_len >= sizeof(info))
+		return RTW_HAL_STATUS_FAILURE;
+
+	_os_mem_set(hal_to_drvpriv(hal_info), &info, 0, sizeof(info));
+	info.mac_header_length = hdr_len;
+	_os_mem_cpy(hal_to_drvpriv(hal_info), (u8 *)&info + 1, hdr, hdr_len);
+
+	ret = mac->ops->upd_shcut_mhdr(mac, &info, (u8)macid);
+	if (MACSUCCESS != ret) {
+		PHL_TRACE(COMP_PHL_MAC, _PHL_WARNING_,
+			  "upd_shcut_mhdr macid %d fail (0x%08X)\n", macid, ret);
+		return RTW_HAL_STATUS_MAC_API_FAILURE;
+	}
+
+	return RTW_HAL_STATUS_SUCCESS;
+}
+
 
 #ifdef RTW_PHL_BCN //fill hal mac ops
 enum rtw_hal_status
@@ -6691,6 +6766,57 @@ enum rtw_hal_status rtw_hal_mac_set_rxfltr_by_subtype(
 	return RTW_HAL_STATUS_SUCCESS;
 }
 
+/**
+ * rtw_hal_mac_set_rxfltr_subtype_all - Filter all subtypes of a frame type
+ * @hal_com:	pointer of struct rtw_hal_com_t
+ * @band:	0x0: band0, 0x1: band1
+ * @type:	802.11 frame type, b'00: mgmt, b'01: ctrl, b'10: data
+ * @target:	array of 16 targets indexed by subtype,
+ *		0: drop, 1: accept(driver), 2: firmware
+ *
+ * Same as rtw_hal_mac_set_rxfltr_by_subtype() for every subtype, but with a
+ * single read-modify-write of the type filter register.
+ *
+ * Return RTW_HAL_STATUS_SUCCESS when setting is ok, otherwise fail.
+ */
+enum rtw_hal_status
+rtw_hal_mac_set_rxfltr_subtype_all(struct rtw_hal_com_t *hal_com, u8 band,
+				   u8 type, u8 *target)
+{
+	struct hal_info_t *hal_info = hal_com->hal_priv;
+	struct mac_ax_adapter *mac = hal_to_mac(hal_info);
+	struct mac_ax_rx_fltr_elem elem = {0};
+	enum mac_ax_pkt_t ftype;
+	u32 err;
+	u8 i;
+
+	switch (type) {
+	case 0:
+		ftype = MAC_AX_PKT_MGNT;
+		break;
+	case 1:
+		ftype = MAC_AX_PKT_CTRL;
+		break;
+	case 2:
+		ftype = MAC_AX_PKT_DATA;
+		break;
+	default:
+		return RTW_HAL_STATUS_FAILURE;
+	}
+
+	for (i = 0; i < 16; i++) {
+		if (target[i] > MAC_AX_FWD_TO_WLAN_CPU)
+			return RTW_HAL_STATUS_FAILURE;
+		elem.target_arr[i] = (enum mac_ax_fwd_target)target[i];
+	}
+	elem.subtype_mask = 0xFFFF;
+
+	err = mac->ops->set_typsbtyp_fltr_detail(mac, ftype, &elem, band);
+	if (err)
+		return RTW_HAL_STATUS_FAILURE;
+	return RTW_HAL_STATUS_SUCCESS;
+}
+
 enum rtw_hal_status
 rtw_hal_mac_enable_bb_rf(struct hal_info_t *hal_info, u8 enable)
 {
@@ -9115,4 +9241,335 @@ rtw_hal_mac_stop_tx_duty(struct hal_info_t *hal_info)
 	}
 
 	return hal_status;
-}
\ No newline at end of file
+}
+
+#ifdef CONFIG_PHL_DLE_REBAL
+enum rtw_hal_status
+rtw_hal_mac_get_dle_occup(struct hal_info_t *hal_info,
+			  struct rtw_dle_rebal_info *info)
+{
+	struct mac_ax_adapter *mac = hal_to_mac(hal_info);
+	struct mac_ax_dle_occup occup = {0};
+
+	if (mac->ops->get_dle_occup(mac, &occup) != MACSUCCESS)
+		return RTW_HAL_STATUS_FAILURE;
+
+	info->prof = occup.prof;
+	info->tx_use = occup.tx_use;
+	info->tx_max = occup.tx_max;
+	info->rx_use = occup.rx_use;
+	info->rx_max = occup.rx_max;
+	info->pub_pgnum = occup.pub_pgnum;
+
+	return RTW_HAL_STATUS_SUCCESS;
+}
+
+enum rtw_hal_status
+rtw_hal_mac_set_dle_rebal(struct hal_info_t *hal_info,
+			  enum rtw_dle_rebal_prof prof)
+{
+	struct mac_ax_adapter *mac = hal_to_mac(hal_info);
+	u32 mac_status;
+
+	mac_status = mac->ops->set_dle_rebal(mac,
+					     (enum mac_ax_dle_rebal_prof)prof);
+	if (mac_status != MACSUCCESS) {
+		PHL_TRACE(COMP_PHL_DBG, _PHL_INFO_, "%s() : fail, status = %d.\n",
+			  __func__, mac_status);
+		return RTW_HAL_STATUS_FAILURE;
+	}
+
+	return RTW_HAL_STATUS_SUCCESS;
+}
+
+enum rtw_hal_status hal_dle_rebal_init(struct hal_info_t *hal_info)
+{
+	void *drv_priv = hal_to_drvpriv(hal_info);
+	struct hal_dle_rebal *rebal = NULL;
+
+	rebal = _os_mem_alloc(drv_priv, sizeof(*rebal));
+	if (NULL == rebal) {
+		PHL_ERR("%s: alloc dle rebal failed\n", __func__);
+		return RTW_HAL_STATUS_RESOURCE;
+	}
+	_os_mem_set(drv_priv, rebal, 0, sizeof(*rebal));
+	rebal->info.en = true;
+	hal_info->dle_rebal = rebal;
+
+	return RTW_HAL_STATUS_SUCCESS;
+}
+
+void hal_dle_rebal_deinit(struct hal_info_t *hal_info)
+{
+	void *drv_priv = hal_to_drvpriv(hal_info);
+
+	if (NULL == hal_info->dle_rebal)
+		return;
+
+	_os_mem_free(drv_priv, hal_info->dle_rebal,
+		     sizeof(struct hal_dle_rebal));
+	hal_info->dle_rebal = NULL;
+}
+
+/*
+ * High watermark of a side is a pressure vote, both sides under the low
+ * watermark vote for the table quota, anything in between keeps the
+ * profile in effect.
+ */
+static u8 _hal_dle_rebal_vote(struct rtw_dle_rebal_info *info, u32 rdu_delta)
+{
+	u32 tx_pct = 0, rx_pct = 0;
+	bool tx_press, rx_press;
+
+	if (info->tx_max)
+		tx_pct = info->tx_use * 100 / info->tx_max;
+	if (info->rx_max)
+		rx_pct = info->rx_use * 100 / info->rx_max;
+
+	tx_press = (tx_pct >= HAL_DLE_REBAL_HIGH_PCT);
+	rx_press = (rx_pct >= HAL_DLE_REBAL_HIGH_PCT || rdu_delta);
+
+	if (tx_press && !rx_press)
+		return DLE_REBAL_PROF_TX_HEAVY;
+	if (rx_press && !tx_press)
+		return DLE_REBAL_PROF_RX_HEAVY;
+	if (tx_pct < HAL_DLE_REBAL_LOW_PCT && rx_pct < HAL_DLE_REBAL_LOW_PCT)
+		return DLE_REBAL_PROF_BALANCED;
+
+	return info->prof;
+}
+
+void hal_dle_rebal_watchdog(struct hal_info_t *hal_info)
+{
+	struct hal_dle_rebal *rebal = hal_info->dle_rebal;
+	struct rtw_dle_rebal_info *info = NULL;
+	u32 rdu_delta = 0;
+	u8 vote;
+
+	if (NULL == rebal || !rebal->info.en)
+		return;
+	info = &rebal->info;
+
+	if (RTW_HAL_STATUS_SUCCESS != rtw_hal_mac_get_dle_occup(hal_info, info)) {
+		info->fail_cnt++;
+		return;
+	}
+	info->sample_cnt++;
+
+#ifdef CONFIG_PCI_HCI
+	info->rdu_cnt = hal_info->hal_com->trx_stat.rx_rdu_cnt;
+	rdu_delta = info->rdu_cnt - rebal->last_rdu;
+	rebal->last_rdu = info->rdu_cnt;
+#endif
+
+	vote = _hal_dle_rebal_vote(info, rdu_delta);
+	if (vote == info->prof) {
+		rebal->cand_cnt = 0;
+		return;
+	}
+
+	if (vote != rebal->cand) {
+		rebal->cand = vote;
+		rebal->cand_cnt = 0;
+	}
+	if (++rebal->cand_cnt < HAL_DLE_REBAL_HOLD_CNT)
+		return;
+	if (rebal->chg_t &&
+	    phl_get_passing_time_ms(rebal->chg_t) < HAL_DLE_REBAL_DWELL_MS)
+		return;
+
+	if (RTW_HAL_STATUS_SUCCESS != rtw_hal_mac_set_dle_rebal(hal_info, vote)) {
+		info->fail_cnt++;
+		return;
+	}
+
+	PHL_INFO("%s: prof %d -> %d, tx %d/%d, rx %d/%d, pub %d\n", __func__,
+		 info->prof, vote, info->tx_use, info->tx_max,
+		 info->rx_use, info->rx_max, info->pub_pgnum);
+	info->prof = vote;
+	info->chg_cnt[vote]++;
+	rebal->cand_cnt = 0;
+	rebal->chg_t = _os_get_cur_time_ms();
+	if (!rebal->chg_t)
+		rebal->chg_t = 1;
+}
+
+void rtw_hal_dle_rebal_set_en(void *hal, bool en)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+	struct hal_dle_rebal *rebal = hal_info->dle_rebal;
+
+	if (NULL == rebal || rebal->info.en == en)
+		return;
+
+	rebal->info.en = en;
+	rebal->cand_cnt = 0;
+	if (!en &&
+	    RTW_HAL_STATUS_SUCCESS ==
+	    rtw_hal_mac_set_dle_rebal(hal_info, DLE_REBAL_PROF_BALANCED))
+		rebal->info.prof = DLE_REBAL_PROF_BALANCED;
+}
+
+enum rtw_hal_status
+rtw_hal_dle_rebal_set_prof(void *hal, enum rtw_dle_rebal_prof prof)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+	struct hal_dle_rebal *rebal = hal_info->dle_rebal;
+	enum rtw_hal_status hstatus;
+
+	if (NULL == rebal || prof >= DLE_REBAL_PROF_MAX)
+		return RTW_HAL_STATUS_FAILURE;
+
+	hstatus = rtw_hal_mac_set_dle_rebal(hal_info, prof);
+	if (RTW_HAL_STATUS_SUCCESS == hstatus) {
+		rebal->info.prof = (u8)prof;
+		rebal->info.chg_cnt[prof]++;
+		rebal->cand_cnt = 0;
+	}
+
+	return hstatus;
+}
+
+void rtw_hal_dle_rebal_get_info(void *hal, struct rtw_dle_rebal_info *info)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+	struct hal_dle_rebal *rebal = hal_info->dle_rebal;
+
+	if (NULL == rebal)
+		return;
+
+	_os_mem_cpy(hal_to_drvpriv(hal_info), info, &rebal->info,
+		    sizeof(*info));
+}
+#endif /* CONFIG_PHL_DLE_REBAL */
+
+#ifdef CONFIG_PHL_H2C_COAL
+enum rtw_hal_status
+rtw_hal_mac_h2c_coal_cfg(struct hal_info_t *hal_info,
+			 struct rtw_h2c_coal_cfg *cfg)
+{
+	struct mac_ax_adapter *mac = hal_to_mac(hal_info);
+	struct mac_ax_h2c_coal_cfg mcfg = {0};
+	u32 mac_status;
+
+	mcfg.en = cfg->en;
+	mcfg.cls_map = cfg->cls_map;
+	mcfg.max_pkt = cfg->max_pkt;
+	mcfg.deadline_us = cfg->deadline_us;
+
+	mac_status = mac->ops->h2c_coal_cfg(mac, &mcfg);
+	if (mac_status != MACSUCCESS) {
+		PHL_TRACE(COMP_PHL_DBG, _PHL_INFO_, "%s() : fail, status = %d.\n",
+			  __func__, mac_status);
+		return RTW_HAL_STATUS_FAILURE;
+	}
+
+	return RTW_HAL_STATUS_SUCCESS;
+}
+
+enum rtw_hal_status
+rtw_hal_mac_get_h2c_coal_stat(struct hal_info_t *hal_info,
+			      struct rtw_h2c_coal_stat *stat, u8 rst)
+{
+	struct mac_ax_adapter *mac = hal_to_mac(hal_info);
+	struct mac_ax_h2c_coal_stat mstat = {0};
+	u8 i;
+
+	if (mac->ops->get_h2c_coal_stat(mac, &mstat, rst) != MACSUCCESS)
+		return RTW_HAL_STATUS_FAILURE;
+
+	for (i = 0; i < H2C_COAL_TRIG_MAX; i++)
+		stat->flush_cnt[i] = mstat.flush_cnt[i];
+	for (i = 0; i < H2C_COAL_BATCH_BIN; i++)
+		stat->batch_bin[i] = mstat.batch_bin[i];
+	stat->tx_cnt = mstat.tx_cnt;
+	for (i = 0; i < H2C_COAL_CLS_MAX; i++) {
+		stat->pkt_cnt[i] = mstat.cls[i].pkt_cnt;
+		stat->lat_sum_us[i] = mstat.cls[i].lat_sum_us;
+		stat->lat_max_us[i] = mstat.cls[i].lat_max_us;
+	}
+
+	return RTW_HAL_STATUS_SUCCESS;
+}
+
+enum rtw_hal_status hal_h2c_coal_init(struct hal_info_t *hal_info)
+{
+	struct rtw_h2c_coal_cfg cfg = {0};
+
+	cfg.en = true;
+	cfg.cls_map = BIT(H2C_COAL_CLS_RA) | BIT(H2C_COAL_CLS_CAM) |
+		      BIT(H2C_COAL_CLS_ROLE) | BIT(H2C_COAL_CLS_STATS);
+	cfg.max_pkt = HAL_H2C_COAL_DEF_MAX_PKT;
+	cfg.deadline_us = HAL_H2C_COAL_DEF_DEADLINE_US;
+
+	return rtw_hal_mac_h2c_coal_cfg(hal_info, &cfg);
+}
+
+void hal_h2c_coal_deinit(struct hal_info_t *hal_info)
+{
+	struct mac_ax_adapter *mac = hal_to_mac(hal_info);
+
+	/* drop anything still queued, it is not going to reach the fw */
+	mac->ops->h2c_agg_flush(mac);
+}
+
+/*
+ * H2C of the coalesced classes issued while any window is open are queued
+ * and go out aggregated on the size or deadline trigger, before the next
+ * h2c that is not coalesced, or when the last open window is left.
+ */
+void hal_h2c_coal_enter(struct hal_info_t *hal_info, u32 token)
+{
+	struct mac_ax_adapter *mac = hal_to_mac(hal_info);
+
+	mac->ops->h2c_coal_win(mac, token, true);
+}
+
+void hal_h2c_coal_leave(struct hal_info_t *hal_info, u32 token)
+{
+	struct mac_ax_adapter *mac = hal_to_mac(hal_info);
+
+	mac->ops->h2c_coal_win(mac, token, false);
+}
+
+/* watchdog backstop for the deadline of a window left open too long */
+void hal_h2c_coal_expire(struct hal_info_t *hal_info)
+{
+	struct mac_ax_adapter *mac = hal_to_mac(hal_info);
+
+	mac->ops->h2c_coal_expire(mac);
+}
+
+enum rtw_hal_status
+rtw_hal_h2c_coal_set_cfg(void *hal, struct rtw_h2c_coal_cfg *cfg)
+{
+	return rtw_hal_mac_h2c_coal_cfg((struct hal_info_t *)hal, cfg);
+}
+
+void rtw_hal_h2c_coal_get_cfg(void *hal, struct rtw_h2c_coal_cfg *cfg)
+{
+	struct mac_ax_adapter *mac = hal_to_mac((struct hal_info_t *)hal);
+	struct mac_ax_h2c_coal_cfg *mcfg = &mac->h2c_agg_info.coal_cfg;
+
+	cfg->en = mcfg->en;
+	cfg->cls_map = mcfg->cls_map;
+	cfg->max_pkt = mcfg->max_pkt;
+	cfg->deadline_us = mcfg->deadline_us;
+}
+
+enum rtw_hal_status
+rtw_hal_h2c_coal_get_stat(void *hal, struct rtw_h2c_coal_stat *stat, u8 rst)
+{
+	return rtw_hal_mac_get_h2c_coal_stat((struct hal_info_t *)hal, stat, rst);
+}
+
+void rtw_hal_h2c_coal_begin(void *hal, u32 token)
+{
+	hal_h2c_coal_enter((struct hal_info_t *)hal, token);
+}
+
+void rtw_hal_h2c_coal_end(void *hal, u32 token)
+{
+	hal_h2c_coal_leave((struct hal_info_t *)hal, token);
+}
+#endif /* CONFIG_PHL_H2C_COAL */
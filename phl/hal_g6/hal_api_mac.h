@@ -19,6 +19,7 @@
 
 #define POLLING_HALMAC_TIME 5
 #define POLLING_HALMAC_CNT 100
+#define HAL_HW_AMSDU_MAX_NUM MAC_AX_AMSDU_AGG_NUM_4
 
 #define hal_to_mac(_halinfo)	((struct mac_ax_adapter *)((_halinfo)->mac))
 
@@ -371,6 +372,13 @@ rtw_hal_mac_ax_parse_ppdu_sts(void *hal, u8 mac_valid, u8 *buf, u16 buf_l,
 enum rtw_hal_status
 rtw_hal_hdr_conv_cfg(struct hal_info_t *hal_info, u8 en_hdr_conv);
 enum rtw_hal_status
+rtw_hal_mac_upd_shcut_mhdr(struct hal_info_t *hal_info, u16 macid,
+			   u8 *hdr, u8 hdr_len);
+#ifdef CONFIG_PHL_CSUM_OFFLOAD_RX
+void rtw_hal_mac_parse_rx_chksum(struct hal_info_t *hal_info, u8 status,
+				 struct rtw_r_meta_data *meta);
+#endif
+enum rtw_hal_status
 rtw_hal_mac_enable_bb_rf(struct hal_info_t *hal_info, u8 enable);
 
 #ifdef RTW_PHL_BCN
@@ -441,6 +449,9 @@ rtw_hal_mac_set_rxfltr_by_type(struct rtw_hal_com_t *hal_com, u8 band,
 enum rtw_hal_status
 rtw_hal_mac_set_rxfltr_by_subtype(struct rtw_hal_com_t *hal_com, u8 band,
 				  u8 type, u8 subtype, u8 target);
+enum rtw_hal_status
+rtw_hal_mac_set_rxfltr_subtype_all(struct rtw_hal_com_t *hal_com, u8 band,
+				   u8 type, u8 *target);
 
 enum rtw_hal_status
 rtw_hal_mac_fw_log_cfg(struct rtw_hal_com_t *hal_com,
@@ -681,4 +692,65 @@ rtw_hal_mac_set_tx_duty(struct hal_info_t *hal_info,
 
 enum rtw_hal_status
 rtw_hal_mac_stop_tx_duty(struct hal_info_t *hal_info);
+
+#ifdef CONFIG_PHL_DLE_REBAL
+/* occupancy watermarks in percent of the max quota in effect */
+#define HAL_DLE_REBAL_HIGH_PCT 80
+#define HAL_DLE_REBAL_LOW_PCT 40
+/* consecutive watchdog votes before a profile change */
+#define HAL_DLE_REBAL_HOLD_CNT 3
+/* min time between two profile changes */
+#define HAL_DLE_REBAL_DWELL_MS 10000
+
+/**
+ * struct hal_dle_rebal - watchdog driven PLE tx/rx quota rebalancer
+ * @cand: profile voted by the last samples, @cand_cnt votes in a row
+ * @chg_t: time of the last profile change, 0 before the first one
+ * @last_rdu: rx_rdu_cnt at the previous sample
+ */
+struct hal_dle_rebal {
+	struct rtw_dle_rebal_info info;
+	u8 cand;
+	u8 cand_cnt;
+	u32 chg_t;
+	u32 last_rdu;
+};
+
+enum rtw_hal_status
+rtw_hal_mac_get_dle_occup(struct hal_info_t *hal_info,
+			  struct rtw_dle_rebal_info *info);
+enum rtw_hal_status
+rtw_hal_mac_set_dle_rebal(struct hal_info_t *hal_info,
+			  enum rtw_dle_rebal_prof prof);
+enum rtw_hal_status hal_dle_rebal_init(struct hal_info_t *hal_info);
+void hal_dle_rebal_deinit(struct hal_info_t *hal_info);
+void hal_dle_rebal_watchdog(struct hal_info_t *hal_info);
+#else
+#define hal_dle_rebal_init(_hal) RTW_HAL_STATUS_SUCCESS
+#define hal_dle_rebal_deinit(_hal)
+#define hal_dle_rebal_watchdog(_hal)
+#endif /* CONFIG_PHL_DLE_REBAL */
+
+#ifdef CONFIG_PHL_H2C_COAL
+#define HAL_H2C_COAL_DEF_MAX_PKT 16
+#define HAL_H2C_COAL_DEF_DEADLINE_US 2000
+
+enum rtw_hal_status
+rtw_hal_mac_h2c_coal_cfg(struct hal_info_t *hal_info,
+			 struct rtw_h2c_coal_cfg *cfg);
+enum rtw_hal_status
+rtw_hal_mac_get_h2c_coal_stat(struct hal_info_t *hal_info,
+			      struct rtw_h2c_coal_stat *stat, u8 rst);
+enum rtw_hal_status hal_h2c_coal_init(struct hal_info_t *hal_info);
+void hal_h2c_coal_deinit(struct hal_info_t *hal_info);
+void hal_h2c_coal_enter(struct hal_info_t *hal_info, u32 token);
+void hal_h2c_coal_leave(struct hal_info_t *hal_info, u32 token);
+void hal_h2c_coal_expire(struct hal_info_t *hal_info);
+#else
+#define hal_h2c_coal_init(_hal) RTW_HAL_STATUS_SUCCESS
+#define hal_h2c_coal_deinit(_hal)
+#define hal_h2c_coal_enter(_hal, _token)
+#define hal_h2c_coal_leave(_hal, _token)
+#define hal_h2c_coal_expire(_hal)
+#endif /* CONFIG_PHL_H2C_COAL */
 #endif /*_HAL_API_MAC_H_*/
@@ -304,6 +304,24 @@ enum rtw_hal_status rtw_hal_rf_chl_rfk_trigger(void *hal,
 	return hal_status;
 }
 
+#ifdef CONFIG_PHL_RFK_CACHE
+void rtw_hal_rf_rfk_cache_cfg(void *hal, u8 en, u8 ther_th)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+
+	halrf_rfk_cache_cfg(hal_info->rf, en ? true : false, ther_th);
+}
+
+u8 rtw_hal_rf_rfk_cache_get_stat(void *hal, struct rtw_rfk_cache_stat *stat,
+				 u8 *ther_th, u8 rst)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+
+	return halrf_rfk_cache_get_stat(hal_info->rf, stat, ther_th,
+					rst ? true : false);
+}
+#endif
+
 enum rtw_hal_status rtw_hal_rf_dack_trigger(struct hal_info_t *hal_info,
 						u8 force)
 {
@@ -600,6 +618,8 @@ rtw_hal_rf_set_power(struct hal_info_t *hal_info, enum phl_phy_idx phy,
 {
 	enum rtw_hal_status hal_status = RTW_HAL_STATUS_FAILURE;
 
+	/* table load, rmw of the tx power CRs combine into one write each */
+	hal_io_wc_begin(hal_info->hal_com);
 	if(halrf_set_power(hal_info->rf, phy, pwr_table))
 	{
 		hal_status = RTW_HAL_STATUS_SUCCESS;
@@ -608,6 +628,7 @@ rtw_hal_rf_set_power(struct hal_info_t *hal_info, enum phl_phy_idx phy,
 	{
 		hal_status = RTW_HAL_STATUS_FAILURE;
 	}
+	hal_io_wc_end(hal_info->hal_com);
 
 	return hal_status;
 }
@@ -987,6 +1008,18 @@ rtw_hal_rf_chl_rfk_trigger(void *hal, u8 phy_idx, u8 force)
 	return RTW_HAL_STATUS_SUCCESS;
 }
 
+#ifdef CONFIG_PHL_RFK_CACHE
+void rtw_hal_rf_rfk_cache_cfg(void *hal, u8 en, u8 ther_th)
+{
+}
+
+u8 rtw_hal_rf_rfk_cache_get_stat(void *hal, struct rtw_rfk_cache_stat *stat,
+				 u8 *ther_th, u8 rst)
+{
+	return false;
+}
+#endif
+
 enum rtw_hal_status rtw_hal_rf_dack_trigger(struct hal_info_t *hal_info,
 						u8 force)
 {
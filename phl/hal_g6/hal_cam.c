@@ -51,6 +51,8 @@ rtw_hal_set_key(void *hal, struct rtw_phl_stainfo_t *sta, u8 type, u8 ext_key, u
 					spp, keyid, keytype, keybuf);
 		}
 	}
+	/* sec_type/sec_cam_idx of cached wd templates follow the key */
+	hal_wd_tmpl_invalidate(hal_info, sta->macid);
 
 	return hal_status;
 }
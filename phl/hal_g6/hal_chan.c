@@ -36,6 +36,288 @@ rtw_hal_radar_detect_cfg(void *hal, bool dfs_enable)
 }
 #endif /*CONFIG_PHL_DFS*/
 
+#ifdef CONFIG_PHL_FAST_CHSW
+enum rtw_hal_status hal_chsw_init(struct hal_info_t *hal_info)
+{
+	void *drv_priv = hal_to_drvpriv(hal_info);
+	struct hal_chsw *chsw = NULL;
+
+	chsw = _os_mem_alloc(drv_priv, sizeof(*chsw));
+	if (NULL == chsw) {
+		PHL_ERR("%s: alloc chsw failed\n", __func__);
+		return RTW_HAL_STATUS_RESOURCE;
+	}
+	_os_mem_set(drv_priv, chsw, 0, sizeof(*chsw));
+	chsw->en = true;
+	hal_info->chsw = chsw;
+
+	return RTW_HAL_STATUS_SUCCESS;
+}
+
+void hal_chsw_deinit(struct hal_info_t *hal_info)
+{
+	void *drv_priv = hal_to_drvpriv(hal_info);
+
+	if (NULL == hal_info->chsw)
+		return;
+
+	_os_mem_free(drv_priv, hal_info->chsw, sizeof(struct hal_chsw));
+	hal_info->chsw = NULL;
+}
+
+/*
+ * Drop the cached power tables and force the next switch of every band
+ * through the full sequence. Called whenever the tx power limit inputs
+ * change or the mac may have lost its bandwidth config.
+ */
+void hal_chsw_inval(struct hal_info_t *hal_info)
+{
+	struct hal_chsw *chsw = hal_info->chsw;
+
+	if (NULL == chsw)
+		return;
+
+	_os_mem_set(hal_to_drvpriv(hal_info), chsw->synced, 0,
+		    sizeof(chsw->synced));
+	_os_mem_set(hal_to_drvpriv(hal_info), chsw->pwr, 0, sizeof(chsw->pwr));
+	chsw->stat.inval++;
+}
+
+void rtw_hal_chsw_cfg(void *hal, u8 en)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+	struct hal_chsw *chsw = hal_info->chsw;
+
+	if (NULL == chsw)
+		return;
+
+	if (chsw->en != en)
+		hal_chsw_inval(hal_info);
+	chsw->en = en;
+}
+
+u8 rtw_hal_chsw_get_stat(void *hal, struct rtw_chsw_stat *stat, u8 rst)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+	struct hal_chsw *chsw = hal_info->chsw;
+	void *drv = hal_to_drvpriv(hal_info);
+
+	if (NULL == chsw)
+		return false;
+
+	_os_mem_cpy(drv, stat, &chsw->stat, sizeof(*stat));
+	if (rst)
+		_os_mem_set(drv, &chsw->stat, 0, sizeof(chsw->stat));
+
+	return chsw->en;
+}
+
+/* a failed switch leaves the band in an unknown state, next one goes full */
+static void _hal_chsw_unsync(struct hal_info_t *hal_info, u8 band_idx)
+{
+	struct hal_chsw *chsw = hal_info->chsw;
+
+	if (NULL == chsw)
+		return;
+
+	chsw->synced[band_idx] = false;
+}
+
+static bool _hal_chsw_is_fast(struct hal_info_t *hal_info, u8 band_idx,
+			      struct rtw_chan_def *chdef)
+{
+	struct hal_chsw *chsw = hal_info->chsw;
+	struct rtw_chan_def *cur = &hal_info->hal_com->band[band_idx].cur_chandef;
+
+	if (NULL == chsw || !chsw->en || !chsw->synced[band_idx])
+		return false;
+
+	return (chdef->band == cur->band && chdef->bw == cur->bw);
+}
+
+/* mac bw config only depends on band, bw and the primary channel position */
+static bool _hal_chsw_mac_keep(struct hal_info_t *hal_info, u8 band_idx,
+			       struct rtw_chan_def *chdef, u8 center_ch)
+{
+	struct hal_chsw *chsw = hal_info->chsw;
+
+	if (chsw->pri_ofst[band_idx] != (s8)(chdef->chan - center_ch))
+		return false;
+
+	chsw->stat.mac_skip++;
+	return true;
+}
+
+/*
+ * Band and bandwidth are kept, only the channel dependent BB/RF settings
+ * change. TX is paused and radar/TSSI tracking is held over the retune;
+ * ppdu status, ADC and the BB reset pulse of rtw_hal_reset() are left
+ * alone since bb set_ch_bw resets the BB on its own.
+ */
+static enum rtw_hal_status
+_hal_chsw_hold(struct rtw_hal_com_t *hal_com, enum phl_phy_idx phy_idx,
+	       u8 band_idx, bool hold)
+{
+	struct hal_info_t *hal_info = hal_com->hal_priv;
+	enum rtw_hal_status status = RTW_HAL_STATUS_SUCCESS;
+
+	if (hold) {
+		status = rtw_hal_tx_pause(hal_com, band_idx, true, PAUSE_RSON_RESET);
+		if (status != RTW_HAL_STATUS_SUCCESS)
+			return status;
+	}
+
+	rtw_hal_bb_dfs_en(hal_info, !hold);
+	if (!hal_com->dbcc_en) {
+		rtw_hal_bb_tssi_cont_en(hal_info, !hold, RF_PATH_A);
+		rtw_hal_bb_tssi_cont_en(hal_info, !hold, RF_PATH_B);
+	} else if (phy_idx == HW_PHY_0) {
+		rtw_hal_bb_tssi_cont_en(hal_info, !hold, RF_PATH_A);
+	} else {
+		rtw_hal_bb_tssi_cont_en(hal_info, !hold, RF_PATH_B);
+	}
+
+	if (!hold)
+		status = rtw_hal_tx_pause(hal_com, band_idx, false, PAUSE_RSON_RESET);
+
+	return status;
+}
+
+static struct hal_chsw_pwr_ent *
+_hal_chsw_pwr_lookup(struct hal_chsw *chsw, u8 band_idx,
+		     struct rtw_chan_def *cur)
+{
+	struct hal_chsw_pwr_ent *ent = NULL;
+	u8 i;
+
+	for (i = 0; i < HAL_CHSW_PWR_CACHE_NUM; i++) {
+		ent = &chsw->pwr[band_idx][i];
+		if (ent->valid && ent->band == cur->band &&
+		    ent->center_ch == cur->center_ch && ent->bw == cur->bw)
+			return ent;
+	}
+
+	return NULL;
+}
+
+/*
+ * Tx shape is only reprogrammed by the power table load on a band or
+ * regulation change, except for cck on channel 14, so a cached table is
+ * only valid as long as channel 14 is not entered or left.
+ */
+static bool _hal_chsw_pwr_load(struct hal_info_t *hal_info, u8 band_idx,
+			       u8 prev_center_ch)
+{
+	struct hal_chsw *chsw = hal_info->chsw;
+	struct rtw_hal_com_t *hal_com = hal_info->hal_com;
+	struct rtw_chan_def *cur = &hal_com->band[band_idx].cur_chandef;
+	struct rtw_tpu_info *tpu = &hal_com->band[band_idx].rtw_tpu_i;
+	struct hal_chsw_pwr_ent *ent = NULL;
+	enum rtw_hal_status status = RTW_HAL_STATUS_SUCCESS;
+
+	if (tpu->normal_mode_lock_en ||
+	    (cur->band == BAND_ON_24G &&
+	     (prev_center_ch == 14 || cur->center_ch == 14)))
+		return false;
+
+	ent = _hal_chsw_pwr_lookup(chsw, band_idx, cur);
+	if (NULL == ent) {
+		chsw->stat.pwr_miss++;
+		return false;
+	}
+
+	_os_mem_cpy(hal_com->drv_priv, &tpu->rtw_tpu_pwr_imt_i, &ent->lmt,
+		    sizeof(ent->lmt));
+	_os_mem_cpy(hal_com->drv_priv, tpu->pwr_lmt_ru, ent->lmt_ru,
+		    sizeof(ent->lmt_ru));
+	ent->last_use = ++chsw->tick;
+
+	/* with the io shadow only registers that differ reach the bus */
+	hal_io_wc_begin(hal_com);
+	status = rtw_hal_mac_write_pwr_limit_reg(hal_com, band_idx);
+	if (status == RTW_HAL_STATUS_SUCCESS)
+		status = rtw_hal_mac_write_pwr_limit_rua_reg(hal_com, band_idx);
+	hal_io_wc_end(hal_com);
+
+	if (status != RTW_HAL_STATUS_SUCCESS) {
+		ent->valid = false;
+		return false;
+	}
+
+	chsw->stat.pwr_hit++;
+	return true;
+}
+
+static void _hal_chsw_pwr_store(struct hal_info_t *hal_info, u8 band_idx)
+{
+	struct hal_chsw *chsw = hal_info->chsw;
+	struct rtw_hal_com_t *hal_com = hal_info->hal_com;
+	struct rtw_chan_def *cur = &hal_com->band[band_idx].cur_chandef;
+	struct rtw_tpu_info *tpu = &hal_com->band[band_idx].rtw_tpu_i;
+	struct hal_chsw_pwr_ent *ent = NULL;
+	u8 i;
+
+	if (NULL == chsw || !chsw->en || tpu->normal_mode_lock_en)
+		return;
+
+	ent = _hal_chsw_pwr_lookup(chsw, band_idx, cur);
+	if (NULL == ent) {
+		/* free slot first, least recently used one otherwise */
+		ent = &chsw->pwr[band_idx][0];
+		for (i = 1; i < HAL_CHSW_PWR_CACHE_NUM && ent->valid; i++) {
+			if (!chsw->pwr[band_idx][i].valid ||
+			    chsw->pwr[band_idx][i].last_use < ent->last_use)
+				ent = &chsw->pwr[band_idx][i];
+		}
+	}
+
+	_os_mem_cpy(hal_com->drv_priv, &ent->lmt, &tpu->rtw_tpu_pwr_imt_i,
+		    sizeof(ent->lmt));
+	_os_mem_cpy(hal_com->drv_priv, ent->lmt_ru, tpu->pwr_lmt_ru,
+		    sizeof(ent->lmt_ru));
+	ent->band = cur->band;
+	ent->center_ch = cur->center_ch;
+	ent->bw = cur->bw;
+	ent->last_use = ++chsw->tick;
+	ent->valid = true;
+}
+
+static void _hal_chsw_done(struct hal_info_t *hal_info, u8 band_idx,
+			   struct rtw_chan_def *chdef, u8 center_ch,
+			   bool fast, bool synced, u32 start_t)
+{
+	struct hal_chsw *chsw = hal_info->chsw;
+	u32 us = phl_get_passing_time_us(start_t);
+
+	if (NULL == chsw)
+		return;
+
+	chsw->synced[band_idx] = synced;
+	chsw->pri_ofst[band_idx] = (s8)(chdef->chan - center_ch);
+
+	if (fast) {
+		chsw->stat.fast++;
+		chsw->stat.fast_us_sum += us;
+		if (us > chsw->stat.fast_us_max)
+			chsw->stat.fast_us_max = us;
+	} else {
+		chsw->stat.full++;
+		chsw->stat.full_us_sum += us;
+		if (us > chsw->stat.full_us_max)
+			chsw->stat.full_us_max = us;
+	}
+}
+#else
+#define _hal_chsw_unsync(_hal, _band)
+#define _hal_chsw_is_fast(_hal, _band, _chdef) false
+#define _hal_chsw_mac_keep(_hal, _band, _chdef, _center_ch) false
+#define _hal_chsw_hold(_hal_com, _phy, _band, _hold) RTW_HAL_STATUS_SUCCESS
+#define _hal_chsw_pwr_load(_hal, _band, _prev_center_ch) false
+#define _hal_chsw_pwr_store(_hal, _band)
+#define _hal_chsw_done(_hal, _band, _chdef, _center_ch, _fast, _synced, _start_t) \
+	do { (void)(_synced); (void)(_start_t); } while (0)
+#endif /* CONFIG_PHL_FAST_CHSW */
+
 enum rtw_hal_status rtw_hal_set_ch_bw(void *hal, u8 band_idx,
 		struct rtw_chan_def *chdef, bool do_rfk)
 {
@@ -45,8 +327,12 @@ enum rtw_hal_status rtw_hal_set_ch_bw(void *hal, u8 band_idx,
 	enum rtw_hal_status status = RTW_HAL_STATUS_SUCCESS;
 	u8 center_ch = 0;
 	u8 central_ch_seg1 = 0;
+	u8 prev_center_ch = cur_chdef->center_ch;
 	enum band_type change_band;
 	enum phl_phy_idx phy_idx = HW_PHY_0;
+	bool fast = false;
+	bool synced = true;
+	u32 start_t = 0;
 
 	if ((chdef->chan != cur_chdef->chan) ||
 	    (chdef->bw != cur_chdef->bw) ||
@@ -54,10 +340,17 @@ enum rtw_hal_status rtw_hal_set_ch_bw(void *hal, u8 band_idx,
 		if (band_idx == 1)
 			phy_idx = HW_PHY_1;
 
-		status = rtw_hal_reset(hal_com, phy_idx, band_idx, true);
+		start_t = _os_get_cur_time_us();
+		/* band and bw kept, no need to go through the hal reset */
+		fast = _hal_chsw_is_fast(hal_info, band_idx, chdef);
+		if (fast)
+			status = _hal_chsw_hold(hal_com, phy_idx, band_idx, true);
+		else
+			status = rtw_hal_reset(hal_com, phy_idx, band_idx, true);
 		if(status != RTW_HAL_STATUS_SUCCESS) {
 			PHL_ERR("%s rtw_hal_reset en - failed\n", __func__);
 			_os_warn_on(1);
+			synced = false;
 		}
 		/* if central channel changed, reset BB & MAC */
 		center_ch = rtw_phl_get_center_ch(chdef->chan, chdef->bw, chdef->offset);
@@ -66,17 +359,22 @@ enum rtw_hal_status rtw_hal_set_ch_bw(void *hal, u8 band_idx,
 
 		change_band = chdef->band;
 
-		status = rtw_hal_mac_set_bw(hal_info, band_idx, chdef->chan,
-					      center_ch, central_ch_seg1, change_band,
-					      chdef->bw);
-		if(status != RTW_HAL_STATUS_SUCCESS) {
-			PHL_ERR("%s rtw_hal_mac_set_bw - failed\n", __func__);
-			return status;
+		if (!fast || !_hal_chsw_mac_keep(hal_info, band_idx, chdef,
+						     center_ch)) {
+			status = rtw_hal_mac_set_bw(hal_info, band_idx, chdef->chan,
+						      center_ch, central_ch_seg1,
+						      change_band, chdef->bw);
+			if(status != RTW_HAL_STATUS_SUCCESS) {
+				PHL_ERR("%s rtw_hal_mac_set_bw - failed\n", __func__);
+				_hal_chsw_unsync(hal_info, band_idx);
+				return status;
+			}
 		}
 
 
 		if(chdef->bw == CHANNEL_WIDTH_80_80 && central_ch_seg1 == 0) {
 			PHL_ERR("%s mising info for 80+80M configuration\n", __func__);
+			_hal_chsw_unsync(hal_info, band_idx);
 			return RTW_HAL_STATUS_FAILURE;
 		}
 		status = rtw_hal_bb_set_ch_bw(hal_info, phy_idx, chdef->chan,
@@ -84,6 +382,7 @@ enum rtw_hal_status rtw_hal_set_ch_bw(void *hal, u8 band_idx,
 					      chdef->bw);
 		if(status != RTW_HAL_STATUS_SUCCESS) {
 			PHL_ERR("%s rtw_hal_bb_set_ch_bw - failed\n", __func__);
+			_hal_chsw_unsync(hal_info, band_idx);
 			return status;
 		}
 
@@ -91,6 +390,7 @@ enum rtw_hal_status rtw_hal_set_ch_bw(void *hal, u8 band_idx,
 
 		if(status != RTW_HAL_STATUS_SUCCESS) {
 			PHL_ERR("%s rtw_hal_rf_set_ch_bw - failed\n", __func__);
+			_hal_chsw_unsync(hal_info, band_idx);
 			return status;
 		}
 
@@ -103,28 +403,41 @@ enum rtw_hal_status rtw_hal_set_ch_bw(void *hal, u8 band_idx,
 			rtw_hal_notify_switch_band(hal, change_band, phy_idx);
 		}
 
-		status = rtw_hal_rf_set_power(hal_info, phy_idx, PWR_LIMIT);
+		if (!fast || !_hal_chsw_pwr_load(hal_info, band_idx,
+						 prev_center_ch)) {
+			status = rtw_hal_rf_set_power(hal_info, phy_idx, PWR_LIMIT);
 
-		if(status != RTW_HAL_STATUS_SUCCESS) {
-			PHL_ERR("%s rtw_hal_rf_set_power - failed\n", __func__);
-			return status;
-		}
+			if(status != RTW_HAL_STATUS_SUCCESS) {
+				PHL_ERR("%s rtw_hal_rf_set_power - failed\n", __func__);
+				_hal_chsw_unsync(hal_info, band_idx);
+				return status;
+			}
 
-		status = rtw_hal_rf_set_power(hal_info, phy_idx, PWR_LIMIT_RU);
+			status = rtw_hal_rf_set_power(hal_info, phy_idx, PWR_LIMIT_RU);
 
-		if(status != RTW_HAL_STATUS_SUCCESS) {
-			PHL_ERR("%s rtw_hal_rf_set_power - failed\n", __func__);
-			return status;
+			if(status != RTW_HAL_STATUS_SUCCESS) {
+				PHL_ERR("%s rtw_hal_rf_set_power - failed\n", __func__);
+				_hal_chsw_unsync(hal_info, band_idx);
+				return status;
+			}
+			_hal_chsw_pwr_store(hal_info, band_idx);
 		}
 
-		PHL_INFO("%s band_idx:%d, ch:%d, bw:%d, offset:%d\n",
-			__func__, band_idx, chdef->chan, chdef->bw, chdef->offset);
+		PHL_INFO("%s band_idx:%d, ch:%d, bw:%d, offset:%d, fast:%d\n",
+			__func__, band_idx, chdef->chan, chdef->bw, chdef->offset,
+			fast);
 
-		status = rtw_hal_reset(hal_com, phy_idx, band_idx, false);
+		if (fast)
+			status = _hal_chsw_hold(hal_com, phy_idx, band_idx, false);
+		else
+			status = rtw_hal_reset(hal_com, phy_idx, band_idx, false);
 		if(status != RTW_HAL_STATUS_SUCCESS) {
 			PHL_ERR("%s rtw_hal_reset dis- failed\n", __func__);
 			_os_warn_on(1);
+			synced = false;
 		}
+		_hal_chsw_done(hal_info, band_idx, chdef, center_ch, fast, synced,
+			       start_t);
 
 		/*PHL_DUMP_CHAN_DEF_EX(chandef);*/
 	}
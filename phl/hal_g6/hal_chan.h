@@ -18,6 +18,44 @@
 enum rtw_hal_status rtw_hal_set_ch_bw(void *hal, u8 band_idx,
 		struct rtw_chan_def *chdef, bool do_rfk);
 
+#ifdef CONFIG_PHL_FAST_CHSW
+/* channels whose tx power limit tables are kept, per band */
+#define HAL_CHSW_PWR_CACHE_NUM 4
+
+struct hal_chsw_pwr_ent {
+	u8 valid;
+	u8 band;
+	u8 center_ch;
+	u8 bw;
+	u32 last_use;
+	struct rtw_tpu_pwr_imt_info lmt;
+	s8 lmt_ru[HAL_MAX_PATH][TPU_SIZE_RUA][TPU_SIZE_BW20_SC];
+};
+
+/**
+ * struct hal_chsw - fast channel switch state
+ * @synced: a full switch ran on the band since the last invalidation, the
+ *	mac bandwidth config matches cur_chandef
+ * @pri_ofst: primary minus center channel of the last switch, per band
+ * @tick: lru clock of @pwr
+ */
+struct hal_chsw {
+	u8 en;
+	u8 synced[MAX_BAND_NUM];
+	s8 pri_ofst[MAX_BAND_NUM];
+	u32 tick;
+	struct hal_chsw_pwr_ent pwr[MAX_BAND_NUM][HAL_CHSW_PWR_CACHE_NUM];
+	struct rtw_chsw_stat stat;
+};
+
+enum rtw_hal_status hal_chsw_init(struct hal_info_t *hal_info);
+void hal_chsw_deinit(struct hal_info_t *hal_info);
+void hal_chsw_inval(struct hal_info_t *hal_info);
+#else
+#define hal_chsw_init(_hal) RTW_HAL_STATUS_SUCCESS
+#define hal_chsw_deinit(_hal)
+#define hal_chsw_inval(_hal)
+#endif /* CONFIG_PHL_FAST_CHSW */
 
 #ifdef DBG_PHL_CHAN
 void phl_chan_dump_chandef(const char *caller, const int line, bool show_caller,
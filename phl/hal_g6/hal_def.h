@@ -402,11 +402,40 @@ struct hal_io_ops {
 #endif
 };
 
+#ifdef CONFIG_PHL_IO_SHADOW
+/* direct mapped, entries are tagged by address, power of 2 */
+#define HAL_IO_SHADOW_SIZE 256
+
+struct hal_io_shadow_ent {
+	u32 addr;
+	u32 val;
+	u8 valid;
+};
+
+/**
+ * struct hal_io_shadow - cache of registers only the host writes
+ * @wc_depth: nesting of write combining windows
+ * @wc_pend/@wc_addr: write held back in the window, its value is in the cache
+ */
+struct hal_io_shadow {
+	struct hal_io_shadow_ent ent[HAL_IO_SHADOW_SIZE];
+	struct rtw_io_shadow_stat stat;
+	_os_lock lock;
+	u8 en;
+	u8 wc_depth;
+	u8 wc_pend;
+	u32 wc_addr;
+};
+#endif
+
 struct hal_io_priv {
 	#ifdef CONFIG_SDIO_INDIRECT_ACCESS
 	_os_mutex sd_indirect_access_mutex;
 	#endif
 	struct hal_io_ops io_ops;
+	#ifdef CONFIG_PHL_IO_SHADOW
+	struct hal_io_shadow shadow;
+	#endif
 };
 
 #define halcom_to_drvpriv(_hcom) (_hcom->drv_priv)
@@ -750,6 +779,7 @@ struct rtw_trx_stat {
 #ifdef CONFIG_PCI_HCI
 	u32 ltr_tx_dly_count;
 	u32 ltr_last_tx_dly_time;
+	u32 rx_rdu_cnt;
 #endif
 	u16 rx_rate;
 	u8 rx_bw;
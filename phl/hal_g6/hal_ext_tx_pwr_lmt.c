@@ -26,6 +26,7 @@ rtw_hal_set_power_lmt(void *hal, u8 band_idx)
 	if (band_idx == 1)
 		phy_idx = HW_PHY_1;
 
+	hal_chsw_inval(hal_info);
 	status = rtw_hal_rf_set_power(hal_info, phy_idx, PWR_LIMIT);
 
 	return status;
@@ -41,6 +42,7 @@ rtw_hal_set_ext_pwr_lmt_en(void *hal,
 	PHL_INFO("%s: en(%d)\n", __func__, enable);
 
 	hal_com->ext_pwr_lmt_en = enable;
+	hal_chsw_inval(hal_info);
 }
 
 void
@@ -75,5 +77,6 @@ rtw_hal_enable_ext_pwr_lmt(void *hal, u8 hw_band,
 
 	/* enable external tx power limit mechanism */
 	hal_com->ext_pwr_lmt_en = true;
+	hal_chsw_inval(hal_info);
 }
 
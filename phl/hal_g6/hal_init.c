@@ -1003,12 +1003,57 @@ enum rtw_hal_status rtw_hal_init(void *drv_priv,
 	}
 #endif
 
+	hal_status = hal_wd_tmpl_init(hal_info);
+	if (hal_status != RTW_HAL_STATUS_SUCCESS){
+		PHL_ERR("hal_wd_tmpl_init failed\n");
+		goto error_wd_tmpl_init;
+	}
+
+	hal_status = hal_rx_cls_init(hal_info);
+	if (hal_status != RTW_HAL_STATUS_SUCCESS){
+		PHL_ERR("hal_rx_cls_init failed\n");
+		goto error_rx_cls_init;
+	}
+
+	hal_status = hal_dle_rebal_init(hal_info);
+	if (hal_status != RTW_HAL_STATUS_SUCCESS){
+		PHL_ERR("hal_dle_rebal_init failed\n");
+		goto error_dle_rebal_init;
+	}
+
+	hal_status = hal_h2c_coal_init(hal_info);
+	if (hal_status != RTW_HAL_STATUS_SUCCESS){
+		PHL_ERR("hal_h2c_coal_init failed\n");
+		goto error_h2c_coal_init;
+	}
+
+	hal_status = hal_chsw_init(hal_info);
+	if (hal_status != RTW_HAL_STATUS_SUCCESS){
+		PHL_ERR("hal_chsw_init failed\n");
+		goto error_chsw_init;
+	}
+
 	return RTW_HAL_STATUS_SUCCESS;
 
+error_chsw_init:
+	hal_h2c_coal_deinit(hal_info);
+
+error_h2c_coal_init:
+	hal_dle_rebal_deinit(hal_info);
+
+error_dle_rebal_init:
+	hal_rx_cls_deinit(hal_info);
+
+error_rx_cls_init:
+	hal_wd_tmpl_deinit(hal_info);
+
+error_wd_tmpl_init:
 #ifdef RTW_PHL_BCN
+	hal_bcn_deinit(hal_info);
+
 error_bcn_init:
-	rtw_hal_btc_deinit(phl_com, hal_info);
 #endif
+	rtw_hal_btc_deinit(phl_com, hal_info);
 
 error_btc_init:
 	rtw_hal_rf_deinit(phl_com, hal_info);
@@ -1060,6 +1105,11 @@ void rtw_hal_deinit(struct rtw_phl_com_t *phl_com, void *hal)
 		return;
 
 	/* stop mechanism / disassociate hal ops */
+	hal_chsw_deinit(hal_info);
+	hal_h2c_coal_deinit(hal_info);
+	hal_dle_rebal_deinit(hal_info);
+	hal_rx_cls_deinit(hal_info);
+	hal_wd_tmpl_deinit(hal_info);
 #ifdef RTW_PHL_BCN
 	hal_bcn_deinit(hal_info);
 #endif
@@ -1302,6 +1352,8 @@ enum rtw_hal_status rtw_hal_start(struct rtw_phl_com_t *phl_com, void *hal)
 		return hal_status;
 	}
 
+	hal_io_shadow_inval(hal_info->hal_com);
+	hal_chsw_inval(hal_info);
 	hal_status = hal_ops->hal_start(phl_com, hal_info);
 	if (hal_status != RTW_HAL_STATUS_SUCCESS)
 		return hal_status;
@@ -1350,6 +1402,8 @@ void rtw_hal_stop(struct rtw_phl_com_t *phl_com, void *hal)
 #endif
 		hal_status = hal_ops->hal_stop(phl_com, hal_info);
 		hal_info->hal_com->is_hal_init = false;
+		hal_io_shadow_inval(hal_info->hal_com);
+		hal_chsw_inval(hal_info);
 	} while (false);
 }
 
@@ -1367,6 +1421,8 @@ enum rtw_hal_status rtw_hal_restart(struct rtw_phl_com_t *phl_com, void *hal)
 	if (hal_status != RTW_HAL_STATUS_SUCCESS)
 		return hal_status;
 
+	hal_io_shadow_inval(hal_info->hal_com);
+	hal_chsw_inval(hal_info);
 	hal_status = hal_ops->hal_start(phl_com, hal_info);
 	if (hal_status != RTW_HAL_STATUS_SUCCESS)
 		return hal_status;
@@ -1459,6 +1515,9 @@ rtw_hal_watchdog(void *hal)
 	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
 	enum rtw_hal_status hal_status = RTW_HAL_STATUS_FAILURE;
 
+	hal_h2c_coal_expire(hal_info);
+	hal_h2c_coal_enter(hal_info, H2C_COAL_TOKEN(H2C_COAL_SEQ_WATCHDOG, 0));
+
 	hal_status = rtw_hal_bb_watchdog(hal_info, false);
 	if (hal_status != RTW_HAL_STATUS_SUCCESS) {
 		PHL_ERR("%s rtw_hal_bb_watchdog fail (%x)\n", __FUNCTION__, hal_status);
@@ -1477,7 +1536,10 @@ rtw_hal_watchdog(void *hal)
 		goto exit;
 	}
 
+	hal_dle_rebal_watchdog(hal_info);
+
 exit:
+	hal_h2c_coal_leave(hal_info, H2C_COAL_TOKEN(H2C_COAL_SEQ_WATCHDOG, 0));
 	return hal_status;
 }
 
@@ -36,6 +36,390 @@ Only sync read/rtw_write_mem operations are provided.
 #define _HAL_IO_C_
 #include "hal_headers.h"
 
+#if defined(DBG_IO) || defined(CONFIG_PHL_IO_SHADOW)
+#define RTW_IO_SNIFF_TYPE_RANGE	0 /* specific address range is accessed */
+#define RTW_IO_SNIFF_TYPE_VALUE	1 /* value match for sniffed range */
+
+struct rtw_io_sniff_ent {
+	u8 chip;
+	u8 hci;
+	u32 addr;
+	u8 type;
+	union {
+		u32 end_addr;
+		struct {
+			u32 mask;
+			u32 val;
+			bool equal;
+		} vm; /* value match */
+	} u;
+	bool trace;
+	char *tag;
+};
+
+#define RTW_IO_SNIFF_RANGE_ENT(_chip, _hci, _addr, _end_addr, _trace, _tag) \
+	{.chip = _chip, .hci = _hci, .addr = _addr, .u.end_addr = _end_addr, .trace = _trace, .tag = _tag, .type = RTW_IO_SNIFF_TYPE_RANGE,}
+
+#define RTW_IO_SNIFF_VALUE_ENT(_chip, _hci, _addr, _mask, _val, _equal, _trace, _tag) \
+	{.chip = _chip, .hci = _hci, .addr = _addr, .u.vm.mask = _mask, .u.vm.val = _val, .u.vm.equal = _equal, .trace = _trace, .tag = _tag, .type = RTW_IO_SNIFF_TYPE_VALUE,}
+
+/* part or all sniffed range is enabled (not all 0) */
+#define RTW_IO_SNIFF_EN_ENT(_chip, _hci, _addr, _mask, _trace, _tag) \
+	{.chip = _chip, .hci = _hci, .addr = _addr, .u.vm.mask = _mask, .u.vm.val = 0, .u.vm.equal = 0, .trace = _trace, .tag = _tag, .type = RTW_IO_SNIFF_TYPE_VALUE,}
+
+/* part or all sniffed range is disabled (not all 1) */
+#define RTW_IO_SNIFF_DIS_ENT(_chip, _hci, _addr, _mask, _trace, _tag) \
+	{.chip = _chip, .hci = _hci, .addr = _addr, .u.vm.mask = _mask, .u.vm.val = 0xFFFFFFFF, .u.vm.equal = 0, .trace = _trace, .tag = _tag, .type = RTW_IO_SNIFF_TYPE_VALUE,}
+
+static bool match_io_sniff_ranges(struct rtw_hal_com_t *hal
+	, const struct rtw_io_sniff_ent *sniff, int i, u32 addr, u16 len)
+{
+
+	/* check if IO range after sniff end address */
+	if (addr > sniff->u.end_addr)
+		return 0;
+
+	return 1;
+}
+
+static bool match_io_sniff_value(struct rtw_hal_com_t *hal
+	, const struct rtw_io_sniff_ent *sniff, int i, u32 addr, u8 len, u32 val)
+{
+	u8 sniff_len;
+	s8 mask_shift;
+	u32 mask;
+	s8 value_shift;
+	u32 value;
+	bool ret = 0;
+
+	/* check if IO range after sniff end address */
+	sniff_len = 4;
+	while (!(sniff->u.vm.mask & (0xFF << ((sniff_len - 1) * 8)))) {
+		sniff_len--;
+		if (sniff_len == 0)
+			goto exit;
+	}
+	if (sniff->addr + sniff_len <= addr)
+		goto exit;
+
+	/* align to IO addr */
+	mask_shift = (sniff->addr - addr) * 8;
+	value_shift = mask_shift + bitshift(sniff->u.vm.mask);
+	if (mask_shift > 0)
+		mask = sniff->u.vm.mask << mask_shift;
+	else if (mask_shift < 0)
+		mask = sniff->u.vm.mask >> -mask_shift;
+	else
+		mask = sniff->u.vm.mask;
+
+	if (value_shift > 0)
+		value = sniff->u.vm.val << value_shift;
+	else if (mask_shift < 0)
+		value = sniff->u.vm.val >> -value_shift;
+	else
+		value = sniff->u.vm.val;
+
+	if ((sniff->u.vm.equal && (mask & val) == (mask & value))
+		|| (!sniff->u.vm.equal && (mask & val) != (mask & value))
+	) {
+		ret = 1;
+		if (0)
+			PHL_INFO(" addr:0x%x len:%u val:0x%x (i:%d sniff_len:%u m_shift:%d mask:0x%x v_shifd:%d value:0x%x equal:%d)\n"
+				, addr, len, val, i, sniff_len, mask_shift, mask, value_shift, value, sniff->u.vm.equal);
+	}
+
+exit:
+	return ret;
+}
+
+static bool match_io_sniff(struct rtw_hal_com_t *hal
+	, const struct rtw_io_sniff_ent *sniff, int i, u32 addr, u8 len, u32 val)
+{
+	bool ret = 0;
+
+	if (sniff->chip != CHIP_WIFI6_MAX
+		&& sniff->chip != hal_get_chip_id(hal))
+		goto exit;
+	/*
+	if (sniff->hci
+		&& !(sniff->hci & hal_get_hci_type(hal)))
+		goto exit;
+	*/
+	if (sniff->addr >= addr + len) /* IO range below sniff start address */
+		goto exit;
+
+	switch (sniff->type) {
+	case RTW_IO_SNIFF_TYPE_RANGE:
+		ret = match_io_sniff_ranges(hal, sniff, i, addr, len);
+		break;
+	case RTW_IO_SNIFF_TYPE_VALUE:
+		if (len == 1 || len == 2 || len == 4)
+			ret = match_io_sniff_value(hal, sniff, i, addr, len, val);
+		break;
+	default:
+		/*_os_warn_on(1);*/
+		break;
+	}
+
+exit:
+	return ret;
+}
+#endif /* DBG_IO || CONFIG_PHL_IO_SHADOW */
+
+#ifdef CONFIG_PHL_IO_SHADOW
+/*
+ * Registers only the host ever writes: not updated by hw or fw and without
+ * side effect on write. Their last written value is kept in hal_io_shadow, so
+ * reads and the read half of read-modify-write are served from memory, writes
+ * of the value already held are dropped, and inside a write combining window
+ * successive writes to one register reach the bus once.
+ */
+static const struct rtw_io_sniff_ent io_shadow[] = {
+	/* R_AX_PWR_RATE_TABLE0 ~ R_AX_PWR_RU_LMT_TABLE7, written by halrf */
+	RTW_IO_SNIFF_RANGE_ENT(CHIP_WIFI6_8852B, 0, 0xD2C0, 0xD35B, 0, "tx pwr tbl"),
+	RTW_IO_SNIFF_RANGE_ENT(CHIP_WIFI6_8852B, 0, 0xF2C0, 0xF35B, 0, "tx pwr tbl c1"),
+};
+
+static const int io_shadow_num = sizeof(io_shadow) / sizeof(struct rtw_io_sniff_ent);
+
+#define _io_shadow_idx(_addr) \
+	((((_addr) >> 2) ^ ((_addr) >> 10)) & (HAL_IO_SHADOW_SIZE - 1))
+
+static bool _io_shadow_match(struct rtw_hal_com_t *hal, u32 addr, u8 len)
+{
+	int i;
+
+	for (i = 0; i < io_shadow_num; i++) {
+		if (match_io_sniff(hal, &io_shadow[i], i, addr, len, 0))
+			return true;
+	}
+
+	return false;
+}
+
+static int _io_shadow_bus_write32(struct rtw_hal_com_t *hal, u32 addr, u32 val)
+{
+	struct hal_io_priv *io_priv = &hal->iopriv;
+	int ret;
+
+	ret = io_priv->io_ops._write32(hal, addr, val);
+	#ifdef RTW_WKARD_BUS_WRITE
+	if (NULL != io_priv->io_ops._write_post_cfg)
+		ret = io_priv->io_ops._write_post_cfg(hal, addr, val);
+	#endif
+	return ret;
+}
+
+/* caller holds shadow->lock */
+static void _io_shadow_wc_flush(struct rtw_hal_com_t *hal)
+{
+	struct hal_io_shadow *shadow = &hal->iopriv.shadow;
+
+	if (!shadow->wc_pend)
+		return;
+
+	shadow->wc_pend = false;
+	shadow->stat.wr_flush++;
+	_io_shadow_bus_write32(hal, shadow->wc_addr,
+			       shadow->ent[_io_shadow_idx(shadow->wc_addr)].val);
+}
+
+/* keep bus order, a held write goes out before any other access */
+static void _io_shadow_wc_sync(struct rtw_hal_com_t *hal)
+{
+	struct hal_io_shadow *shadow = &hal->iopriv.shadow;
+	_os_spinlockfg sp_flags;
+
+	if (!shadow->wc_pend)
+		return;
+
+	_os_spinlock(hal->drv_priv, &shadow->lock, _irq, &sp_flags);
+	_io_shadow_wc_flush(hal);
+	_os_spinunlock(hal->drv_priv, &shadow->lock, _irq, &sp_flags);
+}
+
+static bool _io_shadow_read32(struct rtw_hal_com_t *hal, u32 addr, u32 *val)
+{
+	struct hal_io_shadow *shadow = &hal->iopriv.shadow;
+	struct hal_io_shadow_ent *ent = NULL;
+	_os_spinlockfg sp_flags;
+	u32 idx = _io_shadow_idx(addr);
+
+	if (!shadow->en)
+		return false;
+
+	if (!_io_shadow_match(hal, addr, 4)) {
+		_io_shadow_wc_sync(hal);
+		return false;
+	}
+
+	_os_spinlock(hal->drv_priv, &shadow->lock, _irq, &sp_flags);
+	ent = &shadow->ent[idx];
+	if (ent->valid && ent->addr == addr) {
+		*val = ent->val;
+		shadow->stat.hit++;
+	} else {
+		/* the held write lives in this slot, put it out before evicting */
+		if (shadow->wc_pend && _io_shadow_idx(shadow->wc_addr) == idx)
+			_io_shadow_wc_flush(hal);
+		*val = hal->iopriv.io_ops._read32(hal, addr);
+		ent->addr = addr;
+		ent->val = *val;
+		ent->valid = true;
+		shadow->stat.miss++;
+	}
+	_os_spinunlock(hal->drv_priv, &shadow->lock, _irq, &sp_flags);
+
+	return true;
+}
+
+static bool _io_shadow_write32(struct rtw_hal_com_t *hal, u32 addr, u32 val)
+{
+	struct hal_io_shadow *shadow = &hal->iopriv.shadow;
+	struct hal_io_shadow_ent *ent = NULL;
+	_os_spinlockfg sp_flags;
+
+	if (!shadow->en)
+		return false;
+
+	if (!_io_shadow_match(hal, addr, 4)) {
+		_io_shadow_wc_sync(hal);
+		return false;
+	}
+
+	_os_spinlock(hal->drv_priv, &shadow->lock, _irq, &sp_flags);
+	if (shadow->wc_pend && shadow->wc_addr != addr)
+		_io_shadow_wc_flush(hal);
+
+	ent = &shadow->ent[_io_shadow_idx(addr)];
+	if (ent->valid && ent->addr == addr && ent->val == val) {
+		shadow->stat.wr_skip++;
+		goto exit;
+	}
+
+	ent->addr = addr;
+	ent->val = val;
+	ent->valid = true;
+
+	if (shadow->wc_depth) {
+		if (shadow->wc_pend)
+			shadow->stat.wr_merge++;
+		shadow->wc_pend = true;
+		shadow->wc_addr = addr;
+	} else {
+		/* bus write under the lock, so cache and register agree */
+		_io_shadow_bus_write32(hal, addr, val);
+	}
+
+exit:
+	_os_spinunlock(hal->drv_priv, &shadow->lock, _irq, &sp_flags);
+	return true;
+}
+
+/* 8/16 bit access is not cached, drop the dword it lands in */
+static void _io_shadow_narrow(struct rtw_hal_com_t *hal, u32 addr, u8 len,
+			      bool write)
+{
+	struct hal_io_shadow *shadow = &hal->iopriv.shadow;
+	struct hal_io_shadow_ent *ent = NULL;
+	_os_spinlockfg sp_flags;
+	u32 addr32 = addr & ~0x3;
+
+	if (!shadow->en)
+		return;
+
+	if (!write || !_io_shadow_match(hal, addr, len)) {
+		_io_shadow_wc_sync(hal);
+		return;
+	}
+
+	_os_spinlock(hal->drv_priv, &shadow->lock, _irq, &sp_flags);
+	_io_shadow_wc_flush(hal);
+	ent = &shadow->ent[_io_shadow_idx(addr32)];
+	if (ent->addr == addr32)
+		ent->valid = false;
+	_os_spinunlock(hal->drv_priv, &shadow->lock, _irq, &sp_flags);
+}
+
+/* register content is lost or unknown: power on/off, L1 recovery */
+void hal_io_shadow_inval(struct rtw_hal_com_t *hal)
+{
+	struct hal_io_shadow *shadow = &hal->iopriv.shadow;
+	_os_spinlockfg sp_flags;
+	u32 i;
+
+	_os_spinlock(hal->drv_priv, &shadow->lock, _irq, &sp_flags);
+	shadow->wc_pend = false;
+	for (i = 0; i < HAL_IO_SHADOW_SIZE; i++)
+		shadow->ent[i].valid = false;
+	shadow->stat.inval++;
+	_os_spinunlock(hal->drv_priv, &shadow->lock, _irq, &sp_flags);
+}
+
+/*
+ * Write combining window, nestable. Writes to shadowed registers are held
+ * until a write to another register, any non-shadowed access or the end of
+ * the outermost window.
+ */
+void hal_io_wc_begin(struct rtw_hal_com_t *hal)
+{
+	struct hal_io_shadow *shadow = &hal->iopriv.shadow;
+	_os_spinlockfg sp_flags;
+
+	_os_spinlock(hal->drv_priv, &shadow->lock, _irq, &sp_flags);
+	shadow->wc_depth++;
+	_os_spinunlock(hal->drv_priv, &shadow->lock, _irq, &sp_flags);
+}
+
+void hal_io_wc_end(struct rtw_hal_com_t *hal)
+{
+	struct hal_io_shadow *shadow = &hal->iopriv.shadow;
+	_os_spinlockfg sp_flags;
+
+	_os_spinlock(hal->drv_priv, &shadow->lock, _irq, &sp_flags);
+	if (shadow->wc_depth)
+		shadow->wc_depth--;
+	if (!shadow->wc_depth)
+		_io_shadow_wc_flush(hal);
+	_os_spinunlock(hal->drv_priv, &shadow->lock, _irq, &sp_flags);
+}
+
+void rtw_hal_io_shadow_ctrl(void *hal, u8 en)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+	struct rtw_hal_com_t *hal_com = hal_info->hal_com;
+	struct hal_io_shadow *shadow = &hal_com->iopriv.shadow;
+	_os_spinlockfg sp_flags;
+
+	_os_spinlock(hal_com->drv_priv, &shadow->lock, _irq, &sp_flags);
+	_io_shadow_wc_flush(hal_com);
+	shadow->en = en ? true : false;
+	_os_spinunlock(hal_com->drv_priv, &shadow->lock, _irq, &sp_flags);
+
+	hal_io_shadow_inval(hal_com);
+}
+
+u8 rtw_hal_io_shadow_get_stat(void *hal, struct rtw_io_shadow_stat *stat,
+			      u8 rst)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+	struct rtw_hal_com_t *hal_com = hal_info->hal_com;
+	struct hal_io_shadow *shadow = &hal_com->iopriv.shadow;
+	_os_spinlockfg sp_flags;
+	u8 en;
+
+	_os_spinlock(hal_com->drv_priv, &shadow->lock, _irq, &sp_flags);
+	_os_mem_cpy(hal_com->drv_priv, stat, &shadow->stat, sizeof(*stat));
+	if (rst)
+		_os_mem_set(hal_com->drv_priv, &shadow->stat, 0,
+			    sizeof(shadow->stat));
+	en = shadow->en;
+	_os_spinunlock(hal_com->drv_priv, &shadow->lock, _irq, &sp_flags);
+
+	return en;
+}
+#endif /* CONFIG_PHL_IO_SHADOW */
+
 u8 _hal_read8(struct rtw_hal_com_t *hal, u32 addr)
 {
 	u8 r_val;
@@ -49,6 +433,10 @@ u8 _hal_read8(struct rtw_hal_com_t *hal, u32 addr)
 	}
 	#endif
 
+	#ifdef CONFIG_PHL_IO_SHADOW
+	_io_shadow_narrow(hal, addr, 1, false);
+	#endif
+
 	_read8 = io_priv->io_ops._read8;
 	r_val = _read8(hal, addr);
 	return r_val;
@@ -67,6 +455,10 @@ u16 _hal_read16(struct rtw_hal_com_t *hal, u32 addr)
 	}
 	#endif
 
+	#ifdef CONFIG_PHL_IO_SHADOW
+	_io_shadow_narrow(hal, addr, 2, false);
+	#endif
+
 	_read16 = io_priv->io_ops._read16;
 	r_val = _read16(hal, addr);
 	return r_val;
@@ -85,6 +477,11 @@ u32 _hal_read32(struct rtw_hal_com_t *hal, u32 addr)
 	}
 	#endif
 
+	#ifdef CONFIG_PHL_IO_SHADOW
+	if (_io_shadow_read32(hal, addr, &r_val))
+		return r_val;
+	#endif
+
 	_read32 = io_priv->io_ops._read32;
 	r_val = _read32(hal, addr);
 	return r_val;
@@ -105,6 +502,10 @@ int _hal_write8(struct rtw_hal_com_t *hal, u32 addr, u8 val)
 		return 0;
 	#endif
 
+	#ifdef CONFIG_PHL_IO_SHADOW
+	_io_shadow_narrow(hal, addr, 1, true);
+	#endif
+
 	_write8 = io_priv->io_ops._write8;
 	ret = _write8(hal, addr, val);
 
@@ -131,6 +532,10 @@ int _hal_write16(struct rtw_hal_com_t *hal, u32 addr, u16 val)
 		return 0;
 	#endif
 
+	#ifdef CONFIG_PHL_IO_SHADOW
+	_io_shadow_narrow(hal, addr, 2, true);
+	#endif
+
 	_write16 = io_priv->io_ops._write16;
 	ret = _write16(hal, addr, val);
 
@@ -157,6 +562,12 @@ int _hal_write32(struct rtw_hal_com_t *hal, u32 addr, u32 val)
 		return 0;
 	#endif
 
+	#ifdef CONFIG_PHL_IO_SHADOW
+	/* handled, same as a 4 byte bus write */
+	if (_io_shadow_write32(hal, addr, val))
+		return 4;
+	#endif
+
 	_write32 = io_priv->io_ops._write32;
 	ret = _write32(hal, addr, val);
 
@@ -277,17 +688,28 @@ u32 hal_init_io_priv(struct rtw_hal_com_t *hal,
 	#ifdef CONFIG_SDIO_INDIRECT_ACCESS
 	_os_mutex_init(hal->drv_priv, &iopriv->sd_indirect_access_mutex);
 	#endif
+	#ifdef CONFIG_PHL_IO_SHADOW
+	_os_mem_set(hal->drv_priv, &iopriv->shadow, 0, sizeof(iopriv->shadow));
+	_os_spinlock_init(hal->drv_priv, &iopriv->shadow.lock);
+	iopriv->shadow.en = true;
+	#endif
 	set_intf_ops(hal, &iopriv->io_ops);
 
 	return RTW_HAL_STATUS_SUCCESS;
 }
 u32 hal_deinit_io_priv(struct rtw_hal_com_t *hal)
 {
-	#ifdef CONFIG_SDIO_INDIRECT_ACCESS
+	#if defined(CONFIG_SDIO_INDIRECT_ACCESS) || defined(CONFIG_PHL_IO_SHADOW)
 	struct hal_io_priv *iopriv = &hal->iopriv;
+	#endif
 
+	#ifdef CONFIG_SDIO_INDIRECT_ACCESS
 	_os_mutex_init(hal->drv_priv, &iopriv->sd_indirect_access_mutex);
 	#endif
+	#ifdef CONFIG_PHL_IO_SHADOW
+	iopriv->shadow.en = false;
+	_os_spinlock_free(hal->drv_priv, &iopriv->shadow.lock);
+	#endif
 
 	return RTW_HAL_STATUS_SUCCESS;
 }
@@ -403,40 +825,6 @@ void hal_write32_mask(struct rtw_hal_com_t *hal, u16 addr, u32 mask, u32 val)
 
 
 #ifdef DBG_IO
-#define RTW_IO_SNIFF_TYPE_RANGE	0 /* specific address range is accessed */
-#define RTW_IO_SNIFF_TYPE_VALUE	1 /* value match for sniffed range */
-
-struct rtw_io_sniff_ent {
-	u8 chip;
-	u8 hci;
-	u32 addr;
-	u8 type;
-	union {
-		u32 end_addr;
-		struct {
-			u32 mask;
-			u32 val;
-			bool equal;
-		} vm; /* value match */
-	} u;
-	bool trace;
-	char *tag;
-};
-
-#define RTW_IO_SNIFF_RANGE_ENT(_chip, _hci, _addr, _end_addr, _trace, _tag) \
-	{.chip = _chip, .hci = _hci, .addr = _addr, .u.end_addr = _end_addr, .trace = _trace, .tag = _tag, .type = RTW_IO_SNIFF_TYPE_RANGE,}
-
-#define RTW_IO_SNIFF_VALUE_ENT(_chip, _hci, _addr, _mask, _val, _equal, _trace, _tag) \
-	{.chip = _chip, .hci = _hci, .addr = _addr, .u.vm.mask = _mask, .u.vm.val = _val, .u.vm.equal = _equal, .trace = _trace, .tag = _tag, .type = RTW_IO_SNIFF_TYPE_VALUE,}
-
-/* part or all sniffed range is enabled (not all 0) */
-#define RTW_IO_SNIFF_EN_ENT(_chip, _hci, _addr, _mask, _trace, _tag) \
-	{.chip = _chip, .hci = _hci, .addr = _addr, .u.vm.mask = _mask, .u.vm.val = 0, .u.vm.equal = 0, .trace = _trace, .tag = _tag, .type = RTW_IO_SNIFF_TYPE_VALUE,}
-
-/* part or all sniffed range is disabled (not all 1) */
-#define RTW_IO_SNIFF_DIS_ENT(_chip, _hci, _addr, _mask, _trace, _tag) \
-	{.chip = _chip, .hci = _hci, .addr = _addr, .u.vm.mask = _mask, .u.vm.val = 0xFFFFFFFF, .u.vm.equal = 0, .trace = _trace, .tag = _tag, .type = RTW_IO_SNIFF_TYPE_VALUE,}
-
 const struct rtw_io_sniff_ent read_sniff[] = {
 #ifdef DBG_IO_HCI_EN_CHK
 	RTW_IO_SNIFF_EN_ENT(CHIP_WIFI6_MAX, RTW_HCI_SDIO, 0x02, 0x1FC, 1, "SDIO 0x02[8:2] not all 0"),
@@ -465,100 +853,6 @@ const struct rtw_io_sniff_ent write_sniff[] = {
 
 const int write_sniff_num = sizeof(write_sniff) / sizeof(struct rtw_io_sniff_ent);
 
-static bool match_io_sniff_ranges(struct rtw_hal_com_t *hal
-	, const struct rtw_io_sniff_ent *sniff, int i, u32 addr, u16 len)
-{
-
-	/* check if IO range after sniff end address */
-	if (addr > sniff->u.end_addr)
-		return 0;
-
-	return 1;
-}
-
-static bool match_io_sniff_value(struct rtw_hal_com_t *hal
-	, const struct rtw_io_sniff_ent *sniff, int i, u32 addr, u8 len, u32 val)
-{
-	u8 sniff_len;
-	s8 mask_shift;
-	u32 mask;
-	s8 value_shift;
-	u32 value;
-	bool ret = 0;
-
-	/* check if IO range after sniff end address */
-	sniff_len = 4;
-	while (!(sniff->u.vm.mask & (0xFF << ((sniff_len - 1) * 8)))) {
-		sniff_len--;
-		if (sniff_len == 0)
-			goto exit;
-	}
-	if (sniff->addr + sniff_len <= addr)
-		goto exit;
-
-	/* align to IO addr */
-	mask_shift = (sniff->addr - addr) * 8;
-	value_shift = mask_shift + bitshift(sniff->u.vm.mask);
-	if (mask_shift > 0)
-		mask = sniff->u.vm.mask << mask_shift;
-	else if (mask_shift < 0)
-		mask = sniff->u.vm.mask >> -mask_shift;
-	else
-		mask = sniff->u.vm.mask;
-
-	if (value_shift > 0)
-		value = sniff->u.vm.val << value_shift;
-	else if (mask_shift < 0)
-		value = sniff->u.vm.val >> -value_shift;
-	else
-		value = sniff->u.vm.val;
-
-	if ((sniff->u.vm.equal && (mask & val) == (mask & value))
-		|| (!sniff->u.vm.equal && (mask & val) != (mask & value))
-	) {
-		ret = 1;
-		if (0)
-			PHL_INFO(" addr:0x%x len:%u val:0x%x (i:%d sniff_len:%u m_shift:%d mask:0x%x v_shifd:%d value:0x%x equal:%d)\n"
-				, addr, len, val, i, sniff_len, mask_shift, mask, value_shift, value, sniff->u.vm.equal);
-	}
-
-exit:
-	return ret;
-}
-
-static bool match_io_sniff(struct rtw_hal_com_t *hal
-	, const struct rtw_io_sniff_ent *sniff, int i, u32 addr, u8 len, u32 val)
-{
-	bool ret = 0;
-
-	if (sniff->chip != CHIP_WIFI6_MAX
-		&& sniff->chip != hal_get_chip_id(hal))
-		goto exit;
-	/*
-	if (sniff->hci
-		&& !(sniff->hci & hal_get_hci_type(hal)))
-		goto exit;
-	*/
-	if (sniff->addr >= addr + len) /* IO range below sniff start address */
-		goto exit;
-
-	switch (sniff->type) {
-	case RTW_IO_SNIFF_TYPE_RANGE:
-		ret = match_io_sniff_ranges(hal, sniff, i, addr, len);
-		break;
-	case RTW_IO_SNIFF_TYPE_VALUE:
-		if (len == 1 || len == 2 || len == 4)
-			ret = match_io_sniff_value(hal, sniff, i, addr, len, val);
-		break;
-	default:
-		/*_os_warn_on(1);*/
-		break;
-	}
-
-exit:
-	return ret;
-}
-
 u32 match_read_sniff(struct rtw_hal_com_t *hal, u32 addr, u16 len, u32 val)
 {
 	int i;
@@ -116,6 +116,16 @@ int dbg_hal_sd_iwrite32(struct rtw_hal_com_t *hal, u32 addr, u32 val, const char
 
 void hal_write32_mask(struct rtw_hal_com_t *hal, u16 addr, u32 mask, u32 val);
 
+#ifdef CONFIG_PHL_IO_SHADOW
+void hal_io_shadow_inval(struct rtw_hal_com_t *hal);
+void hal_io_wc_begin(struct rtw_hal_com_t *hal);
+void hal_io_wc_end(struct rtw_hal_com_t *hal);
+#else
+#define hal_io_shadow_inval(_hal)
+#define hal_io_wc_begin(_hal)
+#define hal_io_wc_end(_hal)
+#endif
+
 u32 hal_init_io_priv(struct rtw_hal_com_t *hal,
 void (*set_intf_ops)(struct rtw_hal_com_t *hal, struct hal_io_ops *ops));
 u32 hal_deinit_io_priv(struct rtw_hal_com_t *hal);
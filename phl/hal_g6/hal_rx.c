@@ -57,6 +57,7 @@ rtw_hal_set_rxfltr_by_mode(void *hal, u8 band, enum rtw_rx_fltr_mode mode)
 		return hstatus;
 
 	hal_info->monitor_mode = (mode == RX_FLTR_MODE_SNIFFER);
+	hal_rx_cls_apply(hal_info, band, set_mode);
 
 	/* Record @hal_info_t.rx_fltr_mode only when the mode is not monitor and
 	 * restore, otherwise, it is kept intact.
@@ -549,3 +550,358 @@ hal_rx_ppdu_sts(struct rtw_phl_com_t *phl_com,
 	}
 	_os_spinunlock(phl_com->drv_priv, &rssi_stat->lock, _bh, NULL);
 }
+
+#ifdef CONFIG_PHL_RX_CLS
+/* mgnt: timing advertisement, atim */
+#define RX_CLS_MGNT_DROP (BIT(6) | BIT(9))
+#define RX_CLS_MGNT_PROBE_REQ BIT(4)
+#define RX_CLS_MGNT_PROBE_RSP BIT(5)
+#define RX_CLS_MGNT_BCN BIT(8)
+/* ctrl: trigger, tack, bfrp, ndpa, rts, cts, ack, cf-end(+cf-ack) */
+#define RX_CLS_CTRL_DROP (BIT(2) | BIT(3) | BIT(4) | BIT(5) | BIT(11) | \
+			  BIT(12) | BIT(13) | BIT(14) | BIT(15))
+#define RX_CLS_MODE_NONE 0xFF
+
+/*
+ * Subtypes dropped in the MAC for a rx filter mode, bit n is subtype n.
+ * Scan and sniffer keep everything, bar/ba, ps-poll and data are never
+ * dropped. Probe responses are kept outside strict, ap side acs and obss
+ * scans collect them without entering scan filter mode.
+ */
+static u16 _hal_rx_cls_policy_drop(enum rtw_rx_cls_policy policy,
+				   enum rtw_rx_fltr_mode mode, u8 type)
+{
+	u16 drop = 0;
+
+	if (RX_CLS_POLICY_OFF == policy)
+		return 0;
+
+	switch (mode) {
+	case RX_FLTR_MODE_STA_LINKING:
+	case RX_FLTR_MODE_STA_NORMAL:
+		if (RTW_FRAME_TYPE_MGNT == type) {
+			drop = RX_CLS_MGNT_DROP;
+			/* p2p listen runs on a station role and needs probe req */
+			if (RX_CLS_POLICY_STRICT == policy &&
+			    RX_FLTR_MODE_STA_NORMAL == mode)
+				drop |= RX_CLS_MGNT_PROBE_REQ |
+					RX_CLS_MGNT_PROBE_RSP;
+		} else if (RTW_FRAME_TYPE_CTRL == type) {
+			drop = RX_CLS_CTRL_DROP;
+		}
+		break;
+	case RX_FLTR_MODE_AP_NORMAL:
+		if (RTW_FRAME_TYPE_MGNT == type) {
+			drop = RX_CLS_MGNT_DROP;
+			if (RX_CLS_POLICY_STRICT == policy)
+				drop |= RX_CLS_MGNT_BCN | RX_CLS_MGNT_PROBE_RSP;
+		} else if (RTW_FRAME_TYPE_CTRL == type) {
+			drop = RX_CLS_CTRL_DROP;
+		}
+		break;
+	default:
+		break;
+	}
+
+	return drop;
+}
+
+enum rtw_hal_status hal_rx_cls_init(struct hal_info_t *hal_info)
+{
+	void *drv_priv = hal_to_drvpriv(hal_info);
+	struct hal_rx_cls *cls = NULL;
+	u8 band;
+
+	cls = _os_mem_alloc(drv_priv, sizeof(*cls));
+	if (NULL == cls) {
+		PHL_ERR("%s: alloc rx cls failed\n", __func__);
+		return RTW_HAL_STATUS_RESOURCE;
+	}
+	_os_mem_set(drv_priv, cls, 0, sizeof(*cls));
+	/* nothing dropped until a policy or rule is set */
+	cls->policy = RX_CLS_POLICY_OFF;
+	for (band = 0; band < HW_BAND_MAX; band++)
+		cls->mode[band] = RX_CLS_MODE_NONE;
+	hal_info->rx_cls = cls;
+
+	return RTW_HAL_STATUS_SUCCESS;
+}
+
+void hal_rx_cls_deinit(struct hal_info_t *hal_info)
+{
+	void *drv_priv = hal_to_drvpriv(hal_info);
+
+	if (NULL == hal_info->rx_cls)
+		return;
+
+	_os_mem_free(drv_priv, hal_info->rx_cls, sizeof(struct hal_rx_cls));
+	hal_info->rx_cls = NULL;
+}
+
+/**
+ * hal_rx_cls_apply - program the type/subtype filter of a band
+ * @hal_info: see struct hal_info_t
+ * @band: HW_BAND_0 or HW_BAND_1
+ * @mode: rx filter mode just programmed to @band
+ *
+ * The policy of @mode is applied first and the user rules of @band on top.
+ * Sniffer and scan modes take neither, every subtype goes to host.
+ * Every subtype is written, the registers are back to "to host" after a
+ * MAC init or a wow rx filter change.
+ */
+void hal_rx_cls_apply(struct hal_info_t *hal_info, u8 band,
+		      enum rtw_rx_fltr_mode mode)
+{
+	struct hal_rx_cls *cls = (struct hal_rx_cls *)hal_info->rx_cls;
+	struct rtw_rx_cls_rule *rule = NULL;
+	u8 target[RTW_RX_CLS_TYPE_NUM][RTW_RX_CLS_SUBTYPE_NUM];
+	u16 drop = 0;
+	u8 type, i;
+
+	if (NULL == cls || band >= HW_BAND_MAX)
+		return;
+
+	for (type = 0; type < RTW_RX_CLS_TYPE_NUM; type++) {
+		drop = _hal_rx_cls_policy_drop(cls->policy, mode, type);
+		for (i = 0; i < RTW_RX_CLS_SUBTYPE_NUM; i++)
+			target[type][i] = (drop & BIT(i)) ?
+				RX_CLS_TARGET_DROP : RX_CLS_TARGET_HOST;
+	}
+
+	for (i = 0; i < RTW_RX_CLS_RULE_NUM; i++) {
+		if (RX_FLTR_MODE_SNIFFER == mode || RX_FLTR_MODE_SCAN == mode)
+			break;
+		rule = &cls->rule[i];
+		if (rule->valid && rule->band == band)
+			target[rule->type][rule->subtype] = rule->target;
+	}
+
+	for (type = 0; type < RTW_RX_CLS_TYPE_NUM; type++) {
+		if (RTW_HAL_STATUS_SUCCESS !=
+		    rtw_hal_mac_set_rxfltr_subtype_all(hal_info->hal_com, band,
+						       type, target[type])) {
+			PHL_ERR("%s: band %d type %d fail\n", __func__, band, type);
+			return;
+		}
+	}
+
+	_os_mem_cpy(hal_to_drvpriv(hal_info), cls->target[band], target,
+		    sizeof(target));
+	cls->mode[band] = (u8)mode;
+}
+
+static void _hal_rx_cls_reapply(struct hal_info_t *hal_info, u8 band)
+{
+	struct hal_rx_cls *cls = (struct hal_rx_cls *)hal_info->rx_cls;
+
+	/* not programmed yet, e.g. band 1 without dbcc */
+	if (RX_CLS_MODE_NONE == cls->mode[band])
+		return;
+
+	hal_rx_cls_apply(hal_info, band, cls->mode[band]);
+}
+
+static void _hal_rx_cls_upd_map(struct hal_info_t *hal_info)
+{
+	struct hal_rx_cls *cls = (struct hal_rx_cls *)hal_info->rx_cls;
+	struct rtw_rx_cls_rule *rule = NULL;
+	u8 i;
+
+	_os_mem_set(hal_to_drvpriv(hal_info), cls->rule_map, 0,
+		    sizeof(cls->rule_map));
+	cls->data_rule_cnt = 0;
+	for (i = 0; i < RTW_RX_CLS_RULE_NUM; i++) {
+		rule = &cls->rule[i];
+		if (!rule->valid)
+			continue;
+		cls->rule_map[rule->band][rule->type][rule->subtype] = i + 1;
+		/* frames of a drop rule never reach host, nothing to count */
+		if (RTW_FRAME_TYPE_DATA == rule->type &&
+		    RX_CLS_TARGET_DROP != rule->target)
+			cls->data_rule_cnt++;
+	}
+}
+
+enum rtw_hal_status
+rtw_hal_rx_cls_set_policy(void *hal, enum rtw_rx_cls_policy policy)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+	struct hal_rx_cls *cls = (struct hal_rx_cls *)hal_info->rx_cls;
+	u8 band;
+
+	if (NULL == cls || policy >= RX_CLS_POLICY_MAX)
+		return RTW_HAL_STATUS_FAILURE;
+
+	cls->policy = policy;
+	for (band = 0; band < HW_BAND_MAX; band++)
+		_hal_rx_cls_reapply(hal_info, band);
+
+	return RTW_HAL_STATUS_SUCCESS;
+}
+
+enum rtw_rx_cls_policy rtw_hal_rx_cls_get_policy(void *hal)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+	struct hal_rx_cls *cls = (struct hal_rx_cls *)hal_info->rx_cls;
+
+	return (cls) ? cls->policy : RX_CLS_POLICY_OFF;
+}
+
+/**
+ * rtw_hal_rx_cls_add_rule - add or replace the rule of a band/type/subtype
+ * @hal: see struct hal_info_t
+ * @rule: band, type, subtype and target of the rule
+ * @idx: rule index, for rtw_hal_rx_cls_del_rule()
+ *
+ * The MAC filter of the band is reprogrammed at once if the band is up,
+ * otherwise on its next rx filter mode change.
+ */
+enum rtw_hal_status
+rtw_hal_rx_cls_add_rule(void *hal, struct rtw_rx_cls_rule *rule, u8 *idx)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+	struct hal_rx_cls *cls = (struct hal_rx_cls *)hal_info->rx_cls;
+	u8 i;
+
+	if (NULL == cls || rule->band >= HW_BAND_MAX ||
+	    rule->type >= RTW_RX_CLS_TYPE_NUM ||
+	    rule->subtype >= RTW_RX_CLS_SUBTYPE_NUM ||
+	    rule->target > RX_CLS_TARGET_WLCPU)
+		return RTW_HAL_STATUS_FAILURE;
+
+	i = cls->rule_map[rule->band][rule->type][rule->subtype];
+	if (i) {
+		i--;
+	} else {
+		for (i = 0; i < RTW_RX_CLS_RULE_NUM; i++) {
+			if (!cls->rule[i].valid)
+				break;
+		}
+		if (i == RTW_RX_CLS_RULE_NUM)
+			return RTW_HAL_STATUS_RESOURCE;
+	}
+
+	cls->rule[i].band = rule->band;
+	cls->rule[i].type = rule->type;
+	cls->rule[i].subtype = rule->subtype;
+	cls->rule[i].target = rule->target;
+	cls->rule[i].hit = 0;
+	cls->rule[i].valid = true;
+	_hal_rx_cls_upd_map(hal_info);
+	_hal_rx_cls_reapply(hal_info, rule->band);
+
+	if (idx)
+		*idx = i;
+
+	return RTW_HAL_STATUS_SUCCESS;
+}
+
+enum rtw_hal_status rtw_hal_rx_cls_del_rule(void *hal, u8 idx)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+	struct hal_rx_cls *cls = (struct hal_rx_cls *)hal_info->rx_cls;
+	u8 band;
+
+	if (NULL == cls || idx >= RTW_RX_CLS_RULE_NUM ||
+	    !cls->rule[idx].valid)
+		return RTW_HAL_STATUS_FAILURE;
+
+	band = cls->rule[idx].band;
+	cls->rule[idx].valid = false;
+	_hal_rx_cls_upd_map(hal_info);
+	_hal_rx_cls_reapply(hal_info, band);
+
+	return RTW_HAL_STATUS_SUCCESS;
+}
+
+bool rtw_hal_rx_cls_get_rule(void *hal, u8 idx, struct rtw_rx_cls_rule *rule)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+	struct hal_rx_cls *cls = (struct hal_rx_cls *)hal_info->rx_cls;
+
+	if (NULL == cls || idx >= RTW_RX_CLS_RULE_NUM ||
+	    !cls->rule[idx].valid)
+		return false;
+
+	_os_mem_cpy(hal_to_drvpriv(hal_info), rule, &cls->rule[idx],
+		    sizeof(*rule));
+	return true;
+}
+
+/**
+ * rtw_hal_rx_cls_get_slot - programmed target of a band/type/subtype
+ * @ind_cnt: frames of the type/subtype indicated by the MAC
+ *
+ * Return enum rtw_rx_cls_target
+ */
+u8 rtw_hal_rx_cls_get_slot(void *hal, u8 band, u8 type, u8 subtype,
+			   u32 *ind_cnt)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+	struct hal_rx_cls *cls = (struct hal_rx_cls *)hal_info->rx_cls;
+
+	*ind_cnt = 0;
+	if (NULL == cls || band >= HW_BAND_MAX ||
+	    type >= RTW_RX_CLS_TYPE_NUM || subtype >= RTW_RX_CLS_SUBTYPE_NUM)
+		return RX_CLS_TARGET_HOST;
+
+	*ind_cnt = cls->ind_cnt[band][type][subtype];
+	if (RX_CLS_MODE_NONE == cls->mode[band])
+		return RX_CLS_TARGET_HOST;
+
+	return cls->target[band][type][subtype];
+}
+
+void rtw_hal_rx_cls_reset_cnt(void *hal)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+	struct hal_rx_cls *cls = (struct hal_rx_cls *)hal_info->rx_cls;
+	u8 i;
+
+	if (NULL == cls)
+		return;
+
+	_os_mem_set(hal_to_drvpriv(hal_info), cls->ind_cnt, 0,
+		    sizeof(cls->ind_cnt));
+	for (i = 0; i < RTW_RX_CLS_RULE_NUM; i++)
+		cls->rule[i].hit = 0;
+}
+
+/* reprogram after the type filter was overwritten, e.g. by wow */
+void rtw_hal_rx_cls_restore(void *hal, u8 band)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+
+	if (NULL == hal_info->rx_cls || band >= HW_BAND_MAX)
+		return;
+
+	_hal_rx_cls_reapply(hal_info, band);
+}
+
+/**
+ * rtw_hal_rx_cls_hit - account a frame indicated by the MAC
+ * @hdr: 802.11 header, only read for mgnt/ctrl or when a data rule is set
+ *
+ * Called per rx frame without lock, counters may race with rule changes.
+ */
+void rtw_hal_rx_cls_hit(void *hal, struct rtw_r_meta_data *mdata, u8 *hdr)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+	struct hal_rx_cls *cls = (struct hal_rx_cls *)hal_info->rx_cls;
+	u8 band = mdata->bb_sel;
+	u8 type = mdata->frame_type;
+	u8 subtype, idx;
+
+	if (NULL == cls || band >= HW_BAND_MAX || type >= RTW_RX_CLS_TYPE_NUM)
+		return;
+	if (RTW_FRAME_TYPE_DATA == type &&
+	    (0 == cls->data_rule_cnt || mdata->hdr_cnv))
+		return;
+
+	subtype = (u8)(PHL_GET_80211_HDR_TYPE(hdr) >> 2) & 0xF;
+	cls->ind_cnt[band][type][subtype]++;
+	idx = cls->rule_map[band][type][subtype];
+	if (idx && RX_CLS_TARGET_DROP != cls->rule[idx - 1].target)
+		cls->rule[idx - 1].hit++;
+}
+#endif /* CONFIG_PHL_RX_CLS */
@@ -35,4 +35,33 @@ hal_rx_ppdu_sts(struct rtw_phl_com_t *phl_com,
 u8 rtw_hal_query_rxch_num(void *hal);
 #endif
 
+#ifdef CONFIG_PHL_RX_CLS
+/**
+ * struct hal_rx_cls - MAC type/subtype filter programmed by policy and rules
+ * @mode: rx filter mode last programmed per band, 0xFF before the first one
+ * @target: what is in the type filter registers, see hal_rx_cls_apply()
+ * @rule_map: rule index + 1 per band/type/subtype, 0 for no rule
+ * @ind_cnt: frames indicated by the MAC per band/type/subtype
+ * @data_rule_cnt: data rules that forward, only those need the data header
+ */
+struct hal_rx_cls {
+	enum rtw_rx_cls_policy policy;
+	struct rtw_rx_cls_rule rule[RTW_RX_CLS_RULE_NUM];
+	u8 mode[HW_BAND_MAX];
+	u8 target[HW_BAND_MAX][RTW_RX_CLS_TYPE_NUM][RTW_RX_CLS_SUBTYPE_NUM];
+	u8 rule_map[HW_BAND_MAX][RTW_RX_CLS_TYPE_NUM][RTW_RX_CLS_SUBTYPE_NUM];
+	u32 ind_cnt[HW_BAND_MAX][RTW_RX_CLS_TYPE_NUM][RTW_RX_CLS_SUBTYPE_NUM];
+	u8 data_rule_cnt;
+};
+
+enum rtw_hal_status hal_rx_cls_init(struct hal_info_t *hal_info);
+void hal_rx_cls_deinit(struct hal_info_t *hal_info);
+void hal_rx_cls_apply(struct hal_info_t *hal_info, u8 band,
+		      enum rtw_rx_fltr_mode mode);
+#else
+#define hal_rx_cls_init(_hal) RTW_HAL_STATUS_SUCCESS
+#define hal_rx_cls_deinit(_hal)
+#define hal_rx_cls_apply(_hal, _band, _mode)
+#endif /* CONFIG_PHL_RX_CLS */
+
 #endif /*_HAL_RX_H_*/
@@ -81,6 +81,8 @@ enum rtw_hal_status rtw_hal_lv1_rcvy(void *hal, u32 step)
 
 	PHL_TRACE(COMP_PHL_DBG, _PHL_INFO_, "===> rtw_hal_lv1_rcvy step %d\n", step);
 	status = rtw_hal_mac_lv1_rcvy(hal_info, step);
+	/* cmac is reset during recovery */
+	hal_io_shadow_inval(hal_info->hal_com);
 	PHL_TRACE(COMP_PHL_DBG, _PHL_INFO_, "<=== rtw_hal_lv1_rcvy step %d, status 0x%x\n", step, status);
 
 	return status;
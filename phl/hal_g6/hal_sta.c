@@ -568,6 +568,7 @@ rtw_hal_add_sta_entry(void *hal, struct rtw_phl_stainfo_t *sta)
 	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
 
 	_hal_sta_set_default_value(hal_info, sta);
+	hal_wd_tmpl_invalidate(hal_info, sta->macid);
 
 	/*add mac address-cam*/
 	if (rtw_hal_mac_addr_cam_add_entry(hal_info, sta) !=
@@ -611,6 +612,10 @@ rtw_hal_update_sta_entry(void *hal, struct rtw_phl_stainfo_t *sta,
 	enum rtw_hal_status hal_status = RTW_HAL_STATUS_FAILURE;
 	enum phl_upd_mode mode = PHL_UPD_STA_CON_DISCONN;
 
+	hal_wd_tmpl_invalidate(hal_info, sta->macid);
+	hal_h2c_coal_enter(hal_info,
+			   H2C_COAL_TOKEN(H2C_COAL_SEQ_STA_UPD, sta->macid));
+
 	/*update cmac table*/
 	if (RTW_HAL_STATUS_SUCCESS != _hal_update_cctrl_tbl(hal_info, sta))
 		PHL_WARN("_hal_update_cctrl_tbl failed\n");
@@ -670,6 +675,8 @@ rtw_hal_update_sta_entry(void *hal, struct rtw_phl_stainfo_t *sta,
 	}
 	/* reset bb rssi_stat */
 	rtw_hal_bb_media_status_update(hal_info, sta, is_connect);
+	hal_h2c_coal_leave(hal_info,
+			   H2C_COAL_TOKEN(H2C_COAL_SEQ_STA_UPD, sta->macid));
 
 	return hal_status;
 }
@@ -684,6 +691,10 @@ rtw_hal_change_sta_entry(void *hal, struct rtw_phl_stainfo_t *sta,
 
 	PHL_TRACE(COMP_PHL_DBG, _PHL_INFO_, "%s: sta->macid(0x%X), mode(%d)\n",
 		__FUNCTION__, sta->macid , mode);
+	hal_wd_tmpl_invalidate(hal_info, sta->macid);
+	hal_h2c_coal_enter(hal_info,
+			   H2C_COAL_TOKEN(H2C_COAL_SEQ_STA_UPD, sta->macid));
+
 	/*update cmac table*/
 	if (RTW_HAL_STATUS_SUCCESS != _hal_update_cctrl_tbl(hal_info, sta))
 		PHL_WARN("_hal_update_cctrl_tbl failed\n");
@@ -701,6 +712,8 @@ rtw_hal_change_sta_entry(void *hal, struct rtw_phl_stainfo_t *sta,
 	hal_status = rtw_hal_bb_ra_update(hal_info, sta);
 	if (hal_status != RTW_HAL_STATUS_SUCCESS)
 		PHL_ERR("rtw_hal_bb_ra_update failed\n");
+	hal_h2c_coal_leave(hal_info,
+			   H2C_COAL_TOKEN(H2C_COAL_SEQ_STA_UPD, sta->macid));
 
 	return hal_status;
 }
@@ -712,6 +725,7 @@ rtw_hal_del_sta_entry(void *hal, struct rtw_phl_stainfo_t *sta)
 	enum rtw_hal_status hal_status = RTW_HAL_STATUS_FAILURE;
 
 	_hal_sta_set_default_value(hal_info, sta);
+	hal_wd_tmpl_invalidate(hal_info, sta->macid);
 
 	hal_status = rtw_hal_mac_addr_cam_del_entry(hal_info, sta);
 	if (hal_status != RTW_HAL_STATUS_SUCCESS)
@@ -260,6 +260,18 @@ struct hal_info_t {
 	void *efuse;
 	enum rtw_rx_fltr_mode rx_fltr_mode;
 	u8 monitor_mode; /* default: 0 */
+#ifdef CONFIG_PHL_WD_TMPL_CACHE
+	void *wd_tmpl; /* struct hal_wd_tmpl_cache */
+#endif
+#ifdef CONFIG_PHL_RX_CLS
+	void *rx_cls; /* struct hal_rx_cls */
+#endif
+#ifdef CONFIG_PHL_DLE_REBAL
+	void *dle_rebal; /* struct hal_dle_rebal */
+#endif
+#ifdef CONFIG_PHL_FAST_CHSW
+	void *chsw; /* struct hal_chsw */
+#endif
 };
 
 struct hal_c2h_hdl {
@@ -119,6 +119,238 @@ enum rtw_hal_status rtw_hal_fill_txdesc(void *hal, struct rtw_xmit_req *treq,
 	return rtw_hal_mac_ax_fill_txdesc(hal_info->mac, treq, wd_buf, wd_len);
 }
 
+#ifdef CONFIG_PHL_WD_TMPL_CACHE
+static struct hal_wd_tmpl_cache *_hal_get_wd_tmpl(struct hal_info_t *hal_info)
+{
+	return (struct hal_wd_tmpl_cache *)hal_info->wd_tmpl;
+}
+
+/*
+ * Direct mapped by (macid, tid), the dbcc band and wmm flip the upper
+ * index bits so a macid/tid sent on both bands keeps two templates.
+ */
+static u32 _hal_wd_tmpl_idx(struct rtw_t_meta_data *mdata)
+{
+	u32 idx = (u32)mdata->macid * 8 + mdata->tid;
+
+	idx ^= (u32)(((mdata->band & 0x1) << 1) | (mdata->wmm & 0x1)) << 6;
+
+	return idx & (HAL_WD_TMPL_NUM - 1);
+}
+
+/*
+ * Everything build_txdesc packs except pktlen, sw_seq, hw_ssn_sel, ampdu_en
+ * and bk, which are patched into the template on every hit.
+ */
+static bool _hal_wd_tmpl_match(struct rtw_t_meta_data *key,
+			       struct rtw_t_meta_data *mdata)
+{
+	/* slot key */
+	if (key->macid != mdata->macid || key->tid != mdata->tid ||
+	    key->band != mdata->band || key->wmm != mdata->wmm)
+		return false;
+
+	if (key->dma_ch != mdata->dma_ch || key->hal_port != mdata->hal_port ||
+	    key->bc != mdata->bc || key->mc != mdata->mc)
+		return false;
+
+	/* hdr conversion & hw amsdu */
+	if (key->hw_seq_mode != mdata->hw_seq_mode ||
+	    key->smh_en != mdata->smh_en || key->hw_amsdu != mdata->hw_amsdu ||
+	    key->hdr_len != mdata->hdr_len ||
+	    key->wp_offset != mdata->wp_offset ||
+	    key->shcut_camid != mdata->shcut_camid ||
+	    key->wd_page_size != mdata->wd_page_size ||
+	    key->wdinfo_en != mdata->wdinfo_en ||
+	    key->usb_pkt_ofst != mdata->usb_pkt_ofst)
+		return false;
+
+	/* sec */
+	if (key->hw_sec_iv != mdata->hw_sec_iv ||
+	    key->sec_cam_idx != mdata->sec_cam_idx ||
+	    key->sec_hw_enc != mdata->sec_hw_enc ||
+	    key->sec_type != mdata->sec_type)
+		return false;
+
+	/* ampdu */
+	if (key->max_agg_num != mdata->max_agg_num ||
+	    key->ampdu_density != mdata->ampdu_density)
+		return false;
+
+	/* rate */
+	if (key->f_rate != mdata->f_rate || key->f_bw != mdata->f_bw ||
+	    key->f_gi_ltf != mdata->f_gi_ltf ||
+	    key->userate_sel != mdata->userate_sel ||
+	    key->data_bw_er != mdata->data_bw_er ||
+	    key->f_ldpc != mdata->f_ldpc || key->f_stbc != mdata->f_stbc ||
+	    key->f_dcm != mdata->f_dcm || key->f_er != mdata->f_er)
+		return false;
+
+	/* a ctrl, tx cnt & rty rate */
+	if (key->a_ctrl_uph != mdata->a_ctrl_uph ||
+	    key->a_ctrl_bsr != mdata->a_ctrl_bsr ||
+	    key->a_ctrl_cas != mdata->a_ctrl_cas ||
+	    key->dis_rts_rate_fb != mdata->dis_rts_rate_fb ||
+	    key->dis_data_rate_fb != mdata->dis_data_rate_fb ||
+	    key->data_rty_lowest_rate != mdata->data_rty_lowest_rate ||
+	    key->data_tx_cnt_lmt != mdata->data_tx_cnt_lmt ||
+	    key->data_tx_cnt_lmt_en != mdata->data_tx_cnt_lmt_en)
+		return false;
+
+	/* protection & misc */
+	if (key->rts_en != mdata->rts_en || key->cts2self != mdata->cts2self ||
+	    key->rts_cca_mode != mdata->rts_cca_mode ||
+	    key->hw_rts_en != mdata->hw_rts_en ||
+	    key->mbssid != mdata->mbssid ||
+	    key->nav_use_hdr != mdata->nav_use_hdr ||
+	    key->ack_ch_info != mdata->ack_ch_info ||
+	    key->life_time_sel != mdata->life_time_sel ||
+	    key->spe_rpt != mdata->spe_rpt)
+		return false;
+
+	return true;
+}
+
+static bool _hal_wd_tmpl_cacheable(struct rtw_t_meta_data *mdata)
+{
+	if (RTW_PHL_PKT_TYPE_DATA != mdata->type)
+		return false;
+	if (mdata->macid >= HAL_WD_TMPL_MACID_NUM || mdata->tid >= 8)
+		return false;
+	/* sounding and test frames are rare, not worth a slot */
+	if (mdata->ndpa || mdata->snd_pkt_sel || mdata->sifs_tx ||
+	    mdata->rtt_en || mdata->sw_define || mdata->mac_priv)
+		return false;
+
+	return true;
+}
+
+enum rtw_hal_status hal_wd_tmpl_init(struct hal_info_t *hal_info)
+{
+	void *drv_priv = hal_to_drvpriv(hal_info);
+	struct hal_wd_tmpl_cache *cache = NULL;
+
+	cache = _os_mem_alloc(drv_priv, sizeof(*cache));
+	if (NULL == cache) {
+		PHL_ERR("%s: alloc wd template cache failed\n", __func__);
+		return RTW_HAL_STATUS_RESOURCE;
+	}
+	_os_mem_set(drv_priv, cache, 0, sizeof(*cache));
+	hal_info->wd_tmpl = cache;
+
+	return RTW_HAL_STATUS_SUCCESS;
+}
+
+void hal_wd_tmpl_deinit(struct hal_info_t *hal_info)
+{
+	void *drv_priv = hal_to_drvpriv(hal_info);
+
+	if (NULL == hal_info->wd_tmpl)
+		return;
+
+	_os_mem_free(drv_priv, hal_info->wd_tmpl,
+		     sizeof(struct hal_wd_tmpl_cache));
+	hal_info->wd_tmpl = NULL;
+}
+
+/**
+ * hal_wd_tmpl_invalidate - drop the wd templates of a macid
+ * @hal_info: see struct hal_info_t
+ * @macid: the station whose entry or key was changed
+ *
+ * Only the generation is bumped, so this is safe against the tx path
+ * looking up the cache at the same time.
+ */
+void hal_wd_tmpl_invalidate(struct hal_info_t *hal_info, u16 macid)
+{
+	struct hal_wd_tmpl_cache *cache = _hal_get_wd_tmpl(hal_info);
+	u32 i;
+
+	if (NULL == cache || macid >= HAL_WD_TMPL_MACID_NUM)
+		return;
+
+	/* on wrap a template built 2^32 changes ago would match again */
+	if (0 == ++cache->gen[macid]) {
+		for (i = 0; i < HAL_WD_TMPL_NUM; i++) {
+			if (cache->entry[i].key.macid == macid)
+				cache->entry[i].valid = 0;
+		}
+	}
+	cache->stats.invalidate_cnt++;
+}
+
+struct hal_wd_tmpl_entry *
+hal_wd_tmpl_lookup(struct hal_info_t *hal_info, struct rtw_t_meta_data *mdata)
+{
+	struct hal_wd_tmpl_cache *cache = _hal_get_wd_tmpl(hal_info);
+	struct hal_wd_tmpl_entry *tmpl = NULL;
+
+	if (NULL == cache)
+		return NULL;
+
+	if (false == _hal_wd_tmpl_cacheable(mdata)) {
+		cache->stats.bypass_cnt++;
+		return NULL;
+	}
+
+	tmpl = &cache->entry[_hal_wd_tmpl_idx(mdata)];
+	if (tmpl->valid &&
+	    tmpl->gen == cache->gen[mdata->macid] &&
+	    _hal_wd_tmpl_match(&tmpl->key, mdata)) {
+		cache->stats.hit_cnt++;
+		return tmpl;
+	}
+
+	cache->stats.miss_cnt++;
+	return NULL;
+}
+
+void hal_wd_tmpl_store(struct hal_info_t *hal_info,
+		       struct rtw_t_meta_data *mdata, u8 *wd, u32 wd_len)
+{
+	struct hal_wd_tmpl_cache *cache = _hal_get_wd_tmpl(hal_info);
+	struct hal_wd_tmpl_entry *tmpl = NULL;
+
+	if (NULL == cache || wd_len > HAL_WD_TMPL_LEN)
+		return;
+
+	if (false == _hal_wd_tmpl_cacheable(mdata))
+		return;
+
+	tmpl = &cache->entry[_hal_wd_tmpl_idx(mdata)];
+	tmpl->valid = 0;
+	tmpl->gen = cache->gen[mdata->macid];
+	_os_mem_cpy(hal_to_drvpriv(hal_info), &tmpl->key, mdata,
+		    sizeof(tmpl->key));
+	tmpl->wd_len = (u8)wd_len;
+	_os_mem_cpy(hal_to_drvpriv(hal_info), tmpl->wd, wd, wd_len);
+	tmpl->valid = 1;
+}
+#endif /* CONFIG_PHL_WD_TMPL_CACHE */
+
+void rtw_hal_get_wd_tmpl_stats(void *hal, struct rtw_wd_tmpl_stats *stats)
+{
+#ifdef CONFIG_PHL_WD_TMPL_CACHE
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+	struct hal_wd_tmpl_cache *cache = _hal_get_wd_tmpl(hal_info);
+
+	if (cache) {
+		_os_mem_cpy(hal_to_drvpriv(hal_info), stats, &cache->stats,
+			    sizeof(*stats));
+		return;
+	}
+#endif
+	_os_mem_set(NULL, stats, 0, sizeof(*stats));
+}
+
+enum rtw_hal_status rtw_hal_upd_shcut_mhdr(void *hal, u16 macid,
+					   u8 *hdr, u8 hdr_len)
+{
+	struct hal_info_t *hal_info = (struct hal_info_t *)hal;
+
+	return rtw_hal_mac_upd_shcut_mhdr(hal_info, macid, hdr, hdr_len);
+}
+
 enum rtw_hal_status
 rtw_hal_poll_hw_tx_done(void *hal)
 {
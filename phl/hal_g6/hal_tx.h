@@ -42,4 +42,42 @@ u16 hal_calc_avail_wptr(u16 rptr, u16 wptr, u16 bndy);
 u8 rtw_hal_query_txch_num(void *hal);
 #endif
 
+#ifdef CONFIG_PHL_WD_TMPL_CACHE
+#define HAL_WD_TMPL_NUM 256 /* power of 2, direct mapped by (macid, tid, band, wmm) */
+#define HAL_WD_TMPL_MACID_NUM 128
+#define HAL_WD_TMPL_LEN 48 /* wd body + wd info */
+
+/**
+ * struct hal_wd_tmpl_entry - packed wd body/info of one (macid, tid)
+ * @key: mdata the template was built with, see _hal_wd_tmpl_match()
+ * @gen: generation of the macid when the template was built
+ */
+struct hal_wd_tmpl_entry {
+	struct rtw_t_meta_data key;
+	u8 valid;
+	u8 wd_len;
+	u32 gen;
+	u8 wd[HAL_WD_TMPL_LEN];
+};
+
+struct hal_wd_tmpl_cache {
+	struct hal_wd_tmpl_entry entry[HAL_WD_TMPL_NUM];
+	/* bumped by sta/key change, stale templates are treated as miss */
+	u32 gen[HAL_WD_TMPL_MACID_NUM];
+	struct rtw_wd_tmpl_stats stats;
+};
+
+enum rtw_hal_status hal_wd_tmpl_init(struct hal_info_t *hal_info);
+void hal_wd_tmpl_deinit(struct hal_info_t *hal_info);
+void hal_wd_tmpl_invalidate(struct hal_info_t *hal_info, u16 macid);
+struct hal_wd_tmpl_entry *
+hal_wd_tmpl_lookup(struct hal_info_t *hal_info, struct rtw_t_meta_data *mdata);
+void hal_wd_tmpl_store(struct hal_info_t *hal_info,
+		       struct rtw_t_meta_data *mdata, u8 *wd, u32 wd_len);
+#else
+#define hal_wd_tmpl_init(_hal) RTW_HAL_STATUS_SUCCESS
+#define hal_wd_tmpl_deinit(_hal)
+#define hal_wd_tmpl_invalidate(_hal, _macid)
+#endif /* CONFIG_PHL_WD_TMPL_CACHE */
+
 #endif /*_HAL_TX_H_*/
@@ -38,6 +38,7 @@ enum rtw_hal_status rtw_hal_set_tx_power(void *hal, u8 band_idx,
 	if (band_idx == 1)
 		phy_idx = HW_PHY_1;
 
+	hal_chsw_inval(hal_info);
 	return rtw_hal_rf_set_power(hal_info, phy_idx, pwr_table);
 }
 
@@ -2645,6 +2645,11 @@ void dle_quota_cfg(struct mac_ax_adapter *adapter, struct dle_mem_t *cfg)
 {
 	wde_quota_cfg(adapter, cfg->wde_min_qt, cfg->wde_max_qt);
 	ple_quota_cfg(adapter, cfg->ple_min_qt, cfg->ple_max_qt);
+
+	/* table quota programmed, rebalancer starts over from it */
+	adapter->dle_info.rebal_tx_max = cfg->ple_max_qt->cma0_tx;
+	adapter->dle_info.rebal_rx_max = cfg->ple_max_qt->cma0_dma;
+	adapter->dle_info.rebal_prof = MAC_AX_DLE_REBAL_BALANCED;
 }
 
 u32 dle_quota_change(struct mac_ax_adapter *adapter, enum mac_ax_qta_mode mode)
@@ -2862,6 +2867,38 @@ u32 is_qta_poh(struct mac_ax_adapter *adapter, enum mac_ax_qta_mode mode,
 	return MACSUCCESS;
 }
 
+/*
+ * Put cmac0 tx/rx max back to the rebalancer base before the rx quota
+ * patch below changes it, so the patch never saves or restores a shifted
+ * max and the next profile change starts from the patched quota.
+ */
+static void _patch_rebal_reset(struct mac_ax_adapter *adapter)
+{
+	struct mac_ax_intf_ops *ops = adapter_to_intf_ops(adapter);
+	struct mac_ax_dle_info *info = &adapter->dle_info;
+	u32 tx_val32, rx_val32;
+
+	if (info->rebal_prof == MAC_AX_DLE_REBAL_BALANCED)
+		return;
+
+	tx_val32 = MAC_REG_R32(R_AX_PLE_QTA0_CFG);
+	rx_val32 = MAC_REG_R32(R_AX_PLE_QTA6_CFG);
+	tx_val32 = SET_CLR_WORD(tx_val32, info->rebal_tx_max,
+				B_AX_PLE_Q0_MAX_SIZE);
+	rx_val32 = SET_CLR_WORD(rx_val32, info->rebal_rx_max,
+				B_AX_PLE_Q6_MAX_SIZE);
+	/* shrink the side that grew first, as in mac_set_dle_rebal */
+	if (info->rebal_prof == MAC_AX_DLE_REBAL_TX_HEAVY) {
+		MAC_REG_W32(R_AX_PLE_QTA0_CFG, tx_val32);
+		MAC_REG_W32(R_AX_PLE_QTA6_CFG, rx_val32);
+	} else {
+		MAC_REG_W32(R_AX_PLE_QTA6_CFG, rx_val32);
+		MAC_REG_W32(R_AX_PLE_QTA0_CFG, tx_val32);
+	}
+
+	info->rebal_prof = MAC_AX_DLE_REBAL_BALANCED;
+}
+
 u32 _patch_redu_rx_qta(struct mac_ax_adapter *adapter)
 {
 	struct mac_ax_intf_ops *ops = adapter_to_intf_ops(adapter);
@@ -2882,6 +2919,8 @@ u32 _patch_redu_rx_qta(struct mac_ax_adapter *adapter)
 		return MACHWERR;
 	}
 
+	_patch_rebal_reset(adapter);
+
 	val32 = MAC_REG_R32(R_AX_PLE_QTA6_CFG);
 	if (!val32) {
 		PLTFM_MSG_ERR("[ERR]no rx 0 qta\n");
@@ -2896,6 +2935,7 @@ u32 _patch_redu_rx_qta(struct mac_ax_adapter *adapter)
 		  qta_min : (qta_max - rdu_pg_num);
 	val32 = SET_CLR_WORD(val32, new_qta, B_AX_PLE_Q6_MAX_SIZE);
 	MAC_REG_W32(R_AX_PLE_QTA6_CFG, val32);
+	adapter->dle_info.rebal_rx_max = new_qta;
 
 	val32 = MAC_REG_R32(R_AX_PLE_QTA7_CFG);
 	if (!val32)
@@ -2922,6 +2962,8 @@ u32 _patch_restr_rx_qta(struct mac_ax_adapter *adapter)
 	      is_chip_id(adapter, MAC_AX_CHIP_ID_8852B)))
 		return MACSUCCESS;
 
+	_patch_rebal_reset(adapter);
+
 	val32 = MAC_REG_R32(R_AX_PLE_QTA6_CFG);
 	if (!val32) {
 		PLTFM_MSG_ERR("[ERR]no rx 0 qta\n");
@@ -2931,6 +2973,7 @@ u32 _patch_restr_rx_qta(struct mac_ax_adapter *adapter)
 			       B_AX_PLE_Q6_MAX_SIZE);
 	if (w_val32 != val32)
 		MAC_REG_W32(R_AX_PLE_QTA6_CFG, w_val32);
+	adapter->dle_info.rebal_rx_max = adapter->dle_info.c0_ori_max;
 
 	val32 = MAC_REG_R32(R_AX_PLE_QTA7_CFG);
 	if (!val32)
@@ -2943,3 +2986,121 @@ u32 _patch_restr_rx_qta(struct mac_ax_adapter *adapter)
 	return MACSUCCESS;
 }
 
+u32 mac_get_dle_occup(struct mac_ax_adapter *adapter,
+		      struct mac_ax_dle_occup *occup)
+{
+	struct mac_ax_intf_ops *ops = adapter_to_intf_ops(adapter);
+	struct dle_dfi_quota_t qta;
+	struct dle_dfi_freepg_t freepg;
+	u32 val32, ret;
+
+	if (adapter->sm.pwr != MAC_AX_PWR_ON)
+		return MACPWRSTAT;
+
+	val32 = MAC_REG_R32(R_AX_PLE_QTA0_CFG);
+	occup->tx_min = GET_FIELD(val32, B_AX_PLE_Q0_MIN_SIZE);
+	occup->tx_max = GET_FIELD(val32, B_AX_PLE_Q0_MAX_SIZE);
+	val32 = MAC_REG_R32(R_AX_PLE_QTA6_CFG);
+	occup->rx_min = GET_FIELD(val32, B_AX_PLE_Q6_MIN_SIZE);
+	occup->rx_max = GET_FIELD(val32, B_AX_PLE_Q6_MAX_SIZE);
+
+	qta.dle_type = DLE_CTRL_TYPE_PLE;
+	qta.qtaid = PLE_QTAID_B0_TXPL;
+	ret = dle_dfi_quota(adapter, &qta);
+	if (ret != MACSUCCESS)
+		return ret;
+	occup->tx_use = qta.use_pgnum;
+
+	qta.qtaid = PLE_QTAID_CMAC0_RX;
+	ret = dle_dfi_quota(adapter, &qta);
+	if (ret != MACSUCCESS)
+		return ret;
+	occup->rx_use = qta.use_pgnum;
+
+	freepg.dle_type = DLE_CTRL_TYPE_PLE;
+	ret = dle_dfi_freepg(adapter, &freepg);
+	if (ret != MACSUCCESS)
+		return ret;
+	occup->pub_pgnum = freepg.pub_pgnum;
+
+	occup->prof = adapter->dle_info.rebal_prof;
+
+	return MACSUCCESS;
+}
+
+u32 mac_set_dle_rebal(struct mac_ax_adapter *adapter,
+		      enum mac_ax_dle_rebal_prof prof)
+{
+	struct mac_ax_intf_ops *ops = adapter_to_intf_ops(adapter);
+	struct mac_ax_dle_info *info = &adapter->dle_info;
+	u32 tx_val32, rx_val32;
+	u16 tx_min, tx_max, rx_min, rx_max, shift;
+
+	if (prof >= MAC_AX_DLE_REBAL_MAX)
+		return MACFUNCINPUT;
+
+	if (!(is_chip_id(adapter, MAC_AX_CHIP_ID_8852A) ||
+	      is_chip_id(adapter, MAC_AX_CHIP_ID_8852B)))
+		return MACHWNOSUP;
+
+	/* cmac1 shares the floating pages in dbcc, keep the table quota */
+	if (is_curr_dbcc(adapter))
+		return MACHWNOSUP;
+
+	if (adapter->sm.pwr != MAC_AX_PWR_ON)
+		return MACPWRSTAT;
+
+	if (prof == info->rebal_prof)
+		return MACSUCCESS;
+
+	tx_val32 = MAC_REG_R32(R_AX_PLE_QTA0_CFG);
+	rx_val32 = MAC_REG_R32(R_AX_PLE_QTA6_CFG);
+	if (!rx_val32) {
+		PLTFM_MSG_ERR("[ERR]no rx 0 qta\n");
+		return MACHWERR;
+	}
+	tx_min = GET_FIELD(tx_val32, B_AX_PLE_Q0_MIN_SIZE);
+	rx_min = GET_FIELD(rx_val32, B_AX_PLE_Q6_MIN_SIZE);
+	if (info->rebal_tx_max < tx_min || info->rebal_rx_max < rx_min)
+		return MACFFCFG;
+
+	/*
+	 * Only the max quota moves and the sum of both max stays that of the
+	 * table, min reservation is untouched so pages in use never exceed
+	 * what the table already allows.
+	 */
+	tx_max = info->rebal_tx_max;
+	rx_max = info->rebal_rx_max;
+	switch (prof) {
+	case MAC_AX_DLE_REBAL_TX_HEAVY:
+		shift = (u16)((rx_max - rx_min) * DLE_REBAL_SHIFT_PCT / 100);
+		tx_max += shift;
+		rx_max -= shift;
+		break;
+	case MAC_AX_DLE_REBAL_RX_HEAVY:
+		shift = (u16)((tx_max - tx_min) * DLE_REBAL_SHIFT_PCT / 100);
+		tx_max -= shift;
+		rx_max += shift;
+		break;
+	default:
+		break;
+	}
+
+	/* shrink first so the two max never overlap during the change */
+	if (tx_max < GET_FIELD(tx_val32, B_AX_PLE_Q0_MAX_SIZE)) {
+		MAC_REG_W32(R_AX_PLE_QTA0_CFG,
+			    SET_CLR_WORD(tx_val32, tx_max, B_AX_PLE_Q0_MAX_SIZE));
+		MAC_REG_W32(R_AX_PLE_QTA6_CFG,
+			    SET_CLR_WORD(rx_val32, rx_max, B_AX_PLE_Q6_MAX_SIZE));
+	} else {
+		MAC_REG_W32(R_AX_PLE_QTA6_CFG,
+			    SET_CLR_WORD(rx_val32, rx_max, B_AX_PLE_Q6_MAX_SIZE));
+		MAC_REG_W32(R_AX_PLE_QTA0_CFG,
+			    SET_CLR_WORD(tx_val32, tx_max, B_AX_PLE_Q0_MAX_SIZE));
+	}
+
+	info->rebal_prof = (u8)prof;
+
+	return MACSUCCESS;
+}
+
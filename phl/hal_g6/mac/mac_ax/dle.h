@@ -100,6 +100,9 @@
 
 #define PLE_QTA_PG128B_12KB 96
 
+/* share of the losing side floating pages moved by the quota rebalancer */
+#define DLE_REBAL_SHIFT_PCT 75
+
 #define QLNKTBL_ADDR_INFO_SEL BIT(0)
 #define QLNKTBL_ADDR_INFO_SEL_0 0
 #define QLNKTBL_ADDR_INFO_SEL_1 1
@@ -740,6 +743,57 @@ u32 is_qta_poh(struct mac_ax_adapter *adapter, enum mac_ax_qta_mode mode,
 u32 _patch_redu_rx_qta(struct mac_ax_adapter *adapter);
 u32 _patch_restr_rx_qta(struct mac_ax_adapter *adapter);
 
+/**
+ * @addtogroup Common
+ * @{
+ * @addtogroup DLE
+ * @{
+ */
+
+/**
+ * @brief mac_get_dle_occup
+ *
+ * Sample cmac0 tx/rx PLE quota and usage for the quota rebalancer
+ *
+ * @param *adapter
+ * @param *occup
+ * @return success or fail
+ * @retval u32
+ */
+
+u32 mac_get_dle_occup(struct mac_ax_adapter *adapter,
+		      struct mac_ax_dle_occup *occup);
+/**
+ * @}
+ * @}
+ */
+
+/**
+ * @addtogroup Common
+ * @{
+ * @addtogroup DLE
+ * @{
+ */
+
+/**
+ * @brief mac_set_dle_rebal
+ *
+ * Move PLE floating pages between cmac0 tx and rx max quota,
+ * min quota is kept so the change is safe with traffic running
+ *
+ * @param *adapter
+ * @param prof
+ * @return success or fail
+ * @retval u32
+ */
+
+u32 mac_set_dle_rebal(struct mac_ax_adapter *adapter,
+		      enum mac_ax_dle_rebal_prof prof);
+/**
+ * @}
+ * @}
+ */
+
 /**
  * @addtogroup Common
  * @{
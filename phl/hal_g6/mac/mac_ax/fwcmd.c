@@ -15,6 +15,7 @@
 
 #include "fwcmd.h"
 #include "mcc.h"
+#include "h2c_agg.h"
 
 #if MAC_AX_FEATURE_HV
 #include "../hv_ax/dbgpkg_hv.h"
@@ -146,15 +147,25 @@ u32 h2c_agg_enqueue(struct mac_ax_adapter *adapter, struct rtw_h2c_pkt *h2cb)
 u32 h2c_agg_enqueue(struct mac_ax_adapter *adapter, struct h2c_buf *h2cb)
 #endif
 {
+	struct mac_ax_h2c_agg_info *agg_info = &adapter->h2c_agg_info;
 	struct mac_ax_h2c_agg_node *h2c_agg_node = NULL;
 	u32 ret = MACSUCCESS;
+	u32 now;
+	u8 cls = MAC_AX_H2C_COAL_NONE;
+	u8 trig = MAC_AX_H2C_COAL_TRIG_MAX;
 
 	PLTFM_MUTEX_LOCK(&adapter->h2c_agg_info.h2c_agg_lock);
 
 	if (!adapter->h2c_agg_info.h2c_agg_en) {
-		/* return fall and send the H2C pkt by the orginal function*/
-		ret = MACNOITEM;
-		goto fail;
+		cls = h2c_coal_cls_chk(adapter, h2cb->id);
+		if (cls == MAC_AX_H2C_COAL_NONE) {
+			/* held h2c go out ahead of the one the caller sends now */
+			if (agg_info->coal_pend_num)
+				trig = MAC_AX_H2C_COAL_TRIG_ORDER;
+			/* return fall and send the H2C pkt by the orginal function*/
+			ret = MACNOITEM;
+			goto fail;
+		}
 	}
 
 	h2c_agg_node = (struct mac_ax_h2c_agg_node *)
@@ -168,6 +179,7 @@ u32 h2c_agg_enqueue(struct mac_ax_adapter *adapter, struct h2c_buf *h2cb)
 	PLTFM_MEMSET(h2c_agg_node, 0, sizeof(struct mac_ax_h2c_agg_node));
 	h2c_agg_node->h2c_pkt = (u8 *)h2cb;
 	h2c_agg_node->next = NULL;
+	h2c_agg_node->coal_cls = cls;
 	adapter->h2c_agg_info.h2c_agg_pkt_num++;
 
 	if (!adapter->h2c_agg_info.h2c_agg_queue_head) {
@@ -178,8 +190,28 @@ u32 h2c_agg_enqueue(struct mac_ax_adapter *adapter, struct h2c_buf *h2cb)
 		adapter->h2c_agg_info.h2c_agg_queue_last = h2c_agg_node;
 	}
 
+	if (cls != MAC_AX_H2C_COAL_NONE) {
+		now = PLTFM_GET_TIME_US();
+		h2c_agg_node->enq_t = now;
+		if (!agg_info->coal_pend_num)
+			agg_info->coal_first_t = now;
+		agg_info->coal_pend_num++;
+		#if MAC_AX_PHL_H2C
+		agg_info->coal_pend_len += ALIGN_4_BYTE(h2cb->data_len) +
+					   H2C_AGG_SUB_HDR_LEN;
+		#else
+		agg_info->coal_pend_len += ALIGN_4_BYTE(h2cb->len) +
+					   H2C_AGG_SUB_HDR_LEN;
+		#endif
+		trig = h2c_coal_trig_chk(adapter, now);
+	}
+
 fail:
 	PLTFM_MUTEX_UNLOCK(&adapter->h2c_agg_info.h2c_agg_lock);
+
+	if (trig != MAC_AX_H2C_COAL_TRIG_MAX)
+		h2c_coal_flush(adapter, trig);
+
 	return ret;
 }
 
@@ -77,6 +77,87 @@ fail:
 	return ret;
 }
 
+static u8 h2c_coal_get_cls(u32 id)
+{
+	u8 cat = (u8)GET_FWCMD_CAT(id);
+	u8 cl = (u8)GET_FWCMD_CLASS(id);
+	u8 func = (u8)GET_FWCMD_FUNC(id);
+
+	if (cat == FWCMD_H2C_CAT_OUTSRC) {
+		if (cl != FWCMD_H2C_CL_RA)
+			return MAC_AX_H2C_COAL_NONE;
+		return func == H2C_COAL_FUNC_RA_GET_TXSTS ?
+		       MAC_AX_H2C_COAL_STATS : MAC_AX_H2C_COAL_RA;
+	}
+
+	if (cat != FWCMD_H2C_CAT_MAC)
+		return MAC_AX_H2C_COAL_NONE;
+
+	switch (cl) {
+	case FWCMD_H2C_CL_ADDR_CAM_UPDATE:
+	case FWCMD_H2C_CL_SEC_CAM:
+		return MAC_AX_H2C_COAL_CAM;
+	case FWCMD_H2C_CL_MEDIA_RPT:
+	case FWCMD_H2C_CL_FR_EXCHG:
+		return MAC_AX_H2C_COAL_ROLE;
+	default:
+		return MAC_AX_H2C_COAL_NONE;
+	}
+}
+
+static u8 h2c_coal_batch_bin(u32 num)
+{
+	if (num <= 2)
+		return (u8)(num - 1);
+	if (num <= 4)
+		return 2;
+	if (num <= 8)
+		return 3;
+	return MAC_AX_H2C_COAL_BATCH_BIN - 1;
+}
+
+static void h2c_coal_node_done(struct mac_ax_adapter *adapter,
+			       struct mac_ax_h2c_agg_node *node, u32 now)
+{
+	struct mac_ax_h2c_coal_cls_stat *cls_stat;
+	u32 lat;
+
+	if (node->coal_cls >= MAC_AX_H2C_COAL_MAX)
+		return;
+
+	cls_stat = &adapter->h2c_agg_info.coal_stat.cls[node->coal_cls];
+	lat = now - node->enq_t;
+	cls_stat->pkt_cnt++;
+	cls_stat->lat_sum_us += lat;
+	if (lat > cls_stat->lat_max_us)
+		cls_stat->lat_max_us = lat;
+}
+
+/* caller holds h2c_agg_lock */
+static void h2c_agg_drop_all(struct mac_ax_adapter *adapter)
+{
+	struct mac_ax_h2c_agg_node *cur_agg_node = NULL;
+	struct mac_ax_h2c_agg_node *tmp_agg_node = NULL;
+
+	cur_agg_node = adapter->h2c_agg_info.h2c_agg_queue_head;
+	while (cur_agg_node) {
+#if MAC_AX_PHL_H2C
+		PLTFM_RECYCLE_H2C((struct rtw_h2c_pkt *)cur_agg_node->h2c_pkt);
+#else
+		h2cb_free(adapter, (struct h2c_buf *)cur_agg_node->h2c_pkt);
+#endif
+		tmp_agg_node = cur_agg_node;
+		cur_agg_node = cur_agg_node->next;
+		PLTFM_FREE(tmp_agg_node, sizeof(struct mac_ax_h2c_agg_node));
+	}
+
+	adapter->h2c_agg_info.h2c_agg_queue_head = NULL;
+	adapter->h2c_agg_info.h2c_agg_queue_last = NULL;
+	adapter->h2c_agg_info.h2c_agg_pkt_num = 0;
+	adapter->h2c_agg_info.coal_pend_num = 0;
+	adapter->h2c_agg_info.coal_pend_len = 0;
+}
+
 void mac_h2c_agg_enable(struct mac_ax_adapter *adapter, u8 enable)
 {
 	PLTFM_MUTEX_LOCK(&adapter->h2c_agg_info.h2c_agg_lock);
@@ -101,6 +182,7 @@ u32 mac_h2c_agg_tx(struct mac_ax_adapter *adapter)
 	u32 cur_sub_h2c_len_swap = 0;
 	u32 next_h2cb_len = 0;
 	u32 ret = MACSUCCESS;
+	u32 now = 0;
 	u8 *cur_h2cb_data = NULL;
 	u8 *buf = NULL;
 
@@ -109,6 +191,9 @@ u32 mac_h2c_agg_tx(struct mac_ax_adapter *adapter)
 	if (!adapter->h2c_agg_info.h2c_agg_queue_head)
 		goto fail;
 
+	if (adapter->h2c_agg_info.coal_pend_num)
+		now = PLTFM_GET_TIME_US();
+
 	cur_agg_node = adapter->h2c_agg_info.h2c_agg_queue_head;
 	agg_h2cb = NULL;
 	agg_len = 0;
@@ -140,6 +225,8 @@ u32 mac_h2c_agg_tx(struct mac_ax_adapter *adapter)
 					PLTFM_MSG_ERR("tx normal h2c pkt fail\n");
 					goto fail;
 				}
+				adapter->h2c_agg_info.coal_stat.tx_cnt++;
+				h2c_coal_node_done(adapter, cur_agg_node, now);
 
 				tmp_agg_node = cur_agg_node;
 				cur_agg_node = cur_agg_node->next;
@@ -170,6 +257,7 @@ u32 mac_h2c_agg_tx(struct mac_ax_adapter *adapter)
 		PLTFM_MEMCPY(buf, &cur_sub_h2c_len_swap, H2C_AGG_SUB_HDR_LEN);
 		PLTFM_MEMCPY(buf + H2C_AGG_SUB_HDR_LEN, cur_h2cb_data, cur_h2cb_len);
 		agg_len = agg_len + cur_sub_h2c_len + H2C_AGG_SUB_HDR_LEN;
+		h2c_coal_node_done(adapter, cur_agg_node, now);
 
 		tmp_agg_node = cur_agg_node;
 		cur_agg_node = cur_agg_node->next;
@@ -190,6 +278,7 @@ u32 mac_h2c_agg_tx(struct mac_ax_adapter *adapter)
 				PLTFM_MSG_ERR("tx normal agg_h2c pkt fail\n");
 				goto fail;
 			}
+			adapter->h2c_agg_info.coal_stat.tx_cnt++;
 			agg_h2cb = NULL;
 			agg_len = 0;
 		}
@@ -199,7 +288,8 @@ fail:
 	if (ret) {
 		PLTFM_MSG_ERR("h2c agg error handle\n");
 
-		mac_h2c_agg_flush(adapter);
+		/* h2c_agg_lock is held, mac_h2c_agg_flush would take it again */
+		h2c_agg_drop_all(adapter);
 
 		if (agg_h2cb) {
 #if MAC_AX_PHL_H2C
@@ -212,6 +302,8 @@ fail:
 		adapter->h2c_agg_info.h2c_agg_queue_head = NULL;
 		adapter->h2c_agg_info.h2c_agg_queue_last = NULL;
 		adapter->h2c_agg_info.h2c_agg_pkt_num = 0;
+		adapter->h2c_agg_info.coal_pend_num = 0;
+		adapter->h2c_agg_info.coal_pend_len = 0;
 	}
 	PLTFM_MUTEX_UNLOCK(&adapter->h2c_agg_info.h2c_agg_lock);
 	return ret;
@@ -219,25 +311,151 @@ fail:
 
 void mac_h2c_agg_flush(struct mac_ax_adapter *adapter)
 {
-	struct mac_ax_h2c_agg_node *cur_agg_node = NULL;
-	struct mac_ax_h2c_agg_node *tmp_agg_node = NULL;
-
 	PLTFM_MUTEX_LOCK(&adapter->h2c_agg_info.h2c_agg_lock);
-	cur_agg_node = adapter->h2c_agg_info.h2c_agg_queue_head;
+	h2c_agg_drop_all(adapter);
+	PLTFM_MUTEX_UNLOCK(&adapter->h2c_agg_info.h2c_agg_lock);
+}
 
-	while (cur_agg_node) {
-#if MAC_AX_PHL_H2C
-		PLTFM_RECYCLE_H2C((struct rtw_h2c_pkt *)cur_agg_node->h2c_pkt);
-#else
-		h2cb_free(adapter, (struct h2c_buf *)cur_agg_node->h2c_pkt);
-#endif
-		tmp_agg_node = cur_agg_node;
-		cur_agg_node = cur_agg_node->next;
-		PLTFM_FREE(tmp_agg_node, sizeof(struct mac_ax_h2c_agg_node));
+/* caller holds h2c_agg_lock */
+u8 h2c_coal_cls_chk(struct mac_ax_adapter *adapter, u32 id)
+{
+	struct mac_ax_h2c_agg_info *info = &adapter->h2c_agg_info;
+	u8 cls;
+
+	if (!info->coal_cfg.en || !info->coal_win)
+		return MAC_AX_H2C_COAL_NONE;
+
+	cls = h2c_coal_get_cls(id);
+	if (cls == MAC_AX_H2C_COAL_NONE || !(info->coal_cfg.cls_map & BIT(cls)))
+		return MAC_AX_H2C_COAL_NONE;
+
+	return cls;
+}
+
+u8 h2c_coal_trig_chk(struct mac_ax_adapter *adapter, u32 now)
+{
+	struct mac_ax_h2c_agg_info *info = &adapter->h2c_agg_info;
+
+	if (info->coal_pend_num >= info->coal_cfg.max_pkt ||
+	    (info->coal_pend_len + WD_BODY_LEN + FWCMD_HDR_LEN) >=
+	    H2C_LONG_DATA_LEN)
+		return MAC_AX_H2C_COAL_TRIG_SIZE;
+
+	if (now - info->coal_first_t >= info->coal_cfg.deadline_us)
+		return MAC_AX_H2C_COAL_TRIG_DEADLINE;
+
+	return MAC_AX_H2C_COAL_TRIG_MAX;
+}
+
+u32 h2c_coal_flush(struct mac_ax_adapter *adapter, u8 trig)
+{
+	struct mac_ax_h2c_agg_info *info = &adapter->h2c_agg_info;
+	u32 num;
+
+	PLTFM_MUTEX_LOCK(&info->h2c_agg_lock);
+	num = info->coal_pend_num;
+	if (num && trig < MAC_AX_H2C_COAL_TRIG_MAX) {
+		info->coal_stat.flush_cnt[trig]++;
+		info->coal_stat.batch_bin[h2c_coal_batch_bin(num)]++;
 	}
+	PLTFM_MUTEX_UNLOCK(&info->h2c_agg_lock);
 
-	adapter->h2c_agg_info.h2c_agg_queue_head = NULL;
-	adapter->h2c_agg_info.h2c_agg_queue_last = NULL;
-	adapter->h2c_agg_info.h2c_agg_pkt_num = 0;
-	PLTFM_MUTEX_UNLOCK(&adapter->h2c_agg_info.h2c_agg_lock);
+	if (!num)
+		return MACSUCCESS;
+
+	return mac_h2c_agg_tx(adapter);
+}
+
+/* deadline check for a queue nothing is added to any more */
+void mac_h2c_coal_expire(struct mac_ax_adapter *adapter)
+{
+	struct mac_ax_h2c_agg_info *info = &adapter->h2c_agg_info;
+	u8 flush;
+
+	PLTFM_MUTEX_LOCK(&info->h2c_agg_lock);
+	flush = info->coal_pend_num &&
+		(PLTFM_GET_TIME_US() - info->coal_first_t >=
+		 info->coal_cfg.deadline_us);
+	PLTFM_MUTEX_UNLOCK(&info->h2c_agg_lock);
+
+	if (flush)
+		h2c_coal_flush(adapter, MAC_AX_H2C_COAL_TRIG_DEADLINE);
 }
+
+u32 mac_h2c_coal_cfg(struct mac_ax_adapter *adapter,
+		     struct mac_ax_h2c_coal_cfg *cfg)
+{
+	struct mac_ax_h2c_agg_info *info = &adapter->h2c_agg_info;
+	u8 flush;
+
+	if (cfg->en && (!cfg->max_pkt || !cfg->deadline_us))
+		return MACFUNCINPUT;
+
+	PLTFM_MUTEX_LOCK(&info->h2c_agg_lock);
+	PLTFM_MEMCPY(&info->coal_cfg, cfg, sizeof(*cfg));
+	flush = !cfg->en && info->coal_pend_num;
+	PLTFM_MUTEX_UNLOCK(&info->h2c_agg_lock);
+
+	if (flush)
+		return h2c_coal_flush(adapter, MAC_AX_H2C_COAL_TRIG_END);
+
+	return MACSUCCESS;
+}
+
+/*
+ * A window is keyed by a token the caller picks for one command sequence,
+ * e.g. the station it is setting up. While any window is open the coalesced
+ * classes are held back whoever sends them, so sequences that overlap share
+ * one batch. Entering an open token again and leaving one that is not open
+ * are no-ops; leaving the last open window flushes the queue.
+ */
+void mac_h2c_coal_win(struct mac_ax_adapter *adapter, u32 token, u8 enter)
+{
+	struct mac_ax_h2c_agg_info *info = &adapter->h2c_agg_info;
+	u8 flush = 0;
+	u8 free_idx = MAC_AX_H2C_COAL_WIN_NUM;
+	u8 i;
+
+	if (!token)
+		return;
+
+	PLTFM_MUTEX_LOCK(&info->h2c_agg_lock);
+	for (i = 0; i < MAC_AX_H2C_COAL_WIN_NUM; i++) {
+		if (info->coal_token[i] == token)
+			break;
+		if (!info->coal_token[i] && free_idx == MAC_AX_H2C_COAL_WIN_NUM)
+			free_idx = i;
+	}
+
+	if (enter) {
+		/* all slots taken, the sequence still runs inside the others */
+		if (i == MAC_AX_H2C_COAL_WIN_NUM &&
+		    free_idx != MAC_AX_H2C_COAL_WIN_NUM) {
+			info->coal_token[free_idx] = token;
+			info->coal_win++;
+		}
+	} else if (i != MAC_AX_H2C_COAL_WIN_NUM) {
+		info->coal_token[i] = 0;
+		info->coal_win--;
+		flush = !info->coal_win && info->coal_pend_num;
+	}
+	PLTFM_MUTEX_UNLOCK(&info->h2c_agg_lock);
+
+	if (flush)
+		h2c_coal_flush(adapter, MAC_AX_H2C_COAL_TRIG_END);
+}
+
+u32 mac_get_h2c_coal_stat(struct mac_ax_adapter *adapter,
+			  struct mac_ax_h2c_coal_stat *stat, u8 rst)
+{
+	struct mac_ax_h2c_agg_info *info = &adapter->h2c_agg_info;
+
+	PLTFM_MUTEX_LOCK(&info->h2c_agg_lock);
+	PLTFM_MEMCPY(stat, &info->coal_stat, sizeof(*stat));
+	if (rst)
+		PLTFM_MEMSET(&info->coal_stat, 0, sizeof(info->coal_stat));
+	PLTFM_MUTEX_UNLOCK(&info->h2c_agg_lock);
+
+	return MACSUCCESS;
+}
+
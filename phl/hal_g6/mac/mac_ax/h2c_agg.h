@@ -26,7 +26,19 @@
 								   H2C_AGG_SUB_HDR_LEN) \
 								  < H2C_LONG_DATA_LEN)
 
+/* outsrc ra class function, the fw reports tx status back by c2h */
+#define H2C_COAL_FUNC_RA_GET_TXSTS 0x2
+
 void mac_h2c_agg_flush(struct mac_ax_adapter *adapter);
 u32 mac_h2c_agg_tx(struct mac_ax_adapter *adapter);
 void mac_h2c_agg_enable(struct mac_ax_adapter *adapter, u8 enable);
+u8 h2c_coal_cls_chk(struct mac_ax_adapter *adapter, u32 id);
+u8 h2c_coal_trig_chk(struct mac_ax_adapter *adapter, u32 now);
+u32 h2c_coal_flush(struct mac_ax_adapter *adapter, u8 trig);
+u32 mac_h2c_coal_cfg(struct mac_ax_adapter *adapter,
+		     struct mac_ax_h2c_coal_cfg *cfg);
+void mac_h2c_coal_win(struct mac_ax_adapter *adapter, u32 token, u8 enter);
+void mac_h2c_coal_expire(struct mac_ax_adapter *adapter);
+u32 mac_get_h2c_coal_stat(struct mac_ax_adapter *adapter,
+			  struct mac_ax_h2c_coal_stat *stat, u8 rst);
 #endif
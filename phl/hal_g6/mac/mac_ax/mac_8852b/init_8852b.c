@@ -503,7 +503,13 @@ static struct mac_ax_ops mac8852b_ops = {
 	mac_get_ch_switch_rpt,
 	mac_cfg_bcn_filter,
 	mac_bcn_filter_rssi,
-	mac_bcn_filter_tp
+	mac_bcn_filter_tp,
+	mac_get_dle_occup,
+	mac_set_dle_rebal,
+	mac_h2c_coal_cfg,
+	mac_h2c_coal_win,
+	mac_h2c_coal_expire,
+	mac_get_h2c_coal_stat
 };
 
 static struct mac_ax_hw_info mac8852b_hw_info = {
@@ -70,6 +70,7 @@
 	hal_udelay(adapter->drv_adapter, us)
 #define PLTFM_DELAY_MS(ms)                                                     \
 	hal_mdelay(adapter->drv_adapter, ms)
+#define PLTFM_GET_TIME_US()	_os_get_cur_time_us()
 #define PLTFM_MUTEX_INIT(mutex)                                                \
 	hal_mutex_init(adapter->drv_adapter, mutex)
 #define PLTFM_MUTEX_DEINIT(mutex)                                              \
@@ -188,6 +189,8 @@
 	adapter->pltfm_cb->rtl_delay_us(adapter->drv_adapter, us)
 #define PLTFM_DELAY_MS(ms)                                                     \
 	adapter->pltfm_cb->rtl_delay_ms(adapter->drv_adapter, ms)
+#define PLTFM_GET_TIME_US()                                                    \
+	adapter->pltfm_cb->rtl_get_time_us(adapter->drv_adapter)
 
 #define PLTFM_MUTEX_INIT(mutex)                                                \
 	adapter->pltfm_cb->rtl_mutex_init(adapter->drv_adapter, mutex)
@@ -4790,10 +4793,129 @@ struct mac_ax_fw_info {
  * Please Place Description here.
  * @var mac_ax_h2c_agg_node::h2c_pkt
  * Please Place Description here.
+ * @var mac_ax_h2c_agg_node::coal_cls
+ * enum mac_ax_h2c_coal_cls, MAC_AX_H2C_COAL_NONE if queued by h2c_agg_en
+ * @var mac_ax_h2c_agg_node::enq_t
+ * enqueue time in us, coalesced h2c only
  */
 struct mac_ax_h2c_agg_node {
 	struct mac_ax_h2c_agg_node *next;
 	u8 *h2c_pkt;
+	u8 coal_cls;
+	u32 enq_t;
+};
+
+/**
+ * @enum mac_ax_h2c_coal_cls
+ *
+ * @brief non-urgent h2c classes held back by the coalescing layer
+ *
+ * @var mac_ax_h2c_coal_cls::MAC_AX_H2C_COAL_RA
+ * outsrc ra macid/rssi/mu config
+ * @var mac_ax_h2c_coal_cls::MAC_AX_H2C_COAL_CAM
+ * address cam and security cam updates
+ * @var mac_ax_h2c_coal_cls::MAC_AX_H2C_COAL_ROLE
+ * join info, fw role maintain and dmac ctrl table updates
+ * @var mac_ax_h2c_coal_cls::MAC_AX_H2C_COAL_STATS
+ * ra tx status requests
+ * @var mac_ax_h2c_coal_cls::MAC_AX_H2C_COAL_NONE
+ * sent as soon as built
+ */
+enum mac_ax_h2c_coal_cls {
+	MAC_AX_H2C_COAL_RA = 0,
+	MAC_AX_H2C_COAL_CAM,
+	MAC_AX_H2C_COAL_ROLE,
+	MAC_AX_H2C_COAL_STATS,
+
+	/* keep last */
+	MAC_AX_H2C_COAL_MAX,
+	MAC_AX_H2C_COAL_NONE = MAC_AX_H2C_COAL_MAX,
+};
+
+/**
+ * @enum mac_ax_h2c_coal_trig
+ *
+ * @brief reason of a coalescing queue flush
+ *
+ * @var mac_ax_h2c_coal_trig::MAC_AX_H2C_COAL_TRIG_SIZE
+ * pending h2c reach max_pkt or fill one aggregated h2c
+ * @var mac_ax_h2c_coal_trig::MAC_AX_H2C_COAL_TRIG_DEADLINE
+ * oldest pending h2c older than deadline_us
+ * @var mac_ax_h2c_coal_trig::MAC_AX_H2C_COAL_TRIG_ORDER
+ * an h2c that is not coalesced is about to be sent
+ * @var mac_ax_h2c_coal_trig::MAC_AX_H2C_COAL_TRIG_END
+ * last coalescing window closed or coalescing disabled
+ */
+enum mac_ax_h2c_coal_trig {
+	MAC_AX_H2C_COAL_TRIG_SIZE = 0,
+	MAC_AX_H2C_COAL_TRIG_DEADLINE,
+	MAC_AX_H2C_COAL_TRIG_ORDER,
+	MAC_AX_H2C_COAL_TRIG_END,
+
+	/* keep last */
+	MAC_AX_H2C_COAL_TRIG_MAX,
+};
+
+/* flushed batch size bins: 1, 2, 3-4, 5-8, 9+ h2c */
+#define MAC_AX_H2C_COAL_BATCH_BIN 5
+/* coalescing windows that can be open at the same time */
+#define MAC_AX_H2C_COAL_WIN_NUM 4
+
+/**
+ * @struct mac_ax_h2c_coal_cfg
+ * @brief mac_ax_h2c_coal_cfg
+ *
+ * @var mac_ax_h2c_coal_cfg::en
+ * hold back h2c of the classes in cls_map inside a coalescing window
+ * @var mac_ax_h2c_coal_cfg::cls_map
+ * BIT(enum mac_ax_h2c_coal_cls)
+ * @var mac_ax_h2c_coal_cfg::max_pkt
+ * size trigger, pending h2c count
+ * @var mac_ax_h2c_coal_cfg::deadline_us
+ * deadline trigger, age of the oldest pending h2c
+ */
+struct mac_ax_h2c_coal_cfg {
+	u8 en;
+	u8 cls_map;
+	u16 max_pkt;
+	u32 deadline_us;
+};
+
+/**
+ * @struct mac_ax_h2c_coal_cls_stat
+ * @brief mac_ax_h2c_coal_cls_stat
+ *
+ * @var mac_ax_h2c_coal_cls_stat::pkt_cnt
+ * h2c of the class released by a flush
+ * @var mac_ax_h2c_coal_cls_stat::lat_sum_us
+ * sum of enqueue to flush latency
+ * @var mac_ax_h2c_coal_cls_stat::lat_max_us
+ * max enqueue to flush latency
+ */
+struct mac_ax_h2c_coal_cls_stat {
+	u32 pkt_cnt;
+	u32 lat_sum_us;
+	u32 lat_max_us;
+};
+
+/**
+ * @struct mac_ax_h2c_coal_stat
+ * @brief mac_ax_h2c_coal_stat
+ *
+ * @var mac_ax_h2c_coal_stat::flush_cnt
+ * flushes per enum mac_ax_h2c_coal_trig
+ * @var mac_ax_h2c_coal_stat::batch_bin
+ * flushes per batch size bin, see MAC_AX_H2C_COAL_BATCH_BIN
+ * @var mac_ax_h2c_coal_stat::tx_cnt
+ * h2c packets put on the bus by flushes, aggregated or single
+ * @var mac_ax_h2c_coal_stat::cls
+ * per class counters
+ */
+struct mac_ax_h2c_coal_stat {
+	u32 flush_cnt[MAC_AX_H2C_COAL_TRIG_MAX];
+	u32 batch_bin[MAC_AX_H2C_COAL_BATCH_BIN];
+	u32 tx_cnt;
+	struct mac_ax_h2c_coal_cls_stat cls[MAC_AX_H2C_COAL_MAX];
 };
 
 /**
@@ -4810,6 +4932,20 @@ struct mac_ax_h2c_agg_node {
  * Please Place Description here.
  * @var mac_ax_h2c_agg_info::h2c_agg_lock
  * Please Place Description here.
+ * @var mac_ax_h2c_agg_info::coal_cfg
+ * coalescing configuration
+ * @var mac_ax_h2c_agg_info::coal_stat
+ * coalescing statistics
+ * @var mac_ax_h2c_agg_info::coal_win
+ * number of open coalescing windows
+ * @var mac_ax_h2c_agg_info::coal_token
+ * tokens of the open coalescing windows, 0 is a free slot
+ * @var mac_ax_h2c_agg_info::coal_pend_num
+ * coalesced h2c in the queue
+ * @var mac_ax_h2c_agg_info::coal_pend_len
+ * bytes of the coalesced h2c in the queue
+ * @var mac_ax_h2c_agg_info::coal_first_t
+ * enqueue time of the oldest coalesced h2c in the queue
  */
 struct mac_ax_h2c_agg_info {
 	u8 h2c_agg_en;
@@ -4817,6 +4953,13 @@ struct mac_ax_h2c_agg_info {
 	struct mac_ax_h2c_agg_node *h2c_agg_queue_head;
 	struct mac_ax_h2c_agg_node *h2c_agg_queue_last;
 	mac_ax_mutex h2c_agg_lock;
+	struct mac_ax_h2c_coal_cfg coal_cfg;
+	struct mac_ax_h2c_coal_stat coal_stat;
+	u8 coal_win;
+	u32 coal_token[MAC_AX_H2C_COAL_WIN_NUM];
+	u32 coal_pend_num;
+	u32 coal_pend_len;
+	u32 coal_first_t;
 };
 
 /**
@@ -4882,6 +5025,52 @@ struct mac_ax_dle_info {
 	u16 c1_ori_max;
 	u16 c0_tx_min;
 	u16 c1_tx_min;
+	u16 rebal_tx_max;
+	u16 rebal_rx_max;
+	u8 rebal_prof;
+};
+
+/**
+ * @enum mac_ax_dle_rebal_prof
+ *
+ * @brief split of the PLE floating pages between cmac0 tx and rx
+ *
+ * @var mac_ax_dle_rebal_prof::MAC_AX_DLE_REBAL_BALANCED
+ * max quota of the dle_mem table
+ * @var mac_ax_dle_rebal_prof::MAC_AX_DLE_REBAL_TX_HEAVY
+ * most of the rx floating pages moved to tx
+ * @var mac_ax_dle_rebal_prof::MAC_AX_DLE_REBAL_RX_HEAVY
+ * most of the tx floating pages moved to rx
+ */
+enum mac_ax_dle_rebal_prof {
+	MAC_AX_DLE_REBAL_BALANCED = 0,
+	MAC_AX_DLE_REBAL_TX_HEAVY,
+	MAC_AX_DLE_REBAL_RX_HEAVY,
+	MAC_AX_DLE_REBAL_MAX
+};
+
+/**
+ * @struct mac_ax_dle_occup
+ * @brief mac_ax_dle_occup
+ *
+ * @var mac_ax_dle_occup::tx_use
+ * pages in use by cmac0 tx, PLE quota 0
+ * @var mac_ax_dle_occup::rx_use
+ * pages in use by cmac0 rx, PLE quota 6
+ * @var mac_ax_dle_occup::pub_pgnum
+ * PLE free public pages
+ * @var mac_ax_dle_occup::prof
+ * enum mac_ax_dle_rebal_prof in effect
+ */
+struct mac_ax_dle_occup {
+	u16 tx_min;
+	u16 tx_max;
+	u16 tx_use;
+	u16 rx_min;
+	u16 rx_max;
+	u16 rx_use;
+	u16 pub_pgnum;
+	u8 prof;
 };
 
 /**
@@ -14078,6 +14267,7 @@ struct mac_ax_pltfm_cb {
 
 	u8 (*ld_fw_symbol)(void *phl_adapter, void *drv_adapter,
 			   const char *name, u8 **buf, u32 *buf_size);
+	u32 (*rtl_get_time_us)(void *drv_adapter);
 };
 #endif/*CONFIG_NEW_HALMAC_INTERFACE*/
 
@@ -15538,6 +15728,17 @@ struct mac_ax_ops {
 	u32 (*cfg_bcn_filter)(struct mac_ax_adapter *adapter, struct mac_ax_bcn_fltr cfg);
 	u32 (*bcn_filter_rssi)(struct mac_ax_adapter *adapter, u8 macid, u8 size, u8 *rssi);
 	u32 (*bcn_filter_tp)(struct mac_ax_adapter *adapter, u8 macid, u16 tx, u16 rx);
+	u32 (*get_dle_occup)(struct mac_ax_adapter *adapter,
+			     struct mac_ax_dle_occup *occup);
+	u32 (*set_dle_rebal)(struct mac_ax_adapter *adapter,
+			     enum mac_ax_dle_rebal_prof prof);
+	u32 (*h2c_coal_cfg)(struct mac_ax_adapter *adapter,
+			    struct mac_ax_h2c_coal_cfg *cfg);
+	void (*h2c_coal_win)(struct mac_ax_adapter *adapter, u32 token,
+			     u8 enter);
+	void (*h2c_coal_expire)(struct mac_ax_adapter *adapter);
+	u32 (*get_h2c_coal_stat)(struct mac_ax_adapter *adapter,
+				 struct mac_ax_h2c_coal_stat *stat, u8 rst);
 };
 
 #endif
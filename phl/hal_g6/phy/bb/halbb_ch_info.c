@@ -187,10 +187,13 @@ void halbb_cfg_ch_info_en(struct bb_info *bb, enum bb_ch_info_en_t en,
 		halbb_set_reg(bb, cr->ch_info_en_0, BIT1, val_32);
 
 	/*Phy-sts IE 8 Enable*/
-	if(en == CH_INFO_DISABLE || en == CH_INFO_FROM_CH_STS)
+	if(en == CH_INFO_DISABLE || en == CH_INFO_FROM_CH_STS) {
 		halbb_physts_ie_bitmap_en(bb, bitmap, IE08_FTR_CH, false);
-	else
+		halbb_physts_ie_sub(bb, PHYSTS_SUB_CH_INFO, 0);
+	} else {
 		halbb_physts_ie_bitmap_en(bb, bitmap, IE08_FTR_CH, true);
+		halbb_physts_ie_sub(bb, PHYSTS_SUB_CH_INFO, BIT(IE08_FTR_CH));
+	}
 }
 
 void halbb_cfg_ch_info_buff(struct bb_info *bb, struct bb_ch_info_buf_cfg_info *cfg)
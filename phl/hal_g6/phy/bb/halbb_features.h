@@ -41,6 +41,9 @@
 
 #ifndef DRV_BB_PHYSTS_PARSING_DISABLE
 	#define HALBB_PHYSTS_PARSING_SUPPORT
+	#ifndef DRV_BB_PHYSTS_SUB_DISABLE
+	#define HALBB_PHYSTS_SUB_SUPPORT
+	#endif
 #endif
 #ifndef DRV_BB_ENV_MNTR_DISABLE
 	#define HALBB_ENV_MNTR_SUPPORT
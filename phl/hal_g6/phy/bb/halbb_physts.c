@@ -786,6 +786,29 @@ void halbb_physts_ie_bitmap_en(struct bb_info *bb, enum bb_physts_bitmap_t type,
 	halbb_physts_ie_bitmap_set(bb, type, bitmap);
 }
 
+#ifdef HALBB_PHYSTS_SUB_SUPPORT
+void halbb_physts_ie_sub(struct bb_info *bb, enum bb_physts_sub_t sub,
+			 u32 ie_map)
+{
+	struct bb_physts_info *physts = &bb->bb_physts_i;
+	u32 parse_map = PHYSTS_IE_RSVD_MAP;
+	u8 i;
+
+	if (sub >= PHYSTS_SUB_NUM)
+		return;
+
+	physts->ie_sub[sub] = ie_map;
+
+	for (i = 0; i < PHYSTS_SUB_NUM; i++)
+		parse_map |= physts->ie_sub[i];
+
+	physts->ie_parse_map = parse_map;
+
+	BB_DBG(bb, DBG_PHY_STS, "[%s] sub[%d]=0x%08x, parse_map=0x%08x\n",
+	       __func__, sub, ie_map, parse_map);
+}
+#endif
+
 void halbb_physts_brk_fail_rpt_en(struct bb_info *bb, bool enable,
 				   enum phl_phy_idx phy_idx)
 {
@@ -2316,6 +2339,7 @@ bool halbb_physts_parsing(struct bb_info *bb,
 	enum bb_physts_bitmap_t ie_map_type = PHYSTS_BITMAP_NUM;
 	bool is_cck_rate = false;
 	bool is_valid = true;
+	u32 parse_map = PHYSTS_SUB_ALL_MAP;
 
 #ifdef HALBB_DBCC_SUPPORT
 	#ifdef HALBB_DBCC_DVLP_FLAG
@@ -2371,6 +2395,10 @@ bool halbb_physts_parsing(struct bb_info *bb,
 	halbb_rate_idx_parsor(bb, desc->data_rate, (enum rtw_gi_ltf)desc->gi_ltf, &physts->bb_rate_i);
 	is_cck_rate = halbb_is_cck_rate(bb, desc->data_rate);
 
+	#ifdef HALBB_PHYSTS_SUB_SUPPORT
+	parse_map = physts->ie_parse_map;
+	#endif
+
 	/*---[Physts per IE parsing]------------------------------------------*/
 	for (i = 0; i < IE_PHYSTS_LEN_ALL; i++) {
 		curr_ie = *addr & 0x1f;
@@ -2388,7 +2416,10 @@ bool halbb_physts_parsing(struct bb_info *bb,
 			ie_len = (u16)((((*(addr + 1) & 0xf) << 3) | ((*addr & 0xe0) >> 5)) << 3);
 		}
 
-		if (curr_ie == IE00_CMN_CCK) {
+		if (!(parse_map & BIT(curr_ie))) {
+			/*No consumer, only walk over it*/
+			physts->bb_physts_cnt_i.ie_skip_cnt++;
+		} else if (curr_ie == IE00_CMN_CCK) {
 			halbb_physts_ie_00(bb, addr, ie_len, desc);
 		} else if (curr_ie == IE01_CMN_OFDM) {
 			halbb_physts_ie_01(bb, addr, ie_len, desc);
@@ -2470,6 +2501,9 @@ bool halbb_physts_parsing(struct bb_info *bb,
 	BB_DBG(bb, DBG_PHY_STS, "[%d]Parsing_OK = %d, bitmap=0x%x\n",
 	       physts->bb_physts_cnt_i.all_cnt, is_valid, physts_bitmap);
 
+	/*Results of skipped IEs are stale, hide them from the consumers*/
+	physts_bitmap &= parse_map;
+
 	/*===================================================================*/
 PARSING_END:
 	halbb_physts_fd_rpl_2_rssi_cvrt(bb);
@@ -2571,6 +2605,7 @@ void halbb_physts_watchdog(struct bb_info *bb)
 	physts->bb_physts_cnt_i.ok_ie_cnt = 0;
 	physts->bb_physts_cnt_i.err_ie_cnt = 0;
 	physts->bb_physts_cnt_i.err_len_cnt = 0;
+	physts->bb_physts_cnt_i.ie_skip_cnt = 0;
 }
 
 void halbb_physts_parsing_init(struct bb_info *bb)
@@ -2618,6 +2653,16 @@ void halbb_physts_parsing_init(struct bb_info *bb)
 	halbb_physts_ie_bitmap_en(bb, HE_MU, IE13_DL_MU_DEF, true);
 	halbb_physts_ie_bitmap_en(bb, VHT_MU, IE13_DL_MU_DEF, true);
 
+	/*Data traffic only needs rssi/evm/rate, MP reads every IE*/
+	u32_tmp = PHYSTS_SUB_CMN_MAP;
+	#ifdef BB_8852A_2_SUPPORT
+	if (bb->ic_type == BB_RTL8852A && bb->hal_com->cv <= CBV)
+		u32_tmp |= BIT(IE09_FTR_PLCP_0); /*HE DCM rate fix in IE-9*/
+	#endif
+	halbb_physts_ie_sub(bb, PHYSTS_SUB_CMN, u32_tmp);
+	halbb_physts_ie_sub(bb, PHYSTS_SUB_MP, phl_is_mp_mode(bb->phl_com) ?
+			    PHYSTS_SUB_ALL_MAP : 0);
+
 	physts->show_phy_sts_all_pkt = false;
 	physts->show_phy_sts_max_cnt = 5;
 	physts->show_phy_sts_cnt = 0;
@@ -2647,6 +2692,12 @@ void halbb_physts_dbg(struct bb_info *bb, char input[][16], u32 *_used,
 			 "bitmap set {idx, all, or} {hex_val}\n");
 		BB_DBG_CNSL(*_out_len, *_used, output + *_used, *_out_len - *_used,
 			 "rssi_src {0:td, 1:fd_rpl}\n");
+		#ifdef HALBB_PHYSTS_SUB_SUPPORT
+		BB_DBG_CNSL(*_out_len, *_used, output + *_used, *_out_len - *_used,
+			 "sub show\n");
+		BB_DBG_CNSL(*_out_len, *_used, output + *_used, *_out_len - *_used,
+			 "sub set {0:cmn, 1:ch_info, 2:dbg, 3:mp} {hex_val}\n");
+		#endif
 		return;
 	}
 
@@ -2715,6 +2766,25 @@ void halbb_physts_dbg(struct bb_info *bb, char input[][16], u32 *_used,
 		if (bb->bb_physts_i.physts_dump_mode != 0)
 			halbb_physts_td_time_rpt_en(bb, true, bb->bb_phy_idx);
 
+		halbb_physts_ie_sub(bb, PHYSTS_SUB_DBG,
+				    (physts->physts_dump_mode != 0) ?
+				    PHYSTS_SUB_ALL_MAP : 0);
+
+#ifdef HALBB_PHYSTS_SUB_SUPPORT
+	} else if (_os_strcmp(input[1], "sub") == 0) {
+		if (_os_strcmp(input[2], "set") == 0) {
+			HALBB_SCAN(input[3], DCMD_DECIMAL, &val[0]);
+			HALBB_SCAN(input[4], DCMD_HEX, &val[1]);
+			halbb_physts_ie_sub(bb, (enum bb_physts_sub_t)val[0], val[1]);
+		}
+		for (i = 0; i < PHYSTS_SUB_NUM; i++) {
+			BB_DBG_CNSL(*_out_len, *_used, output + *_used, *_out_len - *_used,
+				    "sub[%d]=0x%08x\n", i, physts->ie_sub[i]);
+		}
+		BB_DBG_CNSL(*_out_len, *_used, output + *_used, *_out_len - *_used,
+			    "parse_map=0x%08x, ie_skip_cnt=%d\n", physts->ie_parse_map,
+			    physts->bb_physts_cnt_i.ie_skip_cnt);
+#endif
 	} else if (_os_strcmp(input[1], "trig") == 0) {
 		HALBB_SCAN(input[2], DCMD_DECIMAL, &val[0]);
 		HALBB_SCAN(input[3], DCMD_DECIMAL, &val[1]);
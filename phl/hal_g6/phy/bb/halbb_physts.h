@@ -81,6 +81,21 @@ enum bb_physts_ie_t {
 	IE_PHYSTS_LEN_ALL		= 32
 };
 
+/*Consumers of the decoded IEs, each one subscribes its own IE bitmap*/
+enum bb_physts_sub_t {
+	PHYSTS_SUB_CMN		= 0, /*rssi/evm/snr/rate: cmn_rpt, cfo, env_mntr*/
+	PHYSTS_SUB_CH_INFO	= 1, /*IE-8 channel raw data*/
+	PHYSTS_SUB_DBG		= 2, /*physts dump*/
+	PHYSTS_SUB_MP		= 3,
+	PHYSTS_SUB_NUM
+};
+
+#define PHYSTS_SUB_CMN_MAP	(BIT(IE00_CMN_CCK) | BIT(IE01_CMN_OFDM) | \
+				 BIT(IE13_DL_MU_DEF))
+#define PHYSTS_SUB_ALL_MAP	0xffffffff
+/*Not decoded by any parser, always kept so parsing stops on them*/
+#define PHYSTS_IE_RSVD_MAP	(BIT(IE16_RSVD16) | BIT(IE23_RSVD23))
+
 struct bb_info;
 
 static const char bb_physts_bitmap_type_t[][9] = {
@@ -668,6 +683,7 @@ struct bb_physts_cnt_info {
 	u16 err_ie_cnt;
 	u16 ok_ie_cnt;
 	u16 err_len_cnt;
+	u32 ie_skip_cnt; /*IEs received but not subscribed*/
 };
 
 struct bb_physts_cr_info {
@@ -696,6 +712,10 @@ struct bb_physts_info {
 	bool rssi_cvrt_2_rpl_en;
 	u8 rpl_path[4]; /*u(8,1)*/
 	u8 rpl_avg; /*u(8,1)*/
+#ifdef HALBB_PHYSTS_SUB_SUPPORT
+	u32 ie_sub[PHYSTS_SUB_NUM];
+	u32 ie_parse_map; /*OR of ie_sub*/
+#endif
 	struct bb_rate_info		bb_rate_i;
 	struct bb_rate_info		bb_rate_mu_i;
 	struct bb_physts_cr_info	bb_physts_cr_i;
@@ -739,6 +759,12 @@ void halbb_physts_ie_bitmap_set(struct bb_info *bb, u32 ie_page, u32 bitmap);
 u32 halbb_physts_ie_bitmap_get(struct bb_info *bb, u32 ie_page);
 void halbb_physts_ie_bitmap_en(struct bb_info *bb, enum bb_physts_bitmap_t type,
 			       enum bb_physts_ie_t ie, bool en);
+#ifdef HALBB_PHYSTS_SUB_SUPPORT
+void halbb_physts_ie_sub(struct bb_info *bb, enum bb_physts_sub_t sub,
+			 u32 ie_map);
+#else
+#define halbb_physts_ie_sub(bb, sub, ie_map)
+#endif
 void halbb_phy_sts_manual_trig(struct bb_info *bb, enum bb_mode_type mode, u8 ss);
 void halbb_physts_watchdog(struct bb_info *bb);
 void halbb_physts_parsing_init(struct bb_info *bb);
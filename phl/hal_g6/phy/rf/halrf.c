@@ -26,12 +26,238 @@
 
 #if 1
 
+#ifdef HALRF_CONFIG_RFK_CACHE
+void halrf_rfk_cache_init(struct rf_info *rf)
+{
+	struct halrf_rfk_cache *cache = &rf->rfk_cache;
+
+	halrf_mem_set(rf, cache, 0, sizeof(*cache));
+	cache->en = true;
+	cache->ther_th = HALRF_RFK_CACHE_THER_TH;
+}
+
+void halrf_rfk_cache_inval(struct rf_info *rf)
+{
+	struct halrf_rfk_cache *cache = &rf->rfk_cache;
+
+	halrf_mem_set(rf, cache->ent, 0, sizeof(cache->ent));
+	cache->busy = false;
+	cache->stat.inval++;
+}
+
+static bool _halrf_rfk_cache_dpk_on(struct rf_info *rf)
+{
+	/*same gate as halrf_dpk_trigger*/
+	if (!(rf->support_ability & HAL_RF_DPK) || rf->phl_com->id.id == 0x1010a)
+		return false;
+
+	return true;
+}
+
+static u8 _halrf_rfk_cache_victim(struct halrf_rfk_cache *cache, u8 path)
+{
+	u8 i, victim = 0;
+
+	for (i = 0; i < HALRF_RFK_CACHE_NUM; i++) {
+		if (!cache->ent[path][i].valid)
+			return i;
+		if (cache->ent[path][i].last_use <
+		    cache->ent[path][victim].last_use)
+			victim = i;
+	}
+
+	return victim;
+}
+
+/*
+ * Look up every path. On a full hit the cached slots are reloaded instead
+ * of running IQK/DPK, otherwise slot[] is where the new results go.
+ */
+static bool _halrf_rfk_cache_lookup(struct rf_info *rf,
+				    enum phl_phy_idx phy_idx)
+{
+	struct halrf_rfk_cache *cache = &rf->rfk_cache;
+	struct rtw_chan_def *chandef = &rf->hal_com->band[phy_idx].cur_chandef;
+	struct halrf_rfk_cache_ent *ent;
+	u8 path, i, hit_num = 0;
+
+	cache->busy = false;
+
+	if (!cache->en || rf->phl_com->drv_mode == RTW_DRV_MODE_MP ||
+	    !(rf->support_ability & HAL_RF_IQK) || rf->iqk.is_fw_iqk)
+		return false;
+
+	cache->tick++;
+
+	for (path = 0; path < KPATH; path++) {
+		cache->ther[path] = halrf_get_thermal(rf, path);
+		cache->slot[path] = _halrf_rfk_cache_victim(cache, path);
+
+		for (i = 0; i < HALRF_RFK_CACHE_NUM; i++) {
+			ent = &cache->ent[path][i];
+			if (!ent->valid || ent->band != chandef->band ||
+			    ent->ch != chandef->center_ch ||
+			    ent->bw != chandef->bw)
+				continue;
+
+			/*same channel, recalibrate in place when drifted*/
+			cache->slot[path] = i;
+			if (HALRF_ABS(cache->ther[path], ent->ther) >=
+			    cache->ther_th) {
+				cache->stat.ther_miss++;
+				ent->valid = false;
+			} else {
+				hit_num++;
+			}
+			break;
+		}
+	}
+
+	if (hit_num == KPATH) {
+		for (path = 0; path < KPATH; path++)
+			cache->ent[path][cache->slot[path]].last_use = cache->tick;
+		cache->stat.hit++;
+		RF_DBG(rf, DBG_RF_RFK, "[RFK_CACHE] hit ch%d bw%d\n",
+		       chandef->center_ch, chandef->bw);
+		return true;
+	}
+
+	cache->stat.miss++;
+	cache->busy = true;
+	RF_DBG(rf, DBG_RF_RFK, "[RFK_CACHE] miss ch%d bw%d\n",
+	       chandef->center_ch, chandef->bw);
+	return false;
+}
+
+static void _halrf_rfk_cache_reload_iqk(struct rf_info *rf,
+					enum phl_phy_idx phy_idx)
+{
+	struct halrf_rfk_cache *cache = &rf->rfk_cache;
+	struct rtw_hal_com_t *hal_i = rf->hal_com;
+	u8 path;
+
+	for (path = 0; path < KPATH; path++) {
+		switch (hal_i->chip_id) {
+#ifdef RF_8852B_SUPPORT
+		case CHIP_WIFI6_8852B:
+			halrf_iqk_cache_reload_8852b(rf, path, cache->slot[path],
+				&cache->ent[path][cache->slot[path]]);
+			break;
+#endif
+		default:
+			break;
+		}
+	}
+}
+
+static void _halrf_rfk_cache_reload_dpk(struct rf_info *rf,
+					enum phl_phy_idx phy_idx)
+{
+	struct halrf_rfk_cache *cache = &rf->rfk_cache;
+	struct rtw_hal_com_t *hal_i = rf->hal_com;
+	u8 path;
+
+	if (!_halrf_rfk_cache_dpk_on(rf))
+		return;
+
+	for (path = 0; path < KPATH; path++) {
+		switch (hal_i->chip_id) {
+#ifdef RF_8852B_SUPPORT
+		case CHIP_WIFI6_8852B:
+			halrf_dpk_cache_reload_8852b(rf, phy_idx, path,
+						     cache->slot[path]);
+			break;
+#endif
+		default:
+			break;
+		}
+	}
+}
+
+static void _halrf_rfk_cache_store(struct rf_info *rf,
+				   enum phl_phy_idx phy_idx)
+{
+	struct halrf_rfk_cache *cache = &rf->rfk_cache;
+	struct rtw_hal_com_t *hal_i = rf->hal_com;
+	struct rtw_chan_def *chandef = &hal_i->band[phy_idx].cur_chandef;
+	struct halrf_rfk_cache_ent *ent;
+	bool ok;
+	u8 path;
+
+	if (!cache->busy)
+		return;
+	cache->busy = false;
+
+	for (path = 0; path < KPATH; path++) {
+		ent = &cache->ent[path][cache->slot[path]];
+		if (ent->valid && (ent->band != chandef->band ||
+		    ent->ch != chandef->center_ch || ent->bw != chandef->bw))
+			cache->stat.evict++;
+		ent->valid = false;
+
+		switch (hal_i->chip_id) {
+#ifdef RF_8852B_SUPPORT
+		case CHIP_WIFI6_8852B:
+			ok = halrf_iqk_cache_save_8852b(rf, path, ent);
+			if (ok && _halrf_rfk_cache_dpk_on(rf))
+				ok = halrf_dpk_cache_check_8852b(rf, phy_idx,
+								 path);
+			break;
+#endif
+		default:
+			ok = false;
+			break;
+		}
+
+		if (!ok) {
+			cache->stat.store_fail++;
+			continue;
+		}
+
+		ent->band = chandef->band;
+		ent->ch = chandef->center_ch;
+		ent->bw = chandef->bw;
+		ent->ther = cache->ther[path];
+		ent->last_use = cache->tick;
+		ent->valid = true;
+	}
+}
+
+void halrf_rfk_cache_cfg(void *rf_void, bool en, u8 ther_th)
+{
+	struct rf_info *rf = (struct rf_info *)rf_void;
+	struct halrf_rfk_cache *cache = &rf->rfk_cache;
+
+	if (ther_th)
+		cache->ther_th = ther_th;
+	if (cache->en != en) {
+		cache->en = en;
+		halrf_rfk_cache_inval(rf);
+	}
+}
+
+bool halrf_rfk_cache_get_stat(void *rf_void, struct rtw_rfk_cache_stat *stat,
+			      u8 *ther_th, bool rst)
+{
+	struct rf_info *rf = (struct rf_info *)rf_void;
+	struct halrf_rfk_cache *cache = &rf->rfk_cache;
+
+	halrf_mem_cpy(rf, stat, &cache->stat, sizeof(*stat));
+	*ther_th = cache->ther_th;
+	if (rst)
+		halrf_mem_set(rf, &cache->stat, 0, sizeof(cache->stat));
+
+	return cache->en;
+}
+#endif
+
 enum rtw_hal_status halrf_chl_rfk_trigger(void *rf_void,
 			   enum phl_phy_idx phy_idx,
 			   bool force)
 {
 	struct rf_info *rf = (struct rf_info *)rf_void;
 	u32 start_time, finish_time;
+	bool rfk_hit = false;
 
 	#if 0
 	struct rtw_hal_com_t *hal_i = rf->hal_com;
@@ -57,20 +283,38 @@ enum rtw_hal_status halrf_chl_rfk_trigger(void *rf_void,
 	/*[RX dck]*/
 	halrf_rx_dck_trigger(rf, phy_idx, true);
 
+#ifdef HALRF_CONFIG_RFK_CACHE
+	rfk_hit = _halrf_rfk_cache_lookup(rf, phy_idx);
+#endif
+
 	/*[LOK, IQK]*/
-	halrf_iqk_trigger(rf, phy_idx, force);
+#ifdef HALRF_CONFIG_RFK_CACHE
+	if (rfk_hit)
+		_halrf_rfk_cache_reload_iqk(rf, phy_idx);
+	else
+#endif
+		halrf_iqk_trigger(rf, phy_idx, force);
 
 	/*[TSSI Trk]*/
 	halrf_tssi_trigger(rf, phy_idx);
 
 	/*[DPK]*/
-	halrf_dpk_trigger(rf, phy_idx, force);
+#ifdef HALRF_CONFIG_RFK_CACHE
+	if (rfk_hit)
+		_halrf_rfk_cache_reload_dpk(rf, phy_idx);
+	else
+#endif
+		halrf_dpk_trigger(rf, phy_idx, force);
+#ifdef HALRF_CONFIG_RFK_CACHE
+	_halrf_rfk_cache_store(rf, phy_idx);
+#endif
 	halrf_fw_ntfy(rf, phy_idx);
 
 	finish_time = _os_get_cur_time_us();
-	RF_DBG(rf, DBG_RF_RFK, "[RX_DCK] halrf_chl_rfk_trigger processing time = %d.%dms\n",
+	RF_DBG(rf, DBG_RF_RFK, "[RX_DCK] halrf_chl_rfk_trigger processing time = %d.%dms%s\n",
 		HALRF_ABS(finish_time, start_time) / 1000,
-		HALRF_ABS(finish_time, start_time) % 1000);
+		HALRF_ABS(finish_time, start_time) % 1000,
+		rfk_hit ? " (cached)" : "");
 	return RTW_HAL_STATUS_SUCCESS;
 }
 
@@ -239,6 +483,11 @@ enum rtw_hal_status halrf_iqk_trigger(void *rf_void,
 
 	if (!(rf->support_ability & HAL_RF_IQK))
 		return RTW_HAL_STATUS_SUCCESS;
+#ifdef HALRF_CONFIG_RFK_CACHE
+	/*page picked outside the cache may hold a cached channel*/
+	if (rf->rfk_cache.en && !rf->rfk_cache.busy)
+		halrf_rfk_cache_inval(rf);
+#endif
 	rf->rfk_is_processing = true;
 	start_time = _os_get_cur_time_us();
 
@@ -320,6 +569,10 @@ enum rtw_hal_status halrf_dpk_trigger(void *rf_void,
 
 	if (!(rf->support_ability & HAL_RF_DPK) || rf->phl_com->id.id == 0x1010a) /*USB buffalo*/
 		return RTW_HAL_STATUS_SUCCESS;
+#ifdef HALRF_CONFIG_RFK_CACHE
+	if (rf->rfk_cache.en && !rf->rfk_cache.busy)
+		halrf_rfk_cache_inval(rf);
+#endif
 
 	halrf_btc_rfk_ntfy(rf, (BIT(phy_idx) << 4), RF_BTC_DPK, RFK_START);
 
@@ -210,6 +210,39 @@ struct halrf_rx_dck_info {
 	struct rfk_location loc[KPATH]; /*max RF path*/
 };
 
+#ifdef HALRF_CONFIG_RFK_CACHE
+/*slot i is iqk table page i / dpk kidx i, results stay on chip per slot*/
+#define HALRF_RFK_CACHE_NUM 2
+/*thermal delta a cached result is still trusted for*/
+#define HALRF_RFK_CACHE_THER_TH 8
+
+struct halrf_rfk_cache_ent {
+	bool valid;
+	u8 band;
+	u8 ch;
+	u8 bw;
+	u8 ther;
+	u32 last_use;
+	/*iqk results kept outside the table page*/
+	u32 iqk_en;
+	u32 iqk_txk;
+	u32 iqk_rxk;
+	u32 lok_idac;
+	u32 lok_vbuf;
+};
+
+struct halrf_rfk_cache {
+	bool en;
+	bool busy; /*chl rfk in progress, iqk/dpk use slot[]*/
+	u8 ther_th;
+	u8 slot[KPATH];
+	u8 ther[KPATH];
+	u32 tick;
+	struct halrf_rfk_cache_ent ent[KPATH][HALRF_RFK_CACHE_NUM];
+	struct rtw_rfk_cache_stat stat;
+};
+#endif
+
 struct rf_info {
 	struct rtw_phl_com_t	*phl_com;
 	struct rtw_hal_com_t	*hal_com;
@@ -280,9 +313,16 @@ struct rf_info {
 #ifdef HALRF_CONFIG_FW_IO_OFLD_SUPPORT
 	struct halrf_fw_offload fwofld;
 #endif
+#ifdef HALRF_CONFIG_RFK_CACHE
+	struct halrf_rfk_cache rfk_cache;
+#endif
 };
 
 /*@--------------------------[Prptotype]-------------------------------------*/
+#ifdef HALRF_CONFIG_RFK_CACHE
+void halrf_rfk_cache_init(struct rf_info *rf);
+void halrf_rfk_cache_inval(struct rf_info *rf);
+#endif
 
 
 #endif
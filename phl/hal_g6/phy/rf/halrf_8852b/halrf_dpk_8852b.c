@@ -1343,8 +1343,16 @@ void _dpk_cal_select_8852b(
 				halrf_dpk_onoff_8852b(rf, path, false);
 		}
 	} else {
-		for (path = 0; path < DPK_RF_PATH_MAX_8852B; path++)
+		for (path = 0; path < DPK_RF_PATH_MAX_8852B; path++) {
+#ifdef HALRF_CONFIG_RFK_CACHE
+			/*chl rfk: the result cache picked the kidx*/
+			if (rf->rfk_cache.busy) {
+				dpk->cur_idx[path] = rf->rfk_cache.slot[path];
+				continue;
+			}
+#endif
 			dpk->cur_idx[path] = 0;
+		}
 	}
 
 	_dpk_bkup_bb_8852b(rf, bb_reg, bb_bkup);
@@ -1479,6 +1487,38 @@ void halrf_dpk_onoff_8852b(
 		   (dpk->is_dpk_enable & off_reverse) ? "enable" : "disable");
 }
 
+#ifdef HALRF_CONFIG_RFK_CACHE
+bool halrf_dpk_cache_check_8852b(
+	struct rf_info *rf,
+	enum phl_phy_idx phy,
+	enum rf_path path)
+{
+	struct halrf_dpk_info *dpk = &rf->dpk;
+
+	/*ext PA bypass is a valid result, a failed kidx is not*/
+	if (_dpk_bypass_check_8852b(rf, phy))
+		return true;
+
+	return dpk->bp[path][dpk->cur_idx[path]].path_ok ? true : false;
+}
+
+void halrf_dpk_cache_reload_8852b(
+	struct rf_info *rf,
+	enum phl_phy_idx phy,
+	enum rf_path path,
+	u8 kidx)
+{
+	struct halrf_dpk_info *dpk = &rf->dpk;
+
+	dpk->cur_idx[path] = kidx;
+	halrf_wreg(rf, 0x8104 + (path << 8), BIT(8), kidx);
+	halrf_dpk_onoff_8852b(rf, path, _dpk_bypass_check_8852b(rf, phy) ? true : false);
+
+	RF_DBG(rf, DBG_RF_DPK, "[DPK] reload S%d[%d] (CH %d) from cache\n",
+	       path, kidx, dpk->bp[path][kidx].ch);
+}
+#endif
+
 void halrf_dpk_track_8852b(
 	struct rf_info *rf)
 {
@@ -46,6 +46,14 @@ void halrf_dpk_8852b(struct rf_info *rf, enum phl_phy_idx phy_idx, bool force);
 
 void halrf_dpk_onoff_8852b(struct rf_info *rf, enum rf_path path, bool off);
 
+#ifdef HALRF_CONFIG_RFK_CACHE
+bool halrf_dpk_cache_check_8852b(struct rf_info *rf, enum phl_phy_idx phy,
+				 enum rf_path path);
+
+void halrf_dpk_cache_reload_8852b(struct rf_info *rf, enum phl_phy_idx phy,
+				  enum rf_path path, u8 kidx);
+#endif
+
 void halrf_dpk_track_8852b(struct rf_info *rf);
 
 #endif
@@ -1318,6 +1318,11 @@ void iqk_get_ch_info_8852b(struct rf_info *rf, enum phl_phy_idx phy, u8 path)
 		}		
 		//RF_DBG(rf, DBG_RF_IQK, "[IQK]we will replace iqk table index(%d), !!!!! \n", idx);
 	}	
+#ifdef HALRF_CONFIG_RFK_CACHE
+	/*chl rfk: the result cache picked the page*/
+	if (rf->rfk_cache.busy)
+		idx = rf->rfk_cache.slot[path];
+#endif
 	RF_DBG(rf, DBG_RF_IQK, "[IQK] (2)  idx = %x\n", idx);
 
 	//RF_DBG(rf, DBG_RF_IQK, "[IQK]===>%s\n", __func__);
@@ -1421,6 +1426,52 @@ void halrf_iqk_reload_8852b(struct rf_info *rf, u8 path)
 	return;
 }
 
+#ifdef HALRF_CONFIG_RFK_CACHE
+__iram_func__
+bool halrf_iqk_cache_save_8852b(struct rf_info *rf, u8 path,
+				struct halrf_rfk_cache_ent *ent)
+{
+	struct halrf_iqk_info *iqk_info = &rf->iqk;
+
+	if (iqk_info->lok_cor_fail[0][path] || iqk_info->lok_fin_fail[0][path] ||
+	    iqk_info->iqk_tx_fail[0][path] || iqk_info->iqk_rx_fail[0][path])
+		return false;
+
+	/*cfir lut stays in the table page, keep the final state of the rest*/
+	ent->iqk_en = halrf_rreg(rf, 0x8124 + (path << 8), MASKDWORD);
+	ent->iqk_txk = halrf_rreg(rf, 0x8138 + (path << 8), MASKDWORD);
+	ent->iqk_rxk = halrf_rreg(rf, 0x813c + (path << 8), MASKDWORD);
+	ent->lok_idac = halrf_rrf(rf, path, 0x58, MASKRF);
+	ent->lok_vbuf = halrf_rrf(rf, path, 0x0a, MASKRF);
+	return true;
+}
+
+__iram_func__
+void halrf_iqk_cache_reload_8852b(struct rf_info *rf, u8 path, u8 idx,
+				  struct halrf_rfk_cache_ent *ent)
+{
+	struct halrf_iqk_info *iqk_info = &rf->iqk;
+
+	iqk_info->reload_cnt++;
+	iqk_info->iqk_band[path] = ent->band;
+	iqk_info->iqk_bw[path] = ent->bw;
+	iqk_info->iqk_ch[path] = ent->ch;
+	iqk_info->iqk_mcc_ch[idx][path] = ent->ch;
+	iqk_info->iqk_table_idx[path] = idx;
+	iqk_info->thermal[path] = ent->ther;
+
+	halrf_wreg(rf, 0x8104 + (path << 8), 0x00000001, idx);
+	halrf_wreg(rf, 0x8154 + (path << 8), 0x00000008, idx);
+	halrf_wreg(rf, 0x8124 + (path << 8), MASKDWORD, ent->iqk_en);
+	halrf_wreg(rf, 0x8138 + (path << 8), MASKDWORD, ent->iqk_txk);
+	halrf_wreg(rf, 0x813c + (path << 8), MASKDWORD, ent->iqk_rxk);
+	halrf_wrf(rf, path, 0x58, MASKRF, ent->lok_idac);
+	halrf_wrf(rf, path, 0x0a, MASKRF, ent->lok_vbuf);
+	RF_DBG(rf, DBG_RF_IQK, "[IQK]S%x reload table idx = %x, ch = %d\n",
+	       path, idx, ent->ch);
+}
+#endif
+
 __iram_func__
 void iqk_start_iqk_8852b(struct rf_info *rf, enum phl_phy_idx phy_idx, u8 path)
 {
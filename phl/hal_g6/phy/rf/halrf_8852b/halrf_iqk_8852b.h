@@ -58,6 +58,12 @@ void iqk_start_iqk_8852b(struct rf_info *rf, enum phl_phy_idx phy_idx,
 void iqk_restore_8852b(struct rf_info *rf, u8 path);
 void iqk_afebb_restore_8852b(struct rf_info *rf, enum phl_phy_idx phy_idx, u8 path);
 void halrf_iqk_reload_8852b(struct rf_info *rf, u8 path);
+#ifdef HALRF_CONFIG_RFK_CACHE
+bool halrf_iqk_cache_save_8852b(struct rf_info *rf, u8 path,
+				struct halrf_rfk_cache_ent *ent);
+void halrf_iqk_cache_reload_8852b(struct rf_info *rf, u8 path, u8 idx,
+				  struct halrf_rfk_cache_ent *ent);
+#endif
 void halrf_nbiqk_enable_8852b(struct rf_info *rf, bool nbiqk_en);
 void halrf_iqk_toneleakage_8852b(struct rf_info *rf, u8 path);
 void halrf_iqk_sram_enable_8852b(struct rf_info *rf, bool iqk_sram_en);
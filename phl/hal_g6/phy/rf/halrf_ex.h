@@ -33,6 +33,11 @@ void halrf_watchdog(void *rf_void);
 enum rtw_hal_status halrf_chl_rfk_trigger(void *rf_void,
 			   enum phl_phy_idx phy_idx,
 			   bool force);
+#ifdef CONFIG_PHL_RFK_CACHE
+void halrf_rfk_cache_cfg(void *rf_void, bool en, u8 ther_th);
+bool halrf_rfk_cache_get_stat(void *rf_void, struct rtw_rfk_cache_stat *stat,
+			      u8 *ther_th, bool rst);
+#endif
 enum rtw_hal_status halrf_dack_trigger(void *rf_void, bool force);
 enum rtw_hal_status halrf_rx_dck_trigger(void *rf_void,
 				enum phl_phy_idx phy_idx, bool is_afe);
@@ -84,6 +84,11 @@ void halrf_rfk_self_init(struct rf_info *rf)
 	/*[DPK init]*/
 	halrf_dpk_init(rf);
 
+#ifdef HALRF_CONFIG_RFK_CACHE
+	/*[RFK cache] table pages do not survive a power cycle*/
+	halrf_rfk_cache_inval(rf);
+#endif
+
 	/*[RXBB BW]*/
 	for (path = 0; path < KPATH; path++)
 		rf->pre_rxbb_bw[path] = 0xff;
@@ -359,6 +364,9 @@ enum rtw_hal_status halrf_init(struct rtw_phl_com_t *phl_com,
 
 	rf->phl_com = phl_com;/*shared memory for all components*/
 	rf->hal_com = hal_com;/*shared memory for phl and hal*/
+#ifdef HALRF_CONFIG_RFK_CACHE
+	halrf_rfk_cache_init(rf);
+#endif
 	
 
 	return RTW_HAL_STATUS_SUCCESS;
@@ -29,6 +29,10 @@
 #define HALRF_CONFIG_FW_IO_OFLD_SUPPORT
 #endif
 
+#ifdef CONFIG_PHL_RFK_CACHE
+#define HALRF_CONFIG_RFK_CACHE
+#endif
+
 #define CF_PHL_BB_CTRL_RX_CCA
 
 /*@--------------------------[Define] ---------------------------------------*/
@@ -332,6 +332,8 @@ _hal_parsing_rx_wd_8852b(struct hal_info_t *hal, u8 *desc,
 		_os_mem_cpy(hal_com->drv_priv,
 			(void*)&mdata->mac_addr, (void*)(desc + 24), MAC_ALEN);
 			mdata->sec_type = GET_RX_AX_DESC_SEC_TYPE_8852B(desc);
+			mdata->hdr_cnv = GET_RX_AX_DESC_HDR_CNV_8852B(desc);
+			mdata->hdr_offset = GET_RX_AX_DESC_HDR_OFFSET_8852B(desc);
 		}
 	}
 
@@ -439,6 +441,29 @@ _hal_rx_wlanhdr_check_8852b(void *drvpriv, void *hdr, struct rtw_r_meta_data *md
 	}
 }
 
+#ifdef CONFIG_PHL_CSUM_OFFLOAD_RX
+static void
+_hal_rx_chksum_8852b(struct rtw_phl_com_t *phl_com, struct hal_info_t *hal,
+		     u8 *buf, u32 buf_len, struct rtw_pkt_buf_list *pkt,
+		     struct rtw_r_meta_data *mdata)
+{
+	u8 *desc = buf;
+	u32 offset = 0;
+
+	if (phl_com->hci_type == RTW_HCI_PCIE)
+		desc = buf + RX_BD_INFO_SIZE;
+
+	/* aligned from the start of rx desc, as the mac aggregates them */
+	offset = _ALIGN((u32)(pkt->vir_addr - desc) + pkt->length, 8);
+	if ((desc + offset) >= (buf + buf_len)) {
+		mdata->chksum_ofld_en = 0;
+		return;
+	}
+
+	rtw_hal_mac_parse_rx_chksum(hal, *(desc + offset), mdata);
+}
+#endif
+
 static void
 _hal_rx_sts_8852b(struct hal_info_t *hal, struct rtw_r_meta_data *meta)
 {
@@ -483,6 +508,10 @@ hal_handle_rx_buffer_8852b(struct rtw_phl_com_t *phl_com,
 		phl_rx->type = RTW_RX_TYPE_WIFI;
 		_hal_rx_wlanhdr_check_8852b(drv, pkt->vir_addr, mdata);
 		_hal_rx_sts_8852b(hal, mdata);
+#ifdef CONFIG_PHL_CSUM_OFFLOAD_RX
+		if (mdata->chksum_ofld_en)
+			_hal_rx_chksum_8852b(phl_com, hal, buf, buf_len, pkt, mdata);
+#endif
 		hal_rx_ppdu_sts_normal_data(phl_com, pkt->vir_addr, mdata);
 	}
 	break;
@@ -115,6 +115,8 @@
 /* DWORD 7 ; Offset 1ch */
 //#define GET_RX_AX_DESC_MAC_ADDR_H_8852B(__pRxStatusDesc) LE_BITS_TO_4BYTE(__pRxStatusDesc+28, 0, 16)
 #define GET_RX_AX_DESC_SEC_TYPE_8852B(__pRxStatusDesc) LE_BITS_TO_4BYTE(__pRxStatusDesc+28, 17, 4)
+#define GET_RX_AX_DESC_HDR_CNV_8852B(__pRxStatusDesc) LE_BITS_TO_4BYTE(__pRxStatusDesc+28, 21, 1)
+#define GET_RX_AX_DESC_HDR_OFFSET_8852B(__pRxStatusDesc) LE_BITS_TO_4BYTE(__pRxStatusDesc+28, 22, 5)
 
 
 /*
@@ -543,6 +543,59 @@ u8 _hal_get_tid_indic_8852be(u8 tid)
 	return tid_indic;
 }
 
+/**
+ * the function fill wd body and wd info, from the (macid, tid) template if
+ * nothing but the per-packet fields changed since it was built
+ * @hal: see struct hal_info_t
+ * @tx_req: see struct rtw_xmit_req
+ * @wd_buf: the wd page to fill
+ * @wd_len: output, length of wd body and wd info
+ */
+static enum rtw_hal_status
+_hal_fill_wd_8852be(struct hal_info_t *hal, struct rtw_xmit_req *tx_req,
+		    u8 *wd_buf, u32 *wd_len)
+{
+	enum rtw_hal_status hstatus = RTW_HAL_STATUS_SUCCESS;
+#ifdef CONFIG_PHL_WD_TMPL_CACHE
+	struct rtw_t_meta_data *mdata = &tx_req->mdata;
+	struct hal_wd_tmpl_entry *tmpl = NULL;
+	u32 *wd_words = (u32 *)wd_buf;
+	u32 w0, w2;
+
+	tmpl = hal_wd_tmpl_lookup(hal, mdata);
+	if (tmpl) {
+		_os_mem_cpy(hal_to_drvpriv(hal), wd_buf, tmpl->wd, tmpl->wd_len);
+
+		w0 = le32_to_cpu(wd_words[0])
+			& ~(AX_TXD_HW_SSN_SEL_MSK << AX_TXD_HW_SSN_SEL_SH);
+		w0 |= (mdata->hw_ssn_sel & AX_TXD_HW_SSN_SEL_MSK)
+			<< AX_TXD_HW_SSN_SEL_SH;
+		wd_words[0] = cpu_to_le32(w0);
+
+		w2 = le32_to_cpu(wd_words[2])
+			& ~(AX_TXD_TXPKTSIZE_MSK << AX_TXD_TXPKTSIZE_SH);
+		w2 |= (mdata->pktlen & AX_TXD_TXPKTSIZE_MSK)
+			<< AX_TXD_TXPKTSIZE_SH;
+		wd_words[2] = cpu_to_le32(w2);
+
+		wd_words[3] = cpu_to_le32(
+			((mdata->sw_seq & AX_TXD_WIFI_SEQ_MSK) << AX_TXD_WIFI_SEQ_SH) |
+			(mdata->ampdu_en ? AX_TXD_AGG_EN : 0) |
+			((mdata->bk || mdata->ack_ch_info) ? AX_TXD_BK : 0));
+
+		*wd_len = tmpl->wd_len;
+		return hstatus;
+	}
+#endif
+	/* connect with halmac */
+	hstatus = rtw_hal_mac_ax_fill_txdesc(hal->mac, tx_req, wd_buf, wd_len);
+#ifdef CONFIG_PHL_WD_TMPL_CACHE
+	if (RTW_HAL_STATUS_SUCCESS == hstatus)
+		hal_wd_tmpl_store(hal, &tx_req->mdata, wd_buf, *wd_len);
+#endif
+	return hstatus;
+}
+
 #ifdef CONFIG_PHL_TXSC
 static u8 qsel_tbl[] = {
 	TID_0_QSEL/*0*/, TID_1_QSEL/*1*/, TID_2_QSEL/*1*/, TID_3_QSEL/*0*/,
@@ -567,8 +620,7 @@ _hal_txsc_update_wd(struct hal_info_t *hal,
 		return RTW_HAL_STATUS_FAILURE;
 
 	if (req->wd_len == 0) {
-		rtw_hal_mac_ax_fill_txdesc(hal->mac, tx_req, req->wd_page,
-								   wd_len);
+		_hal_fill_wd_8852be(hal, tx_req, req->wd_page, wd_len);
 		req->wd_len = (u8)*wd_len;
 	} else {
 		mdata = &tx_req->mdata;
@@ -637,9 +689,7 @@ hal_update_wd_8852be(struct hal_info_t *hal,
 #ifdef CONFIG_PHL_TXSC
 		_hal_txsc_update_wd(hal, req, &wd_len);
 #else
-		/* connect with halmac */
-		rtw_hal_mac_ax_fill_txdesc(hal->mac, tx_req, req->wd_page,
-						&wd_len);
+		_hal_fill_wd_8852be(hal, tx_req, req->wd_page, &wd_len);
 #endif
 		tid_indic = _hal_get_tid_indic_8852be(tx_req->mdata.tid);
 
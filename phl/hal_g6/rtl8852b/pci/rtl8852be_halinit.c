@@ -732,6 +732,9 @@ static u32 hal_rx_handler_8852be(struct hal_info_t *hal, u32 *handled)
 	if (handled0 == 0)
 		return ret;
 
+	if (handled0 & B_AX_RDU_INT)
+		hal_com->trx_stat.rx_rdu_cnt++;
+
 	PHL_TRACE(COMP_PHL_DBG, _PHL_DEBUG_, "RX IRQ B4 : %08X (%08X)\n",
 	          handled0, hal_com->int_array[0]);
 	/* Disable RX interrupts, RX tasklet will enable them after processed RX */
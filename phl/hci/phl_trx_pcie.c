@@ -255,6 +255,9 @@ void phl_tx_stop_pcie(struct phl_info_t *phl_info)
 {
 	void *drv = phl_to_drvpriv(phl_info);
 	_os_atomic_set(drv, &phl_info->phl_sw_tx_sts, PHL_TX_STATUS_SW_PAUSE);
+#ifdef CONFIG_PHL_SER_FAST_L1
+	_os_event_set(drv, &phl_info->tx_pause_evt);
+#endif
 }
 
 bool phl_is_tx_sw_pause_pcie(struct phl_info_t *phl_info)
@@ -292,6 +295,9 @@ void phl_rx_stop_pcie(struct phl_info_t *phl_info)
 {
 	void *drv = phl_to_drvpriv(phl_info);
 	_os_atomic_set(drv, &phl_info->phl_sw_rx_sts, PHL_RX_STATUS_SW_PAUSE);
+#ifdef CONFIG_PHL_SER_FAST_L1
+	_os_event_set(drv, &phl_info->rx_pause_evt);
+#endif
 }
 
 bool phl_is_rx_sw_pause_pcie(struct phl_info_t *phl_info)
@@ -1194,7 +1200,7 @@ static enum rtw_phl_status phl_release_busy_h2c_pkt(
 	return pstatus;
 }
 
-static void phl_tx_reset_pcie(struct phl_info_t *phl_info)
+static void phl_tx_reset_pcie(struct phl_info_t *phl_info, u8 type)
 {
 	struct hci_info_t *hci_info = (struct hci_info_t *)phl_info->hci;
 	struct rtw_wd_page_ring *wd_ring = NULL;
@@ -1213,6 +1219,11 @@ static void phl_tx_reset_pcie(struct phl_info_t *phl_info)
 		rtw_release_pending_wd_page(phl_info, &wd_ring[ch],
 					 wd_ring[ch].pending_wd_page_cnt);
 		wd_ring[ch].cur_hw_res = 0;
+#ifdef CONFIG_PHL_SER_FAST_L1
+		/* held tx requests stay tagged until requeue_tx */
+		if (PHL_CTRL_TX_KEEP & type)
+			continue;
+#endif
 		_phl_reset_wp_tag(phl_info, &wd_ring[ch], ch);
 	}
 
@@ -2424,7 +2435,7 @@ void phl_trx_reset_pcie(struct phl_info_t *phl_info, u8 type)
 	PHL_INFO("%s\n", __func__);
 
 	if (PHL_CTRL_TX & type) {
-		phl_tx_reset_pcie(phl_info);
+		phl_tx_reset_pcie(phl_info, type);
 		phl_reset_tx_stats(phl_stats);
 	}
 
@@ -3475,6 +3486,67 @@ end:
 	/* phl_indic_pkt_complete(phl_info); */
 }
 
+#ifdef CONFIG_PHL_SER_FAST_L1
+/**
+ * requeue the tx requests held in the wp tags by a PHL_CTRL_TX_KEEP reset
+ * return the number of requeued tx requests
+ * @drop: recycle all held tx requests as dropped instead
+ * @drop_cnt: increased by the number of dropped tx requests
+ *
+ * wp_seq is handed out in order and never skips a busy tag, so the held
+ * tags of a channel, read circularly from the next wp_seq, are in
+ * submission order. They are put back at the head of their rings newest
+ * first, ahead of frames queued during the reset, so every tid keeps its
+ * order without relying on the peer's reordering.
+ */
+static u32 phl_requeue_tx_pcie(struct phl_info_t *phl_info, bool drop,
+			       u32 *drop_cnt)
+{
+	struct rtw_hal_com_t *hal_com = rtw_hal_get_halcom(phl_info->hal);
+	struct rtw_wp_rpt_stats *rpt_stats =
+		(struct rtw_wp_rpt_stats *)hal_com->trx_stat.wp_rpt_stats;
+	struct hci_info_t *hci_info = (struct hci_info_t *)phl_info->hci;
+	void *drv = phl_to_drvpriv(phl_info);
+	struct rtw_wd_page_ring *wd_ring = NULL;
+	struct rtw_xmit_req *treq = NULL;
+	u16 wp_seq = 0, i = 0;
+	u32 requeue = 0, dropped = 0;
+	u8 ch = 0;
+
+	wd_ring = (struct rtw_wd_page_ring *)hci_info->wd_ring;
+
+	for (ch = 0; ch < hci_info->total_txch_num; ch++) {
+		/* newest first: backwards from the tag before the next wp_seq */
+		wp_seq = wd_ring[ch].wp_seq;
+		for (i = 1; i < WP_MAX_SEQ_NUMBER; i++) {
+			wp_seq = (wp_seq <= 1) ? WP_MAX_SEQ_NUMBER - 1 : wp_seq - 1;
+			treq = (struct rtw_xmit_req *)wd_ring[ch].wp_tag[wp_seq].ptr;
+			if (NULL == treq)
+				continue;
+
+			if (!drop &&
+			    RTW_PHL_STATUS_SUCCESS ==
+			    phl_tx_requeue_req_head(phl_info, treq)) {
+				_os_spinlock(drv, &wd_ring[ch].wp_tag_lock, _bh, NULL);
+				wd_ring[ch].wp_tag[wp_seq].ptr = NULL;
+				rpt_stats[ch].busy_cnt--;
+				_os_spinunlock(drv, &wd_ring[ch].wp_tag_lock, _bh, NULL);
+				requeue++;
+			} else {
+				phl_recycle_payload(phl_info, ch, wp_seq,
+						    TX_STATUS_TX_FAIL_SW_DROP);
+				dropped++;
+			}
+		}
+	}
+
+	PHL_INFO("%s: requeue %d tx req, drop %d\n", __func__, requeue, dropped);
+	*drop_cnt += dropped;
+
+	return requeue;
+}
+#endif /* CONFIG_PHL_SER_FAST_L1 */
+
 /**
  * Use this function to check if this report is valid
  * @wp_seq: the wp sequence parsing from target report
@@ -3869,6 +3941,9 @@ void phl_hci_trx_ops_init(void)
 	ops.recycle_busy_wd = phl_recycle_busy_wd;
 	ops.recycle_busy_h2c = phl_recycle_busy_h2c;
 	ops.read_hw_rx = phl_read_hw_rx;
+#ifdef CONFIG_PHL_SER_FAST_L1
+	ops.requeue_tx = phl_requeue_tx_pcie;
+#endif
 	ops.pltfm_tx = phl_pltfm_tx_pcie;
 	ops.alloc_h2c_pkt_buf = _phl_alloc_h2c_pkt_buf_pcie;
 	ops.free_h2c_pkt_buf = _phl_free_h2c_pkt_buf_pcie;
@@ -0,0 +1,1022 @@
+/******************************************************************************
+ *
+ * Copyright(c) 2019 Realtek Corporation.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of version 2 of the GNU General Public License as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ *****************************************************************************/
+#define _PHL_TRX_SIM_C_
+#include "../phl_headers.h"
+
+#ifdef CONFIG_PHL_HCI_SIM
+
+#define SIM_WHDR_OFST_ADDR1 4
+#define SIM_WHDR_OFST_ADDR2 10
+
+static struct phl_sim_info *_phl_get_sim(struct phl_info_t *phl_info)
+{
+	return (struct phl_sim_info *)phl_info->hci->sim;
+}
+
+/* xorshift32, deterministic per seed so CI runs are reproducible */
+static u32 _phl_sim_rand(struct phl_sim_info *sim)
+{
+	u32 x = sim->rand;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	sim->rand = x;
+
+	return x;
+}
+
+static bool _phl_sim_hit(struct phl_sim_info *sim, u16 permil)
+{
+	if (0 == permil)
+		return false;
+
+	return ((_phl_sim_rand(sim) % 1000) < permil) ? true : false;
+}
+
+static bool _phl_sim_is_due(u32 due_t, u32 cur_t)
+{
+	return ((s32)(cur_t - due_t) >= 0) ? true : false;
+}
+
+static void phl_tx_start_sim(struct phl_info_t *phl_info)
+{
+	void *drv = phl_to_drvpriv(phl_info);
+	_os_atomic_set(drv, &phl_info->phl_sw_tx_sts, PHL_TX_STATUS_RUNNING);
+}
+
+static void phl_req_tx_stop_sim(struct phl_info_t *phl_info)
+{
+	void *drv = phl_to_drvpriv(phl_info);
+	_os_atomic_set(drv, &phl_info->phl_sw_tx_sts,
+				PHL_TX_STATUS_STOP_INPROGRESS);
+}
+
+static void phl_tx_stop_sim(struct phl_info_t *phl_info)
+{
+	void *drv = phl_to_drvpriv(phl_info);
+	_os_atomic_set(drv, &phl_info->phl_sw_tx_sts, PHL_TX_STATUS_SW_PAUSE);
+}
+
+static bool phl_is_tx_sw_pause_sim(struct phl_info_t *phl_info)
+{
+	void *drvpriv = phl_to_drvpriv(phl_info);
+
+	if (PHL_TX_STATUS_SW_PAUSE == _os_atomic_read(drvpriv,
+								&phl_info->phl_sw_tx_sts))
+		return true;
+	else
+		return false;
+}
+
+static void phl_rx_start_sim(struct phl_info_t *phl_info)
+{
+	void *drv = phl_to_drvpriv(phl_info);
+	_os_atomic_set(drv, &phl_info->phl_sw_rx_sts, PHL_RX_STATUS_RUNNING);
+}
+
+static void phl_req_rx_stop_sim(struct phl_info_t *phl_info)
+{
+	void *drv = phl_to_drvpriv(phl_info);
+	_os_atomic_set(drv, &phl_info->phl_sw_rx_sts,
+				PHL_RX_STATUS_STOP_INPROGRESS);
+}
+
+static void phl_rx_stop_sim(struct phl_info_t *phl_info)
+{
+	void *drv = phl_to_drvpriv(phl_info);
+	_os_atomic_set(drv, &phl_info->phl_sw_rx_sts, PHL_RX_STATUS_SW_PAUSE);
+}
+
+static bool phl_is_rx_sw_pause_sim(struct phl_info_t *phl_info)
+{
+	void *drvpriv = phl_to_drvpriv(phl_info);
+
+	if (PHL_RX_STATUS_SW_PAUSE == _os_atomic_read(drvpriv,
+								&phl_info->phl_sw_rx_sts)) {
+		if (true == rtw_phl_is_phl_rx_idle(phl_info))
+			return true;
+		else
+			return false;
+	} else {
+		return false;
+	}
+}
+
+static struct phl_sim_rx_buf *
+_phl_sim_query_idle_rxbuf(struct phl_info_t *phl_info, struct phl_sim_info *sim)
+{
+	void *drv_priv = phl_to_drvpriv(phl_info);
+	struct phl_sim_rx_buf *rxbuf = NULL;
+
+	_os_spinlock(drv_priv, &sim->idle_rxbuf_lock, _bh, NULL);
+	if (false == list_empty(&sim->idle_rxbuf_list)) {
+		rxbuf = list_first_entry(&sim->idle_rxbuf_list,
+					 struct phl_sim_rx_buf, list);
+		list_del(&rxbuf->list);
+		sim->idle_rxbuf_cnt--;
+	}
+	_os_spinunlock(drv_priv, &sim->idle_rxbuf_lock, _bh, NULL);
+
+	return rxbuf;
+}
+
+static void _phl_sim_release_rxbuf(struct phl_info_t *phl_info,
+				   struct phl_sim_info *sim,
+				   struct phl_sim_rx_buf *rxbuf)
+{
+	void *drv_priv = phl_to_drvpriv(phl_info);
+
+	rxbuf->data_len = 0;
+	_os_spinlock(drv_priv, &sim->idle_rxbuf_lock, _bh, NULL);
+	list_add_tail(&rxbuf->list, &sim->idle_rxbuf_list);
+	sim->idle_rxbuf_cnt++;
+	_os_spinunlock(drv_priv, &sim->idle_rxbuf_lock, _bh, NULL);
+}
+
+static enum rtw_phl_status
+phl_release_target_rx_buf_sim(struct phl_info_t *phl_info, void *r, u8 ch,
+			      enum rtw_rx_type type)
+{
+	struct phl_sim_info *sim = _phl_get_sim(phl_info);
+
+	if (NULL == sim || NULL == r)
+		return RTW_PHL_STATUS_FAILURE;
+
+	_phl_sim_release_rxbuf(phl_info, sim, (struct phl_sim_rx_buf *)r);
+
+	return RTW_PHL_STATUS_SUCCESS;
+}
+
+static void phl_recycle_rx_pkt_sim(struct phl_info_t *phl_info,
+				   struct rtw_phl_rx_pkt *phl_rx)
+{
+	phl_recycle_rx_buf(phl_info, phl_rx);
+}
+
+static void _phl_sim_free_rxbuf(struct phl_info_t *phl_info,
+				struct phl_sim_info *sim)
+{
+	void *drv_priv = phl_to_drvpriv(phl_info);
+	struct phl_sim_rx_buf *rxbuf = NULL;
+	u16 i = 0;
+
+	for (i = 0; i < SIM_RX_BUF_NUM; i++) {
+		rxbuf = &sim->rx_buf[i];
+		if (NULL == rxbuf->vir_addr)
+			continue;
+		_os_mem_free(drv_priv, rxbuf->vir_addr, rxbuf->buf_len);
+		rxbuf->vir_addr = NULL;
+	}
+	INIT_LIST_HEAD(&sim->idle_rxbuf_list);
+	sim->idle_rxbuf_cnt = 0;
+}
+
+static enum rtw_phl_status
+_phl_sim_alloc_rxbuf(struct phl_info_t *phl_info, struct phl_sim_info *sim)
+{
+	void *drv_priv = phl_to_drvpriv(phl_info);
+	struct phl_sim_rx_buf *rxbuf = NULL;
+	u16 i = 0;
+
+	INIT_LIST_HEAD(&sim->idle_rxbuf_list);
+	sim->idle_rxbuf_cnt = 0;
+
+	for (i = 0; i < SIM_RX_BUF_NUM; i++) {
+		rxbuf = &sim->rx_buf[i];
+		rxbuf->vir_addr = _os_mem_alloc(drv_priv, SIM_RX_BUF_SIZE);
+		if (NULL == rxbuf->vir_addr) {
+			PHL_ERR("%s: alloc rx buf %d fail\n", __func__, i);
+			_phl_sim_free_rxbuf(phl_info, sim);
+			return RTW_PHL_STATUS_RESOURCE;
+		}
+		rxbuf->buf_len = SIM_RX_BUF_SIZE;
+		INIT_LIST_HEAD(&rxbuf->list);
+		list_add_tail(&rxbuf->list, &sim->idle_rxbuf_list);
+		sim->idle_rxbuf_cnt++;
+	}
+
+	return RTW_PHL_STATUS_SUCCESS;
+}
+
+static enum rtw_phl_status
+phl_prepare_tx_sim(struct phl_info_t *phl_info, struct rtw_xmit_req *tx_req)
+{
+	enum rtw_phl_status pstatus = RTW_PHL_STATUS_FAILURE;
+	void *drv_priv = phl_to_drvpriv(phl_info);
+	struct phl_sim_info *sim = _phl_get_sim(phl_info);
+	struct rtw_pkt_buf_list *pkt_buf = NULL;
+	struct phl_sim_txbd *txbd = NULL;
+	u32 start_t = _os_get_cur_time_us();
+	u16 packet_len = 0, wp_seq = 0, next_idx = 0;
+	u8 i = 0;
+
+	if (NULL == sim || NULL == tx_req)
+		return pstatus;
+
+	pkt_buf = (struct rtw_pkt_buf_list *)&tx_req->pkt_list[0];
+	for (i = 0; i < tx_req->pkt_cnt; i++) {
+		packet_len += pkt_buf->length;
+		pkt_buf++;
+	}
+	tx_req->total_len = packet_len;
+	tx_req->mdata.pktlen = packet_len;
+	tx_req->mdata.addr_info_num = tx_req->pkt_cnt;
+
+	_os_spinlock(drv_priv, &sim->txbd_lock, _bh, NULL);
+	next_idx = (sim->txbd_host_idx + 1) % SIM_TXBD_NUM;
+	if (next_idx == sim->txbd_hw_idx) {
+		sim->stats.tx_full_cnt++;
+		_os_spinunlock(drv_priv, &sim->txbd_lock, _bh, NULL);
+		PHL_TRACE(COMP_PHL_XMIT, _PHL_DEBUG_, "%s: txbd full\n", __func__);
+		return RTW_PHL_STATUS_RESOURCE;
+	}
+
+	_os_spinlock(drv_priv, &sim->wp_tag_lock, _bh, NULL);
+	wp_seq = sim->wp_seq;
+	if (NULL != sim->wp_tag[wp_seq]) {
+		_os_spinunlock(drv_priv, &sim->wp_tag_lock, _bh, NULL);
+		_os_spinunlock(drv_priv, &sim->txbd_lock, _bh, NULL);
+		PHL_ERR("%s: wp_tag out of resource, wp_seq = 0x%x\n",
+			__func__, wp_seq);
+		return RTW_PHL_STATUS_RESOURCE;
+	}
+	sim->wp_tag[wp_seq] = tx_req;
+	wp_seq = (wp_seq + 1) % SIM_WP_MAX_SEQ_NUMBER;
+	if (0 == wp_seq)
+		wp_seq = 1;
+	_os_spinunlock(drv_priv, &sim->wp_tag_lock, _bh, NULL);
+
+	txbd = &sim->txbd[sim->txbd_host_idx];
+	txbd->treq = tx_req;
+	txbd->wp_seq = sim->wp_seq;
+	txbd->dma_ch = tx_req->mdata.dma_ch;
+	sim->wp_seq = wp_seq;
+	sim->txbd_host_idx = next_idx;
+	sim->stats.tx_req_cnt++;
+	_os_spinunlock(drv_priv, &sim->txbd_lock, _bh, NULL);
+
+	tx_req->tx_time = _os_get_cur_time_ms();
+	sim->stats.tx_time_us += phl_get_passing_time_us(start_t);
+
+	pstatus = RTW_PHL_STATUS_SUCCESS;
+
+	return pstatus;
+}
+
+static void _phl_sim_fill_rx_mdata(struct phl_sim_info *sim,
+				   struct rtw_xmit_req *treq,
+				   struct phl_sim_rx_buf *rxbuf,
+				   struct rtw_r_meta_data *mdata)
+{
+	u8 *hdr = rxbuf->vir_addr;
+	u8 *a1 = hdr + SIM_WHDR_OFST_ADDR1;
+	u8 *a2 = hdr + SIM_WHDR_OFST_ADDR2;
+	u8 i = 0;
+
+	_os_mem_set(NULL, mdata, 0, sizeof(*mdata));
+
+	mdata->dma_ch = 0;
+	mdata->pktlen = rxbuf->data_len;
+	mdata->macid = treq->mdata.macid;
+	mdata->tid = treq->mdata.tid;
+	mdata->seq = treq->mdata.sw_seq;
+	mdata->rx_rate = treq->mdata.f_rate;
+	mdata->bw = treq->mdata.f_bw;
+	mdata->ampdu = treq->mdata.ampdu_en;
+	mdata->a1_match = 1;
+	mdata->rpkt_type = RTW_RX_TYPE_WIFI;
+
+	if (rxbuf->data_len < 24)
+		return;
+
+	mdata->frame_type = (hdr[0] >> 2) & 0x3;
+	mdata->qos = (hdr[0] & BIT7) ? 1 : 0;
+	mdata->more_frag = (hdr[1] & BIT2) ? 1 : 0;
+	mdata->pwr_bit = (hdr[1] & BIT4) ? 1 : 0;
+	mdata->more_data = (hdr[1] & BIT5) ? 1 : 0;
+
+	mdata->bc = 1;
+	for (i = 0; i < 6; i++) {
+		if (a1[i] != 0xff) {
+			mdata->bc = 0;
+			break;
+		}
+	}
+	if (!mdata->bc && (a1[0] & BIT0))
+		mdata->mc = 1;
+
+	_os_mem_cpy(NULL, mdata->ta, a2, 6);
+}
+
+static void _phl_sim_push_wp_rpt(struct phl_sim_info *sim, u16 wp_seq,
+				 u8 dma_ch, u8 txsts)
+{
+	struct phl_sim_wp_rpt *rpt = &sim->wp_rpt[sim->wp_rpt_wptr];
+
+	rpt->wp_seq = wp_seq;
+	rpt->dma_ch = dma_ch;
+	rpt->txsts = txsts;
+	sim->wp_rpt_wptr = (sim->wp_rpt_wptr + 1) % SIM_WP_RPT_NUM;
+}
+
+/*
+ * Move one TX BD over the loopback medium: either lose it, or copy the
+ * payload into an RX buffer and queue it on the RX BD ring with its delivery
+ * time. A wp report is always queued so the TX request gets recycled.
+ */
+static void _phl_sim_dma_tx(struct phl_info_t *phl_info,
+			    struct phl_sim_info *sim,
+			    struct phl_sim_txbd *txbd, u32 cur_t)
+{
+	struct rtw_xmit_req *treq = txbd->treq;
+	struct rtw_pkt_buf_list *pkt_buf = NULL;
+	struct phl_sim_rx_buf *rxbuf = NULL;
+	struct phl_sim_rxbd *rxbd = NULL, *prev = NULL, tmp;
+	u16 next_idx = 0, prev_idx = 0, ofst = 0;
+	u8 txsts = TX_STATUS_TX_DONE;
+	u8 i = 0;
+
+	sim->stats.tx_dma_cnt++;
+
+	if (true == _phl_sim_hit(sim, sim->cfg.loss_permil)) {
+		sim->stats.tx_loss_cnt++;
+		txsts = TX_STATUS_TX_FAIL_REACH_RTY_LMT;
+		goto wp_rpt;
+	}
+
+	next_idx = (sim->rxbd_host_idx + 1) % SIM_RXBD_NUM;
+	if (next_idx == sim->rxbd_hw_idx ||
+	    treq->total_len > SIM_RX_BUF_SIZE) {
+		sim->stats.rx_drop_cnt++;
+		goto wp_rpt;
+	}
+
+	rxbuf = _phl_sim_query_idle_rxbuf(phl_info, sim);
+	if (NULL == rxbuf) {
+		sim->stats.rx_drop_cnt++;
+		goto wp_rpt;
+	}
+
+	pkt_buf = (struct rtw_pkt_buf_list *)&treq->pkt_list[0];
+	for (i = 0; i < treq->pkt_cnt; i++) {
+		_os_mem_cpy(phl_to_drvpriv(phl_info), rxbuf->vir_addr + ofst,
+			    pkt_buf->vir_addr, pkt_buf->length);
+		ofst += pkt_buf->length;
+		pkt_buf++;
+	}
+	rxbuf->data_len = ofst;
+
+	rxbd = &sim->rxbd[sim->rxbd_host_idx];
+	rxbd->rxbuf = rxbuf;
+	rxbd->due_t = cur_t + sim->cfg.latency_us;
+	_phl_sim_fill_rx_mdata(sim, treq, rxbuf, &rxbd->mdata);
+
+	/* swap with the previous undelivered frame to emulate reordering */
+	if (sim->rxbd_host_idx != sim->rxbd_hw_idx &&
+	    true == _phl_sim_hit(sim, sim->cfg.reorder_permil)) {
+		prev_idx = (sim->rxbd_host_idx + SIM_RXBD_NUM - 1) % SIM_RXBD_NUM;
+		prev = &sim->rxbd[prev_idx];
+		tmp = *prev;
+		*prev = *rxbd;
+		*rxbd = tmp;
+		/* keep the delivery time slots, only the frames change place */
+		rxbd->due_t = prev->due_t;
+		prev->due_t = tmp.due_t;
+		sim->stats.tx_reorder_cnt++;
+	}
+
+	sim->rxbd_host_idx = next_idx;
+
+wp_rpt:
+	_phl_sim_push_wp_rpt(sim, txbd->wp_seq, txbd->dma_ch, txsts);
+	txbd->treq = NULL;
+}
+
+static enum rtw_phl_status phl_tx_sim(struct phl_info_t *phl_info)
+{
+	void *drv_priv = phl_to_drvpriv(phl_info);
+	struct phl_sim_info *sim = _phl_get_sim(phl_info);
+	u32 start_t = _os_get_cur_time_us();
+	u16 cnt = 0;
+
+	if (NULL == sim)
+		return RTW_PHL_STATUS_FAILURE;
+
+	_os_spinlock(drv_priv, &sim->txbd_lock, _bh, NULL);
+	_os_spinlock(drv_priv, &sim->rxbd_lock, _bh, NULL);
+	while (sim->txbd_hw_idx != sim->txbd_host_idx) {
+		_phl_sim_dma_tx(phl_info, sim, &sim->txbd[sim->txbd_hw_idx],
+				start_t);
+		sim->txbd_hw_idx = (sim->txbd_hw_idx + 1) % SIM_TXBD_NUM;
+		cnt++;
+	}
+	_os_spinunlock(drv_priv, &sim->rxbd_lock, _bh, NULL);
+	_os_spinunlock(drv_priv, &sim->txbd_lock, _bh, NULL);
+
+	sim->stats.tx_time_us += phl_get_passing_time_us(start_t);
+
+	if (cnt) {
+#ifdef CONFIG_POWER_SAVE
+		phl_ps_tx_pkt_ntfy(phl_info);
+#endif
+		phl_schedule_handler(phl_info->phl_com,
+				     &phl_info->phl_rx_handler);
+	}
+
+	return RTW_PHL_STATUS_SUCCESS;
+}
+
+static void _phl_sim_recycle_payload(struct phl_info_t *phl_info,
+				     struct phl_sim_info *sim,
+				     struct phl_sim_wp_rpt *rpt)
+{
+	enum rtw_phl_status sts = RTW_PHL_STATUS_FAILURE;
+	void *drv_priv = phl_to_drvpriv(phl_info);
+	struct rtw_phl_evt_ops *ops = &phl_info->phl_com->evt_ops;
+	struct rtw_xmit_req *treq = NULL;
+
+	_os_spinlock(drv_priv, &sim->wp_tag_lock, _bh, NULL);
+	treq = sim->wp_tag[rpt->wp_seq];
+	_os_spinunlock(drv_priv, &sim->wp_tag_lock, _bh, NULL);
+
+	if (NULL == treq)
+		goto end;
+
+	sim->stats.wp_rpt_cnt++;
+
+	if (treq->txfb) {
+		treq->txfb->txsts = rpt->txsts;
+		if (treq->txfb->txfb_cb)
+			treq->txfb->txfb_cb(treq->txfb);
+	}
+
+	if (RTW_PHL_TREQ_TYPE_TEST_PATTERN == treq->treq_type) {
+		if (NULL == ops->tx_test_recycle)
+			goto end;
+		sts = ops->tx_test_recycle(phl_info, treq);
+	} else if (RTW_PHL_TREQ_TYPE_NORMAL == treq->treq_type
+#if defined(CONFIG_CORE_TXSC) || defined(CONFIG_PHL_TXSC)
+		   || RTW_PHL_TREQ_TYPE_CORE_TXSC == treq->treq_type
+		   || RTW_PHL_TREQ_TYPE_PHL_ADD_TXSC == treq->treq_type
+#endif
+	) {
+		if (NULL == ops->tx_recycle)
+			goto end;
+		sts = ops->tx_recycle(drv_priv, treq);
+	}
+
+end:
+	if (RTW_PHL_STATUS_SUCCESS != sts) {
+		sim->stats.recycle_fail_cnt++;
+	} else {
+		_os_spinlock(drv_priv, &sim->wp_tag_lock, _bh, NULL);
+		sim->wp_tag[rpt->wp_seq] = NULL;
+		_os_spinunlock(drv_priv, &sim->wp_tag_lock, _bh, NULL);
+	}
+}
+
+static void phl_rx_handle_normal_sim(struct phl_info_t *phl_info,
+				     struct rtw_phl_rx_pkt *phl_rx)
+{
+	enum rtw_phl_status pstatus = RTW_PHL_STATUS_FAILURE;
+	_os_list frames;
+
+	INIT_LIST_HEAD(&frames);
+
+	if (phl_rx->r.mdata.rx_rate <= RTW_DATA_RATE_HE_NSS4_MCS11)
+		phl_info->phl_com->phl_stats.rx_rate_nmr[phl_rx->r.mdata.rx_rate]++;
+
+	pstatus = phl_rx_reorder(phl_info, phl_rx, &frames);
+	if (pstatus == RTW_PHL_STATUS_SUCCESS)
+		phl_handle_rx_frame_list(phl_info, &frames);
+	else
+		PHL_TRACE(COMP_PHL_RECV, _PHL_WARNING_,
+			  "[WARNING]handle normal rx error (0x%08X)!\n", pstatus);
+}
+
+static enum rtw_phl_status phl_rx_sim(struct phl_info_t *phl_info)
+{
+	void *drv_priv = phl_to_drvpriv(phl_info);
+	struct phl_sim_info *sim = _phl_get_sim(phl_info);
+	struct phl_sim_rxbd *rxbd = NULL;
+	struct rtw_phl_rx_pkt *phl_rx = NULL;
+	struct phl_sim_wp_rpt rpt;
+	u32 start_t = _os_get_cur_time_us();
+	u32 wait_us = 0;
+
+	if (NULL == sim)
+		return RTW_PHL_STATUS_FAILURE;
+
+	/* wp reports first, as the release report channel does on hardware */
+	_os_spinlock(drv_priv, &sim->rxbd_lock, _bh, NULL);
+	while (sim->wp_rpt_rptr != sim->wp_rpt_wptr) {
+		rpt = sim->wp_rpt[sim->wp_rpt_rptr];
+		sim->wp_rpt_rptr = (sim->wp_rpt_rptr + 1) % SIM_WP_RPT_NUM;
+		_os_spinunlock(drv_priv, &sim->rxbd_lock, _bh, NULL);
+		_phl_sim_recycle_payload(phl_info, sim, &rpt);
+		_os_spinlock(drv_priv, &sim->rxbd_lock, _bh, NULL);
+	}
+
+	while (sim->rxbd_hw_idx != sim->rxbd_host_idx) {
+		rxbd = &sim->rxbd[sim->rxbd_hw_idx];
+		if (false == _phl_sim_is_due(rxbd->due_t, start_t)) {
+			wait_us = rxbd->due_t - start_t;
+			break;
+		}
+
+		phl_rx = rtw_phl_query_phl_rx(phl_info);
+		if (NULL == phl_rx)
+			break;
+
+		phl_rx->type = RTW_RX_TYPE_WIFI;
+		phl_rx->rxbuf_ptr = (u8 *)rxbd->rxbuf;
+		phl_rx->r.os_priv = NULL;
+		phl_rx->r.mdata = rxbd->mdata;
+		phl_rx->r.pkt_cnt = 1;
+		phl_rx->r.pkt_list[0].vir_addr = rxbd->rxbuf->vir_addr;
+		phl_rx->r.pkt_list[0].length = rxbd->rxbuf->data_len;
+		rxbd->rxbuf = NULL;
+		sim->rxbd_hw_idx = (sim->rxbd_hw_idx + 1) % SIM_RXBD_NUM;
+		sim->stats.rx_cnt++;
+
+		_os_spinunlock(drv_priv, &sim->rxbd_lock, _bh, NULL);
+		phl_rx_handle_normal_sim(phl_info, phl_rx);
+		_os_spinlock(drv_priv, &sim->rxbd_lock, _bh, NULL);
+	}
+	_os_spinunlock(drv_priv, &sim->rxbd_lock, _bh, NULL);
+
+#ifdef PHL_RX_BATCH_IND
+	if (phl_info->rx_new_pending)
+		_phl_indic_new_rxpkt(phl_info);
+#endif
+
+	sim->stats.rx_time_us += phl_get_passing_time_us(start_t);
+
+	/* frames still in flight, come back when the first one is due */
+	if (wait_us)
+		_os_set_timer(drv_priv, &sim->rx_timer,
+			      _os_div_round_up(wait_us, 1000));
+
+	return RTW_PHL_STATUS_SUCCESS;
+}
+
+static void _phl_sim_rx_timer_hdl(void *context)
+{
+	struct phl_info_t *phl_info = (struct phl_info_t *)context;
+
+	phl_schedule_handler(phl_info->phl_com, &phl_info->phl_rx_handler);
+}
+
+static enum rtw_phl_status _phl_handle_xmit_ring_sim
+						(struct phl_info_t *phl_info,
+						struct phl_ring_status *ring_sts)
+{
+	enum rtw_phl_status pstatus = RTW_PHL_STATUS_FAILURE;
+	struct phl_hci_trx_ops *hci_trx_ops = phl_info->hci_trx_ops;
+	struct rtw_phl_tx_ring *tring = ring_sts->ring_ptr;
+	struct rtw_xmit_req *tx_req = NULL;
+	u16 rptr = 0;
+	void *drv_priv = phl_to_drvpriv(phl_info);
+
+	while (0 != ring_sts->req_busy) {
+		rptr = (u16)_os_atomic_read(drv_priv, &tring->phl_next_idx);
+
+		tx_req = (struct rtw_xmit_req *)tring->entry[rptr];
+		if (NULL == tx_req)
+			break;
+		tx_req->mdata.macid = ring_sts->macid;
+		tx_req->mdata.band = ring_sts->band;
+		tx_req->mdata.wmm = ring_sts->wmm;
+		tx_req->mdata.hal_port = ring_sts->port;
+		tx_req->mdata.tid = tring->tid;
+		tx_req->mdata.dma_ch = tring->dma_ch;
+		pstatus = hci_trx_ops->prepare_tx(phl_info, tx_req);
+		if (RTW_PHL_STATUS_SUCCESS != pstatus)
+			break;
+
+		ring_sts->req_busy--;
+		_os_atomic_set(drv_priv, &tring->phl_idx, rptr);
+		if (0 != ring_sts->req_busy) {
+			if (rptr + 1 >= MAX_PHL_RING_ENTRY_NUM)
+				_os_atomic_set(drv_priv, &tring->phl_next_idx, 0);
+			else
+				_os_atomic_inc(drv_priv, &tring->phl_next_idx);
+		}
+	}
+
+	return pstatus;
+}
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5,17,0)
+static void _phl_tx_callback_sim(unsigned long priv)
+{
+	void *context = (void *)priv;
+#else
+static void _phl_tx_callback_sim(void *context)
+{
+#endif
+	enum rtw_phl_status pstatus = RTW_PHL_STATUS_FAILURE;
+	struct rtw_phl_handler *phl_handler
+		= (struct rtw_phl_handler *)phl_container_of(context,
+							struct rtw_phl_handler,
+							os_handler);
+	struct phl_info_t *phl_info = (struct phl_info_t *)phl_handler->context;
+	struct phl_hci_trx_ops *hci_trx_ops = phl_info->hci_trx_ops;
+	struct phl_ring_status *ring_sts = NULL, *t;
+	void *drvpriv = phl_to_drvpriv(phl_info);
+	_os_list sta_list;
+
+	INIT_LIST_HEAD(&sta_list);
+
+	if (true == phl_datapath_chk_trx_pause(phl_info, PHL_CTRL_TX))
+		goto end;
+
+	if (true == phl_check_xmit_ring_resource(phl_info, &sta_list)) {
+		phl_tx_flow_ctrl(phl_info, &sta_list);
+
+		phl_list_for_loop_safe(ring_sts, t, struct phl_ring_status,
+		                       &phl_info->t_fctrl_result, list) {
+			list_del(&ring_sts->list);
+			_phl_handle_xmit_ring_sim(phl_info, ring_sts);
+			phl_release_ring_sts(phl_info, ring_sts);
+		}
+	}
+
+	pstatus = hci_trx_ops->tx(phl_info);
+	if (RTW_PHL_STATUS_FAILURE == pstatus)
+		PHL_TRACE(COMP_PHL_DBG, _PHL_WARNING_, "[WARNING] phl_tx fail!\n");
+
+	if (PHL_TX_STATUS_STOP_INPROGRESS ==
+	    _os_atomic_read(drvpriv, &phl_info->phl_sw_tx_sts))
+		phl_tx_stop_sim(phl_info);
+
+end:
+	phl_free_deferred_tx_ring(phl_info);
+}
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5,17,0)
+static void _phl_rx_callback_sim(unsigned long priv)
+{
+	void *context = (void *)priv;
+#else
+static void _phl_rx_callback_sim(void *context)
+{
+#endif
+	struct rtw_phl_handler *phl_handler
+		= (struct rtw_phl_handler *)phl_container_of(context,
+							struct rtw_phl_handler,
+							os_handler);
+	struct phl_info_t *phl_info = (struct phl_info_t *)phl_handler->context;
+	struct phl_hci_trx_ops *hci_trx_ops = phl_info->hci_trx_ops;
+	void *drvpriv = phl_to_drvpriv(phl_info);
+
+	if (true == phl_datapath_chk_trx_pause(phl_info, PHL_CTRL_RX))
+		return;
+
+	if (true == phl_check_recv_ring_resource(phl_info))
+		hci_trx_ops->rx(phl_info);
+
+	if (PHL_RX_STATUS_STOP_INPROGRESS ==
+	    _os_atomic_read(drvpriv, &phl_info->phl_sw_rx_sts))
+		phl_rx_stop_sim(phl_info);
+}
+
+static void _phl_sim_reset_ring(struct phl_info_t *phl_info,
+				struct phl_sim_info *sim, u8 type)
+{
+	void *drv_priv = phl_to_drvpriv(phl_info);
+	struct phl_sim_wp_rpt rpt;
+	u16 i = 0;
+
+	if (PHL_CTRL_TX & type) {
+		/* every undelivered tx request is reported as sw drop */
+		_os_spinlock(drv_priv, &sim->txbd_lock, _bh, NULL);
+		sim->txbd_host_idx = 0;
+		sim->txbd_hw_idx = 0;
+		_os_spinunlock(drv_priv, &sim->txbd_lock, _bh, NULL);
+		sim->wp_rpt_rptr = sim->wp_rpt_wptr;
+		for (i = 0; i < SIM_WP_MAX_SEQ_NUMBER; i++) {
+			if (NULL == sim->wp_tag[i])
+				continue;
+			rpt.wp_seq = i;
+			rpt.dma_ch = 0;
+			rpt.txsts = TX_STATUS_TX_FAIL_SW_DROP;
+			_phl_sim_recycle_payload(phl_info, sim, &rpt);
+		}
+	}
+
+	if (PHL_CTRL_RX & type) {
+		_os_spinlock(drv_priv, &sim->rxbd_lock, _bh, NULL);
+		while (sim->rxbd_hw_idx != sim->rxbd_host_idx) {
+			if (sim->rxbd[sim->rxbd_hw_idx].rxbuf)
+				_phl_sim_release_rxbuf(phl_info, sim,
+					sim->rxbd[sim->rxbd_hw_idx].rxbuf);
+			sim->rxbd[sim->rxbd_hw_idx].rxbuf = NULL;
+			sim->rxbd_hw_idx = (sim->rxbd_hw_idx + 1) % SIM_RXBD_NUM;
+		}
+		sim->rxbd_host_idx = 0;
+		sim->rxbd_hw_idx = 0;
+		_os_spinunlock(drv_priv, &sim->rxbd_lock, _bh, NULL);
+	}
+}
+
+static void phl_trx_reset_sim(struct phl_info_t *phl_info, u8 type)
+{
+	struct phl_sim_info *sim = _phl_get_sim(phl_info);
+	struct rtw_stats *phl_stats = &phl_info->phl_com->phl_stats;
+
+	PHL_INFO("%s\n", __func__);
+
+	if (NULL == sim)
+		return;
+
+	_phl_sim_reset_ring(phl_info, sim, type);
+
+	if (PHL_CTRL_TX & type)
+		phl_reset_tx_stats(phl_stats);
+	if (PHL_CTRL_RX & type)
+		phl_reset_rx_stats(phl_stats);
+}
+
+static void phl_trx_resume_sim(struct phl_info_t *phl_info, u8 type)
+{
+	if (PHL_CTRL_TX & type)
+		phl_tx_start_sim(phl_info);
+
+	if (PHL_CTRL_RX & type)
+		phl_rx_start_sim(phl_info);
+}
+
+static void phl_trx_stop_sim(struct phl_info_t *phl_info)
+{
+	phl_trx_reset_sim(phl_info, PHL_CTRL_TX|PHL_CTRL_RX);
+}
+
+static void phl_trx_deinit_sim(struct phl_info_t *phl_info)
+{
+	void *drv_priv = phl_to_drvpriv(phl_info);
+	struct phl_sim_info *sim = _phl_get_sim(phl_info);
+
+	FUNCIN();
+	if (NULL == sim)
+		return;
+
+	_os_cancel_timer(drv_priv, &sim->rx_timer);
+	_os_release_timer(drv_priv, &sim->rx_timer);
+	_phl_sim_free_rxbuf(phl_info, sim);
+	_os_spinlock_free(drv_priv, &sim->txbd_lock);
+	_os_spinlock_free(drv_priv, &sim->rxbd_lock);
+	_os_spinlock_free(drv_priv, &sim->wp_tag_lock);
+	_os_spinlock_free(drv_priv, &sim->idle_rxbuf_lock);
+	_os_mem_free(drv_priv, sim, sizeof(*sim));
+	phl_info->hci->sim = NULL;
+	FUNCOUT();
+}
+
+static enum rtw_phl_status phl_register_trx_hdlr_sim(struct phl_info_t *phl_info)
+{
+	enum rtw_phl_status pstatus = RTW_PHL_STATUS_FAILURE;
+	struct rtw_phl_handler *tx_handler = &phl_info->phl_tx_handler;
+	struct rtw_phl_handler *rx_handler = &phl_info->phl_rx_handler;
+	void *drv_priv = phl_to_drvpriv(phl_info);
+
+	tx_handler->type = RTW_PHL_HANDLER_PRIO_HIGH;
+	tx_handler->callback = _phl_tx_callback_sim;
+	tx_handler->context = phl_info;
+	tx_handler->drv_priv = drv_priv;
+	pstatus = phl_register_handler(phl_info->phl_com, tx_handler);
+	if (RTW_PHL_STATUS_SUCCESS != pstatus) {
+		PHL_ERR("%s : register tx_handler fail.\n", __FUNCTION__);
+		return pstatus;
+	}
+
+	rx_handler->type = RTW_PHL_HANDLER_PRIO_HIGH;
+	rx_handler->callback = _phl_rx_callback_sim;
+	rx_handler->context = phl_info;
+	rx_handler->drv_priv = drv_priv;
+	pstatus = phl_register_handler(phl_info->phl_com, rx_handler);
+	if (RTW_PHL_STATUS_SUCCESS != pstatus)
+		PHL_ERR("%s : register rx_handler fail.\n", __FUNCTION__);
+
+	return pstatus;
+}
+
+static enum rtw_phl_status phl_trx_init_sim(struct phl_info_t *phl_info)
+{
+	enum rtw_phl_status pstatus = RTW_PHL_STATUS_FAILURE;
+	void *drv_priv = phl_to_drvpriv(phl_info);
+	struct phl_sim_info *sim = NULL;
+
+	FUNCIN_WSTS(pstatus);
+
+	sim = _os_mem_alloc(drv_priv, sizeof(*sim));
+	if (NULL == sim) {
+		PHL_ERR("%s: alloc sim info fail\n", __func__);
+		return RTW_PHL_STATUS_RESOURCE;
+	}
+	_os_mem_set(drv_priv, sim, 0, sizeof(*sim));
+
+	sim->cfg.latency_us = SIM_DEF_LATENCY_US;
+	sim->cfg.loss_permil = SIM_DEF_LOSS_PERMIL;
+	sim->cfg.reorder_permil = SIM_DEF_REORDER_PERMIL;
+	sim->cfg.seed = 0x5eed;
+	sim->rand = sim->cfg.seed;
+	sim->wp_seq = 1;
+
+	_os_spinlock_init(drv_priv, &sim->txbd_lock);
+	_os_spinlock_init(drv_priv, &sim->rxbd_lock);
+	_os_spinlock_init(drv_priv, &sim->wp_tag_lock);
+	_os_spinlock_init(drv_priv, &sim->idle_rxbuf_lock);
+	_os_init_timer(drv_priv, &sim->rx_timer, _phl_sim_rx_timer_hdl,
+		       phl_info, "phl_sim_rx_timer");
+
+	phl_info->hci->sim = sim;
+
+	pstatus = _phl_sim_alloc_rxbuf(phl_info, sim);
+	if (RTW_PHL_STATUS_SUCCESS == pstatus)
+		pstatus = phl_register_trx_hdlr_sim(phl_info);
+
+	if (RTW_PHL_STATUS_SUCCESS != pstatus)
+		phl_trx_deinit_sim(phl_info);
+
+	FUNCOUT_WSTS(pstatus);
+	return pstatus;
+}
+
+static enum rtw_phl_status phl_trx_config_sim(struct phl_info_t *phl_info)
+{
+	/* no hardware behind the rings, only start the sw datapath */
+	phl_tx_start_sim(phl_info);
+	phl_rx_start_sim(phl_info);
+
+	return RTW_PHL_STATUS_SUCCESS;
+}
+
+static enum rtw_phl_status phl_pltfm_tx_sim(struct phl_info_t *phl_info, void *pkt)
+{
+	struct phl_sim_info *sim = _phl_get_sim(phl_info);
+	struct rtw_h2c_pkt *h2c_pkt = (struct rtw_h2c_pkt *)pkt;
+
+	/* h2c is consumed immediately, there is no firmware to read it */
+	if (sim)
+		sim->stats.h2c_cnt++;
+
+	return phl_enqueue_idle_h2c_pkt(phl_info, h2c_pkt);
+}
+
+static void phl_free_h2c_pkt_buf_sim(struct phl_info_t *phl_info,
+				     struct rtw_h2c_pkt *h2c_pkt)
+{
+	_os_mem_free(phl_to_drvpriv(phl_info), h2c_pkt->vir_head,
+		     h2c_pkt->buf_len);
+}
+
+static enum rtw_phl_status
+phl_alloc_h2c_pkt_buf_sim(struct phl_info_t *phl_info,
+			  struct rtw_h2c_pkt *h2c_pkt, u32 buf_len)
+{
+	h2c_pkt->vir_head = _os_mem_alloc(phl_to_drvpriv(phl_info), buf_len);
+
+	return (h2c_pkt->vir_head) ? RTW_PHL_STATUS_SUCCESS :
+				     RTW_PHL_STATUS_FAILURE;
+}
+
+static void *phl_get_txbd_buf_sim(struct phl_info_t *phl_info)
+{
+	return NULL;
+}
+
+static void *phl_get_rxbd_buf_sim(struct phl_info_t *phl_info)
+{
+	return NULL;
+}
+
+static void phl_tx_watchdog_sim(struct phl_info_t *phl_info)
+{
+	struct rtw_stats *phl_stats = &phl_info->phl_com->phl_stats;
+
+	phl_tx_traffic_upd(phl_stats);
+}
+
+#ifdef CONFIG_PCI_HCI
+static enum rtw_phl_status phl_recycle_busy_wd_sim(struct phl_info_t *phl_info)
+{
+	/* tx BDs are released by the wp report path */
+	return RTW_PHL_STATUS_SUCCESS;
+}
+
+static enum rtw_phl_status phl_recycle_busy_h2c_sim(struct phl_info_t *phl_info)
+{
+	/* h2c packets are returned to idle in phl_pltfm_tx_sim */
+	return RTW_PHL_STATUS_SUCCESS;
+}
+
+static void phl_read_hw_rx_sim(struct phl_info_t *phl_info,
+			       enum rx_channel_type rx_ch)
+{
+}
+#endif
+
+void phl_trx_sim_set_cfg(struct phl_info_t *phl_info, struct phl_sim_cfg *cfg)
+{
+	struct phl_sim_info *sim = _phl_get_sim(phl_info);
+
+	if (NULL == sim)
+		return;
+
+	sim->cfg.latency_us = cfg->latency_us;
+	sim->cfg.loss_permil = (cfg->loss_permil > 1000) ? 1000 : cfg->loss_permil;
+	sim->cfg.reorder_permil = (cfg->reorder_permil > 1000) ?
+				  1000 : cfg->reorder_permil;
+	if (cfg->seed) {
+		sim->cfg.seed = cfg->seed;
+		sim->rand = cfg->seed;
+	}
+
+	PHL_INFO("%s: latency %d us, loss %d, reorder %d (permil), seed 0x%x\n",
+		 __func__, sim->cfg.latency_us, sim->cfg.loss_permil,
+		 sim->cfg.reorder_permil, sim->cfg.seed);
+}
+
+void phl_trx_sim_get_stats(struct phl_info_t *phl_info,
+			   struct phl_sim_stats *stats)
+{
+	struct phl_sim_info *sim = _phl_get_sim(phl_info);
+
+	if (NULL == sim)
+		return;
+
+	_os_mem_cpy(phl_to_drvpriv(phl_info), stats, &sim->stats,
+		    sizeof(*stats));
+}
+
+void phl_trx_sim_reset_stats(struct phl_info_t *phl_info)
+{
+	struct phl_sim_info *sim = _phl_get_sim(phl_info);
+
+	if (NULL == sim)
+		return;
+
+	_os_mem_set(phl_to_drvpriv(phl_info), &sim->stats, 0,
+		    sizeof(sim->stats));
+}
+
+static struct phl_hci_trx_ops ops_sim = {0};
+static void phl_hci_trx_ops_init_sim(void)
+{
+	ops_sim.hci_trx_init = phl_trx_init_sim;
+	ops_sim.hci_trx_deinit = phl_trx_deinit_sim;
+	ops_sim.prepare_tx = phl_prepare_tx_sim;
+	ops_sim.recycle_rx_buf = phl_release_target_rx_buf_sim;
+	ops_sim.tx = phl_tx_sim;
+	ops_sim.rx = phl_rx_sim;
+	ops_sim.trx_cfg = phl_trx_config_sim;
+	ops_sim.trx_stop = phl_trx_stop_sim;
+	ops_sim.pltfm_tx = phl_pltfm_tx_sim;
+	ops_sim.alloc_h2c_pkt_buf = phl_alloc_h2c_pkt_buf_sim;
+	ops_sim.free_h2c_pkt_buf = phl_free_h2c_pkt_buf_sim;
+	ops_sim.trx_reset = phl_trx_reset_sim;
+	ops_sim.trx_resume = phl_trx_resume_sim;
+	ops_sim.req_tx_stop = phl_req_tx_stop_sim;
+	ops_sim.req_rx_stop = phl_req_rx_stop_sim;
+	ops_sim.is_tx_pause = phl_is_tx_sw_pause_sim;
+	ops_sim.is_rx_pause = phl_is_rx_sw_pause_sim;
+	ops_sim.get_txbd_buf = phl_get_txbd_buf_sim;
+	ops_sim.get_rxbd_buf = phl_get_rxbd_buf_sim;
+	ops_sim.recycle_rx_pkt = phl_recycle_rx_pkt_sim;
+	ops_sim.register_trx_hdlr = phl_register_trx_hdlr_sim;
+	ops_sim.rx_handle_normal = phl_rx_handle_normal_sim;
+	ops_sim.tx_watchdog = phl_tx_watchdog_sim;
+#ifdef CONFIG_PCI_HCI
+	ops_sim.recycle_busy_wd = phl_recycle_busy_wd_sim;
+	ops_sim.recycle_busy_h2c = phl_recycle_busy_h2c_sim;
+	ops_sim.read_hw_rx = phl_read_hw_rx_sim;
+#endif
+}
+
+enum rtw_phl_status phl_hook_trx_ops_sim(struct phl_info_t *phl_info)
+{
+	enum rtw_phl_status pstatus = RTW_PHL_STATUS_FAILURE;
+
+	if (NULL != phl_info) {
+		phl_hci_trx_ops_init_sim();
+		phl_info->hci_trx_ops = &ops_sim;
+		pstatus = RTW_PHL_STATUS_SUCCESS;
+	}
+
+	return pstatus;
+}
+#endif /* CONFIG_PHL_HCI_SIM */
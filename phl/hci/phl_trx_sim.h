@@ -0,0 +1,127 @@
+/******************************************************************************
+ *
+ * Copyright(c) 2019 Realtek Corporation.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of version 2 of the GNU General Public License as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ *****************************************************************************/
+#ifndef _PHL_TRX_SIM_H_
+#define _PHL_TRX_SIM_H_
+
+#ifdef CONFIG_PHL_HCI_SIM
+/*
+ * Software HCI loopback backend.
+ * TX requests are placed into an in-memory TX BD ring, "DMA"ed by
+ * phl_tx_sim, looped back into an in-memory RX BD ring and delivered by
+ * phl_rx_sim through the normal phl rx path. A wp report is generated for
+ * every TX BD so the tx_recycle path is exercised as with real hardware.
+ */
+#define SIM_TXBD_NUM 512
+#define SIM_RXBD_NUM 512
+#define SIM_RX_BUF_NUM SIM_RXBD_NUM
+#define SIM_RX_BUF_SIZE 2400
+#define SIM_WP_RPT_NUM SIM_TXBD_NUM
+#define SIM_WP_MAX_SEQ_NUMBER 0xFFF
+
+/* default loopback medium */
+#define SIM_DEF_LATENCY_US 0
+#define SIM_DEF_LOSS_PERMIL 0
+#define SIM_DEF_REORDER_PERMIL 0
+
+struct phl_sim_cfg {
+	u32 latency_us;		/* TX to RX delivery delay */
+	u16 loss_permil;	/* frames lost on the medium, per 1000 */
+	u16 reorder_permil;	/* frames swapped with the previous one, per 1000 */
+	u32 seed;
+};
+
+struct phl_sim_stats {
+	u32 tx_req_cnt;
+	u32 tx_dma_cnt;
+	u32 tx_loss_cnt;
+	u32 tx_reorder_cnt;
+	u32 tx_full_cnt;
+	u32 rx_cnt;
+	u32 rx_drop_cnt;
+	u32 wp_rpt_cnt;
+	u32 recycle_fail_cnt;
+	u32 h2c_cnt;
+	/* accumulated cpu time, used to derive per-packet cost */
+	u64 tx_time_us;
+	u64 rx_time_us;
+};
+
+struct phl_sim_rx_buf {
+	_os_list list;
+	u8 *vir_addr;
+	u32 buf_len;
+	u16 data_len;
+};
+
+struct phl_sim_txbd {
+	struct rtw_xmit_req *treq;
+	u16 wp_seq;
+	u8 dma_ch;
+};
+
+struct phl_sim_rxbd {
+	struct phl_sim_rx_buf *rxbuf;
+	struct rtw_r_meta_data mdata;
+	u32 due_t;
+};
+
+struct phl_sim_wp_rpt {
+	u16 wp_seq;
+	u8 dma_ch;
+	u8 txsts;
+};
+
+struct phl_sim_info {
+	struct phl_sim_cfg cfg;
+	struct phl_sim_stats stats;
+	u32 rand;
+
+	/* TX BD ring, host_idx written by prepare_tx, hw_idx by the sim DMA */
+	struct phl_sim_txbd txbd[SIM_TXBD_NUM];
+	u16 txbd_host_idx;
+	u16 txbd_hw_idx;
+	_os_lock txbd_lock;
+
+	/* RX BD ring, host_idx written by the sim DMA, hw_idx by phl_rx_sim */
+	struct phl_sim_rxbd rxbd[SIM_RXBD_NUM];
+	u16 rxbd_host_idx;
+	u16 rxbd_hw_idx;
+	_os_lock rxbd_lock;
+
+	/* pending wp report, consumed by phl_rx_sim */
+	struct phl_sim_wp_rpt wp_rpt[SIM_WP_RPT_NUM];
+	u16 wp_rpt_wptr;
+	u16 wp_rpt_rptr;
+
+	struct rtw_xmit_req *wp_tag[SIM_WP_MAX_SEQ_NUMBER];
+	u16 wp_seq;
+	_os_lock wp_tag_lock;
+
+	struct phl_sim_rx_buf rx_buf[SIM_RX_BUF_NUM];
+	_os_list idle_rxbuf_list;
+	u16 idle_rxbuf_cnt;
+	_os_lock idle_rxbuf_lock;
+
+	_os_timer rx_timer;
+};
+
+enum rtw_phl_status phl_hook_trx_ops_sim(struct phl_info_t *phl_info);
+void phl_trx_sim_set_cfg(struct phl_info_t *phl_info, struct phl_sim_cfg *cfg);
+void phl_trx_sim_get_stats(struct phl_info_t *phl_info,
+			   struct phl_sim_stats *stats);
+void phl_trx_sim_reset_stats(struct phl_info_t *phl_info);
+#endif /* CONFIG_PHL_HCI_SIM */
+
+#endif	/* _PHL_TRX_SIM_H_ */
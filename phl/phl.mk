@@ -91,6 +91,9 @@ endif
 ifeq ($(CONFIG_SDIO_HCI), y)
 _PHL_FILES += $(phl_path)hci/phl_trx_sdio.o
 endif
+ifeq ($(CONFIG_HCI_SIM), y)
+_PHL_FILES += $(phl_path)hci/phl_trx_sim.o
+endif
 
 ifeq ($(CONFIG_PHL_CUSTOM_FEATURE), y)
 _PHL_FILES += $(phl_path)custom/phl_custom.o
@@ -103,6 +106,7 @@ ifeq ($(CONFIG_PHL_TEST_SUITE), y)
 _PHL_FILES += $(phl_path)test/trx_test.o
 _PHL_FILES += $(phl_path)test/test_module.o
 _PHL_FILES += $(phl_path)test/cmd_disp_test.o
+_PHL_FILES += $(phl_path)test/phl_bench.o
 _PHL_FILES += $(phl_path)test/mp/phl_test_mp.o
 _PHL_FILES += $(phl_path)test/mp/phl_test_mp_config.o
 _PHL_FILES += $(phl_path)test/mp/phl_test_mp_tx.o
@@ -82,9 +82,34 @@ enum rtw_phl_status rtw_phl_tx_req_notify(void *phl);
 enum rtw_phl_status rtw_phl_add_tx_req(void *phl, struct rtw_xmit_req *tx_req);
 void rtw_phl_tx_stop(void *phl);
 void rtw_phl_tx_resume(void *phl);
+void rtw_phl_get_wd_tmpl_stats(void *phl, struct rtw_wd_tmpl_stats *stats);
+#ifdef CONFIG_PHL_TX_ATF
+void rtw_phl_tx_atf_cfg(void *phl, bool en, u32 quantum);
+void rtw_phl_tx_atf_get_cfg(void *phl, struct phl_tx_atf *cfg);
+u16 rtw_phl_tx_atf_get_sta_stats(void *phl, struct rtw_atf_sta_stats *stats,
+				 u16 num);
+#endif
+enum rtw_phl_status rtw_phl_upd_shcut_mhdr(void *phl, u16 macid,
+					   u8 *hdr, u8 hdr_len);
 u16 rtw_phl_tring_rsc(void *phl, u16 macid, u8 tid);
 u16 rtw_phl_query_new_rx_num(void *phl);
 struct rtw_recv_pkt *rtw_phl_query_rx_pkt(void *phl);
+#ifdef CONFIG_PHL_RX_CLS
+enum rtw_phl_status
+rtw_phl_rx_cls_set_policy(void *phl, enum rtw_rx_cls_policy policy);
+enum rtw_rx_cls_policy rtw_phl_rx_cls_get_policy(void *phl);
+enum rtw_phl_status
+rtw_phl_rx_cls_add_rule(void *phl, struct rtw_rx_cls_rule *rule, u8 *idx);
+enum rtw_phl_status rtw_phl_rx_cls_del_rule(void *phl, u8 idx);
+bool rtw_phl_rx_cls_get_rule(void *phl, u8 idx, struct rtw_rx_cls_rule *rule);
+#endif
+#ifdef CONFIG_PHL_H2C_COAL
+void rtw_phl_h2c_coal_begin(void *phl, u32 token);
+void rtw_phl_h2c_coal_end(void *phl, u32 token);
+void rtw_phl_h2c_coal_get_cfg(void *phl, struct rtw_h2c_coal_cfg *cfg);
+enum rtw_phl_status
+rtw_phl_h2c_coal_get_stat(void *phl, struct rtw_h2c_coal_stat *stat, u8 rst);
+#endif
 
 void rtw_phl_rx_deferred_In_token(void *phl);
 void rtw_phl_post_in_complete(void *phl, void *rxobj, u32 inbuf_len, u8 status_code);
@@ -80,6 +80,10 @@ enum rtw_phl_status phl_disp_eng_send_msg(struct phl_info_t *phl, struct phl_msg
 						struct phl_msg_attribute *attr, u32 *msg_hdl);
 enum rtw_phl_status phl_disp_eng_cancel_msg(struct phl_info_t *phl, u8 band_idx, u32 *msg_hdl);
 enum rtw_phl_status phl_disp_eng_clr_pending_msg(struct phl_info_t *phl, u8 band_idx);
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+enum rtw_phl_status phl_disp_eng_get_stat(struct phl_info_t *phl, u8 band_idx,
+					  struct rtw_dispr_stat *stat, u8 rst);
+#endif
 
 enum rtw_phl_status phl_disp_eng_add_token_req(struct phl_info_t *phl, u8 band_idx,
 					    struct phl_cmd_token_req *req, u32 *req_hdl);
@@ -131,6 +135,9 @@ enum rtw_phl_status dispr_send_msg(void *dispr, struct phl_msg *msg,
 				       struct phl_msg_attribute *attr, u32 *msg_hdl);
 enum rtw_phl_status dispr_cancel_msg(void *dispr, u32 *msg_hdl);
 enum rtw_phl_status dispr_clr_pending_msg(void *dispr);
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+void dispr_get_stat(void *dispr, struct rtw_dispr_stat *stat, u8 rst);
+#endif
 
 enum rtw_phl_status dispr_add_token_req(void *dispr,
 					    struct phl_cmd_token_req *req, u32 *req_hdl);
@@ -509,6 +509,23 @@ phl_disp_eng_clr_pending_msg(struct phl_info_t *phl, u8 band_idx)
 	return dispr_clr_pending_msg(dispr);
 }
 
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+enum rtw_phl_status
+phl_disp_eng_get_stat(struct phl_info_t *phl, u8 band_idx,
+		      struct rtw_dispr_stat *stat, u8 rst)
+{
+	enum rtw_phl_status status = RTW_PHL_STATUS_FAILURE;
+	void* dispr = NULL;
+
+	status = _disp_eng_get_dispr_by_idx(phl, band_idx, &dispr);
+	if (RTW_PHL_STATUS_SUCCESS != status)
+		return status;
+
+	dispr_get_stat(dispr, stat, rst);
+	return RTW_PHL_STATUS_SUCCESS;
+}
+#endif
+
 enum rtw_phl_status
 phl_disp_eng_add_token_req(struct phl_info_t *phl,
                            u8 band_idx,
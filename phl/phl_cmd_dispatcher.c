@@ -24,6 +24,10 @@
 
 #define MAX_CMD_REQ_NUM (8)
 #define MODL_MASK_LEN DIV_ROUND_UP(PHL_MDL_ID_MAX, 8)
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+/* msgs dispatched per wakeup before giving the thread back */
+#define DISPR_BATCH_MAX (8)
+#endif
 
 #define GEN_VALID_HDL(_idx) ((u32)(BIT31 | (u32)(_idx)))
 #define IS_HDL_VALID(_hdl) ((_hdl) & BIT31)
@@ -60,6 +64,7 @@ enum phl_msg_status {
 	MSG_STATUS_PENDING = BIT9,
 	MSG_STATUS_FOR_ABORT = BIT10,
 	MSG_STATUS_PENDING_DURING_CANNOT_IO = BIT11,
+	MSG_STATUS_FAST_LANE = BIT12,
 };
 
 enum cmd_req_status {
@@ -137,6 +142,9 @@ struct phl_dispr_msg_ex {
 #ifdef CONFIG_CMD_DISP_SUPPORT_CUSTOM_SEQ
 	struct dispr_msg_attr *attr;
 #endif
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+	u32 enq_t; /* us, 0 if never put into wait queue */
+#endif
 };
 
 /**
@@ -214,6 +222,20 @@ struct cmd_dispatcher {
 	struct phl_bk_module controller;
 	struct phl_token_op_info renew_req_info;
 	u8 exclusive_mdl;
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+	/* modules set in bitmap, grouped by priority in module_q order,
+	 * sub[sub_ofst[pri]] ~ sub[sub_ofst[pri + 1] - 1]
+	 */
+	_os_lock sub_lock;
+	u32 sub_gen;
+	struct phl_bk_module *sub[PHL_BK_MDL_END];
+	u8 sub_ofst[PHL_MDL_PRI_MAX + 1];
+	/* copy of sub owned by the dispatch thread, synced on sub_gen change */
+	u32 run_gen;
+	struct phl_bk_module *run[PHL_BK_MDL_END];
+	u8 run_ofst[PHL_MDL_PRI_MAX + 1];
+	struct rtw_dispr_stat stat;
+#endif
 };
 
 enum rtw_phl_status dispr_process_token_req(struct cmd_dispatcher *obj);
@@ -282,6 +304,88 @@ static void on_abort_msg_complete(struct cmd_dispatcher *obj, struct phl_dispr_m
 	dispr_enqueue_token_op_info(obj, &obj->renew_req_info, TOKEN_OP_RENEW_CMD_REQ, 0xff);
 }
 
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+static const u32 dispr_lat_bkt_us[RTW_DISPR_LAT_BKT_NUM - 1] = {
+	100, 500, 1000, 5000, 10000, 50000, 100000
+};
+
+static u8 _dispr_lat_cls(u8 mdl_id)
+{
+	if (IS_DISPR_CTRL(mdl_id))
+		return RTW_DISPR_LAT_CTRL;
+
+	switch (_get_mdl_priority(mdl_id)) {
+	case PHL_MDL_PRI_ROLE:
+		return RTW_DISPR_LAT_ROLE;
+	case PHL_MDL_PRI_MANDATORY:
+		return RTW_DISPR_LAT_MDRY;
+	case PHL_MDL_PRI_OPTIONAL:
+		return RTW_DISPR_LAT_OPT;
+	default:
+		return RTW_DISPR_LAT_FG;
+	}
+}
+
+static void _dispr_lat_record(struct cmd_dispatcher *obj,
+			      struct phl_dispr_msg_ex *ex)
+{
+	struct rtw_dispr_stat *stat = &obj->stat;
+	u32 us = phl_get_passing_time_us(ex->enq_t);
+	u8 cls = _dispr_lat_cls(MSG_MDL_ID_FIELD(ex->msg.msg_id));
+	u8 i = 0;
+
+	for (i = 0; i < RTW_DISPR_LAT_BKT_NUM - 1; i++) {
+		if (us < dispr_lat_bkt_us[i])
+			break;
+	}
+	stat->lat_hist[cls][i]++;
+	stat->lat_cnt[cls]++;
+	if (us > stat->lat_us_max[cls])
+		stat->lat_us_max[cls] = us;
+	ex->enq_t = 0;
+}
+
+/* called whenever module_q or bitmap changes */
+static void _dispr_sub_rebuild(struct cmd_dispatcher *obj)
+{
+	void *d = phl_to_drvpriv(obj->phl_info);
+	struct phl_bk_module *mdl = NULL;
+	_os_list *node = NULL;
+	u8 i = 0, n = 0;
+
+	_os_spinlock(d, &obj->sub_lock, _bh, NULL);
+	for (i = 0; i < PHL_MDL_PRI_MAX; i++) {
+		obj->sub_ofst[i] = n;
+		if (pq_get_front(d, &(obj->module_q[i]), &node, _bh) == false)
+			continue;
+		do {
+			mdl = (struct phl_bk_module *)node;
+			if (n < PHL_BK_MDL_END && _chk_bitmap_bit(obj->bitmap, mdl->id))
+				obj->sub[n++] = mdl;
+		} while (pq_get_next(d, &(obj->module_q[i]), node, &node, _bh));
+	}
+	obj->sub_ofst[PHL_MDL_PRI_MAX] = n;
+	obj->sub_gen++;
+	obj->stat.sub_rebuild++;
+	_os_spinunlock(d, &obj->sub_lock, _bh, NULL);
+}
+
+static void _dispr_sub_sync(struct cmd_dispatcher *obj)
+{
+	void *d = phl_to_drvpriv(obj->phl_info);
+
+	if (obj->run_gen == obj->sub_gen)
+		return;
+
+	_os_spinlock(d, &obj->sub_lock, _bh, NULL);
+	_os_mem_cpy(d, obj->run_ofst, obj->sub_ofst, sizeof(obj->run_ofst));
+	_os_mem_cpy(d, obj->run, obj->sub,
+		    obj->sub_ofst[PHL_MDL_PRI_MAX] * sizeof(obj->sub[0]));
+	obj->run_gen = obj->sub_gen;
+	_os_spinunlock(d, &obj->sub_lock, _bh, NULL);
+}
+#endif /* CONFIG_PHL_CMD_DISP_BATCH */
+
 static u8 pop_front_idle_msg(struct cmd_dispatcher *obj,
 			     struct phl_dispr_msg_ex **msg)
 {
@@ -300,6 +404,9 @@ static u8 pop_front_idle_msg(struct cmd_dispatcher *obj,
 		_os_mem_set(d, &((*msg)->msg), 0, sizeof(struct phl_msg));
 #ifdef CONFIG_CMD_DISP_SUPPORT_CUSTOM_SEQ
 		(*msg)->attr = NULL;
+#endif
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+		(*msg)->enq_t = 0;
 #endif
 		PHL_TRACE(COMP_PHL_CMDDISP, _PHL_INFO_, "%s: remain cnt(%d)\n", __FUNCTION__, obj->msg_idle_q.cnt);
 		return true;
@@ -313,6 +420,10 @@ static void push_back_idle_msg(struct cmd_dispatcher *obj,
 {
 	void *d = phl_to_drvpriv(obj->phl_info);
 
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+	if (ex->enq_t)
+		_dispr_lat_record(obj, ex);
+#endif
 	if (TEST_STATUS_FLAG(ex->status, MSG_STATUS_NOTIFY_COMPLETE) &&
 	    ex->completion.completion) {
 		if (TEST_STATUS_FLAG(ex->status, MSG_STATUS_CANCEL))
@@ -362,15 +473,31 @@ static void push_back_wait_msg(struct cmd_dispatcher *obj,
 	notify_bk_thread(obj);
 }
 
+#ifdef CONFIG_PHL_CMD_DISP_FAST_LANE
+/* controller msgs first, then fast lane msgs, then the rest, each in FIFO */
+static u8 _get_msg_lane(struct phl_dispr_msg_ex *ex)
+{
+	if (IS_DISPR_CTRL(MSG_MDL_ID_FIELD(ex->msg.msg_id)))
+		return 2;
+	if (TEST_STATUS_FLAG(ex->status, MSG_STATUS_FAST_LANE))
+		return 1;
+	return 0;
+}
+#endif
+
  u8 is_higher_priority(void *d, void *priv,_os_list *input, _os_list *obj)
  {
 	struct phl_dispr_msg_ex *ex_input = (struct phl_dispr_msg_ex *)input;
 	struct phl_dispr_msg_ex *ex_obj = (struct phl_dispr_msg_ex *)obj;
 
+#ifdef CONFIG_PHL_CMD_DISP_FAST_LANE
+	return (_get_msg_lane(ex_input) > _get_msg_lane(ex_obj)) ? true : false;
+#else
 	if (IS_DISPR_CTRL(MSG_MDL_ID_FIELD(ex_input->msg.msg_id)) &&
 	    !IS_DISPR_CTRL(MSG_MDL_ID_FIELD(ex_obj->msg.msg_id)))
 		return true;
 	return false;
+#endif
  }
 
 static void insert_msg_by_priority(struct cmd_dispatcher *obj,
@@ -1063,6 +1190,9 @@ void msg_pre_phase_hdl(struct cmd_dispatcher *obj, struct phl_dispr_msg_ex *ex)
 	enum phl_mdl_ret_code ret = MDL_RET_FAIL;
 	u8 owner_id = (ex->module)?(ex->module->id):(PHL_MDL_ID_MAX);
 	enum phl_bk_module_priority priority = PHL_MDL_PRI_MAX;
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+	u8 j = 0;
+#endif
 
 	if (owner_id <= PHL_BK_MDL_END)
 		priority = _get_mdl_priority(owner_id);
@@ -1078,6 +1208,17 @@ void msg_pre_phase_hdl(struct cmd_dispatcher *obj, struct phl_dispr_msg_ex *ex)
 			if (STOP_DISPATCH_MSG(ret))
 				return;
 		}
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+		for (j = obj->run_ofst[i]; j < obj->run_ofst[i + 1]; j++) {
+			mdl = obj->run[j];
+			if (!_chk_bitmap_bit(ex->premap, mdl->id) ||
+			    !TEST_STATUS_FLAG(mdl->status, MDL_STARTED))
+				continue;
+			ret = feed_mdl_msg(obj, mdl, ex);
+			if (STOP_DISPATCH_MSG(ret))
+				return;
+		}
+#else
 		q = &(obj->module_q[(u8)i]);
 
 		if (pq_get_front(d, q, &node, _bh) == false)
@@ -1092,6 +1233,7 @@ void msg_pre_phase_hdl(struct cmd_dispatcher *obj, struct phl_dispr_msg_ex *ex)
 			if (STOP_DISPATCH_MSG(ret))
 				return;
 		} while(pq_get_next(d, q, node, &node, _bh));
+#endif
 	}
 }
 
@@ -1105,6 +1247,9 @@ void msg_post_phase_hdl(struct cmd_dispatcher *obj, struct phl_dispr_msg_ex *ex)
 	enum phl_mdl_ret_code ret = MDL_RET_FAIL;
 	u8 owner_id = (ex->module)?(ex->module->id):(PHL_MDL_ID_MAX);
 	enum phl_bk_module_priority priority = PHL_MDL_PRI_MAX;
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+	u8 j = 0;
+#endif
 
 	if (owner_id <= PHL_BK_MDL_END)
 		priority = _get_mdl_priority(owner_id);
@@ -1120,6 +1265,17 @@ void msg_post_phase_hdl(struct cmd_dispatcher *obj, struct phl_dispr_msg_ex *ex)
 			if (STOP_DISPATCH_MSG(ret))
 				return;
 		}
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+		for (j = obj->run_ofst[i + 1]; j > obj->run_ofst[i]; j--) {
+			mdl = obj->run[j - 1];
+			if (!_chk_bitmap_bit(ex->postmap, mdl->id)||
+			    !TEST_STATUS_FLAG(mdl->status, MDL_STARTED))
+				continue;
+			ret = feed_mdl_msg(obj, mdl, ex);
+			if (STOP_DISPATCH_MSG(ret))
+				return;
+		}
+#else
 		q = &(obj->module_q[(u8)i]);
 		if (pq_get_tail(d, q, &node, _bh) == false)
 			continue;
@@ -1132,6 +1288,7 @@ void msg_post_phase_hdl(struct cmd_dispatcher *obj, struct phl_dispr_msg_ex *ex)
 			if (STOP_DISPATCH_MSG(ret))
 				return;
 		} while(pq_get_prev(d, q, node, &node, _bh));
+#endif
 	}
 }
 
@@ -1175,6 +1332,9 @@ void msg_dispatch(struct cmd_dispatcher *obj, struct phl_dispr_msg_ex *ex)
 
 	MSG_REDIRECT_CHK(ex);
 
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+	_dispr_sub_sync(obj);
+#endif
 	if ((MSG_INDC_FIELD(ex->msg.msg_id) & MSG_INDC_PRE_PHASE) &&
 	    _is_bitmap_empty(d, bitmap) == false)
 		msg_pre_phase_hdl(obj, ex);
@@ -1221,6 +1381,40 @@ recycle:
 	push_back_idle_msg(obj, ex);
 }
 
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+void dispr_thread_loop_hdl(struct cmd_dispatcher *obj)
+{
+	struct phl_dispr_msg_ex *ex = NULL;
+	u32 cnt = 0;
+
+	/* each wakeup drains up to DISPR_BATCH_MAX msgs, the surplus semaphore
+	 * counts of the drained msgs only cause wakeups finding an empty queue.
+	 * pending msg and token op are still handled ahead of every msg.
+	 */
+	do {
+		clear_pending_msg(obj);
+		token_op_hanler(obj);
+
+		if (!pop_front_wait_msg(obj, &ex))
+			break;
+		cnt++;
+		if (is_msg_canceled(obj, ex)) {
+			push_back_idle_msg(obj, ex);
+			continue;
+		}
+		_and_bitmaps(obj->bitmap, ex->premap, MODL_MASK_LEN);
+		_and_bitmaps(obj->bitmap, ex->postmap, MODL_MASK_LEN);
+		msg_dispatch(obj, ex);
+	} while (cnt < DISPR_BATCH_MAX);
+
+	if (cnt == 0)
+		return;
+	obj->stat.batch++;
+	obj->stat.msg += cnt;
+	if (cnt > obj->stat.batch_max)
+		obj->stat.batch_max = cnt;
+}
+#else
 void dispr_thread_loop_hdl(struct cmd_dispatcher *obj)
 {
 	struct phl_dispr_msg_ex *ex = NULL;
@@ -1248,6 +1442,7 @@ void dispr_thread_loop_hdl(struct cmd_dispatcher *obj)
 		msg_dispatch(obj, ex);
 	}
 }
+#endif /* CONFIG_PHL_CMD_DISP_BATCH */
 
 void dispr_thread_leave_hdl(struct cmd_dispatcher *obj)
 {
@@ -1451,6 +1646,14 @@ enum rtw_phl_status dispr_init(struct phl_info_t *phl_info, void **dispr, u8 idx
 
 	(*dispr) = (void*)obj;
 	_os_spinlock_init(d, &(obj->token_op_q_lock));
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+	_os_spinlock_init(d, &(obj->sub_lock));
+	_os_mem_set(d, obj->sub_ofst, 0, sizeof(obj->sub_ofst));
+	_os_mem_set(d, obj->run_ofst, 0, sizeof(obj->run_ofst));
+	_os_mem_set(d, &(obj->stat), 0, sizeof(obj->stat));
+	obj->sub_gen = 0;
+	obj->run_gen = 0;
+#endif
 	SET_STATUS_FLAG(obj->status, DISPR_INIT);
 	SET_STATUS_FLAG(obj->status, DISPR_NOTIFY_IDLE);
 	_register_dispr_controller(obj);
@@ -1474,6 +1677,9 @@ enum rtw_phl_status dispr_deinit(struct phl_info_t *phl, void *dispr)
 	for (i = 0 ; i < PHL_MDL_PRI_MAX; i++)
 		pq_deinit(d, &(obj->module_q[i]));
 	_os_spinlock_free(d, &(obj->token_op_q_lock));
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+	_os_spinlock_free(d, &(obj->sub_lock));
+#endif
 	_os_mem_free(d, obj, sizeof(struct cmd_dispatcher));
 	PHL_TRACE(COMP_PHL_CMDDISP, _PHL_INFO_, "%s\n", __FUNCTION__);
 	return RTW_PHL_STATUS_SUCCESS;
@@ -1497,6 +1703,11 @@ enum rtw_phl_status dispr_start(void *dispr)
 	if (disp_eng_is_solo_thread_mode(obj->phl_info)) {
 		_os_thread_init(d, &(obj->bk_thread), background_thread_hdl, obj,
 				"dispr_solo_thread");
+#ifdef CONFIG_CMD_DISP_SOLO_MODE
+		if (obj->idx < HW_BAND_MAX)
+			_os_thread_config_cpu(d, &(obj->bk_thread),
+				obj->phl_info->phl_com->dev_sw_cap.dispr_cpu[obj->idx]);
+#endif
 		_os_thread_schedule(d, &(obj->bk_thread));
 	}
 	SET_STATUS_FLAG(obj->status, DISPR_STARTED);
@@ -1570,6 +1781,10 @@ enum rtw_phl_status dispr_register_module(void *dispr,
 			_add_bitmap_bit(obj->bitmap, &(module->id), 1);
 		if (ret == true && priority != PHL_MDL_PRI_OPTIONAL)
 			_add_bitmap_bit(obj->basemap, &(module->id), 1);
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+		if (ret == true)
+			_dispr_sub_rebuild(obj);
+#endif
 	}
 	PHL_TRACE(COMP_PHL_CMDDISP, _PHL_INFO_, "%s id:%d, ret:%d\n",__FUNCTION__, id, ret);
 	if (ret == true) {
@@ -1601,6 +1816,9 @@ enum rtw_phl_status dispr_deregister_module(void *dispr,
 		module = (struct phl_bk_module *)mdl;
 		_clr_bitmap_bit(obj->bitmap, &(module->id), 1);
 		_clr_bitmap_bit(obj->basemap, &(module->id), 1);
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+		_dispr_sub_rebuild(obj);
+#endif
 		bk_module_stop(obj, module);
 		bk_module_deinit(obj, module);
 		_os_mem_free(d, module, sizeof(struct phl_bk_module));
@@ -1648,6 +1866,9 @@ enum rtw_phl_status dispr_module_deinit(void *dispr)
 			_os_mem_free(d, mdl, sizeof(struct phl_bk_module));
 		}
 	}
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+	_dispr_sub_rebuild(obj);
+#endif
 	PHL_TRACE(COMP_PHL_CMDDISP, _PHL_INFO_, "%s\n", __FUNCTION__);
 	return RTW_PHL_STATUS_SUCCESS;
 }
@@ -1676,6 +1897,9 @@ enum rtw_phl_status dispr_module_start(void *dispr)
 				_add_bitmap_bit(obj->basemap, &(module->id), 1);
 		} while(pq_get_next(d, &(obj->module_q[i]), mdl, &mdl, _bh));
 	}
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+	_dispr_sub_rebuild(obj);
+#endif
 	PHL_TRACE(COMP_PHL_CMDDISP, _PHL_INFO_, "%s\n", __FUNCTION__);
 	/*_print_bitmap(obj->bitmap);*/
 	return RTW_PHL_STATUS_SUCCESS;
@@ -1702,6 +1926,9 @@ enum rtw_phl_status dispr_module_stop(void *dispr)
 			bk_module_stop(obj, module);
 		} while(pq_get_next(d, &(obj->module_q[i]), mdl, &mdl, _bh));
 	}
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+	_dispr_sub_rebuild(obj);
+#endif
 	PHL_TRACE(COMP_PHL_CMDDISP, _PHL_INFO_, "%s\n", __FUNCTION__);
 	/*_print_bitmap(obj->bitmap);*/
 	return RTW_PHL_STATUS_SUCCESS;
@@ -2016,11 +2243,26 @@ dispr_send_msg(void *dispr,
 	}
 
 	SET_STATUS_FLAG(msg_ex->status, MSG_STATUS_PRE_PHASE);
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+	msg_ex->enq_t = _os_get_cur_time_us();
+#endif
 
+#ifdef CONFIG_PHL_CMD_DISP_FAST_LANE
+	/* a cmd req owner keeps its order against the req token ops */
+	if (attr && TEST_STATUS_FLAG(attr->opt, MSG_OPT_FAST_LANE) &&
+	    !TEST_STATUS_FLAG(msg_ex->status, MSG_STATUS_OWNER_REQ))
+		SET_STATUS_FLAG(msg_ex->status, MSG_STATUS_FAST_LANE);
+	if (IS_DISPR_CTRL(module_id) ||
+	    TEST_STATUS_FLAG(msg_ex->status, MSG_STATUS_FAST_LANE))
+		insert_msg_by_priority(obj, msg_ex);
+	else
+		push_back_wait_msg(obj, msg_ex);
+#else
 	if (IS_DISPR_CTRL(module_id))
 		insert_msg_by_priority(obj, msg_ex);
 	else
 		push_back_wait_msg(obj, msg_ex);
+#endif
 
 	PHL_TRACE(COMP_PHL_CMDDISP, _PHL_INFO_, "%s, status:0x%x\n",__FUNCTION__, msg_ex->status);
 	if(msg_hdl)
@@ -2072,6 +2314,19 @@ enum rtw_phl_status dispr_clr_pending_msg(void *dispr)
 	PHL_TRACE(COMP_PHL_CMDDISP, _PHL_INFO_, "%s\n", __FUNCTION__);
 	return RTW_PHL_STATUS_SUCCESS;
 }
+
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+void dispr_get_stat(void *dispr, struct rtw_dispr_stat *stat, u8 rst)
+{
+	struct cmd_dispatcher *obj = (struct cmd_dispatcher *)dispr;
+	void *d = phl_to_drvpriv(obj->phl_info);
+
+	_os_mem_cpy(d, stat, &(obj->stat), sizeof(*stat));
+	if (rst)
+		_os_mem_set(d, &(obj->stat), 0, sizeof(obj->stat));
+}
+#endif
+
 enum rtw_phl_status
 dispr_add_token_req(void *dispr,
 			struct phl_cmd_token_req *req,
@@ -83,6 +83,24 @@ struct _ps_mr_info {
 
 #define CMD_PS_TIMER_PERIOD 100
 #define MAX_PWE_REQ_NUM 16
+
+#ifdef CONFIG_PHL_PS_PREDICT
+/* assumed lps enter plus leave cost until one has been measured */
+#define PS_PRED_COST_DFLT_US 2000
+/* periodic traffic must be this many wake costs apart to be worth lps */
+#define PS_PRED_COST_MUL 32
+/* gap samples needed before a flow may be judged periodic */
+#define PS_PRED_PERIODIC_CNT 16
+/* a burst is over once the link stayed idle for this many mean gaps */
+#define PS_PRED_IDLE_GAP_MUL 2
+
+struct _ps_pred {
+	u32 enter_t; /* ms, last lps entry */
+	u32 enter_cost_us; /* duration of the last lps entry */
+	u32 cost_x8_us; /* ewma of lps enter plus leave duration, scaled by 8 */
+	struct rtw_ps_pred_stat stat;
+};
+#endif
 struct cmd_ps {
 	struct phl_info_t *phl_info;
 	void *dispr;
@@ -117,6 +135,10 @@ struct cmd_ps {
 
 	/* rssi */
 	u8 rssi_bcn_min;
+
+#ifdef CONFIG_PHL_PS_PREDICT
+	struct _ps_pred pred;
+#endif
 };
 
 /**
@@ -257,6 +279,104 @@ static void _set_ps_rson(struct cmd_ps *ps, u8 enter, char *rson)
 	}
 }
 
+#ifdef CONFIG_PHL_PS_PREDICT
+static void _ps_pred_init(struct cmd_ps *ps)
+{
+	ps->pred.stat.en = true;
+	ps->pred.cost_x8_us = PS_PRED_COST_DFLT_US << 3;
+	ps->pred.stat.wake_cost_us = PS_PRED_COST_DFLT_US;
+}
+
+static void _ps_pred_wake_lat(struct cmd_ps *ps)
+{
+	struct phl_ps_info *ps_info = &ps->phl_info->ps_info;
+	struct rtw_ps_pred_stat *stat = &ps->pred.stat;
+	u32 lat = 0;
+
+	if (ps_info->wake_req_t == 0)
+		return;
+
+	lat = phl_get_passing_time_us(ps_info->wake_req_t);
+	ps_info->wake_req_t = 0;
+
+	stat->lat_cnt++;
+	stat->lat_us_sum += lat;
+	if (lat > stat->lat_us_max)
+		stat->lat_us_max = lat;
+}
+
+static void _ps_pred_enter(struct cmd_ps *ps, u32 enter_us)
+{
+	struct _ps_pred *pred = &ps->pred;
+
+	pred->stat.enter++;
+	pred->enter_t = _os_get_cur_time_ms();
+	pred->enter_cost_us = enter_us;
+	/* a request raised while still awake was not delayed by lps */
+	ps->phl_info->ps_info.wake_req_t = 0;
+}
+
+static void _ps_pred_leave(struct cmd_ps *ps, u32 leave_us)
+{
+	struct _ps_pred *pred = &ps->pred;
+
+	pred->stat.wake++;
+	pred->stat.ps_ms += phl_get_passing_time_ms(pred->enter_t);
+	pred->cost_x8_us = pred->cost_x8_us - (pred->cost_x8_us >> 3) +
+			   pred->enter_cost_us + leave_us;
+	pred->stat.wake_cost_us = pred->cost_x8_us >> 3;
+
+	_ps_pred_wake_lat(ps);
+}
+
+/**
+ * predict whether the link idles long enough for lps to pay off
+ * return false to hold off lps entry
+ * @ps: see cmd_ps
+ * @sta: link about to enter lps
+ */
+static bool _ps_pred_chk_idle(struct cmd_ps *ps, struct rtw_phl_stainfo_t *sta)
+{
+	struct _ps_pred *pred = &ps->pred;
+	struct rtw_stats *stats = NULL;
+	u32 idle = 0, avg = 0, dev = 0, cost_ms = 0;
+
+	if (!pred->stat.en || sta == NULL)
+		return true;
+
+	stats = &sta->stats;
+	if (stats->last_pkt_time_ms == 0 || stats->pkt_gap_cnt == 0)
+		return true;
+
+	idle = phl_get_passing_time_ms(stats->last_pkt_time_ms);
+	if (idle > PHL_PKT_GAP_MAX_MS)
+		return true;
+
+	avg = stats->pkt_gap_avg_x8 >> 3;
+	dev = stats->pkt_gap_dev_x8 >> 3;
+	cost_ms = pred->stat.wake_cost_us * PS_PRED_COST_MUL / 1000;
+
+	/* voip, game ticks, video frames: stay awake until the flow stops */
+	if (stats->pkt_gap_cnt >= PS_PRED_PERIODIC_CNT &&
+	    (dev << 2) <= avg && avg < cost_ms) {
+		PHL_TRACE(COMP_PHL_PS, _PHL_DEBUG_, "[PS_CMD], %s(): periodic traffic, gap %d ms, dev %d ms, cost %d ms.\n",
+			  __func__, avg, dev, cost_ms);
+		pred->stat.sup_periodic++;
+		return false;
+	}
+
+	/* the next packet of the burst is still expected */
+	if (idle <= PS_PRED_IDLE_GAP_MUL * avg) {
+		PHL_TRACE(COMP_PHL_PS, _PHL_DEBUG_, "[PS_CMD], %s(): in burst, idle %d ms, gap %d ms.\n",
+			  __func__, idle, avg);
+		pred->stat.sup_burst++;
+		return false;
+	}
+
+	return true;
+}
+#endif /* CONFIG_PHL_PS_PREDICT */
+
 /**
  * Leave power saving
  * return RTW_PHL_STATUS_SUCCESS if leave ps ok
@@ -269,6 +389,10 @@ enum rtw_phl_status _leave_ps(struct cmd_ps *ps, bool leave_proto, char *rson)
 	struct phl_info_t *phl_info = ps->phl_info;
 	enum rtw_phl_status status = RTW_PHL_STATUS_FAILURE;
 	struct ps_cfg cfg = {0};
+#ifdef CONFIG_PHL_PS_PREDICT
+	bool pred_wake = false;
+	u32 pred_t = 0;
+#endif
 
 	if (ps->ps_state == PS_STATE_LEAVED) {
 		PHL_TRACE(COMP_PHL_PS, _PHL_INFO_, "[PS_CMD], %s(): not in power saving.\n", __func__);
@@ -313,9 +437,18 @@ enum rtw_phl_status _leave_ps(struct cmd_ps *ps, bool leave_proto, char *rson)
 
 	_set_ps_rson(ps, false, rson);
 
+#ifdef CONFIG_PHL_PS_PREDICT
+	pred_wake = (ps->ps_mode == PS_MODE_LPS &&
+		     ps->ps_state == PS_STATE_ENTERED);
+	pred_t = _os_get_cur_time_us();
+#endif
 	status = phl_ps_leave_ps(phl_info, &cfg);
 
 	if (status == RTW_PHL_STATUS_SUCCESS) {
+#ifdef CONFIG_PHL_PS_PREDICT
+		if (pred_wake)
+			_ps_pred_leave(ps, phl_get_passing_time_us(pred_t));
+#endif
 		ps->cur_pwr_lvl = cfg.pwr_lvl;
 		if (ps->ps_mode == PS_MODE_LPS) {
 			ps->ps_mode = (leave_proto != true) ? PS_MODE_LPS : PS_MODE_NONE;
@@ -350,6 +483,9 @@ enum rtw_phl_status _enter_ps(struct cmd_ps *ps, u8 ps_mode, u16 macid, char *rs
 	enum rtw_phl_status status = RTW_PHL_STATUS_FAILURE;
 	struct ps_cfg cfg = {0};
 	struct rtw_ps_cap_t *ps_cap = _get_ps_cap(ps->phl_info);
+#ifdef CONFIG_PHL_PS_PREDICT
+	u32 pred_t = 0;
+#endif
 
 	if (ps->ps_state == PS_STATE_ENTERED) {
 		PHL_TRACE(COMP_PHL_PS, _PHL_WARNING_, "[PS_CMD], %s(): already in power saving.\n", __func__);
@@ -386,9 +522,16 @@ enum rtw_phl_status _enter_ps(struct cmd_ps *ps, u8 ps_mode, u16 macid, char *rs
 
 	_set_ps_rson(ps, true, rson);
 
+#ifdef CONFIG_PHL_PS_PREDICT
+	pred_t = _os_get_cur_time_us();
+#endif
 	status = phl_ps_enter_ps(ps->phl_info, &cfg);
 
 	if (status == RTW_PHL_STATUS_SUCCESS) {
+#ifdef CONFIG_PHL_PS_PREDICT
+		if (cfg.ps_mode == PS_MODE_LPS)
+			_ps_pred_enter(ps, phl_get_passing_time_us(pred_t));
+#endif
 		ps->cur_pwr_lvl = cfg.pwr_lvl;
 		ps->ps_mode = cfg.ps_mode;
 		ps->macid = cfg.macid;
@@ -657,6 +800,10 @@ static enum phl_mdl_ret_code _ps_mdl_init(void *phl, void *dispr, void **priv)
 
 	_ps_common_info_init(phl_info);
 
+#ifdef CONFIG_PHL_PS_PREDICT
+	_ps_pred_init(ps);
+#endif
+
 	return MDL_RET_SUCCESS;
 }
 
@@ -1046,6 +1193,12 @@ static bool _chk_lps_enter(struct cmd_ps *ps, u16 *macid)
 		return false;
 	}
 
+#ifdef CONFIG_PHL_PS_PREDICT
+	/* traffic prediction */
+	if (!_ps_pred_chk_idle(ps, ps->sta))
+		return false;
+#endif
+
 	/* lps */
 	if (_lps_state_judge_changed(ps, *macid, ps->ps_state, PS_STATE_ENTERED)) {
 		PHL_TRACE(COMP_PHL_PS, _PHL_DEBUG_, "[PS_CMD], %s(): lps state changed, going to enter...\n", __func__);
@@ -1671,6 +1824,12 @@ static enum phl_mdl_ret_code _tx_pkt_ntfy_msg_hdlr(struct cmd_ps *ps, struct phl
 		PHL_DBG("[PS_CMD], %s(): rpwm with tx req.\n", __func__);
 		/* rpwm with tx req */
 		rtw_hal_ps_notify_wake(ps->phl_info->hal);
+#ifdef CONFIG_PHL_PS_PREDICT
+		if (ps->ps_state == PS_STATE_ENTERED) {
+			ps->pred.stat.tx_wake++;
+			_ps_pred_wake_lat(ps);
+		}
+#endif
 	}
 
 	return MDL_RET_SUCCESS;
@@ -1801,6 +1960,22 @@ _ps_mdl_set_info(void *dispr, void *priv, struct phl_module_op_info *info)
 		PHL_TRACE(COMP_PHL_PS, _PHL_INFO_, "[PS_CMD], %s(): btc req pwr %d\n", __func__, *(bool *)info->inbuf);
 		ps->btc_req_pwr = *(bool *)info->inbuf;
 		break;
+#ifdef CONFIG_PHL_PS_PREDICT
+	case PS_MDL_OP_PRED_EN:
+		ps->pred.stat.en = *(bool *)info->inbuf;
+		break;
+	case PS_MDL_OP_PRED_RST:
+		ps->pred.stat.enter = 0;
+		ps->pred.stat.wake = 0;
+		ps->pred.stat.tx_wake = 0;
+		ps->pred.stat.ps_ms = 0;
+		ps->pred.stat.sup_burst = 0;
+		ps->pred.stat.sup_periodic = 0;
+		ps->pred.stat.lat_cnt = 0;
+		ps->pred.stat.lat_us_sum = 0;
+		ps->pred.stat.lat_us_max = 0;
+		break;
+#endif
 	}
 
 	return MDL_RET_SUCCESS;
@@ -1837,6 +2012,12 @@ _ps_mdl_query_info(void *dispr, void *priv, struct phl_module_op_info *info)
 		_os_mem_set(phl_to_drvpriv(ps->phl_info), basic_info->leave_rson, 0, MAX_CMD_PS_RSON_LENGTH);
 		_os_mem_cpy(phl_to_drvpriv(ps->phl_info), basic_info->leave_rson, ps->leave_rson, MAX_CMD_PS_RSON_LENGTH);
 		break;
+#ifdef CONFIG_PHL_PS_PREDICT
+	case PS_MDL_OP_PRED_STAT:
+		_os_mem_cpy(phl_to_drvpriv(ps->phl_info), (void *)info->inbuf,
+					&ps->pred.stat, sizeof(ps->pred.stat));
+		break;
+#endif
 	}
 
 	return MDL_RET_SUCCESS;
@@ -1938,12 +2119,17 @@ void phl_ps_tx_pkt_ntfy(struct phl_info_t *phl_info)
 	SET_MSG_MDL_ID_FIELD(msg.msg_id, PHL_MDL_POWER_MGNT);
 	SET_MSG_EVT_ID_FIELD(msg.msg_id, MSG_EVT_TX_PKT_NTFY);
 	msg.band_idx = HW_BAND_0;
+	attr.opt = MSG_OPT_FAST_LANE;
 	attr.completion.completion = _ps_tx_pkt_ntfy_done;
 	attr.completion.priv = phl_info;
 
 	_os_atomic_set(phl_to_drvpriv(phl_info),
 				   &phl_info->ps_info.tx_ntfy,
 				   1);
+#ifdef CONFIG_PHL_PS_PREDICT
+	if (phl_info->ps_info.wake_req_t == 0)
+		phl_info->ps_info.wake_req_t = _os_get_cur_time_us();
+#endif
 
 	if (phl_disp_eng_send_msg(phl_info, &msg, &attr, NULL) !=
 				RTW_PHL_STATUS_SUCCESS) {
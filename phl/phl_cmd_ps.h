@@ -20,7 +20,12 @@ enum ps_mdl_opcode {
 	PS_MDL_OP_CANCEL_PWR_REQ,
 	PS_MDL_OP_CUR_PWR_LVL,
 	PS_MDL_OP_BASIC_INFO,
-	PS_MDL_OP_BTC_PWR_REQ
+	PS_MDL_OP_BTC_PWR_REQ,
+#ifdef CONFIG_PHL_PS_PREDICT
+	PS_MDL_OP_PRED_STAT,
+	PS_MDL_OP_PRED_EN,
+	PS_MDL_OP_PRED_RST
+#endif
 };
 
 #define MAX_CMD_PS_RSON_LENGTH 30
@@ -71,8 +71,67 @@ struct cmd_ser {
 	struct sts_l2 stsl2[CMD_SER_LOG_SIZE];
 	u8 bserl2;
 	u8 (*ser_l2_hdlr)(void *drv);
+
+#ifdef CONFIG_PHL_SER_FAST_L1
+	u32 l1_t; /* us, M1 received, 0: no l1 in progress */
+	u32 stg_t; /* us, current l1 stage started */
+	struct rtw_ser_l1_stat l1_stat;
+#endif
 };
 
+#ifdef CONFIG_PHL_SER_FAST_L1
+static void _ser_l1_start(struct cmd_ser *cser)
+{
+	cser->l1_t = _os_get_cur_time_us();
+	cser->stg_t = cser->l1_t;
+}
+
+static void _ser_l1_stg_end(struct cmd_ser *cser, u8 stg)
+{
+	struct rtw_ser_l1_stat *stat = &cser->l1_stat;
+	u32 us = phl_get_passing_time_us(cser->stg_t);
+
+	stat->stg_us_last[stg] = us;
+	stat->stg_us_sum[stg] += us;
+	if (us > stat->stg_us_max[stg])
+		stat->stg_us_max[stg] = us;
+
+	cser->stg_t = _os_get_cur_time_us();
+}
+
+static void _ser_l1_end(struct cmd_ser *cser, bool done)
+{
+	struct rtw_ser_l1_stat *stat = &cser->l1_stat;
+	u32 us = 0;
+
+	if (cser->l1_t == 0)
+		return;
+
+	if (done) {
+		us = phl_get_passing_time_us(cser->l1_t);
+		stat->done++;
+		stat->total_us_last = us;
+		if (us > stat->total_us_max)
+			stat->total_us_max = us;
+	} else {
+		stat->fail++;
+	}
+
+	cser->l1_t = 0;
+}
+
+static void _ser_l1_requeue_tx(struct cmd_ser *cser, bool drop)
+{
+	struct phl_hci_trx_ops *ops = cser->phl_info->hci_trx_ops;
+
+	if (cser->l1_t == 0 || ops->requeue_tx == NULL)
+		return;
+
+	cser->l1_stat.requeue += ops->requeue_tx(cser->phl_info, drop,
+						 &cser->l1_stat.drop);
+}
+#endif /* CONFIG_PHL_SER_FAST_L1 */
+
 static void _ser_int_ntfy_ctrl(struct phl_info_t *phl_info,
                                enum rtw_phl_config_int int_type)
 {
@@ -202,6 +261,9 @@ static void _ser_l2_notify(struct cmd_ser *cser)
 	/* L2 can't be rescued, bserl2 wouldn't reset. */
 	/* comment out: wait for new ser flow to handle L2 */
 	cser->bserl2 = true;
+#ifdef CONFIG_PHL_SER_FAST_L1
+	_ser_l1_end(cser, false);
+#endif
 
 	if (cser->ser_l2_hdlr)
 		cser->ser_l2_hdlr(phl_to_drvpriv(phl_info));
@@ -288,6 +350,7 @@ static void _ser_poll_timer_cb(void *priv)
 	}
 
 	nextmsg.band_idx = HW_BAND_0;
+	attr.opt = MSG_OPT_FAST_LANE;
 
 	if (MSG_EVT_ID_FIELD(nextmsg.msg_id)) {
 		PHL_DBG("%s :: nextmsg->msg_id= 0x%X\n", __func__, MSG_EVT_ID_FIELD(nextmsg.msg_id));
@@ -333,7 +396,12 @@ static void _ser_m1_pause_trx(struct cmd_ser *cser)
 	}
 #endif
 
+#ifdef CONFIG_PHL_SER_FAST_L1
+	/* unacknowledged tx is held and requeued on M5 */
+	ctl.cmd = PHL_DATA_CTL_SW_TX_RESET_KEEP;
+#else
 	ctl.cmd = PHL_DATA_CTL_SW_TX_RESET;
+#endif
 	sts = phl_data_ctrler(phl_info, &ctl, NULL);
 	if (RTW_PHL_STATUS_SUCCESS != sts) {
 		PHL_WARN("%s(): reset sw tx failure\n", __func__);
@@ -347,6 +415,9 @@ static void _ser_m1_pause_trx(struct cmd_ser *cser)
 		goto err;
 	}
 
+#ifdef CONFIG_PHL_SER_FAST_L1
+	_ser_l1_stg_end(cser, RTW_SER_L1_STG_PAUSE);
+#endif
 	_ser_m2_notify(cser);
 	_ser_m3_m5_waiting(cser);
 
@@ -380,6 +451,9 @@ static void _ser_m3_reset_hw_trx(struct cmd_ser *cser)
 		goto err;
 	}
 
+#ifdef CONFIG_PHL_SER_FAST_L1
+	_ser_l1_stg_end(cser, RTW_SER_L1_STG_RESET);
+#endif
 	_ser_m4_notify(cser);
 	_ser_m3_m5_waiting(cser);
 
@@ -496,6 +570,9 @@ static void _ser_msg_hdl_m1(struct cmd_ser *cser)
 		_ser_int_ntfy_ctrl(phl_info, RTW_PHL_DIS_HCI_INT);
 
 	_ser_set_status(cser, CMD_SER_M1);
+#ifdef CONFIG_PHL_SER_FAST_L1
+	_ser_l1_start(cser);
+#endif
 	_ser_l1_notify(cser);
 
 	_ser_m1_pause_trx(cser);
@@ -528,6 +605,9 @@ static void _ser_msg_hdl_m3(struct cmd_ser *cser)
 	_os_cancel_timer(drv, &cser->poll_timer);
 	_ser_clear_status(cser, CMD_SER_M2);
 	_ser_set_status(cser, CMD_SER_M3);
+#ifdef CONFIG_PHL_SER_FAST_L1
+	_ser_l1_stg_end(cser, RTW_SER_L1_STG_M3);
+#endif
 
 	_ser_m3_reset_hw_trx(cser);
 }
@@ -542,12 +622,20 @@ static void _ser_msg_hdl_m5(struct cmd_ser *cser)
 	_os_cancel_timer(drv, &cser->poll_timer);
 	_ser_clear_status(cser, CMD_SER_M4);
 	_ser_set_status(cser, CMD_SER_M5);
+#ifdef CONFIG_PHL_SER_FAST_L1
+	_ser_l1_stg_end(cser, RTW_SER_L1_STG_M5);
+	_ser_l1_requeue_tx(cser, false);
+#endif
 
 	ctl.id = PHL_MDL_SER;
 	ctl.cmd = PHL_DATA_CTL_SW_TX_RESUME;
 	sts = phl_data_ctrler(phl_info, &ctl, NULL);
 	if (RTW_PHL_STATUS_SUCCESS != sts)
 		PHL_WARN("%s(): resume sw tx failure\n", __func__);
+#ifdef CONFIG_PHL_SER_FAST_L1
+	_ser_l1_stg_end(cser, RTW_SER_L1_STG_RESUME);
+	_ser_l1_end(cser, true);
+#endif
 
 	_ser_reset_status(cser);
 
@@ -565,6 +653,10 @@ static void _ser_msg_hdl_m9(struct cmd_ser *cser)
 	_ser_set_status(cser, CMD_SER_M9);
 
 	if (cser->state > CMD_SER_NOT_OCCUR) {
+#ifdef CONFIG_PHL_SER_FAST_L1
+		/* tx held since M1 won't make it through L2 */
+		_ser_l1_requeue_tx(cser, true);
+#endif
 		ctl.id = PHL_MDL_SER;
 		ctl.cmd = PHL_DATA_CTL_SW_TX_RESUME;
 		sts = phl_data_ctrler(phl_info, &ctl, NULL);
@@ -768,6 +860,13 @@ _phl_ser_mdl_set_info(void *dispr,
 			}
 			ret = MDL_RET_SUCCESS;
 			break;
+#ifdef CONFIG_PHL_SER_FAST_L1
+		case SER_MDL_OP_L1_STAT_RST:
+			_os_mem_set(phl_to_drvpriv(cser->phl_info), &cser->l1_stat,
+			            0, sizeof(cser->l1_stat));
+			ret = MDL_RET_SUCCESS;
+			break;
+#endif
 	}
 
 	return ret;
@@ -788,6 +887,13 @@ _phl_ser_mdl_query_info(void *dispr,
 			_os_mem_cpy(drv, (void*)info->inbuf, &cser->state, 1);
 			ret = MDL_RET_SUCCESS;
 			break;
+#ifdef CONFIG_PHL_SER_FAST_L1
+		case SER_MDL_OP_L1_STAT:
+			_os_mem_cpy(drv, (void*)info->inbuf, &cser->l1_stat,
+			            sizeof(cser->l1_stat));
+			ret = MDL_RET_SUCCESS;
+			break;
+#endif
 	}
 	return ret;
 }
@@ -873,6 +979,7 @@ phl_ser_send_msg(void *phl, enum RTW_PHL_SER_NOTIFY_EVENT notify)
 	SET_MSG_MDL_ID_FIELD(nextmsg.msg_id, PHL_MDL_SER);
 	SET_MSG_EVT_ID_FIELD(nextmsg.msg_id, event);
 	nextmsg.band_idx = HW_BAND_0;
+	attr.opt = MSG_OPT_FAST_LANE;
 
 	phl_status = rtw_phl_send_msg_to_dispr(phl,
 					       &nextmsg,
@@ -884,6 +991,32 @@ phl_ser_send_msg(void *phl, enum RTW_PHL_SER_NOTIFY_EVENT notify)
 
 	return phl_status;
 }
+
+#ifdef CONFIG_PHL_SER_FAST_L1
+enum rtw_phl_status
+phl_ser_get_l1_stat(struct phl_info_t *phl_info, struct rtw_ser_l1_stat *stat,
+                    bool rst)
+{
+	struct phl_module_op_info op_info = {0};
+	enum rtw_phl_status psts = RTW_PHL_STATUS_FAILURE;
+
+	op_info.op_code = SER_MDL_OP_L1_STAT;
+	op_info.inbuf = (u8 *)stat;
+	op_info.inlen = sizeof(*stat);
+
+	psts = phl_disp_eng_query_bk_module_info(phl_info, HW_BAND_0,
+	                                         PHL_MDL_SER, &op_info);
+	if (RTW_PHL_STATUS_SUCCESS != psts || !rst)
+		return psts;
+
+	op_info.op_code = SER_MDL_OP_L1_STAT_RST;
+	op_info.inbuf = NULL;
+	op_info.inlen = 0;
+
+	return phl_disp_eng_set_bk_module_info(phl_info, HW_BAND_0,
+	                                       PHL_MDL_SER, &op_info);
+}
+#endif /* CONFIG_PHL_SER_FAST_L1 */
 #endif
 
 #ifndef CONFIG_FSM
@@ -27,4 +27,16 @@ enum rtw_phl_status
 phl_register_ser_module(struct phl_info_t *phl_info);
 #endif
 
+#ifdef CONFIG_PHL_SER_FAST_L1
+/* ser module op codes, past the common BK_MODL_OP_* ones */
+enum ser_mdl_opcode {
+	SER_MDL_OP_L1_STAT = BK_MODL_OP_MAX,
+	SER_MDL_OP_L1_STAT_RST
+};
+
+enum rtw_phl_status
+phl_ser_get_l1_stat(struct phl_info_t *phl_info, struct rtw_ser_l1_stat *stat,
+                    bool rst);
+#endif
+
 #endif /* __PHL_CMD_SER_H__ */
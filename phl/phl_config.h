@@ -169,6 +169,9 @@
  * otherwise, all dispatcher would share single background thread, which is in share mode.
 */
 /*#define CONFIG_CMD_DISP_SOLO_MODE*/
+#ifdef CONFIG_CMD_DISP_SOLO
+#define CONFIG_CMD_DISP_SOLO_MODE
+#endif
 
 /* Enable Self-Defined Sequence feature for sender to rearrange dispatch order,
  * Since this is not a mandatory feature and would have addiional memory cost (arround 2200 Bytes)
@@ -188,6 +191,14 @@
 
 #define CONFIG_PHL_CMD_BTC
 
+#ifdef CONFIG_CMD_DISP_BATCH
+#define CONFIG_PHL_CMD_DISP_BATCH
+#endif
+
+#ifdef CONFIG_CMD_DISP_FAST_LANE
+#define CONFIG_PHL_CMD_DISP_FAST_LANE
+#endif
+
 #ifdef CONFIG_MSG_NUM
 	#define CONFIG_PHL_MSG_NUM CONFIG_MSG_NUM
 #endif
@@ -228,6 +239,70 @@
 #define CONFIG_PHL_CSUM_OFFLOAD_RX
 #endif
 
+#ifdef CONFIG_TCP_CSUM_OFFLOAD_TX
+#define CONFIG_PHL_CSUM_OFFLOAD_TX
+#endif
+
+#ifdef CONFIG_HCI_SIM
+#define CONFIG_PHL_HCI_SIM
+#endif
+
+#ifdef CONFIG_WD_TMPL_CACHE
+#define CONFIG_PHL_WD_TMPL_CACHE
+#endif
+
+#ifdef CONFIG_RX_CLS
+#define CONFIG_PHL_RX_CLS
+#endif
+
+#ifdef CONFIG_DLE_REBAL
+#define CONFIG_PHL_DLE_REBAL
+#endif
+
+#ifdef CONFIG_TX_ATF
+#define CONFIG_PHL_TX_ATF
+#endif
+
+#ifdef CONFIG_H2C_COAL
+#define CONFIG_PHL_H2C_COAL
+#endif
+
+/* PCIe only, fw io offload writes registers behind the shadow */
+#if defined(CONFIG_IO_SHADOW) && defined(CONFIG_PCI_HCI) && \
+	!defined(CONFIG_FW_IO_OFLD_SUPPORT)
+#define CONFIG_PHL_IO_SHADOW
+#endif
+
+#ifdef CONFIG_RFK_CACHE
+#define CONFIG_PHL_RFK_CACHE
+#endif
+
+#ifdef CONFIG_FAST_CHSW
+#define CONFIG_PHL_FAST_CHSW
+#endif
+
+#if defined(CONFIG_PS_PREDICT) && defined(CONFIG_POWER_SAVE)
+#define CONFIG_PHL_PS_PREDICT
+#endif
+
+#if defined(CONFIG_MCC_ADAPT_DUR) && defined(CONFIG_MCC_SUPPORT)
+#define CONFIG_PHL_MCC_ADAPT_DUR
+#endif
+
+#ifdef CONFIG_MSG_HUB_RECV_Q
+#define CONFIG_PHL_MSG_HUB_RECV_Q
+#endif
+
+/* PCIe only, in-flight tx is kept in the wp tags across l1 ser */
+#if defined(CONFIG_SER_FAST_L1) && defined(CONFIG_PCI_HCI) && \
+	defined(CONFIG_PHL_CMD_SER)
+#define CONFIG_PHL_SER_FAST_L1
+#endif
+
+#ifdef CONFIG_TX_AMSDU_HW_MODE
+#define CONFIG_PHL_HW_AMSDU
+#endif
+
 #ifdef CONFIG_RX_PSTS_PER_PKT
 #define CONFIG_PHL_RX_PSTS_PER_PKT
 #define RTW_WKARD_DISABLE_PSTS_PER_PKT_DATA
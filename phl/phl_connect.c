@@ -534,3 +534,43 @@ enum rtw_phl_status rtw_phl_p2p_listen_end(void *phl, struct rtw_wifi_role_t *wr
 	return RTW_PHL_STATUS_SUCCESS;
 }
 #endif /* RTW_WKARD_P2P_LISTEN */
+
+#ifdef CONFIG_PHL_H2C_COAL
+/*
+ * rtw_phl_h2c_coal_begin - hold back non-urgent h2c until the matching
+ * rtw_phl_h2c_coal_end(), e.g. around the steps of an association
+ * @token: H2C_COAL_TOKEN() of the sequence, reusing an open one is a no-op
+ */
+void rtw_phl_h2c_coal_begin(void *phl, u32 token)
+{
+	struct phl_info_t *phl_info = (struct phl_info_t *)phl;
+
+	rtw_hal_h2c_coal_begin(phl_info->hal, token);
+}
+
+void rtw_phl_h2c_coal_end(void *phl, u32 token)
+{
+	struct phl_info_t *phl_info = (struct phl_info_t *)phl;
+
+	rtw_hal_h2c_coal_end(phl_info->hal, token);
+}
+
+void rtw_phl_h2c_coal_get_cfg(void *phl, struct rtw_h2c_coal_cfg *cfg)
+{
+	struct phl_info_t *phl_info = (struct phl_info_t *)phl;
+
+	rtw_hal_h2c_coal_get_cfg(phl_info->hal, cfg);
+}
+
+enum rtw_phl_status
+rtw_phl_h2c_coal_get_stat(void *phl, struct rtw_h2c_coal_stat *stat, u8 rst)
+{
+	struct phl_info_t *phl_info = (struct phl_info_t *)phl;
+
+	if (rtw_hal_h2c_coal_get_stat(phl_info->hal, stat, rst) !=
+	    RTW_HAL_STATUS_SUCCESS)
+		return RTW_PHL_STATUS_FAILURE;
+
+	return RTW_PHL_STATUS_SUCCESS;
+}
+#endif /* CONFIG_PHL_H2C_COAL */
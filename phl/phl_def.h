@@ -693,6 +693,7 @@ enum phl_msg_opt {
 	MSG_OPT_CLR_SNDR_MSG_IF_PENDING = BIT2,
 	MSG_OPT_SEND_IN_ABORT = BIT3,
 	MSG_OPT_PENDING_DURING_CANNOT_IO = BIT4,
+	MSG_OPT_FAST_LANE = BIT5, /* overtake queued bk msgs, ignored for cmd req owner */
 };
 
 
@@ -747,6 +748,9 @@ enum phl_data_ctl_cmd {
 	PHL_DATA_CTL_TRX_SW_RESUME = 10,
 	PHL_DATA_CTL_TRX_PAUSE_W_RST = 11,
 	PHL_DATA_CTL_TRX_RESUME_W_RST = 12,
+#ifdef CONFIG_PHL_SER_FAST_L1
+	PHL_DATA_CTL_SW_TX_RESET_KEEP = 13,
+#endif
 	PHL_DATA_CTL_MAX = 0xFF
 };
 
@@ -1591,6 +1595,9 @@ struct dev_cap_t {
 	u8 wl_func_cap;
 	u8 rpq_agg_num; /* 0: no adjust, use mac default size: 121 */
 	bool quota_turbo;
+#ifdef CONFIG_CMD_DISP_SOLO_MODE
+	s8 dispr_cpu[HW_BAND_MAX]; /* cpu of each band's dispatcher thread, <0: any */
+#endif
 };
 
 #ifdef RTW_PHL_BCN //phl def
@@ -1809,6 +1816,13 @@ struct rtw_stats {
 	u16 rx_moving_average_tp; /* rx average MBps*/
 	u32 last_tx_time_ms;
 	u32 last_rx_time_ms;
+#ifdef CONFIG_PHL_PS_PREDICT
+	/* tx and rx inter-packet gap, ewma scaled by 8 */
+	u32 last_pkt_time_ms;
+	u32 pkt_gap_avg_x8;
+	u32 pkt_gap_dev_x8;
+	u16 pkt_gap_cnt;
+#endif
 	u32 txreq_num;
 	u32 rx_rate;
 	u32 rx_rate_nmr[RTW_DATA_RATE_HE_NSS4_MCS11 +1];
@@ -86,6 +86,7 @@
 
 #include "phl_pkt_ofld.h"
 #include "test/phl_dbg_cmd.h"
+#include "test/phl_bench.h"
 #include "phl_chan.h"
 #include "phl_acs.h"
 #include "phl_led_def.h"
@@ -119,6 +120,9 @@
 #include "hci/phl_trx_def_sdio.h"
 #include "hci/phl_trx_sdio.h"
 #endif
+#ifdef CONFIG_PHL_HCI_SIM
+#include "hci/phl_trx_sim.h"
+#endif
 
 
 /******************************************************************************
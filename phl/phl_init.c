@@ -528,6 +528,11 @@ static enum rtw_phl_status phl_set_hci_ops(struct phl_info_t *phl_info)
 		phl_hook_trx_ops_sdio(phl_info);
 	#endif
 
+	#ifdef CONFIG_PHL_HCI_SIM
+	/* loopback replaces the datapath of whatever bus was probed */
+	phl_hook_trx_ops_sim(phl_info);
+	#endif
+
 	return _phl_hci_ops_check(phl_info);
 }
 
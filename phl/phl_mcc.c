@@ -166,6 +166,11 @@ void _mcc_dump_mcc_info(struct phl_mcc_info *minfo)
 	_mcc_dump_state(&minfo->state);
 	_mcc_dump_bt_ino(&minfo->bt_info);
 	_mcc_dump_en_info(&minfo->en_info);
+#ifdef CONFIG_PHL_MCC_ADAPT_DUR
+	PHL_TRACE(COMP_PHL_MCC, _PHL_INFO_, "_mcc_dump_mcc_info(): adapt target(%d), hold(%d), update_cnt(%d)\n",
+		minfo->adapt_i.target, minfo->adapt_i.hold,
+		minfo->adapt_i.update_cnt);
+#endif
 	PHL_TRACE(COMP_PHL_MCC, _PHL_INFO_, "<<< _mcc_dump_mcc_info():\n");
 }
 
@@ -667,9 +672,14 @@ void _mcc_reset_minfo(struct phl_info_t *phl, struct phl_mcc_info *minfo,
 		_os_mem_set(priv, minfo, 0, sizeof(struct phl_mcc_info));
 		return;
 	}
-	if (reset_type & MINFO_RESET_EN_INFO)
+	if (reset_type & MINFO_RESET_EN_INFO) {
 		_os_mem_set(priv, &minfo->en_info, 0,
 				sizeof(struct rtw_phl_mcc_en_info));
+#ifdef CONFIG_PHL_MCC_ADAPT_DUR
+		_os_mem_set(priv, &minfo->adapt_i, 0,
+				sizeof(struct phl_mcc_adapt_info));
+#endif
+	}
 	if (reset_type & MINFO_RESET_MODE)
 		_os_mem_set(priv, &minfo->mcc_mode, 0,
 				sizeof(enum rtw_phl_tdmra_wmode));
@@ -3226,6 +3236,132 @@ exit:
 	return status;
 }
 
+#ifdef CONFIG_PHL_MCC_ADAPT_DUR
+/*
+ * Traffic load of the role since last watchdog: tx + rx bytes of all its
+ * macid, plus the frames still queued in phl tx ring.
+ */
+u64 _mcc_adapt_role_load(struct phl_info_t *phl, struct rtw_phl_mcc_role *mrole,
+				u64 *last_bytes)
+{
+	struct rtw_phl_mcc_macid_bitmap *used_macid = &mrole->used_macid;
+	struct rtw_phl_stainfo_t *sta = NULL;
+	u64 bytes = 0, load = 0;
+	u16 macid = 0;
+	u8 i = 0, j = 0, tid = 0;
+
+	if (used_macid->bitmap == NULL)
+		return 0;
+	for (i = 0; i < (used_macid->len / sizeof(u32)); i++) {
+		if (used_macid->bitmap[i] == 0)
+			continue;
+		for (j = 0; j < 32; j++) {
+			if (!(used_macid->bitmap[i] & BIT(j)))
+				continue;
+			macid = (u16)(i * 32 + j);
+			sta = rtw_phl_get_stainfo_by_macid(phl, macid);
+			if (sta == NULL)
+				continue;
+			bytes += sta->stats.tx_byte_total +
+				sta->stats.rx_byte_total;
+			/* data tid only, ring 8 and 9 are mgnt and hiq */
+			for (tid = 0; tid < 8; tid++)
+				load += (u64)rtw_phl_tring_rsc(phl, macid, tid) *
+						MCC_ADAPT_PENDING_BYTES;
+		}
+	}
+	/* sta left or stats reset, count from now on */
+	if (bytes >= *last_bytes)
+		load += bytes - *last_bytes;
+	*last_bytes = bytes;
+	return load;
+}
+
+/*
+ * Retune the slot of each role by its share of traffic. Durations stay in
+ * [min dur + bcn guard, max_dur of dur_limit], a new target has to hold
+ * for MCC_ADAPT_HOLD watchdogs and differ by MCC_ADAPT_HYST TU from the
+ * current one, and each update moves at most MCC_ADAPT_STEP_MAX TU.
+ */
+void _mcc_adapt_dur(struct phl_info_t *phl, struct phl_mcc_info *minfo)
+{
+	struct phl_mcc_adapt_info *adapt_i = &minfo->adapt_i;
+	struct rtw_phl_mcc_en_info *en_info = &minfo->en_info;
+	struct rtw_phl_mcc_role *m_role1 = &en_info->mcc_role[0];
+	struct rtw_phl_mcc_role *m_role2 = &en_info->mcc_role[1];
+	struct rtw_phl_mcc_dur_info *dur_i_1 = &m_role1->policy.dur_info;
+	struct rtw_phl_mcc_dur_info *dur_i_2 = &m_role2->policy.dur_info;
+	struct phl_mcc_info new_minfo = {0};
+	u64 load1 = 0, load2 = 0;
+	u16 intvl = en_info->mcc_intvl, cur = dur_i_1->dur, target = 0;
+	u16 d1_def = 0, d2_def = 0, lo = 0, hi = 0, diff = 0;
+
+	if (minfo->bt_info.bt_dur != 0 || en_info->mrole_num != MCC_ROLE_NUM ||
+	    intvl == 0)
+		goto reset;
+	load1 = _mcc_adapt_role_load(phl, m_role1, &adapt_i->last_bytes[0]);
+	load2 = _mcc_adapt_role_load(phl, m_role2, &adapt_i->last_bytes[1]);
+	lo = (_mcc_is_ap_category(m_role1->wrole) ? MIN_AP_DUR :
+					MIN_CLIENT_DUR) + MCC_ADAPT_BCN_GUARD;
+	hi = intvl - ((_mcc_is_ap_category(m_role2->wrole) ? MIN_AP_DUR :
+					MIN_CLIENT_DUR) + MCC_ADAPT_BCN_GUARD);
+	if (dur_i_1->dur_limit.enable && dur_i_1->dur_limit.max_dur != 0 &&
+	    dur_i_1->dur_limit.max_dur < hi)
+		hi = dur_i_1->dur_limit.max_dur;
+	if (dur_i_2->dur_limit.enable && dur_i_2->dur_limit.max_dur != 0 &&
+	    dur_i_2->dur_limit.max_dur < intvl &&
+	    intvl - dur_i_2->dur_limit.max_dur > lo)
+		lo = intvl - dur_i_2->dur_limit.max_dur;
+	if (lo > hi)
+		goto reset;
+	if (load1 + load2 < MCC_ADAPT_IDLE_BYTES) {
+		d1_def = _mcc_is_client_category(m_role1->wrole) ?
+					DEFAULT_CLIENT_DUR : DEFAULT_AP_DUR;
+		d2_def = _mcc_is_client_category(m_role2->wrole) ?
+					DEFAULT_CLIENT_DUR : DEFAULT_AP_DUR;
+		target = (u16)_os_division64((u64)intvl * d1_def,
+						d1_def + d2_def);
+	} else {
+		target = (u16)_os_division64(load1 * intvl, load1 + load2);
+	}
+	if (target < lo)
+		target = lo;
+	else if (target > hi)
+		target = hi;
+	diff = (target > cur) ? (target - cur) : (cur - target);
+	if (diff < MCC_ADAPT_HYST)
+		goto reset;
+	if (adapt_i->hold == 0 || ((target > adapt_i->target) ?
+	    (target - adapt_i->target) : (adapt_i->target - target)) >=
+	    MCC_ADAPT_HYST) {
+		adapt_i->target = target;
+		adapt_i->hold = 1;
+		goto exit;
+	}
+	if (++adapt_i->hold < MCC_ADAPT_HOLD)
+		goto exit;
+	if (diff > MCC_ADAPT_STEP_MAX)
+		target = (target > cur) ? (cur + MCC_ADAPT_STEP_MAX) :
+						(cur - MCC_ADAPT_STEP_MAX);
+	PHL_TRACE(COMP_PHL_MCC, _PHL_INFO_, "_mcc_adapt_dur(): load1(%llu), load2(%llu), dur1 %d -> %d, lo(%d), hi(%d)\n",
+		load1, load2, cur, target, lo, hi);
+	_os_mem_cpy(phl_to_drvpriv(phl), &new_minfo, minfo,
+			sizeof(struct phl_mcc_info));
+	_mcc_set_unspecific_dur(&new_minfo);
+	new_minfo.en_info.mcc_role[0].policy.dur_info.dur = target;
+	if (RTW_PHL_STATUS_SUCCESS != _mcc_duration_change(phl, minfo,
+								&new_minfo)) {
+		PHL_TRACE(COMP_PHL_MCC, _PHL_ERR_, "_mcc_adapt_dur(): Change fail\n");
+		goto reset;
+	}
+	adapt_i->update_cnt++;
+reset:
+	adapt_i->hold = 0;
+exit:
+	return;
+}
+#endif /* CONFIG_PHL_MCC_ADAPT_DUR */
+
 void rtw_phl_mcc_watchdog(struct phl_info_t *phl, u8 band_idx)
 {
 	struct phl_mcc_info *minfo = NULL;
@@ -3240,6 +3376,11 @@ void rtw_phl_mcc_watchdog(struct phl_info_t *phl, u8 band_idx)
 
 	if (RTW_PHL_TDMRA_2CLIENTS_WMODE == minfo->mcc_mode)
 		_mcc_2_clients_tracking(phl, minfo);
+#ifdef CONFIG_PHL_MCC_ADAPT_DUR
+	if (RTW_PHL_TDMRA_AP_CLIENT_WMODE == minfo->mcc_mode ||
+	    RTW_PHL_TDMRA_2CLIENTS_WMODE == minfo->mcc_mode)
+		_mcc_adapt_dur(phl, minfo);
+#endif
 
 exit:
 	return;
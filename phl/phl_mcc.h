@@ -48,6 +48,14 @@
 #define AP_CLIENT_OFFSET 40
 #define REF_ROLE_IDX 0
 #define BT_DUR_MAX_2WS 33 /*The max bt slot for 2wifi slot and 1 bt slot*/
+#ifdef CONFIG_PHL_MCC_ADAPT_DUR
+#define MCC_ADAPT_IDLE_BYTES 0x40000 /*per watchdog, below it go back to default dur*/
+#define MCC_ADAPT_PENDING_BYTES 1500 /*weight of one frame queued in phl tx ring*/
+#define MCC_ADAPT_BCN_GUARD 5 /*TU, kept above the min dur against bcn miss*/
+#define MCC_ADAPT_HYST 10 /*TU, smaller change is ignored*/
+#define MCC_ADAPT_STEP_MAX 20 /*TU, largest change per update*/
+#define MCC_ADAPT_HOLD 2 /*watchdogs a new target has to persist*/
+#endif
 
 enum _mcc_minfo_reset_type {
 	MINFO_RESET_EN_INFO = BIT(0),
@@ -72,6 +80,15 @@ struct phl_mcc_fw_log_info {
 	bool update; /*if update = true, we need to update setting to fw.*/
 };
 
+#ifdef CONFIG_PHL_MCC_ADAPT_DUR
+struct phl_mcc_adapt_info {
+	u64 last_bytes[MCC_ROLE_NUM]; /*tx + rx bytes of the role at last watchdog*/
+	u16 target; /*dur of mcc_role[0] wanted by the last watchdog*/
+	u8 hold; /*watchdogs the target has persisted*/
+	u32 update_cnt; /*dur changes pushed to fw*/
+};
+#endif
+
 struct phl_mcc_info {
 	struct rtw_phl_mcc_en_info en_info;
 	enum rtw_phl_tdmra_wmode mcc_mode;
@@ -80,6 +97,9 @@ struct phl_mcc_info {
 	enum rtw_phl_mcc_coex_mode coex_mode;
 	struct rtw_phl_mcc_bt_info bt_info;
 	struct phl_mcc_fw_log_info fw_log_i;
+#ifdef CONFIG_PHL_MCC_ADAPT_DUR
+	struct phl_mcc_adapt_info adapt_i;
+#endif
 };
 
 
@@ -28,17 +28,40 @@ enum msg_recver_status {
 	MSG_RECVER_CLR_CTX = BIT1,
 };
 
+/**
+ * phl_msg_receiver_ex - msg receiver,
+ * @wait_q: msgs pending on this receiver only (CONFIG_PHL_MSG_HUB_RECV_Q)
+ * @sched: receiver thread woken up and not yet found wait_q empty,
+ *	protected by wait_q lock
+ */
 struct phl_msg_receiver_ex {
 	u8 status;
 	u8 bitmap[ MODL_MASK_LEN ];
 	struct phl_msg_receiver ctx;
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+	u8 layer;
+	u8 sched;
+	struct phl_info_t *phl;
+	struct phl_queue wait_q;
+	_os_sema sema;
+	_os_thread thread;
+#endif
 };
 
 
+/**
+ * phl_msg_ex - msg extension,
+ * @rlist: node in wait_q of each receiver (CONFIG_PHL_MSG_HUB_RECV_Q)
+ * @ref: receivers still holding the msg, back to idle_msg_q at zero
+ */
 struct phl_msg_ex {
 	_os_list list;
 	struct phl_msg ctx;
 	struct msg_completion_routine completion;
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+	_os_list rlist[MSG_RECV_MAX];
+	_os_atomic ref;
+#endif
 };
 /**
  * phl_msg_hub - responsible for phl msg forwarding,
@@ -46,6 +69,7 @@ struct phl_msg_ex {
  * @msg_pool: msg extension pool
  * @msg_notify_thread: thread fot forwarding msg
  * @recver: msg receiver, refer to enum phl_msg_recver_layer
+ * @stat: queue depth, coalesce and drop counters (CONFIG_PHL_MSG_HUB_RECV_Q)
  */
 struct phl_msg_hub {
 	u32 status;
@@ -56,6 +80,9 @@ struct phl_msg_hub {
 		_os_thread msg_notify_thread;
 		/* for core & phl layer respectively */
 		struct phl_msg_receiver_ex recver[MSG_RECV_MAX];
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+		struct rtw_msg_hub_stat stat;
+#endif
 };
 
 inline static u8 _is_bitmap_empty(void* d, u8* bitmap){
@@ -91,6 +118,7 @@ static void push_back_idle_msg(struct phl_info_t* phl, struct phl_msg_ex* ex)
 	pq_push(d, &hub->idle_msg_q, &ex->list, _tail, _bh);
 }
 
+#ifndef CONFIG_PHL_MSG_HUB_RECV_Q
 static u8 pop_front_wait_msg(struct phl_info_t* phl, struct phl_msg_ex** msg)
 {
 	void *d = phl_to_drvpriv(phl);
@@ -173,13 +201,204 @@ int msg_thread_hdl(void* param)
 	PHL_INFO("%s down\n",__FUNCTION__);
 	return 0;
 }
+#else
+static const char *msg_recver_thread_name[MSG_RECV_MAX] = {
+	"msg_recv_phl", "msg_recv_core"};
+
+/*
+ * Payload free tx/rx datapath events only tell the receiver to go and look
+ * at the current state (tx ring, c2h report), so one pending copy per
+ * receiver is enough. Msgs with buffers or a completion are always queued.
+ */
+static u8 _msg_coalescable(struct phl_msg_ex *ex)
+{
+	u8 module_id = MSG_MDL_ID_FIELD(ex->ctx.msg_id);
+
+	if (module_id != PHL_MDL_TX && module_id != PHL_MDL_RX)
+		return false;
+	if (ex->ctx.inbuf || ex->ctx.inlen || ex->ctx.outbuf ||
+	    ex->ctx.outlen || ex->completion.completion)
+		return false;
+	return true;
+}
+
+static struct phl_msg_ex *_rlist_to_msg(_os_list *node, u8 layer)
+{
+	return phl_container_of(node - layer, struct phl_msg_ex, rlist[0]);
+}
+
+static void _msg_put(struct phl_info_t *phl, struct phl_msg_ex *ex)
+{
+	if (_os_atomic_dec_return(phl_to_drvpriv(phl), &ex->ref) == 0)
+		push_back_idle_msg(phl, ex);
+}
+
+/* queue ex on one receiver, wake its thread if it is not running already */
+static void _recver_q_push(struct phl_info_t *phl,
+			   struct phl_msg_receiver_ex *recver,
+			   struct phl_msg_ex *ex, u8 coal)
+{
+	void *d = phl_to_drvpriv(phl);
+	struct phl_msg_hub *hub = (struct phl_msg_hub *)phl->msg_hub;
+	struct rtw_msg_recv_stat *rstat = &hub->stat.recv[recver->layer];
+	struct phl_queue *q = &recver->wait_q;
+	struct phl_msg_ex *pend = NULL;
+	_os_list *node = NULL;
+	_os_spinlockfg sp_flags;
+	u8 wake = false;
+
+	_os_spinlock(d, &q->lock, _bh, &sp_flags);
+	if (coal) {
+		for (node = _get_next(&q->queue); node != &q->queue;
+		     node = _get_next(node)) {
+			pend = _rlist_to_msg(node, recver->layer);
+			if (pend->ctx.msg_id == ex->ctx.msg_id &&
+			    pend->ctx.band_idx == ex->ctx.band_idx &&
+			    _msg_coalescable(pend)) {
+				rstat->coal++;
+				_os_spinunlock(d, &q->lock, _bh, &sp_flags);
+				return;
+			}
+		}
+	}
+	_os_atomic_inc(d, &ex->ref);
+	list_add_tail(&ex->rlist[recver->layer], &q->queue);
+	q->cnt++;
+	if (q->cnt > (int)rstat->depth_max)
+		rstat->depth_max = q->cnt;
+	if (!recver->sched) {
+		recver->sched = true;
+		wake = true;
+	}
+	_os_spinunlock(d, &q->lock, _bh, &sp_flags);
+
+	if (wake)
+		_os_sema_up(d, &recver->sema);
+}
+
+/* clears sched once wait_q is seen empty, the next push wakes us again */
+static u8 _recver_q_pop(struct phl_info_t *phl,
+			struct phl_msg_receiver_ex *recver,
+			struct phl_msg_ex **ex)
+{
+	void *d = phl_to_drvpriv(phl);
+	struct phl_queue *q = &recver->wait_q;
+	_os_list *node = NULL;
+	_os_spinlockfg sp_flags;
+
+	(*ex) = NULL;
+	_os_spinlock(d, &q->lock, _bh, &sp_flags);
+	if (!list_empty(&q->queue) && (q->cnt > 0)) {
+		node = _get_next(&q->queue);
+		list_del(node);
+		q->cnt--;
+		(*ex) = _rlist_to_msg(node, recver->layer);
+	} else {
+		recver->sched = false;
+	}
+	_os_spinunlock(d, &q->lock, _bh, &sp_flags);
+
+	return ((*ex) == NULL) ? (false) : (true);
+}
+
+static void msg_dispatch(struct phl_info_t *phl, struct phl_msg_ex *ex)
+{
+	void *d = phl_to_drvpriv(phl);
+	struct phl_msg_hub *hub = (struct phl_msg_hub *)phl->msg_hub;
+	struct phl_msg_receiver_ex *recver = NULL;
+	u8 module_id = MSG_MDL_ID_FIELD(ex->ctx.msg_id);
+	u8 coal = _msg_coalescable(ex);
+	u8 i = 0;
+
+	/* sender ref, keeps ex off idle_msg_q until every receiver has it */
+	_os_atomic_set(d, &ex->ref, 1);
+	for (i = 0; i < MSG_RECV_MAX; i++) {
+		recver = &(hub->recver[i]);
+		if (!TEST_STATUS_FLAG(recver->status, MSG_RECVER_INIT))
+			continue;
+		if (_chk_bitmap_bit(recver->bitmap, module_id))
+			_recver_q_push(phl, recver, ex, coal);
+	}
+	_msg_put(phl, ex);
+}
+
+int msg_recver_thread_hdl(void *param)
+{
+	struct phl_msg_receiver_ex *recver = (struct phl_msg_receiver_ex *)param;
+	struct phl_info_t *phl = recver->phl;
+	void *d = phl_to_drvpriv(phl);
+	struct phl_msg_hub *hub = (struct phl_msg_hub *)phl->msg_hub;
+	struct rtw_msg_recv_stat *rstat = &hub->stat.recv[recver->layer];
+	struct phl_msg_ex *ex = NULL;
+	u32 batch = 0;
+
+	PHL_INFO("%s(%d) enter\n", __FUNCTION__, recver->layer);
+	while (!_os_thread_check_stop(d, &(recver->thread))) {
+
+		_os_sema_down(d, &recver->sema);
+
+		if (_os_thread_check_stop(d, &(recver->thread)))
+			break;
+
+		/* one wakeup drains the whole burst */
+		batch = 0;
+		while (_recver_q_pop(phl, recver, &ex)) {
+			if (TEST_STATUS_FLAG(hub->status, MSG_HUB_STARTED) &&
+			    TEST_STATUS_FLAG(recver->status, MSG_RECVER_INIT))
+				recver->ctx.incoming_evt_notify(recver->ctx.priv,
+								&(ex->ctx));
+			_msg_put(phl, ex);
+			batch++;
+		}
+		if (batch) {
+			rstat->batch++;
+			rstat->msg += batch;
+			if (batch > rstat->batch_max)
+				rstat->batch_max = batch;
+		}
+		if (!TEST_STATUS_FLAG(recver->status, MSG_RECVER_INIT) &&
+		    TEST_STATUS_FLAG(recver->status, MSG_RECVER_CLR_CTX)) {
+			_os_mem_set(d, &(recver->ctx), 0,
+				    sizeof(struct phl_msg_receiver));
+			_os_mem_set(d, recver->bitmap, 0, MODL_MASK_LEN);
+			CLEAR_STATUS_FLAG(recver->status, MSG_RECVER_CLR_CTX);
+		}
+	}
+	while (_recver_q_pop(phl, recver, &ex))
+		_msg_put(phl, ex);
+	_os_thread_wait_stop(d, &(recver->thread));
+	PHL_INFO("%s(%d) down\n", __FUNCTION__, recver->layer);
+	return 0;
+}
+
+enum rtw_phl_status phl_msg_hub_get_stat(struct phl_info_t *phl,
+					 struct rtw_msg_hub_stat *stat, u8 rst)
+{
+	struct phl_msg_hub *hub = (struct phl_msg_hub *)phl->msg_hub;
+	void *d = phl_to_drvpriv(phl);
+	u8 i = 0;
+
+	if (hub == NULL || !TEST_STATUS_FLAG(hub->status, MSG_HUB_INIT))
+		return RTW_PHL_STATUS_FAILURE;
+
+	_os_mem_cpy(d, stat, &hub->stat, sizeof(struct rtw_msg_hub_stat));
+	stat->idle = hub->idle_msg_q.cnt;
+	for (i = 0; i < MSG_RECV_MAX; i++)
+		stat->recv[i].depth = hub->recver[i].wait_q.cnt;
+	if (rst)
+		_os_mem_set(d, &hub->stat, 0, sizeof(struct rtw_msg_hub_stat));
+	return RTW_PHL_STATUS_SUCCESS;
+}
+#endif /* CONFIG_PHL_MSG_HUB_RECV_Q */
 
 
 enum rtw_phl_status phl_msg_hub_init(struct phl_info_t* phl)
 {
 	struct phl_msg_hub* hub = NULL;
 	void *d = phl_to_drvpriv(phl);
-
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+	u8 i = 0;
+#endif
 
 	if(phl->msg_hub != NULL)
 		return RTW_PHL_STATUS_FAILURE;
@@ -194,6 +413,14 @@ enum rtw_phl_status phl_msg_hub_init(struct phl_info_t* phl)
 	_os_sema_init(d, &(hub->msg_q_sema), 0);
 	pq_init(d, &(hub->idle_msg_q));
 	pq_init(d, &(hub->wait_msg_q));
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+	for (i = 0; i < MSG_RECV_MAX; i++) {
+		hub->recver[i].layer = i;
+		hub->recver[i].phl = phl;
+		_os_sema_init(d, &(hub->recver[i].sema), 0);
+		pq_init(d, &(hub->recver[i].wait_q));
+	}
+#endif
 	SET_STATUS_FLAG(hub->status, MSG_HUB_INIT);
 	PHL_INFO("%s\n",__FUNCTION__);
 	return RTW_PHL_STATUS_SUCCESS;
@@ -203,6 +430,9 @@ enum rtw_phl_status phl_msg_hub_deinit(struct phl_info_t* phl)
 {
 	struct phl_msg_hub* hub = (struct phl_msg_hub*)phl->msg_hub;
 	void *d = phl_to_drvpriv(phl);
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+	u8 i = 0;
+#endif
 
 	if(!TEST_STATUS_FLAG(hub->status, MSG_HUB_INIT))
 		return RTW_PHL_STATUS_FAILURE;
@@ -211,6 +441,12 @@ enum rtw_phl_status phl_msg_hub_deinit(struct phl_info_t* phl)
 	pq_deinit(d, &(hub->idle_msg_q));
 	pq_deinit(d, &(hub->wait_msg_q));
 	_os_sema_free(d, &(hub->msg_q_sema));
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+	for (i = 0; i < MSG_RECV_MAX; i++) {
+		pq_deinit(d, &(hub->recver[i].wait_q));
+		_os_sema_free(d, &(hub->recver[i].sema));
+	}
+#endif
 	_os_mem_free(d, hub, sizeof(struct phl_msg_hub));
 	PHL_INFO("%s\n",__FUNCTION__);
 	return RTW_PHL_STATUS_SUCCESS;
@@ -233,9 +469,20 @@ enum rtw_phl_status phl_msg_hub_start(struct phl_info_t* phl)
 	for(i = 0; i < MAX_MSG_NUM; i++) {
 		pq_push(d, &hub->idle_msg_q, &hub->msg_pool[i].list, _tail, _bh);
 	}
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+	for (i = 0; i < MSG_RECV_MAX; i++) {
+		pq_reset(d, &(hub->recver[i].wait_q), _bh);
+		hub->recver[i].sched = false;
+		_os_thread_init(d, &(hub->recver[i].thread),
+				msg_recver_thread_hdl, &(hub->recver[i]),
+				msg_recver_thread_name[i]);
+		_os_thread_schedule(d, &(hub->recver[i].thread));
+	}
+#else
 	_os_thread_init(d, &(hub->msg_notify_thread), msg_thread_hdl, phl,
 						"msg_notify_thread");
 	_os_thread_schedule(d, &(hub->msg_notify_thread));
+#endif
 	SET_STATUS_FLAG(hub->status, MSG_HUB_STARTED);
 	PHL_INFO("%s\n",__FUNCTION__);
 	return RTW_PHL_STATUS_SUCCESS;
@@ -245,14 +492,26 @@ enum rtw_phl_status phl_msg_hub_stop(struct phl_info_t* phl)
 {
 	struct phl_msg_hub* hub = (struct phl_msg_hub*)phl->msg_hub;
 	void *d = phl_to_drvpriv(phl);
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+	u8 i = 0;
+#endif
 
 	if(!TEST_STATUS_FLAG(hub->status, MSG_HUB_STARTED))
 		return RTW_PHL_STATUS_FAILURE;
 
 	CLEAR_STATUS_FLAG(hub->status, MSG_HUB_STARTED);
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+	for (i = 0; i < MSG_RECV_MAX; i++) {
+		_os_thread_stop(d, &(hub->recver[i].thread));
+		_os_sema_up(d, &(hub->recver[i].sema));
+		_os_thread_deinit(d, &(hub->recver[i].thread));
+		pq_reset(d, &(hub->recver[i].wait_q), _bh);
+	}
+#else
 	_os_thread_stop(d, &(hub->msg_notify_thread));
 	_os_sema_up(d, &(hub->msg_q_sema));
 	_os_thread_deinit(d, &(hub->msg_notify_thread));
+#endif
 	pq_reset(d, &(hub->idle_msg_q), _bh);
 	pq_reset(d, &(hub->wait_msg_q), _bh);
 
@@ -271,6 +530,9 @@ enum rtw_phl_status phl_msg_hub_send(struct phl_info_t* phl,
 		return RTW_PHL_STATUS_FAILURE;
 
 	if(!pop_front_idle_msg(phl, &ex)) {
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+		hub->stat.drop++;
+#endif
 		PHL_ERR(" %s idle msg empty\n",__FUNCTION__);
 		return RTW_PHL_STATUS_RESOURCE;
 	}
@@ -280,7 +542,12 @@ enum rtw_phl_status phl_msg_hub_send(struct phl_info_t* phl,
 		ex->completion.priv = attr->completion.priv;
 	}
 
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+	hub->stat.send++;
+	msg_dispatch(phl, ex);
+#else
 	push_back_wait_msg(phl, ex);
+#endif
 
 	PHL_TRACE(COMP_PHL_DBG, _PHL_DEBUG_, "%s, msg_id:0x%x enqueue\n",
 		  __FUNCTION__, msg->msg_id);
@@ -31,6 +31,11 @@ phl_msg_hub_update_recver_mask(void *phl, enum phl_msg_recver_layer layer,
 enum rtw_phl_status
 phl_msg_hub_deregister_recver(void *phl, enum phl_msg_recver_layer layer);
 
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+enum rtw_phl_status phl_msg_hub_get_stat(struct phl_info_t *phl,
+					 struct rtw_msg_hub_stat *stat, u8 rst);
+#endif
+
 void phl_msg_hub_phy_mgnt_evt_hdlr(struct phl_info_t *phl, u16 evt_id);
 void phl_msg_hub_rx_evt_hdlr(struct phl_info_t *phl, u16 evt_id, u8 *buf,
 			     u32 len);
@@ -124,6 +124,9 @@ void phl_update_rx_stats(struct rtw_stats *stats, struct rtw_recv_pkt *rx_pkt)
 	u64 diff_bits = 0;
 
 	stats->last_rx_time_ms = cur_time;
+#ifdef CONFIG_PHL_PS_PREDICT
+	phl_update_pkt_gap(stats, cur_time);
+#endif
 	stats->rx_byte_total += rx_pkt->mdata.pktlen;
 	if (rx_pkt->mdata.bc == 0 && rx_pkt->mdata.mc == 0)
 		stats->rx_byte_uni += rx_pkt->mdata.pktlen;
@@ -854,6 +857,10 @@ enum rtw_phl_status phl_rx_reorder(struct phl_info_t *phl_info,
 	struct phl_tid_ampdu_rx *r;
 	struct phl_hci_trx_ops *hci_trx_ops = phl_info->hci_trx_ops;
 
+#ifdef CONFIG_PHL_RX_CLS
+	rtw_hal_rx_cls_hit(phl_info->hal, meta, phl_rx->r.pkt_list[0].vir_addr);
+#endif
+
 	/*
 	 * Remove FCS if is is appended
 	 * TODO: handle more than one in pkt_list
@@ -1229,6 +1236,64 @@ enum rtw_rx_status rtw_phl_get_rx_status(void *phl)
 	return RTW_STATUS_RX_OK;
 }
 
+#ifdef CONFIG_PHL_RX_CLS
+enum rtw_phl_status
+rtw_phl_rx_cls_set_policy(void *phl, enum rtw_rx_cls_policy policy)
+{
+	struct phl_info_t *phl_info = (struct phl_info_t *)phl;
+
+	if (RTW_HAL_STATUS_SUCCESS !=
+	    rtw_hal_rx_cls_set_policy(phl_info->hal, policy))
+		return RTW_PHL_STATUS_FAILURE;
+
+	return RTW_PHL_STATUS_SUCCESS;
+}
+
+enum rtw_rx_cls_policy rtw_phl_rx_cls_get_policy(void *phl)
+{
+	struct phl_info_t *phl_info = (struct phl_info_t *)phl;
+
+	return rtw_hal_rx_cls_get_policy(phl_info->hal);
+}
+
+/**
+ * rtw_phl_rx_cls_add_rule - forward or drop a frame type/subtype in the MAC
+ * @phl: see struct phl_info_t
+ * @rule: band, 802.11 type/subtype and target, replaces the policy and any
+ *	previous rule of the same band/type/subtype
+ * @idx: index of the rule, for rtw_phl_rx_cls_del_rule()
+ */
+enum rtw_phl_status
+rtw_phl_rx_cls_add_rule(void *phl, struct rtw_rx_cls_rule *rule, u8 *idx)
+{
+	struct phl_info_t *phl_info = (struct phl_info_t *)phl;
+
+	if (RTW_HAL_STATUS_SUCCESS !=
+	    rtw_hal_rx_cls_add_rule(phl_info->hal, rule, idx))
+		return RTW_PHL_STATUS_FAILURE;
+
+	return RTW_PHL_STATUS_SUCCESS;
+}
+
+enum rtw_phl_status rtw_phl_rx_cls_del_rule(void *phl, u8 idx)
+{
+	struct phl_info_t *phl_info = (struct phl_info_t *)phl;
+
+	if (RTW_HAL_STATUS_SUCCESS !=
+	    rtw_hal_rx_cls_del_rule(phl_info->hal, idx))
+		return RTW_PHL_STATUS_FAILURE;
+
+	return RTW_PHL_STATUS_SUCCESS;
+}
+
+bool rtw_phl_rx_cls_get_rule(void *phl, u8 idx, struct rtw_rx_cls_rule *rule)
+{
+	struct phl_info_t *phl_info = (struct phl_info_t *)phl;
+
+	return rtw_hal_rx_cls_get_rule(phl_info->hal, idx, rule);
+}
+#endif /* CONFIG_PHL_RX_CLS */
+
 enum rtw_phl_status
 rtw_phl_enter_mon_mode(void *phl, struct rtw_wifi_role_t *wrole)
 {
@@ -47,6 +47,9 @@ struct hci_info_t {
 	u8 *rxbuf_pool;
 	u8 *wp_tag;
 	u16 wp_seq[PHL_MACID_MAX_NUM]; 	/* maximum macid number */
+#ifdef CONFIG_PHL_HCI_SIM
+	void *sim;	/* struct phl_sim_info, software loopback backend */
+#endif
 
 };
 
@@ -129,6 +132,9 @@ struct phl_hci_trx_ops {
 	enum rtw_phl_status (*recycle_busy_wd)(struct phl_info_t *phl);
 	enum rtw_phl_status (*recycle_busy_h2c)(struct phl_info_t *phl);
 	void (*read_hw_rx)(struct phl_info_t *phl, enum rx_channel_type rx_ch);
+#ifdef CONFIG_PHL_SER_FAST_L1
+	u32 (*requeue_tx)(struct phl_info_t *phl, bool drop, u32 *drop_cnt);
+#endif
 #endif
 
 #ifdef CONFIG_USB_HCI
@@ -260,11 +266,16 @@ enum data_ctrl_err_code {
 struct phl_ps_info {
 	bool init;
 	_os_atomic tx_ntfy;
+#ifdef CONFIG_PHL_PS_PREDICT
+	u32 wake_req_t; /* us, first datapath wake request while in lps */
+#endif
 };
 #endif
 
 #define PHL_CTRL_TX BIT0
 #define PHL_CTRL_RX BIT1
+/* with PHL_CTRL_TX on trx_reset: hold in-flight tx requests for requeue */
+#define PHL_CTRL_TX_KEEP BIT2
 #define POLL_SW_TX_PAUSE_CNT 100
 #define POLL_SW_TX_PAUSE_MS 5
 #define POLL_SW_RX_PAUSE_CNT 100
@@ -288,6 +299,10 @@ struct phl_info_t {
 	_os_atomic phl_sw_rx_more;
 	_os_atomic phl_sw_rx_req_pwr;
 	_os_atomic is_hw_trx_pause;
+#ifdef CONFIG_PHL_SER_FAST_L1
+	_os_event tx_pause_evt;
+	_os_event rx_pause_evt;
+#endif
 	enum data_ctrl_mdl pause_tx_id;
 	enum data_ctrl_mdl pause_rx_id;
 	_os_lock t_ring_list_lock;
@@ -297,6 +312,9 @@ struct phl_info_t {
 	_os_list t_ring_list;
 	_os_list t_fctrl_result;
 	_os_list t_ring_free_list;
+#ifdef CONFIG_PHL_TX_ATF
+	struct phl_tx_atf tx_atf;
+#endif
 	void *ring_sts_pool;
 	void *rx_pkt_pool;
 	struct phl_h2c_pkt_pool *h2c_pool;
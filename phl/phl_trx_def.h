@@ -324,6 +324,8 @@ struct rtw_r_meta_data {
 	u8 mac_addr[6];		/* DW6 [0:31] DW7 [0:15] */
 	u8 smart_ant;		/* DW7 [16:16] */
 	u8 sec_type;		/* DW7 [17:20] */
+	u8 hdr_cnv;		/* DW7 [21:21] */
+	u8 hdr_offset;		/* DW7 [22:26] */
 };
 
 
@@ -491,6 +493,61 @@ struct phl_tx_plan {
 	_os_list sorted_ring;
 };
 
+#ifdef CONFIG_PHL_TX_ATF
+/* airtime credit added per round to every backlogged station */
+#define PHL_ATF_DEF_QUANTUM_US 4000
+/* preamble, SIFS, block ack and backoff, amortized over an A-MPDU */
+#define PHL_ATF_PPDU_OVH_US 100
+/* rate assumed before the first RA report, 100kbps */
+#define PHL_ATF_DEF_RATE 540
+
+/**
+ * airtime deficit state of a macid, see phl_tx_flow_ctrl()
+ * @deficit: airtime credit left in us, negative when the station is in debt
+ * @rate: estimated phy rate in 100kbps, refreshed by the tx watchdog
+ * @ampdu: estimated MPDUs per PPDU
+ * @airtime: estimated airtime charged since the ring list was created, us
+ * @airtime_intvl: airtime charged in the last watchdog period, us
+ * @airtime_cur: airtime charged so far in the running watchdog period, us
+ * @held_cnt: rounds the station had frames held back for lack of credit
+ */
+struct phl_atf_sta {
+	s32 deficit;
+	u32 rate;
+	u16 ampdu;
+	u64 airtime;
+	u32 airtime_intvl;
+	u32 airtime_cur;
+	u32 held_cnt;
+};
+
+/**
+ * @en: schedule data frames by airtime deficit
+ * @quantum: airtime credit per round, us
+ * @round_cnt: scheduling rounds with at least one data ring
+ */
+struct phl_tx_atf {
+	u8 en;
+	u32 quantum;
+	u32 round_cnt;
+};
+
+/**
+ * per macid airtime, as reported to core by rtw_phl_tx_atf_get_sta_stats()
+ * @share: percent of the airtime of all stations in the last watchdog period
+ * other fields as in struct phl_atf_sta
+ */
+struct rtw_atf_sta_stats {
+	u16 macid;
+	u32 rate;
+	u16 ampdu;
+	s32 deficit;
+	u64 airtime;
+	u32 share;
+	u32 held_cnt;
+};
+#endif /* CONFIG_PHL_TX_ATF */
+
 /**
  * this phl ring list contains a list of phl TX rings that have the same macid
  * and different tid, and it can be access by both core and phl
@@ -502,6 +559,7 @@ struct phl_tx_plan {
  * @mbssid: TODO
  * @phl_ring: the phl rings with same macid but different tid, see rtw_phl_tx_ring
  * @tx_plan: transmission plan for this macid, decide by _phl_check_tring_list()
+ * @atf: airtime deficit of this macid, see struct phl_atf_sta
  */
 struct rtw_phl_tring_list {
 	_os_list list;
@@ -512,6 +570,9 @@ struct rtw_phl_tring_list {
 	/*u8 mbssid*/
 	struct rtw_phl_tx_ring phl_ring[MAX_PHL_RING_CAT_NUM];/* tid 0~7, 8:mgnt, 9:hiq */
 	struct phl_tx_plan tx_plan;
+#ifdef CONFIG_PHL_TX_ATF
+	struct phl_atf_sta atf;
+#endif
 };
 
 /**
@@ -552,6 +613,20 @@ struct rtw_phl_pkt_req {
 	struct rtw_xmit_req *tx_req;
 };
 
+/**
+ * struct rtw_wd_tmpl_stats - hal wd template cache statistics
+ * @hit_cnt: wd copied from the (macid, tid) template and patched
+ * @miss_cnt: wd packed by mac_ax and stored as the new template
+ * @bypass_cnt: packet type not cached, e.g. mgnt or sounding frames
+ * @invalidate_cnt: sta entry or key changes
+ */
+struct rtw_wd_tmpl_stats {
+	u32 hit_cnt;
+	u32 miss_cnt;
+	u32 bypass_cnt;
+	u32 invalidate_cnt;
+};
+
 /*
 0000: WIFI packet
 0001: PPDU status
@@ -604,4 +679,345 @@ enum rtw_rx_fltr_mode {
 	RX_FLTR_MODE_RESTORE = 0xFF
 };
 
+#ifdef CONFIG_PHL_RX_CLS
+#define RTW_RX_CLS_RULE_NUM 16
+#define RTW_RX_CLS_TYPE_NUM 3 /* mgnt, ctrl, data */
+#define RTW_RX_CLS_SUBTYPE_NUM 16
+
+/* same encoding as the MAC type/subtype filter */
+enum rtw_rx_cls_target {
+	RX_CLS_TARGET_DROP = 0,
+	RX_CLS_TARGET_HOST = 1,
+	RX_CLS_TARGET_WLCPU = 2
+};
+
+/**
+ * enum rtw_rx_cls_policy - subtypes dropped by the MAC per rx filter mode
+ * @RX_CLS_POLICY_OFF: every subtype to host, only user rules apply (default)
+ * @RX_CLS_POLICY_NORMAL: drop the subtypes the host never handles in the mode
+ * @RX_CLS_POLICY_STRICT: also drop beacons and probe responses outside
+ *	scan, an AP loses OBSS detection and acs, a STA the beacons of other
+ *	BSSs
+ */
+enum rtw_rx_cls_policy {
+	RX_CLS_POLICY_OFF,
+	RX_CLS_POLICY_NORMAL,
+	RX_CLS_POLICY_STRICT,
+	RX_CLS_POLICY_MAX
+};
+
+/**
+ * struct rtw_rx_cls_rule - user type/subtype rule, overrides the policy
+ * @type: 802.11 frame type, RTW_FRAME_TYPE_MGNT/CTRL/DATA
+ * @target: enum rtw_rx_cls_target
+ * @hit: frames of the type/subtype indicated by the MAC while the rule is
+ *	set, not kept for a drop rule since dropped frames never reach host
+ */
+struct rtw_rx_cls_rule {
+	u8 valid;
+	u8 band;
+	u8 type;
+	u8 subtype;
+	u8 target;
+	u32 hit;
+};
+#endif /* CONFIG_PHL_RX_CLS */
+
+#ifdef CONFIG_PHL_DLE_REBAL
+/* same encoding as enum mac_ax_dle_rebal_prof */
+enum rtw_dle_rebal_prof {
+	DLE_REBAL_PROF_BALANCED = 0,
+	DLE_REBAL_PROF_TX_HEAVY,
+	DLE_REBAL_PROF_RX_HEAVY,
+	DLE_REBAL_PROF_MAX
+};
+
+/**
+ * struct rtw_dle_rebal_info - PLE cmac0 tx/rx quota rebalancer state
+ * @tx_use/@rx_use: pages in use at the last watchdog sample
+ * @tx_max/@rx_max: max quota in effect, in pages
+ * @pub_pgnum: PLE free public pages at the last sample
+ * @rdu_cnt: rx desc unavailable interrupts seen, rx overflows into PLE
+ * @chg_cnt: profile changes per target profile
+ */
+struct rtw_dle_rebal_info {
+	u8 en;
+	u8 prof;
+	u16 tx_use;
+	u16 tx_max;
+	u16 rx_use;
+	u16 rx_max;
+	u16 pub_pgnum;
+	u32 rdu_cnt;
+	u32 sample_cnt;
+	u32 fail_cnt;
+	u32 chg_cnt[DLE_REBAL_PROF_MAX];
+};
+#endif /* CONFIG_PHL_DLE_REBAL */
+
+#ifdef CONFIG_PHL_H2C_COAL
+/* same encoding as enum mac_ax_h2c_coal_cls */
+enum rtw_h2c_coal_cls {
+	H2C_COAL_CLS_RA = 0,
+	H2C_COAL_CLS_CAM,
+	H2C_COAL_CLS_ROLE,
+	H2C_COAL_CLS_STATS,
+	H2C_COAL_CLS_MAX
+};
+
+/* same encoding as enum mac_ax_h2c_coal_trig */
+enum rtw_h2c_coal_trig {
+	H2C_COAL_TRIG_SIZE = 0,
+	H2C_COAL_TRIG_DEADLINE,
+	H2C_COAL_TRIG_ORDER,
+	H2C_COAL_TRIG_END,
+	H2C_COAL_TRIG_MAX
+};
+
+/* flushed batch size bins: 1, 2, 3-4, 5-8, 9+ h2c */
+#define H2C_COAL_BATCH_BIN 5
+
+/* command sequence a coalescing window is opened for */
+enum rtw_h2c_coal_seq {
+	H2C_COAL_SEQ_STA_UPD = 1,
+	H2C_COAL_SEQ_WATCHDOG,
+	H2C_COAL_SEQ_CONNECT,
+	H2C_COAL_SEQ_DISCONNECT,
+	H2C_COAL_SEQ_AP_ASSOC
+};
+
+/* window token of a sequence on one macid, never 0 */
+#define H2C_COAL_TOKEN(_seq, _macid) (((u32)(_seq) << 16) | (u16)(_macid))
+
+/**
+ * struct rtw_h2c_coal_cfg - h2c coalescing configuration
+ * @cls_map: BIT(enum rtw_h2c_coal_cls) of the classes held back
+ * @max_pkt: flush once that many h2c are pending
+ * @deadline_us: flush once the oldest pending h2c is that old
+ */
+struct rtw_h2c_coal_cfg {
+	u8 en;
+	u8 cls_map;
+	u16 max_pkt;
+	u32 deadline_us;
+};
+
+/**
+ * struct rtw_h2c_coal_stat - h2c coalescing counters
+ * @flush_cnt: flushes per enum rtw_h2c_coal_trig
+ * @batch_bin: flushes per batch size bin
+ * @tx_cnt: h2c packets put on the bus by flushes
+ * @pkt_cnt/@lat_sum_us/@lat_max_us: per class h2c count and enqueue to
+ *	flush latency
+ */
+struct rtw_h2c_coal_stat {
+	u32 flush_cnt[H2C_COAL_TRIG_MAX];
+	u32 batch_bin[H2C_COAL_BATCH_BIN];
+	u32 tx_cnt;
+	u32 pkt_cnt[H2C_COAL_CLS_MAX];
+	u32 lat_sum_us[H2C_COAL_CLS_MAX];
+	u32 lat_max_us[H2C_COAL_CLS_MAX];
+};
+#endif /* CONFIG_PHL_H2C_COAL */
+
+#ifdef CONFIG_PHL_IO_SHADOW
+/**
+ * struct rtw_io_shadow_stat - register shadow cache counters
+ * @hit/@miss: 32-bit reads of shadowed registers served from / not found in
+ *	the cache
+ * @wr_skip: writes dropped because the register already holds the value
+ * @wr_merge: pending writes replaced by a later write to the same register
+ * @wr_flush: pending writes put on the bus
+ * @inval: whole cache invalidations (start/stop, L1 recovery)
+ */
+struct rtw_io_shadow_stat {
+	u32 hit;
+	u32 miss;
+	u32 wr_skip;
+	u32 wr_merge;
+	u32 wr_flush;
+	u32 inval;
+};
+#endif /* CONFIG_PHL_IO_SHADOW */
+
+#ifdef CONFIG_PHL_RFK_CACHE
+/**
+ * struct rtw_rfk_cache_stat - channel switch rfk result cache counters
+ * @hit: channel switches served from cached iqk/dpk results
+ * @miss: channel switches that ran a full iqk/dpk
+ * @ther_miss: misses on a cached channel whose thermal had drifted
+ * @evict: cached channels replaced by another channel (lru)
+ * @store_fail: calibrations not cached because iqk/dpk reported a failure
+ * @inval: whole cache invalidations (hal start, rfk run outside the cache)
+ */
+struct rtw_rfk_cache_stat {
+	u32 hit;
+	u32 miss;
+	u32 ther_miss;
+	u32 evict;
+	u32 store_fail;
+	u32 inval;
+};
+#endif /* CONFIG_PHL_RFK_CACHE */
+
+#ifdef CONFIG_PHL_FAST_CHSW
+/**
+ * struct rtw_chsw_stat - channel switch counters
+ * @full: switches through the hal reset sequence (band or bandwidth change,
+ *	first switch after an invalidation, fast switch disabled)
+ * @fast: switches keeping band and bandwidth, hal reset skipped
+ * @mac_skip: fast switches that left the mac bandwidth config untouched
+ * @pwr_hit/@pwr_miss: fast switches whose tx power limit tables were / were
+ *	not found in the per channel cache
+ * @inval: cache invalidations (tx power or limit change, hal start/stop)
+ * @full_us_sum/@full_us_max: accumulated and worst full switch latency
+ * @fast_us_sum/@fast_us_max: accumulated and worst fast switch latency
+ */
+struct rtw_chsw_stat {
+	u32 full;
+	u32 fast;
+	u32 mac_skip;
+	u32 pwr_hit;
+	u32 pwr_miss;
+	u32 inval;
+	u32 full_us_sum;
+	u32 full_us_max;
+	u32 fast_us_sum;
+	u32 fast_us_max;
+};
+#endif /* CONFIG_PHL_FAST_CHSW */
+
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+/* msg sender classes of the cmd dispatcher latency histogram */
+enum rtw_dispr_lat_cls {
+	RTW_DISPR_LAT_CTRL,	/* dispatcher controller: phy mgnt, tx, rx */
+	RTW_DISPR_LAT_ROLE,	/* role modules: mrc, sound */
+	RTW_DISPR_LAT_MDRY,	/* mandatory modules: power mgnt, ser */
+	RTW_DISPR_LAT_OPT,	/* optional modules: btc, led, general ... */
+	RTW_DISPR_LAT_FG,	/* cmd token owners: scan, connect, ap start ... */
+	RTW_DISPR_LAT_CLS_NUM
+};
+
+/* <100us, <500us, <1ms, <5ms, <10ms, <50ms, <100ms, >=100ms */
+#define RTW_DISPR_LAT_BKT_NUM 8
+
+/**
+ * struct rtw_dispr_stat - cmd dispatcher batching and latency counters
+ * @batch: wakeups that dispatched at least one msg
+ * @msg: msgs taken from the wait queue
+ * @batch_max: most msgs dispatched in one wakeup
+ * @sub_rebuild: rebuilds of the module subscriber list
+ * @lat_cnt: completed msgs per sender class
+ * @lat_us_max: worst enqueue to completion latency per sender class
+ * @lat_hist: enqueue to completion latency histogram per sender class
+ */
+struct rtw_dispr_stat {
+	u32 batch;
+	u32 msg;
+	u32 batch_max;
+	u32 sub_rebuild;
+	u32 lat_cnt[RTW_DISPR_LAT_CLS_NUM];
+	u32 lat_us_max[RTW_DISPR_LAT_CLS_NUM];
+	u32 lat_hist[RTW_DISPR_LAT_CLS_NUM][RTW_DISPR_LAT_BKT_NUM];
+};
+#endif /* CONFIG_PHL_CMD_DISP_BATCH */
+
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+/**
+ * struct rtw_msg_recv_stat - msg hub counters of one receiver layer
+ * @depth: msgs pending now
+ * @depth_max: most msgs pending at once
+ * @msg: msgs delivered
+ * @coal: payload free tx/rx events merged into an identical pending one
+ * @batch: wakeups that delivered at least one msg
+ * @batch_max: most msgs delivered in one wakeup
+ */
+struct rtw_msg_recv_stat {
+	u32 depth;
+	u32 depth_max;
+	u32 msg;
+	u32 coal;
+	u32 batch;
+	u32 batch_max;
+};
+
+/**
+ * struct rtw_msg_hub_stat - msg hub queue counters
+ * @send: msgs accepted by phl_msg_hub_send
+ * @drop: msgs refused, no idle msg left
+ * @idle: idle msgs now
+ */
+struct rtw_msg_hub_stat {
+	u32 send;
+	u32 drop;
+	u32 idle;
+	struct rtw_msg_recv_stat recv[MSG_RECV_MAX];
+};
+#endif /* CONFIG_PHL_MSG_HUB_RECV_Q */
+
+#ifdef CONFIG_PHL_PS_PREDICT
+/**
+ * struct rtw_ps_pred_stat - traffic predictive lps counters
+ * @en: prediction enabled, lps entry only follows the period check otherwise
+ * @enter: lps entries
+ * @wake: lps leaves
+ * @tx_wake: rpwm wakeups for tx that stayed in lps
+ * @ps_ms: time spent in lps
+ * @sup_burst: entries held off, the link is still inside a packet burst
+ * @sup_periodic: entries held off, periodic traffic closer than the wake cost
+ * @wake_cost_us: average lps enter plus leave duration
+ * @lat_cnt: datapath wake requests served
+ * @lat_us_sum: time from datapath wake request to power on, summed
+ * @lat_us_max: worst time from datapath wake request to power on
+ */
+struct rtw_ps_pred_stat {
+	u8 en;
+	u32 enter;
+	u32 wake;
+	u32 tx_wake;
+	u32 ps_ms;
+	u32 sup_burst;
+	u32 sup_periodic;
+	u32 wake_cost_us;
+	u32 lat_cnt;
+	u64 lat_us_sum;
+	u32 lat_us_max;
+};
+#endif /* CONFIG_PHL_PS_PREDICT */
+
+#ifdef CONFIG_PHL_SER_FAST_L1
+enum rtw_ser_l1_stg {
+	RTW_SER_L1_STG_PAUSE,	/* M1: pause and reset sw trx, pause hw trx */
+	RTW_SER_L1_STG_M3,	/* M2 sent, waiting for M3 */
+	RTW_SER_L1_STG_RESET,	/* M3: reset and resume hw trx, resume sw rx */
+	RTW_SER_L1_STG_M5,	/* M4 sent, waiting for M5 */
+	RTW_SER_L1_STG_RESUME,	/* M5: requeue held tx, resume sw tx */
+	RTW_SER_L1_STG_NUM
+};
+
+/**
+ * struct rtw_ser_l1_stat - L1 SER recovery counters
+ * @done: recoveries that reached M5
+ * @fail: recoveries escalated to L2
+ * @requeue: in-flight tx requests requeued after the dma reset
+ * @drop: in-flight tx requests dropped, no tx ring room left to requeue
+ * @total_us_last: M1 to tx resume of the last recovery
+ * @total_us_max: worst M1 to tx resume
+ * @stg_us_last: per stage duration of the last recovery
+ * @stg_us_max: worst per stage duration
+ * @stg_us_sum: per stage duration, summed over all recoveries
+ */
+struct rtw_ser_l1_stat {
+	u32 done;
+	u32 fail;
+	u32 requeue;
+	u32 drop;
+	u32 total_us_last;
+	u32 total_us_max;
+	u32 stg_us_last[RTW_SER_L1_STG_NUM];
+	u32 stg_us_max[RTW_SER_L1_STG_NUM];
+	u64 stg_us_sum[RTW_SER_L1_STG_NUM];
+};
+#endif /* CONFIG_PHL_SER_FAST_L1 */
+
 #endif	/* __PHL_TRX_DEF_H_ */
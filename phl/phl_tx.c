@@ -200,12 +200,41 @@ phl_tx_traffic_upd(struct rtw_stats *sts)
 	}
 }
 
+#ifdef CONFIG_PHL_PS_PREDICT
+void phl_update_pkt_gap(struct rtw_stats *stats, u32 cur_time)
+{
+	u32 gap = 0, avg = 0;
+
+	if (stats->last_pkt_time_ms) {
+		gap = cur_time - stats->last_pkt_time_ms;
+		if (gap > PHL_PKT_GAP_MAX_MS) {
+			stats->pkt_gap_avg_x8 = 0;
+			stats->pkt_gap_dev_x8 = 0;
+			stats->pkt_gap_cnt = 0;
+		} else {
+			avg = stats->pkt_gap_avg_x8 >> 3;
+			stats->pkt_gap_dev_x8 = stats->pkt_gap_dev_x8 -
+				(stats->pkt_gap_dev_x8 >> 3) +
+				((gap > avg) ? (gap - avg) : (avg - gap));
+			stats->pkt_gap_avg_x8 = stats->pkt_gap_avg_x8 -
+				(stats->pkt_gap_avg_x8 >> 3) + gap;
+			if (stats->pkt_gap_cnt < 0xFFFF)
+				stats->pkt_gap_cnt++;
+		}
+	}
+	stats->last_pkt_time_ms = cur_time;
+}
+#endif
+
 void phl_update_tx_stats(struct rtw_stats *stats, struct rtw_xmit_req *tx_req)
 {
 	u32 diff_t = 0, cur_time = _os_get_cur_time_ms();
 	u64 diff_bits = 0;
 
 	stats->last_tx_time_ms = cur_time;
+#ifdef CONFIG_PHL_PS_PREDICT
+	phl_update_pkt_gap(stats, cur_time);
+#endif
 	stats->tx_byte_total += tx_req->total_len;
 
 	stats->txreq_num++;
@@ -664,6 +693,264 @@ u8 phl_check_xmit_ring_resource(struct phl_info_t *phl_info, _os_list *sta_list)
 		return true;
 }
 
+#ifdef CONFIG_PHL_TX_ATF
+/* 1SS 20MHz long GI phy rate in 100kbps */
+static const u16 _atf_legacy_rate[] = {
+	10, 20, 55, 110, 60, 90, 120, 180, 240, 360, 480, 540
+};
+static const u16 _atf_ht_vht_rate[] = {
+	65, 130, 195, 260, 390, 520, 585, 650, 780, 867
+};
+static const u16 _atf_he_rate[] = {
+	86, 172, 258, 344, 516, 688, 774, 860, 1032, 1147, 1290, 1434
+};
+/* bandwidth scaling from 20MHz, in quarters */
+static const u8 _atf_bw_x4[] = {4, 8, 17, 34};
+
+static u32 _phl_tx_atf_rate(struct rtw_rate_info *rt)
+{
+	u8 nss = 1, mcs = 0;
+	u32 rate = 0;
+
+	switch (rt->mode) {
+	case HAL_LEGACY_MODE:
+		if (rt->mcs_ss_idx < ARRAY_SIZE(_atf_legacy_rate))
+			return _atf_legacy_rate[rt->mcs_ss_idx];
+		return 0;
+	case HAL_HT_MODE:
+		nss = (rt->mcs_ss_idx >> 3) + 1;
+		mcs = rt->mcs_ss_idx & 0x7;
+		rate = _atf_ht_vht_rate[mcs];
+		break;
+	case HAL_VHT_MODE:
+		nss = ((rt->mcs_ss_idx & 0x70) >> 4) + 1;
+		mcs = rt->mcs_ss_idx & 0x0F;
+		if (mcs >= ARRAY_SIZE(_atf_ht_vht_rate))
+			mcs = ARRAY_SIZE(_atf_ht_vht_rate) - 1;
+		rate = _atf_ht_vht_rate[mcs];
+		break;
+	case HAL_HE_MODE:
+		nss = ((rt->mcs_ss_idx & 0x70) >> 4) + 1;
+		mcs = rt->mcs_ss_idx & 0x0F;
+		if (mcs >= ARRAY_SIZE(_atf_he_rate))
+			mcs = ARRAY_SIZE(_atf_he_rate) - 1;
+		rate = _atf_he_rate[mcs];
+		break;
+	default:
+		return 0;
+	}
+
+	return rate * nss * _atf_bw_x4[rt->bw & 0x3] / 4;
+}
+
+/* refresh the rate and aggregation the airtime estimate is based on */
+static void _phl_tx_atf_watchdog(struct phl_info_t *phl_info)
+{
+	void *drvpriv = phl_to_drvpriv(phl_info);
+	struct rtw_phl_tring_list *tring_list = NULL;
+	struct rtw_phl_stainfo_t *sta = NULL;
+	struct phl_atf_sta *atf = NULL;
+
+	_os_spinlock(drvpriv, &phl_info->t_ring_list_lock, _bh, NULL);
+	phl_list_for_loop(tring_list, struct rtw_phl_tring_list,
+			  &phl_info->t_ring_list, list) {
+		atf = &tring_list->atf;
+		atf->airtime_intvl = atf->airtime_cur;
+		atf->airtime_cur = 0;
+
+		sta = rtw_phl_get_stainfo_by_macid(phl_info, tring_list->macid);
+		if (NULL == sta || NULL == sta->hal_sta)
+			continue;
+		atf->rate = _phl_tx_atf_rate(&sta->hal_sta->ra_info.rpt_rt_i);
+		if (HAL_LEGACY_MODE == sta->hal_sta->ra_info.rpt_rt_i.mode)
+			atf->ampdu = 1;
+		else
+			atf->ampdu = sta->asoc_cap.num_ampdu ?
+				     sta->asoc_cap.num_ampdu : 1;
+	}
+	_os_spinunlock(drvpriv, &phl_info->t_ring_list_lock, _bh, NULL);
+}
+
+static u32 _phl_tx_atf_cost(struct phl_atf_sta *atf, u32 len)
+{
+	u32 rate = atf->rate ? atf->rate : PHL_ATF_DEF_RATE;
+	u16 ampdu = atf->ampdu ? atf->ampdu : 1;
+
+	/* len * 8 bits over rate / 10 bits per us */
+	return len * 80 / rate + PHL_ATF_PPDU_OVH_US / ampdu;
+}
+
+static bool _phl_tx_atf_has_data(struct phl_tx_plan *tx_plan)
+{
+	struct phl_ring_status *ring_sts = NULL;
+
+	phl_list_for_loop(ring_sts, struct phl_ring_status,
+			  &tx_plan->sorted_ring, list) {
+		if (ring_sts->ring_ptr->tid < RTW_PHL_RING_CAT_MGNT)
+			return true;
+	}
+
+	return false;
+}
+
+/* trim req_busy to the frames the station can pay for, true if any held */
+static bool _phl_tx_atf_allot(struct phl_info_t *phl_info,
+			      struct phl_atf_sta *atf,
+			      struct phl_ring_status *ring_sts)
+{
+	struct rtw_phl_tx_ring *ring = ring_sts->ring_ptr;
+	struct rtw_xmit_req *tx_req = NULL;
+	u32 cost = 0;
+	u16 idx = 0, n = 0;
+
+	idx = (u16)_os_atomic_read(phl_to_drvpriv(phl_info), &ring->phl_next_idx);
+	while (n < ring_sts->req_busy && atf->deficit > 0) {
+		tx_req = (struct rtw_xmit_req *)ring->entry[idx];
+		if (NULL == tx_req)
+			break;
+		cost = _phl_tx_atf_cost(atf, tx_req->total_len);
+		atf->deficit -= (s32)cost;
+		atf->airtime += cost;
+		atf->airtime_cur += cost;
+		n++;
+		idx = (idx + 1 >= MAX_PHL_RING_ENTRY_NUM) ? 0 : idx + 1;
+	}
+
+	if (n == ring_sts->req_busy)
+		return false;
+
+	ring_sts->req_busy = n;
+	return true;
+}
+
+/*
+ * Airtime deficit round robin over the stations with data frames: every
+ * round a backlogged station may send while it has airtime credit, and
+ * each frame is charged its estimated airtime. When no backlogged station
+ * has credit left all of them get the same number of quanta, so a slow
+ * station gets the same airtime as a fast one instead of the same number
+ * of frames. Management and hiq rings are never held. The deficit state
+ * is shared with _phl_tx_atf_watchdog, both run under t_ring_list_lock.
+ * Returns true if any station had frames held back in its ring.
+ */
+static bool _phl_tx_atf_plan(struct phl_info_t *phl_info, _os_list *sta_list)
+{
+	void *drvpriv = phl_to_drvpriv(phl_info);
+	struct phl_tx_atf *tx_atf = &phl_info->tx_atf;
+	struct rtw_phl_tring_list *tring_list = NULL;
+	struct phl_tx_plan *tx_plan = NULL;
+	struct phl_ring_status *ring_sts = NULL, *ts = NULL;
+	struct phl_atf_sta *atf = NULL;
+	s32 max_deficit = 0;
+	u32 topup = 0;
+	bool has_data = false, held = false, held_any = false;
+
+	_os_spinlock(drvpriv, &phl_info->t_ring_list_lock, _bh, NULL);
+	phl_list_for_loop(tx_plan, struct phl_tx_plan, sta_list, list) {
+		if (true == tx_plan->sleep || !_phl_tx_atf_has_data(tx_plan))
+			continue;
+		tring_list = phl_container_of(tx_plan, struct rtw_phl_tring_list,
+					      tx_plan);
+		if (!has_data || tring_list->atf.deficit > max_deficit)
+			max_deficit = tring_list->atf.deficit;
+		has_data = true;
+	}
+
+	if (!has_data)
+		goto out;
+	tx_atf->round_cnt++;
+
+	if (max_deficit <= 0)
+		topup = ((u32)(-max_deficit) / tx_atf->quantum + 1) *
+			tx_atf->quantum;
+
+	phl_list_for_loop(tx_plan, struct phl_tx_plan, sta_list, list) {
+		if (true == tx_plan->sleep || !_phl_tx_atf_has_data(tx_plan))
+			continue;
+		tring_list = phl_container_of(tx_plan, struct rtw_phl_tring_list,
+					      tx_plan);
+		atf = &tring_list->atf;
+		atf->deficit += (s32)topup;
+
+		held = false;
+		phl_list_for_loop_safe(ring_sts, ts, struct phl_ring_status,
+				       &tx_plan->sorted_ring, list) {
+			if (ring_sts->ring_ptr->tid >= RTW_PHL_RING_CAT_MGNT)
+				continue;
+			if (_phl_tx_atf_allot(phl_info, atf, ring_sts))
+				held = true;
+			if (0 == ring_sts->req_busy) {
+				list_del(&ring_sts->list);
+				phl_release_ring_sts(phl_info, ring_sts);
+			}
+		}
+
+		if (held) {
+			atf->held_cnt++;
+			held_any = true;
+		} else if (atf->deficit > 0)
+			atf->deficit = 0; /* drained, credit is not banked */
+	}
+out:
+	_os_spinunlock(drvpriv, &phl_info->t_ring_list_lock, _bh, NULL);
+
+	return held_any;
+}
+
+void rtw_phl_tx_atf_cfg(void *phl, bool en, u32 quantum)
+{
+	struct phl_info_t *phl_info = (struct phl_info_t *)phl;
+
+	phl_info->tx_atf.en = en;
+	if (quantum)
+		phl_info->tx_atf.quantum = quantum;
+}
+
+void rtw_phl_tx_atf_get_cfg(void *phl, struct phl_tx_atf *cfg)
+{
+	struct phl_info_t *phl_info = (struct phl_info_t *)phl;
+
+	_os_mem_cpy(phl_to_drvpriv(phl_info), cfg, &phl_info->tx_atf,
+		    sizeof(*cfg));
+}
+
+/* fill up to num entries, one per macid ring list, return the count */
+u16 rtw_phl_tx_atf_get_sta_stats(void *phl, struct rtw_atf_sta_stats *stats,
+				 u16 num)
+{
+	struct phl_info_t *phl_info = (struct phl_info_t *)phl;
+	void *drvpriv = phl_to_drvpriv(phl_info);
+	struct rtw_phl_tring_list *tring_list = NULL;
+	struct phl_atf_sta *atf = NULL;
+	u64 total = 0;
+	u16 cnt = 0;
+
+	_os_spinlock(drvpriv, &phl_info->t_ring_list_lock, _bh, NULL);
+	phl_list_for_loop(tring_list, struct rtw_phl_tring_list,
+			  &phl_info->t_ring_list, list)
+		total += tring_list->atf.airtime_intvl;
+
+	phl_list_for_loop(tring_list, struct rtw_phl_tring_list,
+			  &phl_info->t_ring_list, list) {
+		if (cnt >= num)
+			break;
+		atf = &tring_list->atf;
+		stats[cnt].macid = tring_list->macid;
+		stats[cnt].rate = atf->rate;
+		stats[cnt].ampdu = atf->ampdu;
+		stats[cnt].deficit = atf->deficit;
+		stats[cnt].airtime = atf->airtime;
+		stats[cnt].share = total ?
+			(u32)_os_division64((u64)atf->airtime_intvl * 100, total) : 0;
+		stats[cnt].held_cnt = atf->held_cnt;
+		cnt++;
+	}
+	_os_spinunlock(drvpriv, &phl_info->t_ring_list_lock, _bh, NULL);
+
+	return cnt;
+}
+#endif /* CONFIG_PHL_TX_ATF */
+
 void phl_tx_flow_ctrl(struct phl_info_t *phl_info, _os_list *sta_list)
 {
 	_os_list *t_fctrl_result = &phl_info->t_fctrl_result;
@@ -675,6 +962,19 @@ void phl_tx_flow_ctrl(struct phl_info_t *phl_info, _os_list *sta_list)
 	_os_mem_set(phl_to_drvpriv(phl_info), tid_entry, 0,
 		    sizeof(_os_list *) * MAX_PHL_RING_CAT_NUM);
 
+#ifdef CONFIG_PHL_TX_ATF
+	/*
+	 * held frames stay in the ring after phl_check_xmit_ring_resource
+	 * cleared phl_sw_tx_more, run the handler again to send them on
+	 * the next round instead of waiting for new tx
+	 */
+	if (phl_info->tx_atf.en && _phl_tx_atf_plan(phl_info, sta_list)) {
+		_os_atomic_set(phl_to_drvpriv(phl_info),
+			       &phl_info->phl_sw_tx_more, 1);
+		rtw_phl_tx_req_notify(phl_info);
+	}
+#endif
+
 	phl_list_for_loop_safe(tx_plan, tp, struct phl_tx_plan, sta_list,
 			       list) {
 		/* drop power saving station */
@@ -1244,6 +1544,10 @@ phl_trx_free_sw_rsc(void *phl)
 	_os_spinlock_free(drv_priv, &phl_info->rx_ring_lock);
 	_os_spinlock_free(drv_priv, &phl_info->t_fctrl_result_lock);
 	_os_spinlock_free(drv_priv, &phl_info->t_ring_free_list_lock);
+#ifdef CONFIG_PHL_SER_FAST_L1
+	_os_event_free(drv_priv, &phl_info->tx_pause_evt);
+	_os_event_free(drv_priv, &phl_info->rx_pause_evt);
+#endif
 
 	FUNCOUT();
 }
@@ -1294,10 +1598,19 @@ enum rtw_phl_status phl_datapath_init(struct phl_info_t *phl_info)
 		INIT_LIST_HEAD(&phl_info->t_ring_list);
 		INIT_LIST_HEAD(&phl_info->t_fctrl_result);
 		INIT_LIST_HEAD(&phl_info->t_ring_free_list);
+#ifdef CONFIG_PHL_TX_ATF
+		phl_info->tx_atf.en = true;
+		phl_info->tx_atf.quantum = PHL_ATF_DEF_QUANTUM_US;
+#endif
 		_os_spinlock_init(drv_priv, &phl_info->t_ring_list_lock);
 		_os_spinlock_init(drv_priv, &phl_info->rx_ring_lock);
 		_os_spinlock_init(drv_priv, &phl_info->t_fctrl_result_lock);
 		_os_spinlock_init(drv_priv, &phl_info->t_ring_free_list_lock);
+#ifdef CONFIG_PHL_SER_FAST_L1
+		/* set by the hci tx/rx stop, also on ecsa and wow stop paths */
+		_os_event_init(drv_priv, &phl_info->tx_pause_evt);
+		_os_event_init(drv_priv, &phl_info->rx_pause_evt);
+#endif
 
 #ifdef CONFIG_PHL_CPU_BALANCE_RX
 		event_handler->type = RTW_PHL_HANDLER_PRIO_LOW;
@@ -1403,6 +1716,10 @@ static void _phl_datapath_req_pwr(struct phl_info_t *phl_info, u8 type)
 		_os_atomic_set(phl_to_drvpriv(phl_info),
 		               &phl_info->phl_sw_rx_req_pwr,
 		               1);
+#ifdef CONFIG_PHL_PS_PREDICT
+	if (phl_info->ps_info.wake_req_t == 0)
+		phl_info->ps_info.wake_req_t = _os_get_cur_time_us();
+#endif
 
 	psts = phl_disp_eng_send_msg(phl_info, &msg, &attr, NULL);
 	if (RTW_PHL_STATUS_SUCCESS != psts) {
@@ -1488,6 +1805,25 @@ void rtw_phl_tx_resume(void *phl)
 	hci_trx_ops->trx_resume(phl_info, PHL_CTRL_TX);
 }
 
+void rtw_phl_get_wd_tmpl_stats(void *phl, struct rtw_wd_tmpl_stats *stats)
+{
+	struct phl_info_t *phl_info = (struct phl_info_t *)phl;
+
+	rtw_hal_get_wd_tmpl_stats(phl_info->hal, stats);
+}
+
+enum rtw_phl_status rtw_phl_upd_shcut_mhdr(void *phl, u16 macid,
+					   u8 *hdr, u8 hdr_len)
+{
+	struct phl_info_t *phl_info = (struct phl_info_t *)phl;
+
+	if (RTW_HAL_STATUS_SUCCESS !=
+	    rtw_hal_upd_shcut_mhdr(phl_info->hal, macid, hdr, hdr_len))
+		return RTW_PHL_STATUS_FAILURE;
+
+	return RTW_PHL_STATUS_SUCCESS;
+}
+
 
 enum rtw_phl_status rtw_phl_tx_req_notify(void *phl)
 {
@@ -1557,6 +1893,56 @@ enum rtw_phl_status rtw_phl_add_tx_req(void *phl,
 	return pstatus;
 }
 
+#ifdef CONFIG_PHL_SER_FAST_L1
+/**
+ * phl_tx_requeue_req_head - put a tx request back in front of its ring
+ * @phl_info: see struct phl_info_t
+ * @tx_req: a tx request taken from this ring earlier
+ *
+ * Only called while sw tx is paused, so phl_idx is not moving. The request
+ * goes before every frame the core queued meanwhile; requeue several
+ * requests of a ring newest first to keep their order.
+ */
+enum rtw_phl_status phl_tx_requeue_req_head(struct phl_info_t *phl_info,
+					    struct rtw_xmit_req *tx_req)
+{
+	enum rtw_phl_status pstatus = RTW_PHL_STATUS_FAILURE;
+	struct rtw_phl_tring_list *tring_list = NULL;
+	struct rtw_phl_tx_ring *ring = NULL;
+	void *drv_priv = phl_to_drvpriv(phl_info);
+	u16 rptr = 0;
+
+	_os_spinlock(drv_priv, &phl_info->t_ring_list_lock, _bh, NULL);
+
+	phl_list_for_loop(tring_list, struct rtw_phl_tring_list,
+			  &phl_info->t_ring_list, list) {
+		if (tx_req->mdata.macid == tring_list->macid) {
+			ring = &tring_list->phl_ring[tx_req->mdata.tid];
+			break;
+		}
+	}
+
+	if (NULL != ring) {
+		rptr = (u16)_os_atomic_read(drv_priv, &ring->phl_idx);
+		if (phl_calc_avail_wptr(rptr, ring->core_idx,
+					MAX_PHL_RING_ENTRY_NUM) > 0) {
+			/* phl_idx is the last consumed entry, free to reuse */
+			ring->entry[rptr] = (u8 *)tx_req;
+			rptr = (0 == rptr) ? MAX_PHL_RING_ENTRY_NUM - 1 : rptr - 1;
+			_os_atomic_set(drv_priv, &ring->phl_idx, rptr);
+			_os_atomic_set(drv_priv, &phl_info->phl_sw_tx_more, 1);
+			pstatus = RTW_PHL_STATUS_SUCCESS;
+		} else {
+			pstatus = RTW_PHL_STATUS_RESOURCE;
+		}
+	}
+
+	_os_spinunlock(drv_priv, &phl_info->t_ring_list_lock, _bh, NULL);
+
+	return pstatus;
+}
+#endif /* CONFIG_PHL_SER_FAST_L1 */
+
 u16 rtw_phl_tring_rsc(void *phl, u16 macid, u8 tid)
 {
 	struct rtw_phl_tring_list *tring_list, *t;
@@ -1691,6 +2077,9 @@ phl_tx_watchdog(struct phl_info_t *phl_info)
 	struct rtw_stats *phl_stats = &phl_info->phl_com->phl_stats;
 
 	phl_tx_traffic_upd(phl_stats);
+#ifdef CONFIG_PHL_TX_ATF
+	_phl_tx_atf_watchdog(phl_info);
+#endif
 	trx_ops->tx_watchdog(phl_info);
 }
 
@@ -1815,6 +2204,10 @@ _phl_sw_tx_pause(struct phl_info_t *phl_info,
 		return sts;
 	}
 
+#ifdef CONFIG_PHL_SER_FAST_L1
+	/* drop a set left by an earlier stop, e.g. ecsa or wow precfg */
+	_os_event_reset(drv, &phl_info->tx_pause_evt);
+#endif
 	/* requset sw tx to stop */
 	ops->req_tx_stop(phl_info);
 
@@ -1829,7 +2222,13 @@ _phl_sw_tx_pause(struct phl_info_t *phl_info,
 				sts = RTW_PHL_STATUS_SUCCESS;
 				break;
 			}
+#ifdef CONFIG_PHL_SER_FAST_L1
+			/* tx thread signals once it has paused itself */
+			_os_event_wait(drv, &phl_info->tx_pause_evt,
+				       POLL_SW_TX_PAUSE_MS);
+#else
 			_os_sleep_ms(drv, POLL_SW_TX_PAUSE_MS);
+#endif
 		}
 
 		if (RTW_PHL_STATUS_SUCCESS != sts) {
@@ -1947,6 +2346,9 @@ _phl_sw_rx_pause(struct phl_info_t *phl_info,
 		return sts;
 	}
 
+#ifdef CONFIG_PHL_SER_FAST_L1
+	_os_event_reset(drv, &phl_info->rx_pause_evt);
+#endif
 	/* requset sw rx to stop */
 	ops->req_rx_stop(phl_info);
 
@@ -1961,7 +2363,13 @@ _phl_sw_rx_pause(struct phl_info_t *phl_info,
 				sts = RTW_PHL_STATUS_SUCCESS;
 				break;
 			}
+#ifdef CONFIG_PHL_SER_FAST_L1
+			/* rx process signals once it has paused itself */
+			_os_event_wait(drv, &phl_info->rx_pause_evt,
+				       POLL_SW_RX_PAUSE_MS);
+#else
 			_os_sleep_ms(drv, POLL_SW_RX_PAUSE_MS);
+#endif
 		}
 
 		if (RTW_PHL_STATUS_SUCCESS != sts) {
@@ -2195,6 +2603,13 @@ phl_data_ctrler(struct phl_info_t *phl_info, struct phl_data_ctl_t *ctl,
 		_phl_sw_tx_rst(phl_info);
 		sts = RTW_PHL_STATUS_SUCCESS;
 		break;
+#ifdef CONFIG_PHL_SER_FAST_L1
+	case PHL_DATA_CTL_SW_TX_RESET_KEEP:
+		phl_info->hci_trx_ops->trx_reset(phl_info,
+						 PHL_CTRL_TX | PHL_CTRL_TX_KEEP);
+		sts = RTW_PHL_STATUS_SUCCESS;
+		break;
+#endif
 	case PHL_DATA_CTL_SW_RX_RESET:
 		_phl_sw_rx_rst(phl_info);
 		sts = RTW_PHL_STATUS_SUCCESS;
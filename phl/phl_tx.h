@@ -31,6 +31,10 @@ void phl_release_ring_sts(struct phl_info_t *phl_info,
 u8 phl_check_xmit_ring_resource(struct phl_info_t *phl_info,
 				_os_list *sta_list);
 void phl_tx_flow_ctrl(struct phl_info_t *phl_info, _os_list *sta_list);
+#ifdef CONFIG_PHL_SER_FAST_L1
+enum rtw_phl_status phl_tx_requeue_req_head(struct phl_info_t *phl_info,
+					    struct rtw_xmit_req *tx_req);
+#endif
 enum rtw_phl_status rtw_phl_tx_req_notify(void *phl);
 enum rtw_phl_status phl_register_handler(struct rtw_phl_com_t *phl_com,
 				struct rtw_phl_handler *handler);
@@ -76,6 +80,11 @@ void phl_dump_tx_plan(_os_list *sta_list);
 void phl_dump_t_fctrl_result(_os_list *t_fctrl_result);
 const char *phl_tfc_lvl_to_str(u8 lvl);
 void phl_tx_traffic_upd(struct rtw_stats *sts);
+#ifdef CONFIG_PHL_PS_PREDICT
+/* gaps longer than this end a flow, the gap estimate restarts */
+#define PHL_PKT_GAP_MAX_MS 1000
+void phl_update_pkt_gap(struct rtw_stats *stats, u32 cur_time);
+#endif
 void phl_tx_watchdog(struct phl_info_t *phl_info);
 void phl_reset_tx_stats(struct rtw_stats *stats);
 void phl_dump_h2c_pool_stats(struct phl_h2c_pkt_pool *h2c_pkt_pool);
@@ -1030,6 +1030,10 @@ static enum rtw_phl_status _init_postcfg_set_rxfltr(struct phl_info_t *phl_info)
 			PHL_ERR("[wow] set rx filter ctrl to host fail, status(%u)\n", hstatus);
 			break;
 		}
+#ifdef CONFIG_PHL_RX_CLS
+		/* the type filters above overwrite the classification */
+		rtw_hal_rx_cls_restore(phl_info->hal, 0);
+#endif
 	} while (0);
 
 	return (hstatus == RTW_HAL_STATUS_SUCCESS) ?
@@ -537,7 +537,11 @@ static __inline void _os_event_free(void *h, _os_event *event)
 
 static __inline void _os_event_reset(void *h, _os_event *event)
 {
-	/* TODO */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(3, 13, 0)
+	reinit_completion(event);
+#else
+	INIT_COMPLETION(*event);
+#endif
 }
 
 static __inline void _os_event_set(void *h, _os_event *event)
@@ -751,6 +755,12 @@ static inline int _os_thread_wait_stop(void *drv_priv, _os_thread *thread)
 	rtw_thread_wait_stop();
 	return RTW_PHL_STATUS_SUCCESS;
 }
+/* cpu_id < 0 leaves the thread to the scheduler */
+static inline void _os_thread_config_cpu(void *drv_priv, _os_thread *thread, s8 cpu_id)
+{
+	if (cpu_id >= 0 && thread->thread_handler)
+		rtw_thread_set_cpu(thread->thread_handler, cpu_id);
+}
 
 #if 0
 static inline _os_thread _os_thread_start(int (*threadfn)(void *data),
@@ -377,6 +377,9 @@ static inline int _os_thread_wait_stop(void *drv_priv, _os_thread *thread)
 {
 	return RTW_PHL_STATUS_SUCCESS;
 }
+static inline void _os_thread_config_cpu(void *drv_priv, _os_thread *thread, s8 cpu_id)
+{
+}
 
 #if 0 /* TODO */
 static inline _os_thread _os_thread_start(int (*threadfn)(void *data),
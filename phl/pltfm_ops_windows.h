@@ -532,6 +532,9 @@ static inline int _os_thread_wait_stop(void *drv_priv, _os_thread *thread)
 {
 	return RTW_PHL_STATUS_SUCCESS;
 }
+static inline void _os_thread_config_cpu(void *drv_priv, _os_thread *thread, s8 cpu_id)
+{
+}
 
 /* Workitem */
 static __inline u8 _os_workitem_init(void *drv_priv, _os_workitem *workitem, void (*call_back_func)(void* context), void *context)
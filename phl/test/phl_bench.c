@@ -0,0 +1,380 @@
+/******************************************************************************
+ *
+ * Copyright(c) 2019 Realtek Corporation.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of version 2 of the GNU General Public License as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ *****************************************************************************/
+#define _PHL_BENCH_C_
+#include "../phl_headers.h"
+
+/*
+ * Micro-benchmarks of the PHL/HAL per-packet paths, run in the module
+ * against the real HAL through "phl bench" (test suite builds only).
+ *
+ * Covered: hal_update_wd WD packing (wd), _hal_parsing_rx_wd rx desc
+ * parsing (rxd), phl sta lookup by address (sta) and phl_rx_reorder (reorder),
+ * reported as ns/op and compared against a baseline kept with "bench save"
+ * or loaded from a stored JSON result with "bench base".
+ *
+ * Deliberately out of scope:
+ * - a userspace build with an osdep shim, CI runs and perf_event cache-miss
+ *   counts, the driver has no userspace build to host them;
+ * - txsc/rxsc, rtw_get_stainfo, sw ccmp/gcmp, NAT25 and rtw_find_network,
+ *   they live in core and are not reachable from phl.
+ */
+
+#ifdef CONFIG_PHL_TEST_SUITE
+
+#define BENCH_WD_PAGE_SIZE 128
+#define BENCH_PAYLOAD_SIZE 1500
+#define BENCH_RXD_L_SIZE 32
+#define BENCH_WHDR_LEN 24
+#ifdef CONFIG_PCI_HCI
+#define BENCH_RXBD_INFO_SIZE 4
+#else
+#define BENCH_RXBD_INFO_SIZE 0
+#endif
+#define BENCH_RX_BUF_SIZE (BENCH_RXBD_INFO_SIZE + BENCH_RXD_L_SIZE + \
+			   BENCH_PAYLOAD_SIZE)
+/* tid of the bench ba session, skipped when the sta already has one */
+#define BENCH_REORDER_TID 7
+
+struct phl_bench_case_info {
+	char name[8];
+	u8 id;
+};
+
+static const struct phl_bench_case_info phl_bench_case_i[] = {
+	{"wd", PHL_BENCH_WD},
+	{"rxd", PHL_BENCH_RXD},
+	{"sta", PHL_BENCH_STA},
+	{"reorder", PHL_BENCH_REORDER}
+};
+
+/*
+ * Baseline ns/op, either saved from a previous run with "bench save" or fed
+ * back from a stored JSON result with "bench base <case> <ns_op>".
+ */
+static u32 phl_bench_base[PHL_BENCH_MAX];
+static struct phl_bench_result phl_bench_last[PHL_BENCH_MAX];
+
+static u32 _bench_ns_op(u32 start_us, u32 iter)
+{
+	u32 us = phl_get_passing_time_us(start_us);
+
+	if (0 == iter)
+		return 0;
+
+	return (u32)_os_division64((u64)us * 1000, iter);
+}
+
+static void _bench_wd(struct phl_info_t *phl_info, u32 iter,
+		      struct phl_bench_result *res)
+{
+	void *drv = phl_to_drvpriv(phl_info);
+	struct rtw_xmit_req treq;
+	struct rtw_pkt_buf_list pkt;
+	struct rtw_phl_pkt_req req;
+	u8 *wd_page = NULL, *payload = NULL;
+	u32 start_t = 0, i = 0;
+
+	wd_page = _os_mem_alloc(drv, BENCH_WD_PAGE_SIZE);
+	payload = _os_mem_alloc(drv, BENCH_PAYLOAD_SIZE);
+	if (NULL == wd_page || NULL == payload)
+		goto exit;
+
+	_os_mem_set(drv, &treq, 0, sizeof(treq));
+	_os_mem_set(drv, &pkt, 0, sizeof(pkt));
+	_os_mem_set(drv, payload, 0, BENCH_PAYLOAD_SIZE);
+
+	pkt.vir_addr = payload;
+	pkt.length = BENCH_PAYLOAD_SIZE;
+	treq.pkt_list = (u8 *)&pkt;
+	treq.pkt_cnt = 1;
+	treq.total_len = BENCH_PAYLOAD_SIZE;
+	treq.mdata.pktlen = BENCH_PAYLOAD_SIZE;
+	treq.mdata.addr_info_num = 1;
+	treq.mdata.wdinfo_en = 1;
+	treq.mdata.hdr_len = BENCH_WHDR_LEN;
+	treq.mdata.type = RTW_PHL_PKT_TYPE_DATA;
+
+	start_t = _os_get_cur_time_us();
+	for (i = 0; i < iter; i++) {
+		req.wd_page = wd_page;
+		req.wd_len = 0;
+		req.wp_seq = (u16)(i & 0xFFF);
+		req.tx_req = &treq;
+		treq.mdata.sw_seq = (u16)(i & 0xFFF);
+		treq.mdata.tid = (u8)(i & 0x7);
+		if (RTW_HAL_STATUS_SUCCESS !=
+		    rtw_hal_update_wd_page(phl_info->hal, &req))
+			res->fail++;
+	}
+	res->ns_op = _bench_ns_op(start_t, iter);
+	res->iter = iter;
+
+exit:
+	if (wd_page)
+		_os_mem_free(drv, wd_page, BENCH_WD_PAGE_SIZE);
+	if (payload)
+		_os_mem_free(drv, payload, BENCH_PAYLOAD_SIZE);
+}
+
+static void _bench_rxd(struct phl_info_t *phl_info, u32 iter,
+		       struct phl_bench_result *res)
+{
+	void *drv = phl_to_drvpriv(phl_info);
+	struct rtw_phl_rx_pkt *phl_rx = NULL;
+	u8 *buf = NULL, *rxd = NULL, *hdr = NULL;
+	u32 start_t = 0, i = 0;
+
+	buf = _os_mem_alloc(drv, BENCH_RX_BUF_SIZE);
+	phl_rx = _os_mem_alloc(drv, sizeof(*phl_rx));
+	if (NULL == buf || NULL == phl_rx)
+		goto exit;
+
+	/* long rx desc of a unicast qos data frame, no drv info, no shift */
+	_os_mem_set(drv, buf, 0, BENCH_RX_BUF_SIZE);
+	rxd = buf + BENCH_RXBD_INFO_SIZE;
+	SET_BITS_TO_LE_4BYTE(rxd, 0, 14, BENCH_PAYLOAD_SIZE);
+	SET_BITS_TO_LE_4BYTE(rxd, 31, 1, 1);
+	SET_BITS_TO_LE_4BYTE(rxd + 12, 0, 1, 1);
+	hdr = rxd + BENCH_RXD_L_SIZE;
+	SET_WHDR_TYPE(hdr, 2);
+	SET_WHDR_QOS_EN(hdr, 1);
+
+	start_t = _os_get_cur_time_us();
+	for (i = 0; i < iter; i++) {
+		_os_mem_set(drv, phl_rx, 0, sizeof(*phl_rx));
+		if (RTW_HAL_STATUS_SUCCESS !=
+		    rtw_hal_handle_rx_buffer(phl_info->phl_com, phl_info->hal,
+					     buf, BENCH_RX_BUF_SIZE, phl_rx))
+			res->fail++;
+	}
+	res->ns_op = _bench_ns_op(start_t, iter);
+	res->iter = iter;
+
+exit:
+	if (buf)
+		_os_mem_free(drv, buf, BENCH_RX_BUF_SIZE);
+	if (phl_rx)
+		_os_mem_free(drv, phl_rx, sizeof(*phl_rx));
+}
+
+static void _bench_sta(struct phl_info_t *phl_info, u32 iter,
+		       struct phl_bench_result *res)
+{
+	struct rtw_wifi_role_t *wrole = &phl_info->phl_com->wifi_roles[0];
+	u32 start_t = 0, i = 0;
+
+	start_t = _os_get_cur_time_us();
+	for (i = 0; i < iter; i++) {
+		if (NULL == rtw_phl_get_stainfo_by_addr(phl_info, wrole,
+							wrole->mac_addr))
+			res->fail++;
+	}
+	res->ns_op = _bench_ns_op(start_t, iter);
+	res->iter = iter;
+}
+
+/*
+ * In-order qos data to a private ba session on the primary role's own sta,
+ * every frame takes the lookup and in-window fast path and is returned on
+ * the frames list, nothing is buffered so no reorder timer is armed.
+ */
+static void _bench_reorder(struct phl_info_t *phl_info, u32 iter,
+			   struct phl_bench_result *res)
+{
+	void *drv = phl_to_drvpriv(phl_info);
+	struct rtw_wifi_role_t *wrole = &phl_info->phl_com->wifi_roles[0];
+	struct rtw_phl_stainfo_t *sta = NULL;
+	struct phl_tid_ampdu_rx *r = NULL;
+	struct rtw_phl_rx_pkt *phl_rx = NULL;
+	struct rtw_r_meta_data *meta = NULL;
+	u8 *payload = NULL;
+	_os_list frames;
+	u32 start_t = 0, i = 0;
+
+	sta = rtw_phl_get_stainfo_by_addr(phl_info, wrole, wrole->mac_addr);
+	if (NULL == sta)
+		return;
+
+	payload = _os_mem_alloc(drv, BENCH_PAYLOAD_SIZE);
+	phl_rx = _os_mem_alloc(drv, sizeof(*phl_rx));
+	r = phl_tid_ampdu_rx_alloc(phl_info, sta, 0, 0, BENCH_REORDER_TID,
+				   PHL_MAX_AGG_WSIZE);
+	if (NULL == payload || NULL == phl_rx || NULL == r)
+		goto exit;
+
+	_os_spinlock(drv, &sta->tid_rx_lock, _bh, NULL);
+	if (sta->tid_rx[BENCH_REORDER_TID]) {
+		_os_spinunlock(drv, &sta->tid_rx_lock, _bh, NULL);
+		goto exit;
+	}
+	sta->tid_rx[BENCH_REORDER_TID] = r;
+	_os_spinunlock(drv, &sta->tid_rx_lock, _bh, NULL);
+
+	_os_mem_set(drv, phl_rx, 0, sizeof(*phl_rx));
+	_os_mem_set(drv, payload, 0, BENCH_PAYLOAD_SIZE);
+	meta = &phl_rx->r.mdata;
+	meta->qos = 1;
+	meta->tid = BENCH_REORDER_TID;
+	_os_mem_cpy(drv, meta->mac_addr, wrole->mac_addr, MAC_ALEN);
+	_os_mem_cpy(drv, meta->ta, wrole->mac_addr, MAC_ALEN);
+	phl_rx->r.pkt_cnt = 1;
+	phl_rx->r.pkt_list[0].vir_addr = payload;
+
+	start_t = _os_get_cur_time_us();
+	for (i = 0; i < iter; i++) {
+		INIT_LIST_HEAD(&frames);
+		/* append_fcs trims the length on every pass */
+		phl_rx->r.pkt_list[0].length = BENCH_PAYLOAD_SIZE;
+		meta->seq = (u16)(i & 0xFFF);
+		if (RTW_PHL_STATUS_SUCCESS !=
+		    phl_rx_reorder(phl_info, phl_rx, &frames) ||
+		    list_empty(&frames))
+			res->fail++;
+	}
+	res->ns_op = _bench_ns_op(start_t, iter);
+	res->iter = iter;
+
+	_os_spinlock(drv, &sta->tid_rx_lock, _bh, NULL);
+	sta->tid_rx[BENCH_REORDER_TID] = NULL;
+	_os_spinunlock(drv, &sta->tid_rx_lock, _bh, NULL);
+
+exit:
+	if (r)
+		phl_tid_ampdu_rx_free(r);
+	if (phl_rx)
+		_os_mem_free(drv, phl_rx, sizeof(*phl_rx));
+	if (payload)
+		_os_mem_free(drv, payload, BENCH_PAYLOAD_SIZE);
+}
+
+static void _bench_run(struct phl_info_t *phl_info, u8 id, u32 iter)
+{
+	struct phl_bench_result *res = &phl_bench_last[id];
+
+	_os_mem_set(phl_to_drvpriv(phl_info), res, 0, sizeof(*res));
+
+	switch (id) {
+	case PHL_BENCH_WD:
+		_bench_wd(phl_info, iter, res);
+		break;
+	case PHL_BENCH_RXD:
+		_bench_rxd(phl_info, iter, res);
+		break;
+	case PHL_BENCH_STA:
+		_bench_sta(phl_info, iter, res);
+		break;
+	case PHL_BENCH_REORDER:
+		_bench_reorder(phl_info, iter, res);
+		break;
+	default:
+		break;
+	}
+}
+
+static void _bench_dump(u8 id, u32 *used, char *output, u32 out_len)
+{
+	struct phl_bench_result *res = &phl_bench_last[id];
+	u32 base = phl_bench_base[id];
+	s32 delta = 0;
+
+	if (base)
+		delta = (s32)(((s64)res->ns_op - base) * 100 / base);
+
+	/* one json object per line, so results can be diffed against a baseline */
+	PHL_DBG_MON_INFO(out_len, *used, output + *used, out_len - *used,
+		"{\"case\":\"%s\",\"iter\":%d,\"fail\":%d,\"ns_op\":%d,"
+		"\"base_ns_op\":%d,\"delta_pct\":%d,\"regress\":%d}\n",
+		phl_bench_case_i[id].name, res->iter, res->fail, res->ns_op,
+		base, delta,
+		(base && delta > PHL_BENCH_REGRESS_PCT) ? 1 : 0);
+}
+
+static u8 _bench_get_case(char *name)
+{
+	u8 i = 0;
+
+	for (i = 0; i < PHL_BENCH_MAX; i++) {
+		if (0 == _os_strcmp(name, phl_bench_case_i[i].name))
+			return phl_bench_case_i[i].id;
+	}
+
+	return PHL_BENCH_MAX;
+}
+
+/*
+ * echo phl bench <all|wd|rxd|sta|reorder> [iter]
+ * echo phl bench save
+ * echo phl bench base <case> <ns_op>
+ */
+void phl_bench_cmd_parser(struct phl_info_t *phl_info, char input[][MAX_ARGV],
+			  u32 input_num, char *output, u32 out_len)
+{
+	u32 used = 0;
+	u32 iter = PHL_BENCH_DEF_ITER;
+	u32 val = 0;
+	u8 id = 0;
+
+	if (input_num < 2) {
+		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+			"[DBG] bench <all|wd|rxd|sta|reorder> [iter] | save | base <case> <ns_op>\n");
+		return;
+	}
+
+	if (0 == _os_strcmp(input[1], "save")) {
+		for (id = 0; id < PHL_BENCH_MAX; id++) {
+			if (phl_bench_last[id].iter)
+				phl_bench_base[id] = phl_bench_last[id].ns_op;
+		}
+		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+			"[DBG] bench baseline saved\n");
+		return;
+	}
+
+	if (0 == _os_strcmp(input[1], "base")) {
+		if (input_num < 4)
+			return;
+		id = _bench_get_case(input[2]);
+		if (PHL_BENCH_MAX == id)
+			return;
+		_os_sscanf(input[3], "%d", &val);
+		phl_bench_base[id] = val;
+		return;
+	}
+
+	if (input_num >= 3) {
+		_os_sscanf(input[2], "%d", &iter);
+		if (0 == iter || iter > PHL_BENCH_MAX_ITER)
+			iter = PHL_BENCH_DEF_ITER;
+	}
+
+	if (0 == _os_strcmp(input[1], "all")) {
+		for (id = 0; id < PHL_BENCH_MAX; id++) {
+			_bench_run(phl_info, id, iter);
+			_bench_dump(id, &used, output, out_len);
+		}
+		return;
+	}
+
+	id = _bench_get_case(input[1]);
+	if (PHL_BENCH_MAX == id) {
+		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+			"[DBG] unknown bench case %s\n", input[1]);
+		return;
+	}
+
+	_bench_run(phl_info, id, iter);
+	_bench_dump(id, &used, output, out_len);
+}
+#endif /* CONFIG_PHL_TEST_SUITE */
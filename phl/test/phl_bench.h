@@ -0,0 +1,43 @@
+/******************************************************************************
+ *
+ * Copyright(c) 2019 Realtek Corporation.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of version 2 of the GNU General Public License as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ *****************************************************************************/
+#ifndef _PHL_BENCH_H_
+#define _PHL_BENCH_H_
+
+#ifdef CONFIG_PHL_TEST_SUITE
+
+#define PHL_BENCH_DEF_ITER 10000
+#define PHL_BENCH_MAX_ITER 1000000
+/* ns/op increase over baseline reported as regression, in percent */
+#define PHL_BENCH_REGRESS_PCT 10
+
+enum phl_bench_case {
+	PHL_BENCH_WD,		/* rtw_hal_update_wd_page, wd packing */
+	PHL_BENCH_RXD,		/* rtw_hal_handle_rx_buffer, rx desc parsing */
+	PHL_BENCH_STA,		/* rtw_phl_get_stainfo_by_addr */
+	PHL_BENCH_REORDER,	/* phl_rx_reorder, in-order ba session */
+	PHL_BENCH_MAX
+};
+
+struct phl_bench_result {
+	u32 iter;
+	u32 fail;
+	u32 ns_op;
+};
+
+void phl_bench_cmd_parser(struct phl_info_t *phl_info, char input[][MAX_ARGV],
+			  u32 input_num, char *output, u32 out_len);
+#endif /* CONFIG_PHL_TEST_SUITE */
+
+#endif /* _PHL_BENCH_H_ */
@@ -1080,7 +1080,7 @@ void phl_dbg_trx_stats(struct phl_info_t *phl_info, char input[][MAX_ARGV],
 		"tx request num to phl	: %d\n",
 			 (int)phl_stats->txreq_num);
 
-#ifdef CONFIG_PCI_HCI
+#if defined(CONFIG_PCI_HCI) && !defined(CONFIG_PHL_HCI_SIM)
 	_dbg_tx_stats_pcie(phl_info, input, input_num, output, out_len, &used,
 			   ctrl, ch);
 #endif
@@ -1097,6 +1097,645 @@ void phl_dbg_trx_stats(struct phl_info_t *phl_info, char input[][MAX_ARGV],
 			 (int)phl_stats->last_rx_time_ms);
 }
 
+#ifdef CONFIG_PHL_HCI_SIM
+void phl_dbg_hci_sim(struct phl_info_t *phl_info, char input[][MAX_ARGV],
+		     u32 input_num, char *output, u32 out_len)
+{
+	struct phl_sim_stats stats = {0};
+	struct phl_sim_cfg cfg = {0};
+	u32 used = 0;
+	u32 val[4] = {0};
+	u32 pkt = 0;
+
+	if (input_num >= 2 && 0 == _os_strcmp(input[1], "reset")) {
+		phl_trx_sim_reset_stats(phl_info);
+		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+			"[DBG] hci sim stats reset\n");
+		return;
+	}
+
+	if (input_num >= 5 && 0 == _os_strcmp(input[1], "set")) {
+		_os_sscanf(input[2], "%d", &val[0]);
+		_os_sscanf(input[3], "%d", &val[1]);
+		_os_sscanf(input[4], "%d", &val[2]);
+		if (input_num >= 6)
+			_get_hex_from_string(input[5], &val[3]);
+		cfg.latency_us = val[0];
+		cfg.loss_permil = (u16)val[1];
+		cfg.reorder_permil = (u16)val[2];
+		cfg.seed = val[3];
+		phl_trx_sim_set_cfg(phl_info, &cfg);
+		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+			"[DBG] latency %d us, loss %d, reorder %d (permil)\n",
+			val[0], val[1], val[2]);
+		return;
+	}
+
+	if (input_num >= 2) {
+		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+			"[DBG] hci_sim [reset | set <latency_us> <loss> <reorder> [seed]]\n");
+		return;
+	}
+
+	phl_trx_sim_get_stats(phl_info, &stats);
+
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"\ntx request		: %d\n", stats.tx_req_cnt);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"tx dma			: %d\n", stats.tx_dma_cnt);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"tx loss			: %d\n", stats.tx_loss_cnt);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"tx reorder		: %d\n", stats.tx_reorder_cnt);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"txbd full		: %d\n", stats.tx_full_cnt);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"wp report		: %d\n", stats.wp_rpt_cnt);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"recycle fail		: %d\n", stats.recycle_fail_cnt);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"rx			: %d\n", stats.rx_cnt);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"rx drop			: %d\n", stats.rx_drop_cnt);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"h2c			: %d\n", stats.h2c_cnt);
+
+	pkt = (stats.tx_dma_cnt) ? stats.tx_dma_cnt : 1;
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"tx cpu time		: %llu us (%d ns/pkt)\n", stats.tx_time_us,
+		(u32)_os_division64(stats.tx_time_us * 1000, pkt));
+	pkt = (stats.rx_cnt) ? stats.rx_cnt : 1;
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"rx cpu time		: %llu us (%d ns/pkt)\n", stats.rx_time_us,
+		(u32)_os_division64(stats.rx_time_us * 1000, pkt));
+}
+#endif /* CONFIG_PHL_HCI_SIM */
+
+#ifdef CONFIG_PHL_RX_CLS
+static const char *rx_cls_policy_str[RX_CLS_POLICY_MAX] = {
+	"off", "normal", "strict"
+};
+static const char *rx_cls_type_str[] = {"mgnt", "ctrl", "data"};
+static const char *rx_cls_target_str[] = {"drop", "host", "wlcpu"};
+
+/*
+ * echo phl rx_cls
+ * echo phl rx_cls policy <off|normal|strict>
+ * echo phl rx_cls add <band> <type> <subtype> <0:drop|1:host|2:wlcpu>
+ * echo phl rx_cls del <idx>
+ * echo phl rx_cls reset
+ */
+void phl_dbg_rx_cls(struct phl_info_t *phl_info, char input[][MAX_ARGV],
+		    u32 input_num, char *output, u32 out_len)
+{
+	struct rtw_rx_cls_rule rule = {0};
+	u32 used = 0;
+	u32 val[4] = {0};
+	u32 cnt = 0;
+	u8 band, type, subtype, target, idx = 0;
+
+	if (input_num >= 3 && 0 == _os_strcmp(input[1], "policy")) {
+		for (idx = 0; idx < RX_CLS_POLICY_MAX; idx++) {
+			if (0 == _os_strcmp(input[2], (char *)rx_cls_policy_str[idx]))
+				break;
+		}
+		if (RTW_PHL_STATUS_SUCCESS !=
+		    rtw_phl_rx_cls_set_policy(phl_info,
+					      (enum rtw_rx_cls_policy)idx))
+			PHL_DBG_MON_INFO(out_len, used, output + used,
+				out_len - used, "[DBG] unknown policy %s\n",
+				input[2]);
+		return;
+	}
+
+	if (input_num >= 6 && 0 == _os_strcmp(input[1], "add")) {
+		_os_sscanf(input[2], "%d", &val[0]);
+		_os_sscanf(input[3], "%d", &val[1]);
+		_get_hex_from_string(input[4], &val[2]);
+		_os_sscanf(input[5], "%d", &val[3]);
+		rule.band = (u8)val[0];
+		rule.type = (u8)val[1];
+		rule.subtype = (u8)val[2];
+		rule.target = (u8)val[3];
+		if (RTW_PHL_STATUS_SUCCESS ==
+		    rtw_phl_rx_cls_add_rule(phl_info, &rule, &idx))
+			PHL_DBG_MON_INFO(out_len, used, output + used,
+				out_len - used, "[DBG] rule %d added\n", idx);
+		else
+			PHL_DBG_MON_INFO(out_len, used, output + used,
+				out_len - used, "[DBG] add rule fail\n");
+		return;
+	}
+
+	if (input_num >= 3 && 0 == _os_strcmp(input[1], "del")) {
+		_os_sscanf(input[2], "%d", &val[0]);
+		if (RTW_PHL_STATUS_SUCCESS !=
+		    rtw_phl_rx_cls_del_rule(phl_info, (u8)val[0]))
+			PHL_DBG_MON_INFO(out_len, used, output + used,
+				out_len - used, "[DBG] no rule %d\n", val[0]);
+		return;
+	}
+
+	if (input_num >= 2 && 0 == _os_strcmp(input[1], "reset")) {
+		rtw_hal_rx_cls_reset_cnt(phl_info->hal);
+		return;
+	}
+
+	if (input_num >= 2) {
+		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+			"[DBG] rx_cls [policy <off|normal|strict> | add <band> <type> <subtype> <target> | del <idx> | reset]\n");
+		return;
+	}
+
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"\npolicy: %s\n",
+		rx_cls_policy_str[rtw_hal_rx_cls_get_policy(phl_info->hal)]);
+
+	for (idx = 0; idx < RTW_RX_CLS_RULE_NUM; idx++) {
+		if (!rtw_phl_rx_cls_get_rule(phl_info, idx, &rule))
+			continue;
+		if (RX_CLS_TARGET_DROP == rule.target) {
+			PHL_DBG_MON_INFO(out_len, used, output + used,
+				out_len - used,
+				"rule[%d] band %d %s subtype 0x%x -> %s\n",
+				idx, rule.band, rx_cls_type_str[rule.type],
+				rule.subtype, rx_cls_target_str[rule.target]);
+			continue;
+		}
+		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+			"rule[%d] band %d %s subtype 0x%x -> %s, hit %d\n",
+			idx, rule.band, rx_cls_type_str[rule.type],
+			rule.subtype, rx_cls_target_str[rule.target], rule.hit);
+	}
+
+	/* dropped subtypes and subtypes that reached host */
+	for (band = 0; band < HW_BAND_MAX; band++) {
+		for (type = 0; type < RTW_RX_CLS_TYPE_NUM; type++) {
+			for (subtype = 0; subtype < RTW_RX_CLS_SUBTYPE_NUM;
+			     subtype++) {
+				target = rtw_hal_rx_cls_get_slot(phl_info->hal,
+						band, type, subtype, &cnt);
+				if (RX_CLS_TARGET_HOST == target && 0 == cnt)
+					continue;
+				PHL_DBG_MON_INFO(out_len, used, output + used,
+					out_len - used,
+					"band %d %s subtype 0x%x: %s, ind %d\n",
+					band, rx_cls_type_str[type], subtype,
+					rx_cls_target_str[target], cnt);
+			}
+		}
+	}
+}
+#endif /* CONFIG_PHL_RX_CLS */
+
+#ifdef CONFIG_PHL_DLE_REBAL
+static const char *dle_rebal_prof_str[DLE_REBAL_PROF_MAX] = {
+	"balanced", "tx_heavy", "rx_heavy"
+};
+
+/*
+ * echo phl dle_rebal
+ * echo phl dle_rebal en <0|1>
+ * echo phl dle_rebal prof <balanced|tx_heavy|rx_heavy>, stops the watchdog
+ */
+void phl_dbg_dle_rebal(struct phl_info_t *phl_info, char input[][MAX_ARGV],
+		       u32 input_num, char *output, u32 out_len)
+{
+	struct rtw_dle_rebal_info info = {0};
+	u32 used = 0;
+	u32 val = 0;
+	u8 idx = 0;
+
+	if (input_num >= 3 && 0 == _os_strcmp(input[1], "en")) {
+		_os_sscanf(input[2], "%d", &val);
+		rtw_hal_dle_rebal_set_en(phl_info->hal, val ? true : false);
+		return;
+	}
+
+	if (input_num >= 3 && 0 == _os_strcmp(input[1], "prof")) {
+		for (idx = 0; idx < DLE_REBAL_PROF_MAX; idx++) {
+			if (0 == _os_strcmp(input[2], (char *)dle_rebal_prof_str[idx]))
+				break;
+		}
+		if (DLE_REBAL_PROF_MAX == idx) {
+			PHL_DBG_MON_INFO(out_len, used, output + used,
+				out_len - used, "[DBG] unknown prof %s\n",
+				input[2]);
+			return;
+		}
+		rtw_hal_dle_rebal_set_en(phl_info->hal, false);
+		if (RTW_HAL_STATUS_SUCCESS !=
+		    rtw_hal_dle_rebal_set_prof(phl_info->hal,
+					       (enum rtw_dle_rebal_prof)idx))
+			PHL_DBG_MON_INFO(out_len, used, output + used,
+				out_len - used, "[DBG] set prof fail\n");
+		return;
+	}
+
+	if (input_num >= 2) {
+		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+			"[DBG] dle_rebal [en <0|1> | prof <balanced|tx_heavy|rx_heavy>]\n");
+		return;
+	}
+
+	rtw_hal_dle_rebal_get_info(phl_info->hal, &info);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"\nen %d, prof %s\n", info.en,
+		(info.prof < DLE_REBAL_PROF_MAX) ?
+		dle_rebal_prof_str[info.prof] : "unknown");
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"tx use/max %d/%d, rx use/max %d/%d, pub free %d\n",
+		info.tx_use, info.tx_max, info.rx_use, info.rx_max,
+		info.pub_pgnum);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"sample %d, fail %d, rdu %d\n",
+		info.sample_cnt, info.fail_cnt, info.rdu_cnt);
+	for (idx = 0; idx < DLE_REBAL_PROF_MAX; idx++)
+		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+			"to %s: %d\n", dle_rebal_prof_str[idx],
+			info.chg_cnt[idx]);
+}
+#endif /* CONFIG_PHL_DLE_REBAL */
+
+#ifdef CONFIG_PHL_TX_ATF
+/*
+ * echo phl atf
+ * echo phl atf en <0|1>
+ * echo phl atf quantum <us>
+ */
+void phl_dbg_tx_atf(struct phl_info_t *phl_info, char input[][MAX_ARGV],
+		    u32 input_num, char *output, u32 out_len)
+{
+	void *drv = phl_to_drvpriv(phl_info);
+	struct phl_tx_atf *tx_atf = &phl_info->tx_atf;
+	struct rtw_phl_tring_list *tring_list = NULL;
+	struct phl_atf_sta *atf = NULL;
+	u32 used = 0;
+	u32 val = 0;
+	u64 total = 0;
+
+	if (input_num >= 3 && 0 == _os_strcmp(input[1], "en")) {
+		_os_sscanf(input[2], "%d", &val);
+		rtw_phl_tx_atf_cfg(phl_info, val ? true : false, 0);
+		return;
+	}
+
+	if (input_num >= 3 && 0 == _os_strcmp(input[1], "quantum")) {
+		_os_sscanf(input[2], "%d", &val);
+		rtw_phl_tx_atf_cfg(phl_info, tx_atf->en, val);
+		return;
+	}
+
+	if (input_num >= 2) {
+		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+			"[DBG] atf [en <0|1> | quantum <us>]\n");
+		return;
+	}
+
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"\nen %d, quantum %d us, round %d\n",
+		tx_atf->en, tx_atf->quantum, tx_atf->round_cnt);
+
+	_os_spinlock(drv, &phl_info->t_ring_list_lock, _bh, NULL);
+	phl_list_for_loop(tring_list, struct rtw_phl_tring_list,
+			  &phl_info->t_ring_list, list)
+		total += tring_list->atf.airtime_intvl;
+
+	/* share: airtime of the last watchdog period over all stations */
+	phl_list_for_loop(tring_list, struct rtw_phl_tring_list,
+			  &phl_info->t_ring_list, list) {
+		atf = &tring_list->atf;
+		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+			"macid %d: rate %d00k, ampdu %d, deficit %d, airtime %llu us, share %d%%, held %d\n",
+			tring_list->macid, atf->rate, atf->ampdu,
+			atf->deficit, (unsigned long long)atf->airtime,
+			total ? (u32)_os_division64((u64)atf->airtime_intvl * 100,
+						    total) : 0,
+			atf->held_cnt);
+	}
+	_os_spinunlock(drv, &phl_info->t_ring_list_lock, _bh, NULL);
+}
+#endif /* CONFIG_PHL_TX_ATF */
+
+#ifdef CONFIG_PHL_H2C_COAL
+static const char *h2c_coal_cls_str[H2C_COAL_CLS_MAX] = {
+	"ra", "cam", "role", "stats"
+};
+
+static const char *h2c_coal_trig_str[H2C_COAL_TRIG_MAX] = {
+	"size", "deadline", "order", "end"
+};
+
+/*
+ * echo phl h2c_coal [rst]
+ * echo phl h2c_coal en <0|1>
+ * echo phl h2c_coal map <hex cls_map>
+ * echo phl h2c_coal max <pkt>
+ * echo phl h2c_coal deadline <us>
+ */
+void phl_dbg_h2c_coal(struct phl_info_t *phl_info, char input[][MAX_ARGV],
+		      u32 input_num, char *output, u32 out_len)
+{
+	struct rtw_h2c_coal_cfg cfg = {0};
+	struct rtw_h2c_coal_stat stat = {0};
+	u32 used = 0;
+	u32 val = 0;
+	u8 rst = false;
+	u8 i = 0;
+
+	rtw_hal_h2c_coal_get_cfg(phl_info->hal, &cfg);
+
+	if (input_num >= 3) {
+		if (0 == _os_strcmp(input[1], "en")) {
+			_os_sscanf(input[2], "%d", &val);
+			cfg.en = val ? true : false;
+		} else if (0 == _os_strcmp(input[1], "map")) {
+			_get_hex_from_string(input[2], &val);
+			cfg.cls_map = (u8)(val & (BIT(H2C_COAL_CLS_MAX) - 1));
+		} else if (0 == _os_strcmp(input[1], "max")) {
+			_os_sscanf(input[2], "%d", &val);
+			cfg.max_pkt = (u16)val;
+		} else if (0 == _os_strcmp(input[1], "deadline")) {
+			_os_sscanf(input[2], "%d", &val);
+			cfg.deadline_us = val;
+		} else {
+			goto usage;
+		}
+		if (RTW_HAL_STATUS_SUCCESS !=
+		    rtw_hal_h2c_coal_set_cfg(phl_info->hal, &cfg))
+			PHL_DBG_MON_INFO(out_len, used, output + used,
+				out_len - used, "[DBG] set h2c_coal cfg fail\n");
+		return;
+	}
+
+	if (input_num >= 2) {
+		if (_os_strcmp(input[1], "rst"))
+			goto usage;
+		rst = true;
+	}
+
+	if (RTW_HAL_STATUS_SUCCESS !=
+	    rtw_hal_h2c_coal_get_stat(phl_info->hal, &stat, rst))
+		return;
+
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"\nen %d, map 0x%x, max %d, deadline %d us, tx %d\n",
+		cfg.en, cfg.cls_map, cfg.max_pkt, cfg.deadline_us,
+		stat.tx_cnt);
+	for (i = 0; i < H2C_COAL_TRIG_MAX; i++)
+		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+			"flush by %s: %d\n", h2c_coal_trig_str[i],
+			stat.flush_cnt[i]);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"batch 1/2/3-4/5-8/9+: %d/%d/%d/%d/%d\n",
+		stat.batch_bin[0], stat.batch_bin[1], stat.batch_bin[2],
+		stat.batch_bin[3], stat.batch_bin[4]);
+	for (i = 0; i < H2C_COAL_CLS_MAX; i++)
+		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+			"%s: h2c %d, lat avg %d us, max %d us\n",
+			h2c_coal_cls_str[i], stat.pkt_cnt[i],
+			stat.pkt_cnt[i] ?
+			stat.lat_sum_us[i] / stat.pkt_cnt[i] : 0,
+			stat.lat_max_us[i]);
+	return;
+
+usage:
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"[DBG] h2c_coal [rst | en <0|1> | map <hex> | max <pkt> | deadline <us>]\n");
+}
+#endif /* CONFIG_PHL_H2C_COAL */
+
+#ifdef CONFIG_PHL_IO_SHADOW
+/*
+ * echo phl io_shadow [rst]
+ * echo phl io_shadow en <0|1>
+ */
+void phl_dbg_io_shadow(struct phl_info_t *phl_info, char input[][MAX_ARGV],
+		       u32 input_num, char *output, u32 out_len)
+{
+	struct rtw_io_shadow_stat stat = {0};
+	u32 used = 0;
+	u32 val = 0;
+	u8 rst = false;
+	u8 en = 0;
+
+	if (input_num >= 3) {
+		if (_os_strcmp(input[1], "en"))
+			goto usage;
+		_os_sscanf(input[2], "%d", &val);
+		rtw_hal_io_shadow_ctrl(phl_info->hal, val ? true : false);
+		return;
+	}
+
+	if (input_num >= 2) {
+		if (_os_strcmp(input[1], "rst"))
+			goto usage;
+		rst = true;
+	}
+
+	en = rtw_hal_io_shadow_get_stat(phl_info->hal, &stat, rst);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"\nen %d, read hit %d, miss %d\n", en, stat.hit, stat.miss);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"write skip %d, merge %d, flush %d, inval %d\n",
+		stat.wr_skip, stat.wr_merge, stat.wr_flush, stat.inval);
+	return;
+
+usage:
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"[DBG] io_shadow [rst | en <0|1>]\n");
+}
+#endif /* CONFIG_PHL_IO_SHADOW */
+
+#ifdef CONFIG_PHL_RFK_CACHE
+/*
+ * echo phl rfk_cache [rst]
+ * echo phl rfk_cache en <0|1>
+ * echo phl rfk_cache th <thermal delta>
+ */
+void phl_dbg_rfk_cache(struct phl_info_t *phl_info, char input[][MAX_ARGV],
+		       u32 input_num, char *output, u32 out_len)
+{
+	struct rtw_rfk_cache_stat stat = {0};
+	u32 used = 0;
+	u32 val = 0;
+	u8 rst = false;
+	u8 en = 0;
+	u8 ther_th = 0;
+
+	if (input_num >= 3) {
+		_os_sscanf(input[2], "%d", &val);
+		if (!_os_strcmp(input[1], "en")) {
+			rtw_hal_rf_rfk_cache_cfg(phl_info->hal, val ? true : false,
+						 0);
+		} else if (!_os_strcmp(input[1], "th") && val && val < 0xff) {
+			en = rtw_hal_rf_rfk_cache_get_stat(phl_info->hal, &stat,
+							   &ther_th, false);
+			rtw_hal_rf_rfk_cache_cfg(phl_info->hal, en, (u8)val);
+		} else {
+			goto usage;
+		}
+		return;
+	}
+
+	if (input_num >= 2) {
+		if (_os_strcmp(input[1], "rst"))
+			goto usage;
+		rst = true;
+	}
+
+	en = rtw_hal_rf_rfk_cache_get_stat(phl_info->hal, &stat, &ther_th, rst);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"\nen %d, ther_th %d, hit %d, miss %d, ther_miss %d\n",
+		en, ther_th, stat.hit, stat.miss, stat.ther_miss);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"evict %d, store_fail %d, inval %d\n",
+		stat.evict, stat.store_fail, stat.inval);
+	return;
+
+usage:
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"[DBG] rfk_cache [rst | en <0|1> | th <n>]\n");
+}
+#endif /* CONFIG_PHL_RFK_CACHE */
+
+#ifdef CONFIG_PHL_FAST_CHSW
+/*
+ * echo phl chsw [rst]
+ * echo phl chsw en <0|1>
+ */
+void phl_dbg_chsw(struct phl_info_t *phl_info, char input[][MAX_ARGV],
+		  u32 input_num, char *output, u32 out_len)
+{
+	struct rtw_chsw_stat stat = {0};
+	u32 used = 0;
+	u32 val = 0;
+	u8 rst = false;
+	u8 en = 0;
+
+	if (input_num >= 3) {
+		if (_os_strcmp(input[1], "en"))
+			goto usage;
+		_os_sscanf(input[2], "%d", &val);
+		rtw_hal_chsw_cfg(phl_info->hal, val ? true : false);
+		return;
+	}
+
+	if (input_num >= 2) {
+		if (_os_strcmp(input[1], "rst"))
+			goto usage;
+		rst = true;
+	}
+
+	en = rtw_hal_chsw_get_stat(phl_info->hal, &stat, rst);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"\nen %d, full %d, fast %d, mac_skip %d, pwr_hit %d, pwr_miss %d, inval %d\n",
+		en, stat.full, stat.fast, stat.mac_skip, stat.pwr_hit,
+		stat.pwr_miss, stat.inval);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"full avg %d us max %d us, fast avg %d us max %d us\n",
+		stat.full ? stat.full_us_sum / stat.full : 0, stat.full_us_max,
+		stat.fast ? stat.fast_us_sum / stat.fast : 0, stat.fast_us_max);
+	return;
+
+usage:
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"[DBG] chsw [rst | en <0|1>]\n");
+}
+#endif /* CONFIG_PHL_FAST_CHSW */
+
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+/*
+ * echo phl dispr <band> [rst]
+ */
+void phl_dbg_dispr(struct phl_info_t *phl_info, char input[][MAX_ARGV],
+		   u32 input_num, char *output, u32 out_len)
+{
+	static const char *cls_name[RTW_DISPR_LAT_CLS_NUM] = {
+		"ctrl", "role", "mdry", "opt", "fg"};
+	struct rtw_dispr_stat stat = {0};
+	u32 used = 0;
+	u32 band = 0;
+	u8 rst = false;
+	u8 i = 0;
+	u32 *h = NULL;
+
+	if (input_num < 2)
+		goto usage;
+	_os_sscanf(input[1], "%d", &band);
+	if (input_num >= 3) {
+		if (_os_strcmp(input[2], "rst"))
+			goto usage;
+		rst = true;
+	}
+
+	if (RTW_PHL_STATUS_SUCCESS !=
+	    phl_disp_eng_get_stat(phl_info, (u8)band, &stat, rst))
+		goto usage;
+
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"\nbatch %d, msg %d, batch_max %d, sub_rebuild %d\n",
+		stat.batch, stat.msg, stat.batch_max, stat.sub_rebuild);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"cls   cnt      max_us   <100us <500us <1ms   <5ms   <10ms  <50ms  <100ms >=100ms\n");
+	for (i = 0; i < RTW_DISPR_LAT_CLS_NUM; i++) {
+		h = stat.lat_hist[i];
+		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+			"%-5s %-8d %-8d %-6d %-6d %-6d %-6d %-6d %-6d %-6d %-6d\n",
+			cls_name[i], stat.lat_cnt[i], stat.lat_us_max[i],
+			h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7]);
+	}
+	return;
+
+usage:
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"[DBG] dispr <band> [rst]\n");
+}
+#endif /* CONFIG_PHL_CMD_DISP_BATCH */
+
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+/*
+ * echo phl msg_hub [rst]
+ */
+void phl_dbg_msg_hub(struct phl_info_t *phl_info, char input[][MAX_ARGV],
+		     u32 input_num, char *output, u32 out_len)
+{
+	static const char *layer_name[MSG_RECV_MAX] = {"phl", "core"};
+	struct rtw_msg_hub_stat stat = {0};
+	struct rtw_msg_recv_stat *r = NULL;
+	u32 used = 0;
+	u8 rst = false;
+	u8 i = 0;
+
+	if (input_num >= 2) {
+		if (_os_strcmp(input[1], "rst"))
+			goto usage;
+		rst = true;
+	}
+
+	if (RTW_PHL_STATUS_SUCCESS !=
+	    phl_msg_hub_get_stat(phl_info, &stat, rst))
+		goto usage;
+
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"\nsend %d, drop %d, idle %d\n", stat.send, stat.drop, stat.idle);
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"layer depth  depth_max msg      coal     batch    batch_max\n");
+	for (i = 0; i < MSG_RECV_MAX; i++) {
+		r = &stat.recv[i];
+		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+			"%-5s %-6d %-9d %-8d %-8d %-8d %-9d\n",
+			layer_name[i], r->depth, r->depth_max, r->msg, r->coal,
+			r->batch, r->batch_max);
+	}
+	return;
+
+usage:
+	PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
+		"[DBG] msg_hub [rst]\n");
+}
+#endif /* CONFIG_PHL_MSG_HUB_RECV_Q */
+
 void phl_dbg_cmd_show_rssi(struct phl_info_t *phl_info, char input[][MAX_ARGV],
 		 	   u32 input_num, char *output, u32 out_len)
 {
@@ -1390,6 +2029,81 @@ void phl_dbg_cmd_parser(struct phl_info_t *phl_info, char input[][MAX_ARGV],
 			"[DBG] Current TX duty control: %d \n", tx_duty);
 	}
 	break;
+	case PHL_DBG_BENCH:
+	{
+		phl_bench_cmd_parser(phl_info, input, input_num, output, out_len);
+	}
+	break;
+#ifdef CONFIG_PHL_RX_CLS
+	case PHL_DBG_RX_CLS:
+	{
+		phl_dbg_rx_cls(phl_info, input, input_num, output, out_len);
+	}
+	break;
+#endif
+#ifdef CONFIG_PHL_DLE_REBAL
+	case PHL_DBG_DLE_REBAL:
+	{
+		phl_dbg_dle_rebal(phl_info, input, input_num, output, out_len);
+	}
+	break;
+#endif
+#ifdef CONFIG_PHL_TX_ATF
+	case PHL_DBG_TX_ATF:
+	{
+		phl_dbg_tx_atf(phl_info, input, input_num, output, out_len);
+	}
+	break;
+#endif
+#ifdef CONFIG_PHL_H2C_COAL
+	case PHL_DBG_H2C_COAL:
+	{
+		phl_dbg_h2c_coal(phl_info, input, input_num, output, out_len);
+	}
+	break;
+#endif
+#ifdef CONFIG_PHL_IO_SHADOW
+	case PHL_DBG_IO_SHADOW:
+	{
+		phl_dbg_io_shadow(phl_info, input, input_num, output, out_len);
+	}
+	break;
+#endif
+#ifdef CONFIG_PHL_RFK_CACHE
+	case PHL_DBG_RFK_CACHE:
+	{
+		phl_dbg_rfk_cache(phl_info, input, input_num, output, out_len);
+	}
+	break;
+#endif
+#ifdef CONFIG_PHL_FAST_CHSW
+	case PHL_DBG_CHSW:
+	{
+		phl_dbg_chsw(phl_info, input, input_num, output, out_len);
+	}
+	break;
+#endif
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+	case PHL_DBG_DISPR:
+	{
+		phl_dbg_dispr(phl_info, input, input_num, output, out_len);
+	}
+	break;
+#endif
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+	case PHL_DBG_MSG_HUB:
+	{
+		phl_dbg_msg_hub(phl_info, input, input_num, output, out_len);
+	}
+	break;
+#endif
+#ifdef CONFIG_PHL_HCI_SIM
+	case PHL_DBG_HCI_SIM:
+	{
+		phl_dbg_hci_sim(phl_info, input, input_num, output, out_len);
+	}
+	break;
+#endif
 	default:
 		PHL_DBG_MON_INFO(out_len, used, output + used,
 			out_len - used, "[DBG] Do not support this command\n");
@@ -58,7 +58,38 @@ enum PHL_DBG_CMD_ID {
 	PHL_DBG_ECSA,
 	PHL_DBG_MCC,
 	PHL_DBG_LTR,
-	PHL_DBG_CFG_TX_DUTY
+	PHL_DBG_CFG_TX_DUTY,
+	PHL_DBG_BENCH,
+#ifdef CONFIG_PHL_RX_CLS
+	PHL_DBG_RX_CLS,
+#endif
+#ifdef CONFIG_PHL_DLE_REBAL
+	PHL_DBG_DLE_REBAL,
+#endif
+#ifdef CONFIG_PHL_TX_ATF
+	PHL_DBG_TX_ATF,
+#endif
+#ifdef CONFIG_PHL_H2C_COAL
+	PHL_DBG_H2C_COAL,
+#endif
+#ifdef CONFIG_PHL_IO_SHADOW
+	PHL_DBG_IO_SHADOW,
+#endif
+#ifdef CONFIG_PHL_RFK_CACHE
+	PHL_DBG_RFK_CACHE,
+#endif
+#ifdef CONFIG_PHL_FAST_CHSW
+	PHL_DBG_CHSW,
+#endif
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+	PHL_DBG_DISPR,
+#endif
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+	PHL_DBG_MSG_HUB,
+#endif
+#ifdef CONFIG_PHL_HCI_SIM
+	PHL_DBG_HCI_SIM
+#endif
 };
 
 static const struct phl_dbg_cmd_info phl_dbg_cmd_i[] = {
@@ -83,7 +114,38 @@ static const struct phl_dbg_cmd_info phl_dbg_cmd_i[] = {
 	{"ecsa", PHL_DBG_ECSA},
 	{"mcc", PHL_DBG_MCC},
 	{"ltr", PHL_DBG_LTR},
-	{"tx_duty", PHL_DBG_CFG_TX_DUTY}
+	{"tx_duty", PHL_DBG_CFG_TX_DUTY},
+	{"bench", PHL_DBG_BENCH},
+#ifdef CONFIG_PHL_RX_CLS
+	{"rx_cls", PHL_DBG_RX_CLS},
+#endif
+#ifdef CONFIG_PHL_DLE_REBAL
+	{"dle_rebal", PHL_DBG_DLE_REBAL},
+#endif
+#ifdef CONFIG_PHL_TX_ATF
+	{"atf", PHL_DBG_TX_ATF},
+#endif
+#ifdef CONFIG_PHL_H2C_COAL
+	{"h2c_coal", PHL_DBG_H2C_COAL},
+#endif
+#ifdef CONFIG_PHL_IO_SHADOW
+	{"io_shadow", PHL_DBG_IO_SHADOW},
+#endif
+#ifdef CONFIG_PHL_RFK_CACHE
+	{"rfk_cache", PHL_DBG_RFK_CACHE},
+#endif
+#ifdef CONFIG_PHL_FAST_CHSW
+	{"chsw", PHL_DBG_CHSW},
+#endif
+#ifdef CONFIG_PHL_CMD_DISP_BATCH
+	{"dispr", PHL_DBG_DISPR},
+#endif
+#ifdef CONFIG_PHL_MSG_HUB_RECV_Q
+	{"msg_hub", PHL_DBG_MSG_HUB},
+#endif
+#ifdef CONFIG_PHL_HCI_SIM
+	{"hci_sim", PHL_DBG_HCI_SIM}
+#endif
 };
 
 enum rtw_hal_status
@@ -24,14 +24,20 @@ enum PHL_PS_CMD_ID {
 	PHL_PS_HELP,
 	PHL_PS_SHOW,
 	PHL_PS_TEST,
-	PHL_PS_STOP_PS
+	PHL_PS_STOP_PS,
+#ifdef CONFIG_PHL_PS_PREDICT
+	PHL_PS_PRED
+#endif
 };
 
 struct phl_ps_cmd_info phl_ps_cmd_i[] = {
 	{"-h", PHL_PS_HELP},
 	{"show", PHL_PS_SHOW},
 	{"test", PHL_PS_TEST},
-	{"stop_ps", PHL_PS_STOP_PS}
+	{"stop_ps", PHL_PS_STOP_PS},
+#ifdef CONFIG_PHL_PS_PREDICT
+	{"pred", PHL_PS_PRED}
+#endif
 };
 
 /* echo phl ps show */
@@ -63,6 +69,18 @@ static void _phl_ps_cmd_test_ps(struct phl_info_t *phl_info, u32 *used, char inp
 	phl_ps_dbg_test_ps(phl_info, used, input, input_num, output, out_len);
 }
 
+#ifdef CONFIG_PHL_PS_PREDICT
+/* echo phl ps pred [rst | en <0/1>] */
+static void _phl_ps_cmd_pred(struct phl_info_t *phl_info, u32 *used, char input[][MAX_ARGV],
+			u32 input_num, char *output, u32 out_len)
+{
+	if (phl_info == NULL)
+		return;
+
+	phl_ps_dbg_pred(phl_info, used, input, input_num, output, out_len);
+}
+#endif
+
 void phl_ps_cmd_parser(struct phl_info_t *phl_info, char input[][MAX_ARGV],
 			u32 input_num, char *output, u32 out_len)
 {
@@ -96,6 +114,12 @@ void phl_ps_cmd_parser(struct phl_info_t *phl_info, char input[][MAX_ARGV],
 		_phl_ps_cmd_stop_ps(phl_info, &used, input, input_num,
 					output, out_len);
 		break;
+#ifdef CONFIG_PHL_PS_PREDICT
+	case PHL_PS_PRED:
+		_phl_ps_cmd_pred(phl_info, &used, input, input_num,
+					output, out_len);
+		break;
+#endif
 	default:
 		PS_CNSL(out_len, used, output + used, out_len - used,
 			 "command not supported !!\n");
@@ -244,4 +268,47 @@ void phl_ps_dbg_test_ps(struct phl_info_t *phl_info, u32 *used,
 	} while (0);
 }
 
+#ifdef CONFIG_PHL_PS_PREDICT
+void phl_ps_dbg_pred(struct phl_info_t *phl_info, u32 *used,
+	char input[][MAX_ARGV], u32 input_num, char *output, u32 out_len)
+{
+	struct phl_module_op_info op_info = {0};
+	struct rtw_ps_pred_stat stat = {0};
+	u32 val = 0;
+	bool en = false;
+
+	if (input_num >= 3 && !_os_strcmp(input[2], "rst")) {
+		op_info.op_code = PS_MDL_OP_PRED_RST;
+		phl_disp_eng_set_bk_module_info(phl_info, HW_BAND_0,
+				PHL_MDL_POWER_MGNT, &op_info);
+	} else if (input_num >= 4 && !_os_strcmp(input[2], "en")) {
+		if (!_get_hex_from_string(input[3], &val))
+			return;
+		en = (val ? true : false);
+		op_info.op_code = PS_MDL_OP_PRED_EN;
+		op_info.inbuf = (u8 *)&en;
+		op_info.inlen = sizeof(en);
+		phl_disp_eng_set_bk_module_info(phl_info, HW_BAND_0,
+				PHL_MDL_POWER_MGNT, &op_info);
+	}
+
+	op_info.op_code = PS_MDL_OP_PRED_STAT;
+	op_info.inbuf = (u8 *)&stat;
+	op_info.inlen = sizeof(stat);
+	if (phl_disp_eng_query_bk_module_info(phl_info, HW_BAND_0,
+			PHL_MDL_POWER_MGNT, &op_info) != RTW_PHL_STATUS_SUCCESS)
+		return;
+
+	PS_CNSL(out_len, *used, output + *used, out_len - *used,
+		"en: %d, enter: %d, wake: %d, tx_wake: %d, ps_ms: %d\
+		\nsup_burst: %d, sup_periodic: %d, wake_cost_us: %d\
+		\nwake lat cnt: %d, avg_us: %d, max_us: %d\n",
+		stat.en, stat.enter, stat.wake, stat.tx_wake, stat.ps_ms,
+		stat.sup_burst, stat.sup_periodic, stat.wake_cost_us,
+		stat.lat_cnt,
+		(stat.lat_cnt ? (u32)_os_division64(stat.lat_us_sum, stat.lat_cnt) : 0),
+		stat.lat_us_max);
+}
+#endif /* CONFIG_PHL_PS_PREDICT */
+
 #endif /* CONFIG_POWER_SAVE */
@@ -31,6 +31,10 @@ void phl_ps_dbg_stop_ps(struct phl_info_t *phl_info, u32 *used,
 		char input[][MAX_ARGV], u32 input_num, char *output, u32 out_len);
 void phl_ps_dbg_test_ps(struct phl_info_t *phl_info, u32 *used,
 		char input[][MAX_ARGV], u32 input_num, char *output, u32 out_len);
+#ifdef CONFIG_PHL_PS_PREDICT
+void phl_ps_dbg_pred(struct phl_info_t *phl_info, u32 *used,
+		char input[][MAX_ARGV], u32 input_num, char *output, u32 out_len);
+#endif
 
 #endif
 #endif /* _PHL_PS_DBG_CMD_H_ */
@@ -24,12 +24,18 @@ enum PHL_SER_CMD_ID {
 	PHL_SER_STATE,
 	PHL_SER_CMAC,
 	PHL_SER_DMAC,
+#ifdef CONFIG_PHL_SER_FAST_L1
+	PHL_SER_L1,
+#endif
 };
 
 struct phl_ser_cmd_info phl_ser_cmd_i[] = {
 	{"state", PHL_SER_STATE},
 	{"cmac", PHL_SER_CMAC},
-	{"dmac", PHL_SER_DMAC}
+	{"dmac", PHL_SER_DMAC},
+#ifdef CONFIG_PHL_SER_FAST_L1
+	{"l1", PHL_SER_L1}
+#endif
 };
 
 /* echo phl ser state */
@@ -83,6 +89,38 @@ void _phl_ser_cmd_dmac(struct phl_info_t *phl_info, u32 *used, char input[][MAX_
 			"\nSER DMAC Reset (status = 0x%x) \n", (int)status);
 }
 
+#ifdef CONFIG_PHL_SER_FAST_L1
+/* echo phl ser l1 [rst] */
+void _phl_ser_cmd_l1(struct phl_info_t *phl_info, u32 *used, char input[][MAX_ARGV],
+			u32 input_num, char *output, u32 out_len)
+{
+	static const char *stg_name[RTW_SER_L1_STG_NUM] = {
+		"pause", "wait_m3", "reset", "wait_m5", "resume"};
+	struct rtw_ser_l1_stat stat = {0};
+	bool rst = false;
+	u8 i = 0;
+
+	if (input_num >= 3 && !_os_strcmp(input[2], "rst"))
+		rst = true;
+
+	if (RTW_PHL_STATUS_SUCCESS != phl_ser_get_l1_stat(phl_info, &stat, rst))
+		return;
+
+	PHL_DBG_MON_INFO(out_len, *used, output + *used, out_len - *used,
+		"\n[SER L1] done %d, fail %d, requeue %d, drop %d\n"
+		"total_us last %d, max %d\n",
+		stat.done, stat.fail, stat.requeue, stat.drop,
+		stat.total_us_last, stat.total_us_max);
+
+	for (i = 0; i < RTW_SER_L1_STG_NUM; i++) {
+		PHL_DBG_MON_INFO(out_len, *used, output + *used, out_len - *used,
+			"%-8s last %d us, max %d us, avg %d us\n",
+			stg_name[i], stat.stg_us_last[i], stat.stg_us_max[i],
+			(stat.done ? (u32)_os_division64(stat.stg_us_sum[i], stat.done) : 0));
+	}
+}
+#endif
+
 void phl_ser_cmd_parser(struct phl_info_t *phl_info, char input[][MAX_ARGV],
 			u32 input_num, char *output, u32 out_len)
 {
@@ -116,6 +154,12 @@ void phl_ser_cmd_parser(struct phl_info_t *phl_info, char input[][MAX_ARGV],
 		_phl_ser_cmd_dmac(phl_info, &used, input, input_num,
 					output, out_len);
 		break;
+#ifdef CONFIG_PHL_SER_FAST_L1
+	case PHL_SER_L1:
+		_phl_ser_cmd_l1(phl_info, &used, input, input_num,
+					output, out_len);
+		break;
+#endif
 	default:
 		PHL_DBG_MON_INFO(out_len, used, output + used, out_len - used,
 			 "command not supported !!\n");
@@ -1001,6 +1001,29 @@ enum rtw_phl_status phl_rx_ring_test(void *phl,
 }
 
 
+#ifdef CONFIG_PHL_HCI_SIM
+/*
+ * With the software HCI backend every tx request comes back on the rx ring,
+ * so the tx ring test followed by an rx kick exercises the full datapath.
+ */
+enum rtw_phl_status phl_ring_loopback_test(void *phl,
+					   struct rtw_trx_test_param *test_param)
+{
+	enum rtw_phl_status sts = RTW_PHL_STATUS_FAILURE;
+	FUNCIN_WSTS(sts);
+	do {
+		sts = phl_tx_ring_test(phl, test_param);
+		if (RTW_PHL_STATUS_SUCCESS != sts)
+			break;
+
+		sts = phl_rx_ring_test(phl, test_param);
+	} while (false);
+	FUNCOUT_WSTS(sts);
+	return sts;
+}
+#endif /* CONFIG_PHL_HCI_SIM */
+
+
 enum rtw_phl_status phl_hal_tx_test(void *phl,
 				     struct rtw_trx_test_param *test_param)
 {
@@ -1102,6 +1125,11 @@ enum rtw_phl_status phl_trx_test_start(void *phl,
 	case TEST_MODE_PHL_RX_RING_TEST:
 		status = phl_rx_ring_test(phl, test_param);
 		break;
+#ifdef CONFIG_PHL_HCI_SIM
+	case TEST_MODE_PHL_RING_LOOPBACK:
+		status = phl_ring_loopback_test(phl, test_param);
+		break;
+#endif
 	case TEST_MODE_HAL_TX_TEST:
 		status = phl_hal_tx_test(phl, test_param);
 		break;